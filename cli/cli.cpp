@@ -236,7 +236,7 @@ namespace cppsdkcli {
 
 		do {
 			util::String payload = "Hello from SDK : ";
-			payload.append(std::to_string(itr));
+			payload.append(util::ToString(itr));
 			std::unique_ptr<Utf8String> p_topic_name = Utf8String::Create(p_topic_name_str);
 			rc = p_iot_client_->Publish(std::move(p_topic_name), false, false,
 										mqtt::QoS::QOS1, payload, std::chrono::milliseconds(2000));
@@ -28,7 +28,9 @@
 #include <iostream>
 #include <memory>
 #include <atomic>
+#include <chrono>
 
+#include "util/OutputBuffer.hpp"
 #include "util/Utf8String.hpp"
 #include "util/threading/ThreadTask.hpp"
 
@@ -60,7 +62,21 @@ namespace awsiotsdk {
 		KEEP_ALIVE = 12,
 		PUBLISH_INBOUND = 13,
 		UNSUBSCRIBE = 14,
-		RECONNECT = 15
+		RECONNECT = 15,
+		PUBLISH_BATCH = 16
+	};
+
+	/**
+	 * @brief ActionPriority Enum Class
+	 *
+	 * Defines the priority lanes of the outbound action queue. Queued Control actions are always performed first.
+	 * High and Normal priority actions share the remaining capacity, with High priority actions being
+	 * preferred but not allowed to starve Normal priority actions
+	 */
+	enum class ActionPriority {
+		CONTROL = 0,	///< Protocol control packets, eg. PUBACK, PINGREQ, SUBSCRIBE, UNSUBSCRIBE
+		HIGH = 1,		///< Application data that expects an Ack, eg. QoS1 Publish
+		NORMAL = 2		///< Application data that does not expect an Ack, eg. QoS0 Publish
 	};
 
 	/**
@@ -128,6 +144,12 @@ namespace awsiotsdk {
 		 * @param action_id - new Action ID
 		 */
 		virtual void SetActionId(uint16_t action_id) = 0;
+
+		/**
+		 * @brief Get the number of packets this run of the Action sends, used to charge per type rate limits
+		 * @return uint32_t - Packet count
+		 */
+		virtual uint32_t GetPacketCount() { return 1; }
 	};
 
 	/**
@@ -187,6 +209,25 @@ namespace awsiotsdk {
 		virtual ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
 										   std::shared_ptr<ActionData> p_action_data) = 0;
 
+		/**
+		 * @brief Perform one non-blocking step of an Action runner
+		 *
+		 * Called repeatedly by a Client Reactor instead of running PerformAction in a dedicated thread.
+		 * A step must not block, it does the work that is currently possible and returns the time at which it
+		 * should be called again. It is also called earlier if the network connection becomes readable.
+		 * Default implementation returns ACTION_STEP_NOT_SUPPORTED_ERROR
+		 *
+		 * @param p_network_connection - Network connection to be used to perform the Action
+		 * @param [out] next_step_time_out - Time at which the next step should be performed
+		 * @return ResponseCode indicating result of the API call
+		 */
+		virtual ResponseCode PerformStep(std::shared_ptr<NetworkConnection> p_network_connection,
+										 std::chrono::steady_clock::time_point &next_step_time_out) {
+			IOT_UNUSED(p_network_connection);
+			IOT_UNUSED(next_step_time_out);
+			return ResponseCode::ACTION_STEP_NOT_SUPPORTED_ERROR;
+		}
+
 		// Rule of 5 stuff
 		// Disabling default, move and copy constructors
 		// Actions instances can be run as threads if needed and should not be copied or moved
@@ -209,6 +250,7 @@ namespace awsiotsdk {
 		ActionType action_type_;                                ///< Type of the action
 		util::String action_info_string_;                        ///< Info string
 		std::shared_ptr<std::atomic_bool> p_thread_continue_;    ///< Shared atomic variable used for sync when action is run in separate thread
+		util::OutputBuffer output_buffer_;                        ///< Reused to serialize outbound packets, an Action instance is never run concurrently
 
 		/**
 		 * @brief Generic Network Read function for all actions
@@ -228,5 +270,19 @@ namespace awsiotsdk {
 		 */
 		ResponseCode WriteToNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection,
 										  const util::String &write_buf);
+
+		/**
+		 * @brief Generic vectored Network Write function for all actions
+		 *
+		 * Writes the segments as one contiguous stream using NetworkConnection::WriteV. Partial writes are resumed
+		 * from the first unsent byte without copying the remaining data
+		 *
+		 * @param p_network_connection - Network connection to be used to perform Write
+		 * @param p_segments - Buffer segments to be written, in order
+		 * @param segment_count - Number of segments
+		 * @return ResponeCode indicating result of the API call
+		 */
+		ResponseCode WriteToNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection,
+										  const util::StringView *p_segments, size_t segment_count);
 	};
 }
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ActionCompletion.hpp
+ * @brief Completion state of a single request
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "Action.hpp"
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	/**
+	 * @brief Action Completion Class
+	 *
+	 * Holds the response for a single request and lets any number of threads wait for it. Each request gets its own
+	 * instance, shared between the waiting thread and the Ack handler, so that requests do not have to share
+	 * a response variable or a lock while they wait
+	 */
+	class AWS_API_EXPORT ActionCompletion {
+	public:
+		/**
+		 * @brief Signal shared between multiple completions, used to wait for any one of them
+		 */
+		class AWS_API_EXPORT Signal {
+		protected:
+			std::mutex signal_lock_;				///< Mutex for signal state
+			std::condition_variable signal_wait_;	///< Condition variable used to wake up the waiting thread
+			bool is_signalled_;						///< Whether any of the completions has completed
+
+		public:
+			Signal() : is_signalled_(false) { }
+
+			/**
+			 * @brief Set the signal and wake up the waiting thread
+			 */
+			void Notify();
+
+			/**
+			 * @brief Wait for the signal to be set
+			 *
+			 * @param deadline - Time until which to wait
+			 * @return true if the signal was set before the deadline
+			 */
+			bool WaitUntil(std::chrono::steady_clock::time_point deadline);
+		};
+
+	protected:
+		std::mutex completion_lock_;				///< Mutex for completion state
+		std::condition_variable completion_wait_;	///< Condition variable used to wake up waiting threads on completion
+		bool is_complete_;							///< Whether a response has been received
+		ResponseCode response_;						///< Received response, valid once complete
+		util::Vector<std::shared_ptr<Signal>> signals_;	///< Signals to notify on completion
+
+	public:
+		ActionCompletion();
+
+		// Rule of 5 stuff
+		// Shared between threads through a shared_ptr, should not be moved or copied
+		ActionCompletion(const ActionCompletion &) = delete;					// Delete Copy constructor
+		ActionCompletion(ActionCompletion &&) = delete;							// Delete Move constructor
+		ActionCompletion &operator=(const ActionCompletion &) & = delete;		// Delete Copy assignment operator
+		ActionCompletion &operator=(ActionCompletion &&) & = delete;			// Delete Move assignment operator
+		~ActionCompletion() { }
+
+		/**
+		 * @brief Factory method to create an Action Completion instance
+		 * @return std::shared_ptr<ActionCompletion>
+		 */
+		static std::shared_ptr<ActionCompletion> Create();
+
+		/**
+		 * @brief Get an Ack handler that completes the provided instance
+		 *
+		 * @param p_action_completion - Instance to complete when the handler is called
+		 * @return ActionData::AsyncAckNotificationHandlerPtr Handler
+		 */
+		static ActionData::AsyncAckNotificationHandlerPtr GetAckHandler(
+				std::shared_ptr<ActionCompletion> p_action_completion);
+
+		/**
+		 * @brief Set the response and wake up waiting threads. Only the first call has any effect
+		 *
+		 * @param rc - Response
+		 * @return true if this call completed the instance
+		 */
+		bool Complete(ResponseCode rc);
+
+		/**
+		 * @brief Has a response been received?
+		 * @return boolean indicating completion status
+		 */
+		bool IsComplete();
+
+		/**
+		 * @brief Get the received response
+		 * @return ResponseCode Received response, MQTT_REQUEST_TIMEOUT_ERROR if not complete
+		 */
+		ResponseCode GetResponseCode();
+
+		/**
+		 * @brief Wait for a response
+		 *
+		 * @param timeout - Max time to wait
+		 * @return true if a response was received within the timeout
+		 */
+		bool WaitFor(std::chrono::milliseconds timeout);
+
+		/**
+		 * @brief Wait for a response
+		 *
+		 * @param deadline - Time until which to wait
+		 * @return true if a response was received before the deadline
+		 */
+		bool WaitUntil(std::chrono::steady_clock::time_point deadline);
+
+		/**
+		 * @brief Add a signal to be notified on completion
+		 *
+		 * @param p_signal - Signal to notify
+		 * @return false if already complete, the signal is not added in that case
+		 */
+		bool AddSignal(std::shared_ptr<Signal> p_signal);
+
+		/**
+		 * @brief Remove a previously added signal
+		 *
+		 * @param p_signal - Signal to remove
+		 */
+		void RemoveSignal(const std::shared_ptr<Signal> &p_signal);
+	};
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ActionFuture.hpp
+ * @brief Handle to the result of an Async request
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "ActionCompletion.hpp"
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	/**
+	 * @brief Action Future Class
+	 *
+	 * Lightweight handle to the response of an Async request, an alternative to providing an Ack handler and matching
+	 * responses to requests by Action ID. Copies of a future refer to the same request. A future is ready once
+	 * a response has been received, the request has failed or the request has timed out. Multiple futures can be
+	 * waited on together using WaitAll and WaitAny
+	 */
+	class AWS_API_EXPORT ActionFuture {
+	protected:
+		std::shared_ptr<ActionCompletion> p_action_completion_;	///< Completion state shared with the Ack handler
+		uint16_t action_id_;									///< Action ID assigned to the request
+
+	public:
+		/**
+		 * @brief Default constructor, creates a future that is not associated with any request
+		 */
+		ActionFuture();
+
+		/**
+		 * @brief Constructor
+		 *
+		 * @param p_action_completion - Completion state of the request
+		 * @param action_id - Action ID assigned to the request
+		 */
+		ActionFuture(std::shared_ptr<ActionCompletion> p_action_completion, uint16_t action_id);
+
+		// Rule of 5 stuff
+		// Keeping defaults, futures are cheap to copy and move
+		ActionFuture(const ActionFuture &) = default;					// Default Copy constructor
+		ActionFuture(ActionFuture &&) = default;						// Default Move constructor
+		ActionFuture &operator=(const ActionFuture &) & = default;		// Default Copy assignment operator
+		ActionFuture &operator=(ActionFuture &&) & = default;			// Default Move assignment operator
+		~ActionFuture() = default;										// Default destructor
+
+		/**
+		 * @brief Create a future that is already ready with the given response
+		 *
+		 * @param rc - Response
+		 * @return ActionFuture Ready future
+		 */
+		static ActionFuture CreateReady(ResponseCode rc);
+
+		/**
+		 * @brief Is this future associated with a request?
+		 * @return boolean indicating validity
+		 */
+		bool IsValid() const { return nullptr != p_action_completion_; }
+
+		/**
+		 * @brief Get Action ID assigned to the request, this is the Packet ID for MQTT requests
+		 * @return uint16_t Action ID
+		 */
+		uint16_t GetActionId() const { return action_id_; }
+
+		/**
+		 * @brief Is the response available?
+		 * @return true if the response is available, false if it is not or the future is not valid
+		 */
+		bool IsReady() const;
+
+		/**
+		 * @brief Wait for the response
+		 *
+		 * @param timeout - Max time to wait
+		 * @return true if the response is available
+		 */
+		bool WaitFor(std::chrono::milliseconds timeout) const;
+
+		/**
+		 * @brief Get the response, does not wait
+		 * @return ResponseCode Response, MQTT_REQUEST_TIMEOUT_ERROR if not ready, NULL_VALUE_ERROR if not valid
+		 */
+		ResponseCode GetResponseCode() const;
+
+		/**
+		 * @brief Wait for all futures to be ready
+		 *
+		 * @param futures - Futures to wait for
+		 * @param timeout - Max time to wait for all of them
+		 * @return ResponseCode SUCCESS if all futures are ready, MQTT_REQUEST_TIMEOUT_ERROR otherwise.
+		 * Responses of the individual requests are available from the futures
+		 */
+		static ResponseCode WaitAll(const util::Vector<ActionFuture> &futures, std::chrono::milliseconds timeout);
+
+		/**
+		 * @brief Wait for any one of the futures to be ready
+		 *
+		 * @param futures - Futures to wait for
+		 * @param timeout - Max time to wait
+		 * @param ready_index_out[out] - Index of the first ready future in the list
+		 * @return ResponseCode SUCCESS if a future is ready, MQTT_REQUEST_TIMEOUT_ERROR if none became ready within
+		 * the timeout, NULL_VALUE_ERROR if the list has no valid futures
+		 */
+		static ResponseCode WaitAny(const util::Vector<ActionFuture> &futures, std::chrono::milliseconds timeout,
+									size_t &ready_index_out);
+	};
+}
@@ -27,6 +27,7 @@
 #pragma once
 
 #include "ClientCoreState.hpp"
+#include "ClientReactor.hpp"
 #include "util/threading/ThreadTask.hpp"
 
 namespace awsiotsdk {
@@ -45,6 +46,8 @@ namespace awsiotsdk {
 		util::Map<ActionType, std::shared_ptr<util::Threading::ThreadTask>> thread_map_;    ///< Map for storing currently active threads
 
 		std::shared_ptr<ClientCoreState> p_client_core_state_;								///< Client Core state instance
+		std::shared_ptr<ClientReactor> p_client_reactor_;									///< Client Reactor driving this instance, nullptr if it runs its own threads
+		uint32_t reactor_client_id_;														///< ID of this instance in the Client Reactor
 
 		/**
 		 * @brief Constructor
@@ -54,6 +57,16 @@ namespace awsiotsdk {
 		 */
 		ClientCore(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ClientCoreState> p_state);
 
+		/**
+		 * @brief Constructor for instances driven by a Client Reactor, does not start any threads
+		 *
+		 * @param p_network_connection - Network Connection instance to be passed as argument to actions
+		 * @param p_state - Client Core state instance
+		 * @param p_client_reactor - Client Reactor the instance will be added to
+		 */
+		ClientCore(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ClientCoreState> p_state,
+				   std::shared_ptr<ClientReactor> p_client_reactor);
+
 	public:
 		// Disabling default, copy and move constructors. Defining the virtual destructor
 		// Class contains thread instances. Should not be copied or moved
@@ -83,6 +96,21 @@ namespace awsiotsdk {
 		static std::unique_ptr<ClientCore>
 		Create(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ClientCoreState> p_state);
 
+		/**
+		 * @brief Factory method for creating a Client Core instance driven by a Client Reactor
+		 *
+		 * Outbound actions and Action runners are performed by the event loop thread of the Client Reactor
+		 * instead of dedicated threads. See ClientReactor for restrictions on callbacks
+		 *
+		 * @param p_network_connection - Network Connection instance to be passed as argument to actions
+		 * @param p_state - Client Core state instance
+		 * @param p_client_reactor - Client Reactor to add the instance to
+		 * @return nullptr on error, std::unique_ptr<ClientCore> instance otherwise
+		 */
+		static std::unique_ptr<ClientCore>
+		Create(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ClientCoreState> p_state,
+			   std::shared_ptr<ClientReactor> p_client_reactor);
+
 		/**
 		 * @brief Register Action for execution by Client Core
 		 *
@@ -103,8 +131,8 @@ namespace awsiotsdk {
 		 * @brief Perform Action in Blocking Mode
 		 *
 		 * This API will perform the Action in Blocking mode. The timeout for the action to give a valid response
-		 * is provided as an argument. This API stops processing of all outbound actions until Response is received
-		 * for the requested Action Type
+		 * is provided as an argument. Each call waits for its own response, so multiple threads can have blocking
+		 * Actions in flight at the same time. Outbound actions are only held up while the request is being written
 		 *
 		 * @param action_type - Type of the Action to be executed. Must be registered
 		 * @param action_data - Action Data to be passed as argument to the Action instance
@@ -130,12 +158,28 @@ namespace awsiotsdk {
 		ResponseCode PerformActionAsync(ActionType action_type, std::shared_ptr<ActionData> action_data,
 										uint16_t &action_id_out);
 
+		/**
+		 * @brief Perform Action in Asynchronous Mode with the given priority
+		 *
+		 * Same as PerformActionAsync, the Action is enqueued in the priority lane provided as argument
+		 *
+		 * @param action_type - Type of the Action to be executed. Must be registered
+		 * @param action_data - Action Data to be passed as argument to the Action instance
+		 * @param action_priority - Priority lane to enqueue the Action in
+		 * @param [out] action_id_out - Action ID assigned to this request
+		 *
+		 * @return ResponseCode indicating result of the enqueue operation
+		 */
+		ResponseCode PerformActionAsync(ActionType action_type, std::shared_ptr<ActionData> action_data,
+										ActionPriority action_priority, uint16_t &action_id_out);
+
 		/**
 		 * @brief Create Thread Task to execute request Action Type
 		 *
 		 * This API will create a new instance of the Action Type that is request in the API call and call perform
 		 * action on that instance in a new Thread Task. If the Action is Thread Aware, it will be executed until
-		 * it finishes or the Thread Task is terminated (Usually on exit).
+		 * it finishes or the Thread Task is terminated (Usually on exit). Instances driven by a Client Reactor
+		 * perform the Action in steps on the event loop thread instead, Action data is not used in that case.
 		 *
 		 * @param action_type - Type of the Action to be executed. Must be registered
 		 * @param action_data - Action Data to be passed as argument to the Action instance
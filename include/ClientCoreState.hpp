@@ -22,29 +22,95 @@
 #pragma once
 
 #include <condition_variable>
+#include <mutex>
 #include <chrono>
 
 #include "util/Core_EXPORTS.hpp"
 
 #include "util/Utf8String.hpp"
+#include "util/memory/MemoryResource.hpp"
 #include "util/memory/stl/Map.hpp"
 #include "util/memory/stl/Queue.hpp"
+#include "util/threading/LockFreeQueue.hpp"
+#include "util/threading/TokenBucket.hpp"
 
 #include "Action.hpp"
 #include "ResponseCode.hpp"
 #include "NetworkConnection.hpp"
+#include "ActionCompletion.hpp"
+#include "CoalescingNetworkConnection.hpp"
+#include "PendingAckTracker.hpp"
 
 /**
  * Default sleep duration between each execution of Client Core thread operations
  */
 #define DEFAULT_CORE_THREAD_SLEEP_DURATION_MS 100
 
+/**
+ * Default timeout for pending Acks
+ */
+#ifndef DEFAULT_PENDING_ACK_TIMEOUT_MS
+#define DEFAULT_PENDING_ACK_TIMEOUT_MS 30000
+#endif
+
 /**
  * Max size of the queue
  */
 #define DEFAULT_MAX_QUEUE_SIZE 16
 
+/**
+ * Upper limit for the configurable max size of the queue. Queue storage is allocated once with this capacity
+ */
+#ifndef MAX_ACTION_QUEUE_CAPACITY
+#define MAX_ACTION_QUEUE_CAPACITY 256
+#endif
+
+/**
+ * Number of High priority actions that are performed for each Normal priority action when both are queued
+ */
+#ifndef HIGH_PRIORITY_ACTION_DRAIN_WEIGHT
+#define HIGH_PRIORITY_ACTION_DRAIN_WEIGHT 4
+#endif
+
+/**
+ * Number of outbound action queue priority lanes, one for each ActionPriority
+ */
+#define ACTION_PRIORITY_LANE_COUNT 3
+
+/**
+ * Default max rate at which queued actions are processed. 0 disables rate limiting
+ */
+#ifndef DEFAULT_ACTION_PROCESSING_RATE_HZ
+#define DEFAULT_ACTION_PROCESSING_RATE_HZ 0
+#endif
+
+/**
+ * Default max number of bytes coalesced into a single network write by the outbound thread. 0 disables coalescing
+ */
+#ifndef DEFAULT_WRITE_COALESCING_MAX_BYTES
+#define DEFAULT_WRITE_COALESCING_MAX_BYTES 0
+#endif
+
+/**
+ * Default max time coalesced writes are held back while more queued actions are processed
+ */
+#ifndef DEFAULT_WRITE_COALESCING_MAX_DELAY_US
+#define DEFAULT_WRITE_COALESCING_MAX_DELAY_US 200
+#endif
+
 namespace awsiotsdk {
+	/**
+	 * @brief ActionQueueOverflowPolicy Enum Class
+	 *
+	 * Defines what happens when an Action is enqueued while the outbound queue is full.
+	 * Control priority actions are never dropped to make room for another action and never block the caller
+	 */
+	enum class ActionQueueOverflowPolicy {
+		REJECT = 0,								///< New action is rejected with ACTION_QUEUE_FULL
+		DROP_OLDEST = 1,						///< Oldest action in the same priority lane is dropped, falling back to Normal and then High priority lanes
+		DROP_OLDEST_NORMAL_PRIORITY_FIRST = 2,	///< Oldest Normal priority action (eg. QoS0 Publish) is dropped, falling back to the High priority lane
+		BLOCK_WITH_TIMEOUT = 3					///< Caller is blocked until there is space in the queue or the timeout expires. Control actions are queued past the max queue size, up to MAX_ACTION_QUEUE_CAPACITY, instead
+	};
 
 	/**
 	 * @brief Client Core State Class
@@ -57,51 +123,227 @@ namespace awsiotsdk {
 	 *
 	 */
 	class ClientCoreState : public ActionState {
-	protected:
+	public:
+		/**
+		 * Define a type for the Action drop handler
+		 * Called with the Action that was rejected or dropped and ACTION_QUEUE_FULL or ACTION_DROPPED respectively
+		 */
+		typedef std::function<void(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+								   ResponseCode rc)> ActionDropHandlerPtr;
 
 		/**
-		 * @brief Pending Ack Data Class
-		 *
-		 * Defining an internal class for storing information about Pending Acks.
-		 *
+		 * Define a type for the Outbound action notify handler
+		 * Called when an action is enqueued or processing of queued actions is enabled
 		 */
-		class PendingAckData {
-		public:
-			std::chrono::system_clock::time_point time_of_request_;            ///< Time at which the request was sent
-			ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler_;    ///< Handler to which response must be sent
-		};
+		typedef std::function<void()> OutboundActionNotifyHandlerPtr;
 
+	protected:
 		std::atomic<uint16_t> next_action_id_;                    ///< Atomic, ID of the next Action that will be enqueued
 		std::atomic_int cur_core_threads_;                        ///< Atomic, Count of currently running core threads
 		std::atomic_int max_hardware_threads_;                    ///< Atomic, Count of the maximum allowed hardware threads
 		std::atomic_size_t max_queue_size_;                        ///< Atomic, Current configured max queue size
-		std::chrono::seconds ack_timeout_;                        ///< Timeout for pending Acks, older Acks are deleted with a failed response
+		std::atomic<uint32_t> action_processing_rate_hz_;        ///< Atomic, Max rate at which queued actions are processed, 0 if unlimited
+		std::chrono::milliseconds ack_timeout_;                    ///< Timeout for pending Acks, older Acks are deleted with a failed response. Protected by ack_map_lock_
 
 		std::mutex register_action_lock_;                    ///< Mutex for Register Action Request flow
 		std::mutex ack_map_lock_;                    ///< Mutex for Ack Map operations
 
-		// Used to perform blocking sync actions
-		std::mutex sync_action_request_lock_;                    ///< Mutex for Sync Action Request flow
-		std::mutex sync_action_response_lock_;                    ///< Mutex for Sync Action Response flow
-		std::condition_variable sync_action_response_wait_;        ///< Condition variable used to wake up calling thread on Sync Action response
-		ResponseCode sync_action_response_;                        ///< Variable to store received Sync Action response
+		// Only held while an Action writes its request, never while waiting for a response
+		std::mutex perform_action_lock_;                        ///< Mutex serializing PerformAction calls on registered Actions
 
 		std::atomic_bool process_queued_actions_;                ///< Atomic, indicates whether currently queued Actions should be processed or not
 		std::shared_ptr<std::atomic_bool> continue_execution_;    ///< Atomic, Used to synchronize running threads, false value causes running threads to stop
 
 		util::Map<ActionType, std::unique_ptr<Action>> action_map_;                    ///< Map containing currently initialized Action Instances
-		util::Map<uint16_t, std::unique_ptr<PendingAckData>> pending_ack_map_;        ///< Map containing currently pending Acks
+		PendingAckTracker pending_ack_tracker_;                    ///< Currently pending Acks. Protected by ack_map_lock_
 		util::Map<ActionType, Action::CreateHandlerPtr> action_create_handler_map_;    ///< Map containing currently registered Action Types and corrosponding Factories
 
-		util::Queue<std::pair<ActionType, std::shared_ptr<ActionData>>> outbound_action_queue_;    ///< Queue of outbound actions
+		// Used to put the outbound thread to sleep while the queue is empty, enqueue itself does not lock
+		std::mutex outbound_action_queue_lock_;                    ///< Mutex used by the outbound thread to wait for queued actions
+		std::condition_variable outbound_action_queue_wait_;    ///< Condition variable used to wake up the outbound thread when actions are queued
+		std::atomic_bool is_outbound_thread_waiting_;            ///< Atomic, indicates whether the outbound thread is waiting for queued actions
+		std::atomic_size_t outbound_action_queue_length_;        ///< Atomic, Count of actions currently reserved in the outbound queue
+
+		typedef util::Threading::LockFreeQueue<std::pair<ActionType, std::shared_ptr<ActionData>>> OutboundActionQueue;
+		std::unique_ptr<OutboundActionQueue> p_outbound_action_queues_[ACTION_PRIORITY_LANE_COUNT];    ///< Queues of outbound actions, indexed by ActionPriority
+		uint32_t high_priority_drain_count_;    ///< High priority actions performed since the last Normal priority action. Only used by the outbound thread
+
+		std::mutex action_rate_limit_lock_;                    ///< Mutex for Action rate limit operations
+		util::Map<ActionType, std::unique_ptr<util::Threading::TokenBucket>> action_rate_limit_map_;    ///< Map containing rate limits for Action Types that have one configured
+		util::Map<ActionType, util::Queue<std::shared_ptr<ActionData>>> deferred_action_map_;    ///< Queued actions waiting for rate limit budget. Only used by the outbound thread
+
+		std::atomic<ActionQueueOverflowPolicy> overflow_policy_;    ///< Atomic, What to do when an action is enqueued while the queue is full
+		std::atomic<uint32_t> overflow_block_timeout_ms_;        ///< Atomic, Max time a producer is blocked with the BLOCK_WITH_TIMEOUT policy
+		std::atomic_size_t dropped_action_count_;                ///< Atomic, Count of actions that were rejected or dropped because the queue was full
+		std::mutex action_drop_handler_lock_;                    ///< Mutex for Action drop handler operations
+		ActionDropHandlerPtr p_action_drop_handler_;            ///< Handler called for each rejected or dropped action, can be nullptr
+
+		// Used to block producers with the BLOCK_WITH_TIMEOUT policy until the outbound thread frees up space
+		std::mutex outbound_action_queue_space_lock_;            ///< Mutex used by producers to wait for space in the queue
+		std::condition_variable outbound_action_queue_space_wait_;    ///< Condition variable used to wake up producers when space is freed up
+		std::mutex expired_ack_lock_;                            ///< Mutex for expired Ack processing
+		util::Vector<PendingAckTracker::ExpiredAck> expired_ack_list_;    ///< Reused list of expired Acks. Protected by expired_ack_lock_
+		std::chrono::steady_clock::time_point next_ack_expiry_check_time_;    ///< Time of the next expired Ack check. Only used by the outbound thread
+
+		std::atomic_int blocked_producer_count_;                ///< Atomic, Count of producers currently waiting for space in the queue
+
+		std::atomic_size_t write_coalescing_max_bytes_;            ///< Atomic, Max bytes coalesced into a single write, 0 if coalescing is disabled
+		std::atomic<uint32_t> write_coalescing_max_delay_us_;    ///< Atomic, Max time coalesced writes are held back
+		std::shared_ptr<CoalescingNetworkConnection> p_coalescing_network_connection_;    ///< Collects writes of coalesced actions. Only used by the outbound thread
+		util::Vector<uint16_t> coalesced_action_ids_;            ///< IDs of actions with unflushed writes. Only used by the outbound thread
+		util::Vector<uint16_t> coalesced_written_ack_ids_;    ///< IDs of actions completed by the flush of their writes. Only used by the outbound thread
+		std::chrono::steady_clock::time_point coalesced_write_deadline_;    ///< Time by which coalesced writes must be flushed. Only used by the outbound thread
+		std::chrono::steady_clock::time_point next_rate_limited_action_time_;    ///< Earliest time of the next action when a processing rate is set. Only used by the outbound thread
+
+		OutboundActionNotifyHandlerPtr p_outbound_action_notify_handler_;    ///< Handler called when the outbound queue needs processing, can be nullptr
+
+		/**
+		 * @brief Wake up the outbound thread if it is waiting for queued actions
+		 */
+		void NotifyOutboundThread();
+
+		/**
+		 * @brief Reserve a slot in the outbound queue, applying the configured overflow policy if it is full
+		 *
+		 * Control actions are never blocked, with the BLOCK_WITH_TIMEOUT policy they take a slot past the max queue
+		 * size instead. They are rejected once MAX_ACTION_QUEUE_CAPACITY slots are reserved in total
+		 *
+		 * @param action_priority - Priority lane the action will be enqueued in
+		 * @return ResponseCode indicating result of the API call
+		 */
+		ResponseCode ReserveOutboundQueueSlot(ActionPriority action_priority);
+
+		/**
+		 * @brief Drop the oldest queued action that the overflow policy allows to be dropped
+		 *
+		 * The slot of the dropped action is handed over to the caller instead of being released
+		 *
+		 * @param overflow_policy - Current overflow policy, must be one of the drop policies
+		 * @param action_priority - Priority lane the new action will be enqueued in
+		 * @return true if an action was dropped
+		 */
+		bool DropOldestQueuedAction(ActionQueueOverflowPolicy overflow_policy, ActionPriority action_priority);
+
+		/**
+		 * @brief Count a rejected or dropped action and notify the Action drop handler
+		 *
+		 * @param action_type - Type of the Action
+		 * @param p_action_data - Data of the Action
+		 * @param rc - ACTION_QUEUE_FULL for rejected actions, ACTION_DROPPED for dropped actions
+		 */
+		void NotifyActionDropped(ActionType action_type, std::shared_ptr<ActionData> p_action_data, ResponseCode rc);
+
+		/**
+		 * @brief Release a slot in the outbound queue and wake up a producer if one is blocked
+		 */
+		void ReleaseOutboundQueueSlot();
+
+		/**
+		 * @brief Check whether any priority lane of the outbound queue has an action ready
+		 * @return true if all lanes are empty
+		 */
+		bool IsOutboundActionQueueEmpty() const;
+
+		/**
+		 * @brief Dequeue the next application data action
+		 *
+		 * High priority actions are preferred, but after HIGH_PRIORITY_ACTION_DRAIN_WEIGHT of them in a row a
+		 * queued Normal priority action is dequeued so that it is not starved
+		 *
+		 * @param queued_action[out] - Dequeued action
+		 * @return true if an action was dequeued
+		 */
+		bool DequeueDataAction(std::pair<ActionType, std::shared_ptr<ActionData>> &queued_action);
+
+		/**
+		 * @brief Check whether a dequeued action can be performed now, defer it otherwise
+		 *
+		 * @param queued_action - Dequeued action, moved from if it can be performed or is deferred
+		 * @param now - Current time
+		 * @param next_wakeup_time[in, out] - Lowered to the time a deferred Action can be performed
+		 * @param action_type_out[out] - Type of the Action to perform
+		 * @param p_action_data_out[out] - Data of the Action to perform
+		 * @return true if the action can be performed now
+		 */
+		bool TakeOrDeferAction(std::pair<ActionType, std::shared_ptr<ActionData>> &queued_action,
+							   std::chrono::steady_clock::time_point now,
+							   std::chrono::steady_clock::time_point &next_wakeup_time,
+							   ActionType &action_type_out, std::shared_ptr<ActionData> &p_action_data_out);
+
+		/**
+		 * @brief Take tokens from the rate limits that apply to the given Action
+		 *
+		 * An Action takes one token from the limit of its own type. A Publish Batch also takes one token per packet
+		 * from the Publish limit, so that batching does not get around it. Tokens are only taken if all the limits
+		 * have enough available
+		 *
+		 * @param action_type - Type of the Action
+		 * @param p_action_data - Data of the Action
+		 * @param now - Current time
+		 * @param next_wakeup_time[in, out] - Lowered to the time the tokens will be available if they are not available now
+		 * @return true if the Action can be performed now. Always true for Action Types without a rate limit
+		 */
+		bool TryTakeActionToken(ActionType action_type, const std::shared_ptr<ActionData> &p_action_data,
+								std::chrono::steady_clock::time_point now,
+								std::chrono::steady_clock::time_point &next_wakeup_time);
+
+		/**
+		 * @brief Get the next queued action that is within its rate limit
+		 *
+		 * Control actions are taken first, followed by deferred actions and then application data actions.
+		 * Actions that are over their rate limit are moved to a deferred queue for their Action Type and are
+		 * performed in order once the budget allows, without blocking Actions of other types
+		 *
+		 * @param now - Current time
+		 * @param next_wakeup_time[in, out] - Lowered to the time a deferred Action can be performed
+		 * @param action_type_out[out] - Type of the Action to perform
+		 * @param p_action_data_out[out] - Data of the Action to perform
+		 * @return true if an Action is ready to be performed
+		 */
+		bool GetNextOutboundAction(std::chrono::steady_clock::time_point now,
+								   std::chrono::steady_clock::time_point &next_wakeup_time,
+								   ActionType &action_type_out, std::shared_ptr<ActionData> &p_action_data_out);
+
+		/**
+		 * @brief Perform a dequeued outbound action and notify its Ack handler on failure
+		 *
+		 * @param action_type - Type of the Action
+		 * @param p_action_data - Data to be passed to perform Action
+		 * @param p_network_connection - Connection the Action should write to
+		 */
+		void PerformOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+								   std::shared_ptr<NetworkConnection> p_network_connection);
+
+		/**
+		 * @brief Check whether writes of the given Action Type can be coalesced with other writes
+		 *
+		 * Only Actions that do nothing but write a single request qualify
+		 *
+		 * @param action_type - Type of the Action
+		 * @return true if the Action can write to a coalescing connection
+		 */
+		static bool IsCoalescableAction(ActionType action_type);
+
+		/**
+		 * @brief Perform a dequeued outbound action, coalescing its write with other queued actions if enabled
+		 *
+		 * @param action_type - Type of the Action
+		 * @param p_action_data - Data to be passed to perform Action
+		 * @param thread_continue - Sync point of the outbound thread
+		 */
+		void PerformOrCoalesceOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+											 const std::atomic_bool &thread_continue);
 
 		/**
-		 * @brief Internal Action Handler for Sync Action responses
+		 * @brief Write all coalesced data to the network
+		 *
+		 * Actions that complete once written are completed with the result of the write. If the write fails,
+		 * pending Acks of the other coalesced actions are completed with the failure. Holds perform_action_lock_
+		 * while writing, so must not be called with it held
 		 *
-		 * @param action_id - ID of the Action that response was received for
-		 * @param rc - Received response
+		 * @param thread_continue - Sync point of the outbound thread
 		 */
-		void SyncActionHandler(uint16_t action_id, ResponseCode rc);
+		void FlushCoalescedWrites(const std::atomic_bool &thread_continue);
 
 	public:
 		/**
@@ -110,16 +352,22 @@ namespace awsiotsdk {
 		 */
 		std::shared_ptr<NetworkConnection> p_network_connection_;
 
+		/**
+		 * @brief Memory resource of this instance of the Client, nullptr to use the process wide default
+		 * Set as the default resource of the threads performing actions of this client, see MemoryResource
+		 */
+		util::memory::MemoryResource *p_memory_resource_;
+
 		/**
 		 * @brief Overload for Get next Action ID
 		 * @return uint16_t Action ID
 		 */
 		virtual uint16_t GetNextActionId() {
-			if(UINT16_MAX == next_action_id_) {
-				next_action_id_ = 1;
-				return UINT16_MAX;
+			// Actions can be enqueued from multiple threads, wrap around without handing out 0
+			uint16_t action_id = next_action_id_;
+			while(!next_action_id_.compare_exchange_weak(action_id, (UINT16_MAX == action_id) ? 1 : action_id + 1)) {
 			}
-			return next_action_id_++;
+			return action_id;
 		};
 
 		/**
@@ -130,9 +378,99 @@ namespace awsiotsdk {
 
 		/**
 		 * @brief Set max size for action queue
+		 *
+		 * Values larger than MAX_ACTION_QUEUE_CAPACITY are limited to MAX_ACTION_QUEUE_CAPACITY
+		 *
 		 * @param size_t max_queue_size
 		 */
-		void SetMaxActionQueueSize(size_t max_queue_size) { max_queue_size_ = max_queue_size; }
+		void SetMaxActionQueueSize(size_t max_queue_size) {
+			max_queue_size_ = (MAX_ACTION_QUEUE_CAPACITY < max_queue_size) ? MAX_ACTION_QUEUE_CAPACITY : max_queue_size;
+		}
+
+		/**
+		 * @brief Get current max rate at which queued actions are processed
+		 * @return uint32_t Rate in actions per second, 0 if rate limiting is disabled
+		 */
+		uint32_t GetActionProcessingRate() { return action_processing_rate_hz_; }
+
+		/**
+		 * @brief Set max rate at which queued actions are processed
+		 *
+		 * The outbound thread processes queued actions as soon as they are enqueued. If a non-zero rate is set,
+		 * it waits after each action so that no more than the configured number of actions are performed per second
+		 *
+		 * @param action_processing_rate_hz - Rate in actions per second, 0 disables rate limiting
+		 */
+		void SetActionProcessingRate(uint32_t action_processing_rate_hz) { action_processing_rate_hz_ = action_processing_rate_hz; }
+
+		/**
+		 * @brief Set a token bucket rate limit for queued actions of the given type
+		 *
+		 * Up to burst_size actions of the type are performed back to back, after which they are limited to
+		 * rate_per_sec. Actions waiting for budget do not hold up queued actions of other types, so control
+		 * packets are not delayed by a publish limit. A Publish limit also charges each Publish Batch one action per
+		 * packet in the batch. Applies to queued actions only
+		 *
+		 * @param action_type - Type of the Action
+		 * @param rate_per_sec - Sustained rate in actions per second, 0 removes the rate limit
+		 * @param burst_size - Number of actions that can be performed back to back
+		 * @return ResponseCode indicating result of the API call
+		 */
+		ResponseCode SetActionRateLimit(ActionType action_type, uint32_t rate_per_sec, uint32_t burst_size);
+
+		/**
+		 * @brief Set what happens when an action is enqueued while the queue is full
+		 *
+		 * With the BLOCK_WITH_TIMEOUT policy the enqueuing thread waits for the outbound thread to free up space.
+		 * Should not be used if actions are enqueued from the outbound thread itself
+		 *
+		 * @param overflow_policy - Overflow policy
+		 * @param block_timeout - Max time to block the caller, only used by BLOCK_WITH_TIMEOUT
+		 */
+		void SetActionQueueOverflowPolicy(ActionQueueOverflowPolicy overflow_policy,
+										  std::chrono::milliseconds block_timeout);
+
+		/**
+		 * @brief Get current overflow policy
+		 * @return ActionQueueOverflowPolicy
+		 */
+		ActionQueueOverflowPolicy GetActionQueueOverflowPolicy() { return overflow_policy_; }
+
+		/**
+		 * @brief Get count of actions that were rejected or dropped because the queue was full
+		 * @return size_t Count of actions
+		 */
+		size_t GetDroppedActionCount() { return dropped_action_count_; }
+
+		/**
+		 * @brief Set handler to be called for each action that is rejected or dropped because the queue was full
+		 *
+		 * The handler is called from the thread enqueueing the new action and must not block. Dropped actions
+		 * also have their Ack handler, if any, called with ACTION_DROPPED
+		 *
+		 * @param p_action_drop_handler - Handler, nullptr to remove
+		 */
+		void SetActionDropHandler(ActionDropHandlerPtr p_action_drop_handler);
+
+		/**
+		 * @brief Configure coalescing of queued writes
+		 *
+		 * When enabled, the outbound thread keeps performing queued Publish, Puback, Subscribe and Unsubscribe
+		 * actions into a single buffer and writes it once the queue has no more actions ready, the byte budget is
+		 * reached or the delay since the first coalesced write expires. Small requests from many producers then
+		 * share network writes. Coalesced QoS0 publishes are completed once the coalesced data is written, with
+		 * the result of that write
+		 *
+		 * @param max_bytes - Byte budget for a single write, 0 disables coalescing
+		 * @param max_delay - Max time to hold back coalesced writes while more queued actions are processed
+		 */
+		void SetWriteCoalescing(size_t max_bytes, std::chrono::microseconds max_delay);
+
+		/**
+		 * @brief Get byte budget for coalesced writes
+		 * @return size_t Byte budget, 0 if coalescing is disabled
+		 */
+		size_t GetWriteCoalescingMaxBytes() { return write_coalescing_max_bytes_; }
 
 		/**
 		 * @brief Get pointer to sync point used for execution status of the Core instance
@@ -147,7 +485,7 @@ namespace awsiotsdk {
 		 * @brief Sets whether the Client is allowed to process queue actions
 		 * @param process_queued_actions value to set it to
 		 */
-		void SetProcessQueuedActions(bool process_queued_actions) { process_queued_actions_ = process_queued_actions; }
+		void SetProcessQueuedActions(bool process_queued_actions);
 
 		/**
 		 * @brief Get whether the Client can process queued actions
@@ -161,19 +499,46 @@ namespace awsiotsdk {
 		 * This function processes the actions queued up in the Outbound action queue.
 		 * The function accepts a Sync point that can be used to control execution in a separate thread.
 		 * If the value is set to false for the sync point, the function will perform one action from the queue.
-		 * This puts the running thread to sleep if there are no queued up actions.
+		 * The running thread waits on a condition variable while there are no queued up actions or processing
+		 * of queued actions is disabled, and is woken up as soon as an action is enqueued.
 		 * DO NOT call from main thread unless you have a separate thread to queue up actions
 		 *
 		 * @param thread_task_out_sync
 		 */
 		void ProcessOutboundActionQueue(std::shared_ptr<std::atomic_bool> thread_task_out_sync);
 
+		/**
+		 * @brief Perform the next ready action from the outbound queue without blocking
+		 *
+		 * Performs one iteration of the outbound processing done by ProcessOutboundActionQueue, including expired
+		 * Ack cleanup. Coalesced writes are flushed when no action is ready. Used by the outbound thread and by
+		 * Client Reactors, only one thread may call this at a time
+		 *
+		 * @param thread_continue - Sync point of the calling thread
+		 * @param [out] next_wakeup_time_out - Time by which this should be called again if nothing was performed
+		 * @return true if an action was performed, false if no action is ready
+		 */
+		bool ProcessNextOutboundAction(const std::atomic_bool &thread_continue,
+									   std::chrono::steady_clock::time_point &next_wakeup_time_out);
+
+		/**
+		 * @brief Set handler to be called when the outbound queue needs processing
+		 *
+		 * Used when outbound actions are not processed by the outbound thread. The handler is called from the
+		 * thread enqueueing the action and must not block. Must be set before any actions are enqueued
+		 *
+		 * @param p_outbound_action_notify_handler - Handler, nullptr to remove
+		 */
+		void SetOutboundActionNotifyHandler(OutboundActionNotifyHandlerPtr p_outbound_action_notify_handler) {
+			p_outbound_action_notify_handler_ = p_outbound_action_notify_handler;
+		}
+
 		/**
 		 * @brief Perform Action in Blocking Mode
 		 *
 		 * This API will perform the Action in Blocking mode. The timeout for the action to give a valid response
-		 * is provided as an argument. This API stops processing of all outbound actions until Response is received
-		 * for the requested Action Type
+		 * is provided as an argument. Each call waits for its own response, so multiple threads can have blocking
+		 * Actions in flight at the same time. Outbound actions are only held up while the request is being written
 		 *
 		 * @param action_type - Type of the Action to be executed. Must be registered
 		 * @param action_data - Action Data to be passed as argument to the Action instance
@@ -212,6 +577,10 @@ namespace awsiotsdk {
 		/**
 		 * @brief Enqueue Action for processing in Outbound Queue
 		 *
+		 * Safe to call from multiple threads at the same time. Enqueue does not take any locks, the outbound
+		 * thread is only signalled if it is currently waiting for actions. Publish actions are enqueued with
+		 * Normal priority, all other actions with Control priority
+		 *
 		 * @param action_type - Type of the Action
 		 * @param action_data - Data to be passed to perform Action
 		 * @param action_id_out[out] - Action ID that was assigned to this action by the Client
@@ -220,8 +589,26 @@ namespace awsiotsdk {
 		ResponseCode EnqueueOutboundAction(ActionType action_type, std::shared_ptr<ActionData> action_data,
 										   uint16_t &action_id_out);
 
+		/**
+		 * @brief Enqueue Action for processing in the given priority lane of the Outbound Queue
+		 *
+		 * All lanes share the configured max queue size
+		 *
+		 * @param action_type - Type of the Action
+		 * @param action_data - Data to be passed to perform Action
+		 * @param action_priority - Priority lane to enqueue the Action in
+		 * @param action_id_out[out] - Action ID that was assigned to this action by the Client
+		 * @return ResponseCode indicating result of the API call
+		 */
+		ResponseCode EnqueueOutboundAction(ActionType action_type, std::shared_ptr<ActionData> action_data,
+										   ActionPriority action_priority, uint16_t &action_id_out);
+
 		/**
 		 * @brief Register Ack Handler for provided action id
+		 *
+		 * The handler is called with MQTT_REQUEST_TIMEOUT_ERROR if no Ack is received within the Ack timeout.
+		 * Fails with ACTION_QUEUE_FULL if PENDING_ACK_TABLE_SIZE Acks are already pending
+		 *
 		 * @param action_id - Action ID
 		 * @param p_async_ack_handler - Handler to call on response
 		 * @return ResponseCode indicating result of the API call
@@ -237,18 +624,53 @@ namespace awsiotsdk {
 
 		/**
 		 * @brief Call registered Ack handler if it exists for specified Packet id
+		 *
+		 * The handler is called after the Ack has been removed from the pending Ack table, without holding any locks
+		 *
 		 * @param action_id - Action ID
 		 * @param rc - Response Code to pass to the Handler if found
 		 */
 		void ForwardReceivedAck(uint16_t action_id, ResponseCode rc);
 
+		/**
+		 * @brief Complete an Action that has no response once its request is written to the network
+		 *
+		 * Requests written to the coalescing connection of the outbound thread are only on the network once the
+		 * coalesced data is flushed, their Ack handler is called with the result of the flush. Otherwise the Ack
+		 * handler is called with SUCCESS right away
+		 *
+		 * @param action_id - Action ID
+		 * @param p_network_connection - Network connection the Action wrote its request to
+		 */
+		void ForwardWrittenAck(uint16_t action_id, const std::shared_ptr<NetworkConnection> &p_network_connection);
+
+		/**
+		 * @brief Check whether an Ack handler is registered for the specified Action ID
+		 * @param action_id - Action ID
+		 * @return true if an Ack is pending
+		 */
+		bool IsAckPending(uint16_t action_id);
+
 		/**
 		 * @brief Delete all expired Acks
 		 *
-		 * Deletes all Acks where the timeouts have expired. Responds with Code indicating request timeout
+		 * Deletes all Acks where the timeouts have expired. Responds with Code indicating request timeout.
+		 * Called periodically by the outbound thread
 		 */
 		void DeleteExpiredAcks();
 
+		/**
+		 * @brief Get timeout for pending Acks
+		 * @return std::chrono::milliseconds Timeout
+		 */
+		std::chrono::milliseconds GetAckTimeout();
+
+		/**
+		 * @brief Set timeout for pending Acks, applies to Acks registered after this call
+		 * @param ack_timeout - Timeout
+		 */
+		void SetAckTimeout(std::chrono::milliseconds ack_timeout);
+
 		/**
 		 * @brief Default Constructor
 		 */
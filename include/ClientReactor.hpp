@@ -0,0 +1,202 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ClientReactor.hpp
+ * @brief Contains the Client Reactor class
+ *
+ * Defines the Client Reactor class which drives many Client Core instances
+ * from a small, fixed number of event loop threads
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include "ClientCoreState.hpp"
+#include "util/threading/ThreadTask.hpp"
+
+#ifndef CLIENT_REACTOR_MAX_EVENTS
+#define CLIENT_REACTOR_MAX_EVENTS 256
+#endif
+
+#ifndef CLIENT_REACTOR_MAX_ACTIONS_PER_STEP
+#define CLIENT_REACTOR_MAX_ACTIONS_PER_STEP 64
+#endif
+
+namespace awsiotsdk {
+	/**
+	 * @brief Client Reactor Class
+	 *
+	 * Runs the outbound queue and Action runners of many Client Core instances on a fixed number of event loop
+	 * threads, instead of three threads per client. Clients are assigned to the event loops round robin. Each event
+	 * loop waits for socket readiness of all its clients using epoll and performs Action runners using
+	 * Action::PerformStep. Only available on Linux.
+	 *
+	 * Callbacks of reactor driven clients run on the event loop thread and must not block. They must not perform
+	 * blocking Actions, which includes destroying a client that is still connected. Callbacks may create clients
+	 * and destroy other clients of any Client Reactor, but not the client whose callback is running. Network
+	 * connections should be created with a short TLS read timeout, a read is only attempted when the socket is
+	 * readable but a partial TLS record can still block it.
+	 * The Client Reactor does not reconnect, the application is expected to reconnect from its own thread after
+	 * the disconnect callback is called.
+	 */
+	class ClientReactor {
+	protected:
+		/**
+		 * @brief State of a client registered with the Client Reactor
+		 */
+		struct ReactorClient {
+			uint32_t client_id_;														///< ID returned by AddClient
+			std::shared_ptr<ClientCoreState> p_client_core_state_;						///< Client Core state instance
+			util::Vector<std::unique_ptr<Action>> pending_action_runners_;			///< Added since the last iteration, guarded by the client map lock
+			util::Vector<std::unique_ptr<Action>> action_runners_;					///< Action runners performed in steps
+			util::Vector<std::chrono::steady_clock::time_point> runner_step_times_;	///< Next step time of each Action runner
+			std::chrono::steady_clock::time_point outbound_step_time_;				///< Next time the outbound queue is processed
+			std::atomic_bool is_outbound_pending_;									///< Atomic, Set when actions are enqueued
+			bool is_readable_;														///< Socket was reported readable in this iteration
+			int registered_fd_;														///< Socket descriptor registered with epoll, -1 if none
+			int wakeup_fd_;															///< Event descriptor of the event loop
+			std::atomic_bool is_removed_;												///< Atomic, Set by RemoveClient, the event loop only releases the client
+		};
+
+		/**
+		 * @brief Event loop thread and its clients
+		 */
+		struct EventLoop {
+			int epoll_fd_;																///< epoll instance of this event loop
+			int wakeup_fd_;															///< Event descriptor used to wake up the event loop
+			std::mutex client_map_lock_;												///< Guards the client map and removed clients, not held while clients are processed
+			std::mutex process_lock_;													///< Held while the event loop processes its clients
+			util::Map<uint32_t, std::shared_ptr<ReactorClient>> client_map_;			///< Clients driven by this event loop
+			util::Vector<std::shared_ptr<ReactorClient>> removed_clients_;			///< Removed from another event loop thread, released by this one
+			util::Vector<std::shared_ptr<ReactorClient>> active_clients_;				///< Clients of the current iteration, only used by the event loop thread
+			std::shared_ptr<std::atomic_bool> p_thread_continue_;					///< Sync point of the event loop thread
+			std::unique_ptr<util::Threading::ThreadTask> p_thread_task_;				///< Event loop thread
+		};
+
+		util::Vector<std::unique_ptr<EventLoop>> event_loops_;	///< Event loops, clients are assigned round robin
+		std::atomic<uint32_t> next_client_id_;					///< Atomic, ID of the next client that will be added
+
+		/**
+		 * @brief Constructor
+		 */
+		ClientReactor();
+
+		/**
+		 * @brief Get the event loop a client is assigned to
+		 *
+		 * @param client_id - ID returned by AddClient
+		 * @return EventLoop reference
+		 */
+		EventLoop &GetEventLoop(uint32_t client_id) { return *event_loops_[client_id % event_loops_.size()]; }
+
+		/**
+		 * @brief Run an event loop until its sync point is cleared
+		 *
+		 * @param p_event_loop - Event loop to run
+		 */
+		void RunEventLoop(EventLoop *p_event_loop);
+
+		/**
+		 * @brief Perform all work of one client that is due
+		 *
+		 * @param event_loop - Event loop the client is assigned to
+		 * @param client - Client to process
+		 * @param now - Start time of this event loop iteration
+		 * @param [out] next_wakeup_time - Lowered to the next time the client has work due
+		 */
+		void ProcessClient(EventLoop &event_loop, ReactorClient &client, std::chrono::steady_clock::time_point now,
+						   std::chrono::steady_clock::time_point &next_wakeup_time);
+
+		/**
+		 * @brief Register the current socket of a client with epoll if it changed
+		 *
+		 * @param event_loop - Event loop the client is assigned to
+		 * @param client - Client to register
+		 */
+		void UpdateSocketRegistration(EventLoop &event_loop, ReactorClient &client);
+
+		/**
+		 * @brief Deregister the socket of a removed client and destroy its Action runners
+		 *
+		 * Must be called with the process lock of the event loop held, or from the event loop thread
+		 *
+		 * @param event_loop - Event loop the client is assigned to
+		 * @param client - Removed client
+		 */
+		void ReleaseClient(EventLoop &event_loop, ReactorClient &client);
+
+	public:
+		// Rule of 5 stuff
+		// Disabling default, copy and move constructors
+		// Instances own event loop threads and should not be copied or moved
+		ClientReactor(const ClientReactor &) = delete;								// Delete Copy constructor
+		ClientReactor(ClientReactor &&) = delete;									// Delete Move constructor
+		ClientReactor &operator=(const ClientReactor &) & = delete;				// Delete Copy assignment operator
+		ClientReactor &operator=(ClientReactor &&) & = delete;						// Delete Move assignment operator
+		virtual ~ClientReactor();													// Stops all event loops
+
+		/**
+		 * @brief Factory method for creating a Client Reactor instance
+		 *
+		 * @param thread_count - Number of event loop threads, at least one
+		 * @return nullptr on error or if not supported on this platform, shared_ptr to the created instance otherwise
+		 */
+		static std::shared_ptr<ClientReactor> Create(size_t thread_count);
+
+		/**
+		 * @brief Add a client to be driven by this Client Reactor
+		 *
+		 * Outbound actions of the client are processed by its event loop. The network connection must already be
+		 * set in the client state
+		 *
+		 * @param p_client_core_state - Client Core state instance
+		 * @param [out] client_id_out - ID of the client, used for the other Client Reactor APIs
+		 * @return ResponseCode indicating result of the API call
+		 */
+		ResponseCode AddClient(std::shared_ptr<ClientCoreState> p_client_core_state, uint32_t &client_id_out);
+
+		/**
+		 * @brief Add an Action runner to a client, performed using Action::PerformStep
+		 *
+		 * @param client_id - ID returned by AddClient
+		 * @param p_action_runner - Action runner instance
+		 * @return ResponseCode indicating result of the API call
+		 */
+		ResponseCode AddActionRunner(uint32_t client_id, std::unique_ptr<Action> p_action_runner);
+
+		/**
+		 * @brief Remove a client and its Action runners
+		 *
+		 * Waits for the event loop to finish processing the client. When called from an event loop thread it does not
+		 * wait, the client is no longer processed once this returns but its state is only released by its event loop
+		 * after the current iteration. Must not be called from a callback of the client that is being removed
+		 *
+		 * @param client_id - ID returned by AddClient
+		 */
+		void RemoveClient(uint32_t client_id);
+
+		/**
+		 * @brief Get number of event loop threads
+		 * @return size_t Thread count
+		 */
+		size_t GetThreadCount() const { return event_loops_.size(); }
+	};
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file CoalescingNetworkConnection.hpp
+ * @brief Network connection wrapper that collects writes and sends them together
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "util/memory/stl/String.hpp"
+
+#include "NetworkConnection.hpp"
+
+namespace awsiotsdk {
+	/**
+	 * @brief Coalescing Network Connection Class
+	 *
+	 * Wraps a network connection. Writes are appended to an internal buffer and reported as complete, the buffer
+	 * is written to the wrapped connection in one write when flushed. Used by the outbound thread to let requests
+	 * that are queued back to back share a single write, similar to TCP_CORK. Reads, connect and disconnect are
+	 * passed through to the wrapped connection. Not thread safe beyond the locking done by NetworkConnection
+	 */
+	class CoalescingNetworkConnection : public NetworkConnection {
+	protected:
+		std::shared_ptr<NetworkConnection> p_network_connection_;	///< Wrapped connection
+		util::String coalesced_buf_;								///< Writes that have not been flushed yet
+
+		ResponseCode ConnectInternal();
+
+		ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out);
+
+		ResponseCode WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+									size_t &size_written_bytes_out);
+
+		ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+								  size_t size_bytes_to_read, size_t &size_read_bytes_out);
+
+		ResponseCode DisconnectInternal();
+
+		ResponseCode WaitForReadableInternal(std::chrono::milliseconds timeout);
+
+		ResponseCode WaitForWritableInternal(std::chrono::milliseconds timeout);
+
+	public:
+		/**
+		 * @brief Constructor
+		 *
+		 * @param p_network_connection - Connection to write coalesced data to
+		 */
+		explicit CoalescingNetworkConnection(std::shared_ptr<NetworkConnection> p_network_connection);
+
+		// Rule of 5 stuff
+		// Disable default constructor, copy and move. Wraps a connection that is shared with other threads
+		CoalescingNetworkConnection() = delete;															// Delete Default constructor
+		CoalescingNetworkConnection(const CoalescingNetworkConnection &) = delete;						// Delete Copy constructor
+		CoalescingNetworkConnection(CoalescingNetworkConnection &&) = delete;							// Delete Move constructor
+		CoalescingNetworkConnection &operator=(const CoalescingNetworkConnection &) & = delete;			// Delete Copy assignment operator
+		CoalescingNetworkConnection &operator=(CoalescingNetworkConnection &&) & = delete;				// Delete Move assignment operator
+		virtual ~CoalescingNetworkConnection() { }
+
+		bool IsConnected();
+
+		bool IsPhysicalLayerConnected();
+
+		int GetSocketDescriptor();
+
+		/**
+		 * @brief Get number of bytes waiting to be flushed
+		 * @return size_t Byte count
+		 */
+		size_t GetCoalescedLength() { return coalesced_buf_.length(); }
+
+		/**
+		 * @brief Write all coalesced data to the wrapped connection
+		 *
+		 * Retries partial writes until all data is written. The buffer is cleared even if the write fails
+		 *
+		 * @param thread_continue - Cleared when the calling thread should stop retrying
+		 * @return ResponseCode indicating status of the write
+		 */
+		ResponseCode Flush(const std::atomic_bool &thread_continue);
+	};
+}
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <mutex>
@@ -31,9 +32,18 @@
 #include "util/Core_EXPORTS.hpp"
 #include "util/memory/stl/String.hpp"
 #include "util/memory/stl/Vector.hpp"
+#include "util/StringView.hpp"
 
 #include "ResponseCode.hpp"
 
+/**
+ * Vectored writes of several segments up to this many bytes in total are joined and sent as one TLS record by the
+ * TLS implementations. Larger writes send each segment directly from the caller's buffer
+ */
+#ifndef NETWORK_WRITEV_COALESCE_MAX_BYTES
+#define NETWORK_WRITEV_COALESCE_MAX_BYTES 16384
+#endif
+
 namespace awsiotsdk {
 	/**
 	 * @brief Network Connection Class
@@ -50,6 +60,7 @@ namespace awsiotsdk {
 		 */
 		std::mutex read_mutex;        ///< Mutex for synchronizing read operations
 		std::mutex write_mutex;        ///< Mutex for synchronizing write operations
+		util::String write_segments_buf_;    ///< Used to join segments for vectored writes, only accessed with write_mutex held
 
 		/**
 		 * @brief Create a Network socket and open the connection
@@ -73,13 +84,41 @@ namespace awsiotsdk {
 		 */
 		virtual ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out) = 0;
 
+		/**
+		 * @brief Write a list of buffer segments to the network socket as one contiguous stream
+		 *
+		 * Internal implementation of the WriteV function. The default implementation joins the segments in
+		 * write_segments_buf_ and calls WriteInternal, the buffer keeps its capacity so this only allocates while it
+		 * grows. Implementations that can write from several buffers should override it
+		 *
+		 * @param const util::StringView * - segments to write, in order
+		 * @param size_t - number of segments
+		 * @param size_t - reference to store number of bytes written, counted across all segments
+		 * @return ResponseCode - successful write or Network error code
+		 */
+		virtual ResponseCode WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+											size_t &size_written_bytes_out);
+
+		/**
+		 * @brief Join segments into write_segments_buf_, write_mutex must be held
+		 *
+		 * @param const util::StringView * - segments to join, in order
+		 * @param size_t - number of segments
+		 * @return const util::String & - joined segments, valid until the next call
+		 */
+		const util::String &JoinSegments(const util::StringView *p_segments, size_t segment_count);
+
 		/**
 		 * @brief Read bytes from the network socket
 		 *
-		 * Internal implementation of the Read function to be provided by the derived class
+		 * Internal implementation of the Read function to be provided by the derived class. Should return as soon as
+		 * any data is available instead of waiting for size_bytes_to_read bytes, callers that need an exact number
+		 * of bytes retry with the remaining count. NETWORK_SSL_NOTHING_TO_READ is returned only if no data arrived
+		 * within the read timeout
 		 *
-		 * @param util::String - reference to buffer where read bytes should be copied
-		 * @param size_t - number of bytes to read
+		 * @param util::String - reference to buffer where read bytes should be copied, starting at buf_read_offset.
+		 * Must already be large enough to hold size_bytes_to_read bytes after the offset
+		 * @param size_t - max number of bytes to read
 		 * @param size_t - reference to store number of bytes read
 		 * @return ResponseCode - successful read or Network error code
 		 */
@@ -95,6 +134,30 @@ namespace awsiotsdk {
 		 */
 		virtual ResponseCode DisconnectInternal() = 0;
 
+		/**
+		 * @brief Wait until data can be read from the network socket
+		 *
+		 * Internal implementation of the WaitForReadable function. Should wait on the underlying socket, for example
+		 * using poll, and return early if data is already buffered by the TLS layer. The default implementation
+		 * sleeps for the full timeout so that existing ports keep their behavior
+		 *
+		 * @param std::chrono::milliseconds - max time to wait
+		 * @return ResponseCode - SUCCESS if data may be available, NETWORK_SSL_NOTHING_TO_READ on timeout
+		 * or Network error code
+		 */
+		virtual ResponseCode WaitForReadableInternal(std::chrono::milliseconds timeout);
+
+		/**
+		 * @brief Wait until data can be written to the network socket
+		 *
+		 * Internal implementation of the WaitForWritable function, see WaitForReadableInternal
+		 *
+		 * @param std::chrono::milliseconds - max time to wait
+		 * @return ResponseCode - SUCCESS if data may be written, NETWORK_SSL_WRITE_TIMEOUT_ERROR on timeout
+		 * or Network error code
+		 */
+		virtual ResponseCode WaitForWritableInternal(std::chrono::milliseconds timeout);
+
 	public:
 		/**
 		 * @brief Check if Network layer is still connected
@@ -134,13 +197,37 @@ namespace awsiotsdk {
 		 */
 		virtual ResponseCode Write(const util::String &buf, size_t &size_written_bytes_out) final;
 
+		/**
+		 * @brief Write a list of buffer segments to the network socket
+		 *
+		 * Calls the internal vectored write function after obtaining write lock. The segments are sent as one
+		 * contiguous stream, for example a packet header followed by a payload owned by the application, without
+		 * joining them first. May write fewer bytes than requested, callers resume from the returned byte count
+		 *
+		 * @param const util::StringView * - segments to write, in order
+		 * @param size_t - number of segments
+		 * @param size_t - reference to store number of bytes written, counted across all segments
+		 * @return ResponseCode - successful write or Network error code
+		 */
+		virtual ResponseCode WriteV(const util::StringView *p_segments, size_t segment_count,
+									size_t &size_written_bytes_out) final;
+
+		/**
+		 * @brief Get the total length of a list of buffer segments
+		 *
+		 * @param const util::StringView * - segments
+		 * @param size_t - number of segments
+		 * @return size_t - sum of the segment lengths
+		 */
+		static size_t GetSegmentsLength(const util::StringView *p_segments, size_t segment_count);
+
 		/**
 		 * @brief Read bytes from the network socket
 		 *
-		 * Calls the internal read function after obtaining read lock
+		 * Calls the internal read function after obtaining read lock. May read fewer bytes than requested
 		 *
 		 * @param util::String - reference to buffer where read bytes should be copied
-		 * @param size_t - number of bytes to read
+		 * @param size_t - max number of bytes to read
 		 * @param size_t - reference to store number of bytes read
 		 * @return ResponseCode - successful read or Network error code
 		 */
@@ -159,6 +246,38 @@ namespace awsiotsdk {
 		 */
 		virtual ResponseCode Disconnect() final;
 
+		/**
+		 * @brief Wait until data can be read from the network socket
+		 *
+		 * Calls the internal wait function after obtaining read lock. Used instead of sleeping when a read
+		 * returns no data, returns as soon as data arrives
+		 *
+		 * @param std::chrono::milliseconds - max time to wait
+		 * @return ResponseCode - SUCCESS if data may be available, NETWORK_SSL_NOTHING_TO_READ on timeout
+		 * or Network error code
+		 */
+		virtual ResponseCode WaitForReadable(std::chrono::milliseconds timeout) final;
+
+		/**
+		 * @brief Wait until data can be written to the network socket
+		 *
+		 * Calls the internal wait function after obtaining write lock. Used instead of sleeping after a partial write
+		 *
+		 * @param std::chrono::milliseconds - max time to wait
+		 * @return ResponseCode - SUCCESS if data may be written, NETWORK_SSL_WRITE_TIMEOUT_ERROR on timeout
+		 * or Network error code
+		 */
+		virtual ResponseCode WaitForWritable(std::chrono::milliseconds timeout) final;
+
+		/**
+		 * @brief Get the OS socket descriptor used by this connection
+		 *
+		 * Used to register the connection with a readiness based event loop. Only valid while connected
+		 *
+		 * @return int - Socket descriptor, -1 if the implementation does not expose one
+		 */
+		virtual int GetSocketDescriptor() { return -1; }
+
 		virtual ~NetworkConnection() {}
 	};
 }
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PendingAckTracker.hpp
+ * @brief Table of pending Acks with timer based expiry
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "Action.hpp"
+#include "ResponseCode.hpp"
+
+/**
+ * Number of slots in the pending Ack table, must be a power of two. This limits the number of Acks that can be pending
+ * at the same time, any Action IDs can share the table
+ */
+#ifndef PENDING_ACK_TABLE_SIZE
+#define PENDING_ACK_TABLE_SIZE 1024
+#endif
+
+/**
+ * Resolution of pending Ack expiry
+ */
+#ifndef PENDING_ACK_TIMER_TICK_MS
+#define PENDING_ACK_TIMER_TICK_MS 10
+#endif
+
+namespace awsiotsdk {
+	/**
+	 * @brief Pending Ack Tracker Class
+	 *
+	 * Keeps track of the Ack handlers of requests that are waiting for a response. Handlers are stored in a fixed size
+	 * table of slots taken from a free list. Slots are found through chains indexed by the low bits of the Action ID,
+	 * which are one slot long while Action IDs are handed out in sequence, and are linked into a two level timing wheel
+	 * for expiry, so registering, completing and expiring an Ack are constant time and do not allocate memory. The first level has one bucket per tick, the second
+	 * level has one bucket per full rotation of the first level. Acks that expire further out than the second level
+	 * covers are parked in its last bucket and rescheduled when it is reached.
+	 * Not thread safe, callers must synchronize access. Handlers are moved out of the tracker and are never called by it,
+	 * so that callers can run them after releasing their locks. While a handler is being dispatched the Ack is still
+	 * reported as pending, so that a thread waiting for the response can tell it is about to arrive
+	 */
+	class AWS_API_EXPORT PendingAckTracker {
+	public:
+		typedef std::pair<uint16_t, ActionData::AsyncAckNotificationHandlerPtr> ExpiredAck;
+
+	protected:
+		static const size_t WHEEL_LEVEL_0_BITS = 8;
+		static const size_t WHEEL_LEVEL_0_SIZE = 1 << WHEEL_LEVEL_0_BITS;
+		static const size_t WHEEL_LEVEL_1_SIZE = 64;
+		static const int32_t INVALID_INDEX = -1;
+
+		/**
+		 * @brief Table slot holding one pending Ack
+		 */
+		struct Slot {
+			ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler_;	///< Handler to which response must be sent
+			uint64_t expiry_tick_;		///< Tick at which the Ack expires
+			int32_t bucket_;			///< Timing wheel bucket the slot is linked into
+			int32_t prev_;				///< Previous slot in the bucket
+			int32_t next_;				///< Next slot in the bucket
+			int32_t chain_next_;		///< Next slot in the Action ID chain, or in the free list if not in use
+			uint16_t action_id_;		///< Action ID of the pending request
+			bool is_in_use_;			///< Whether the slot holds a pending Ack
+			bool is_dispatching_;		///< Whether the handler has been taken out for dispatch
+		};
+
+		util::Vector<Slot> slots_;				///< Pending Ack table
+		util::Vector<int32_t> bucket_heads_;	///< First slot of each timing wheel bucket, level 0 followed by level 1
+		util::Vector<int32_t> chain_heads_;		///< First slot of each Action ID chain
+		int32_t free_head_;						///< First unused slot
+		size_t mask_;							///< Table size - 1, used to map Action IDs to chains
+		size_t pending_ack_count_;				///< Number of pending Acks
+		std::chrono::milliseconds tick_duration_;	///< Duration of one timing wheel tick
+		uint64_t current_tick_;					///< Last tick that has been processed
+
+		uint64_t GetTick(std::chrono::steady_clock::time_point time_point);
+		int32_t FindSlot(uint16_t action_id);
+		void LinkSlot(int32_t slot_index);
+		void UnlinkSlot(int32_t slot_index);
+		void ReleaseSlot(int32_t slot_index);
+
+	public:
+		/**
+		 * @brief Constructor
+		 *
+		 * @param table_size - Number of slots in the table, rounded up to a power of two
+		 * @param tick_duration - Resolution of Ack expiry
+		 */
+		PendingAckTracker(size_t table_size, std::chrono::milliseconds tick_duration);
+
+		// Rule of 5 stuff
+		// Disable copying and moving, the table is owned by one Client Core State
+		PendingAckTracker() = delete;												// Delete Default constructor
+		PendingAckTracker(const PendingAckTracker &) = delete;						// Delete Copy constructor
+		PendingAckTracker(PendingAckTracker &&) = delete;							// Delete Move constructor
+		PendingAckTracker &operator=(const PendingAckTracker &) & = delete;			// Delete Copy assignment operator
+		PendingAckTracker &operator=(PendingAckTracker &&) & = delete;				// Delete Move assignment operator
+		~PendingAckTracker() { }
+
+		/**
+		 * @brief Register a handler to be called when an Ack is received for the given Action ID
+		 *
+		 * Registering again for an Action ID that is already pending replaces the handler and the expiry time
+		 *
+		 * @param action_id - Action ID of the request
+		 * @param p_async_ack_handler - Handler, moved into the table
+		 * @param expiry_time - Time after which the Ack is considered timed out
+		 * @return ResponseCode indicating result of the API call. ACTION_QUEUE_FULL if all slots are in use or the
+		 * Ack for this Action ID is being dispatched
+		 */
+		ResponseCode Register(uint16_t action_id, ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+							  std::chrono::steady_clock::time_point expiry_time);
+
+		/**
+		 * @brief Remove the pending Ack for the given Action ID without dispatching it
+		 *
+		 * @param action_id - Action ID of the request
+		 * @param p_async_ack_handler_out[out] - Handler that was registered for the Action ID
+		 * @return true if an Ack was pending for the Action ID and was not being dispatched
+		 */
+		bool Remove(uint16_t action_id, ActionData::AsyncAckNotificationHandlerPtr &p_async_ack_handler_out);
+
+		/**
+		 * @brief Take the handler of the pending Ack for the given Action ID out for dispatch
+		 *
+		 * The slot stays reserved until EndDispatch is called
+		 *
+		 * @param action_id - Action ID of the request
+		 * @param p_async_ack_handler_out[out] - Handler that was registered for the Action ID
+		 * @return true if an Ack was pending for the Action ID and was not already being dispatched
+		 */
+		bool BeginDispatch(uint16_t action_id, ActionData::AsyncAckNotificationHandlerPtr &p_async_ack_handler_out);
+
+		/**
+		 * @brief Release the slot of an Ack after its handler has been called
+		 *
+		 * @param action_id - Action ID of the request
+		 */
+		void EndDispatch(uint16_t action_id);
+
+		/**
+		 * @brief Check whether an Ack is pending for the given Action ID
+		 *
+		 * @param action_id - Action ID of the request
+		 * @return true if an Ack is pending
+		 */
+		bool IsPending(uint16_t action_id);
+
+		/**
+		 * @brief Get number of pending Acks
+		 * @return size_t Count of pending Acks
+		 */
+		size_t GetPendingAckCount() { return pending_ack_count_; }
+
+		/**
+		 * @brief Advance the timing wheel and take the handlers of all expired Acks out for dispatch
+		 *
+		 * EndDispatch must be called for each expired Ack once its handler has been called
+		 *
+		 * @param now - Current time
+		 * @param expired_acks_out[out] - Expired Acks are appended to this list
+		 */
+		void BeginDispatchExpired(std::chrono::steady_clock::time_point now, util::Vector<ExpiredAck> &expired_acks_out);
+	};
+}
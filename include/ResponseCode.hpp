@@ -104,12 +104,15 @@ namespace awsiotsdk {
 		NETWORK_ALREADY_CONNECTED_ERROR = -502,        ///< Returned when the Network is already connected and a connection attempt is made.
 		NETWORK_PHYSICAL_LAYER_DISCONNECTED = -503,    ///< Returned when the physical layer is disconnected.
 		NETWORK_NOTHING_TO_WRITE_ERROR = -504,			///< Returned when the Network write function is passed an empty buffer as argument
+		NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR = -505,	///< Returned when the requested network transport backend is not available on this platform
 
 		// ClientCore Error Codes
 
 		ACTION_NOT_REGISTERED_ERROR = -601,            ///< Requested action is not registered with the core client
 		ACTION_QUEUE_FULL = -602,                    ///< Core Client Action queue is full
 		ACTION_CREATE_FAILED = -603,				///< Core Client was not able to create the requested action
+		ACTION_DROPPED = -604,						///< Queued action was dropped by the Core Client to make room for a newer action
+		ACTION_STEP_NOT_SUPPORTED_ERROR = -605,		///< Action can not be driven in steps by a Client Reactor
 
 		// MQTT Error Codes
 
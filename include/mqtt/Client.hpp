@@ -27,6 +27,7 @@
 #include "util/Utf8String.hpp"
 
 #include "ClientCore.hpp"
+#include "ActionFuture.hpp"
 
 #include "mqtt/Connect.hpp"
 #include "mqtt/Publish.hpp"
@@ -47,6 +48,7 @@ namespace awsiotsdk {
 	protected:
 		std::unique_ptr<ClientCore> p_client_core_;				///< Unique pointer to the Client Core instance
 		std::shared_ptr<mqtt::ClientState> p_client_state_;		///< MQTT Client state
+		util::memory::MemoryResource *p_memory_resource_;		///< Memory resource of this client, nullptr for the process default
 
 		/**
 		 * @brief Constructor
@@ -57,6 +59,28 @@ namespace awsiotsdk {
 		 */
 		MqttClient(std::shared_ptr<NetworkConnection> p_network_connection,
 				   std::chrono::milliseconds mqtt_command_timeout);
+
+		/**
+		 * @brief Constructor
+		 *
+		 * @param p_network_connection - Network connection to use with this MQTT Client instance
+		 * @param mqtt_command_timeout - Command timeout in milliseconds for internal blocking operations (Reconnect and Resubscribe)
+		 * @param p_client_reactor - Client Reactor to drive this instance, nullptr to use dedicated threads
+		 */
+		MqttClient(std::shared_ptr<NetworkConnection> p_network_connection,
+				   std::chrono::milliseconds mqtt_command_timeout, std::shared_ptr<ClientReactor> p_client_reactor);
+
+		/**
+		 * @brief Constructor
+		 *
+		 * @param p_network_connection - Network connection to use with this MQTT Client instance
+		 * @param mqtt_command_timeout - Command timeout in milliseconds for internal blocking operations (Reconnect and Resubscribe)
+		 * @param p_client_reactor - Client Reactor to drive this instance, nullptr to use dedicated threads
+		 * @param p_memory_resource - Memory resource for the containers of this instance, nullptr for the process default
+		 */
+		MqttClient(std::shared_ptr<NetworkConnection> p_network_connection,
+				   std::chrono::milliseconds mqtt_command_timeout, std::shared_ptr<ClientReactor> p_client_reactor,
+				   util::memory::MemoryResource *p_memory_resource);
 	public:
 
 		// Disabling default and copy constructors. Defining a virtual destructor
@@ -80,6 +104,61 @@ namespace awsiotsdk {
 		static std::unique_ptr<MqttClient> Create(std::shared_ptr<NetworkConnection> p_network_connection,
 												  std::chrono::milliseconds mqtt_command_timeout);
 
+		/**
+		 * @brief Create factory method for a client driven by a Client Reactor
+		 *
+		 * Network reads, keep alive and queued actions are performed by the event loop thread of the Client Reactor,
+		 * so many clients can share a few threads. Callbacks must not block and the client does not reconnect on
+		 * its own. Callbacks may create clients on the same Client Reactor, and destroy other clients once they are
+		 * disconnected, see ClientReactor for details
+		 *
+		 * @param p_network_connection - Network connection to use with this MQTT Client instance
+		 * @param mqtt_command_timeout - Command timeout in milliseconds for internal blocking operations
+		 * @param p_client_reactor - Client Reactor to drive this instance
+		 *
+		 * @return nullptr on error, std::unique_ptr<MqttClient> pointing to a unique MQTT client instance otherwise
+		 */
+		static std::unique_ptr<MqttClient> Create(std::shared_ptr<NetworkConnection> p_network_connection,
+												  std::chrono::milliseconds mqtt_command_timeout,
+												  std::shared_ptr<ClientReactor> p_client_reactor);
+
+		/**
+		 * @brief Create factory method for a client with its own memory resource
+		 *
+		 * The resource is the default resource of the client threads, and of the calling thread while client
+		 * methods create packets, so containers of this client are allocated from it when the SDK is built with
+		 * ResourceAllocator. Clients given separate resources do not share memory. Packets and network connections
+		 * created by the application use the default resource of the thread creating them, see ThreadResourceScope.
+		 * The resource must outlive the client and every packet created by it
+		 *
+		 * @param p_network_connection - Network connection to use with this MQTT Client instance
+		 * @param mqtt_command_timeout - Command timeout in milliseconds for internal blocking operations (Reconnect and Resubscribe)
+		 * @param p_memory_resource - Memory resource for this client, nullptr for the process default
+		 *
+		 * @return nullptr on error, std::unique_ptr<MqttClient> pointing to a unique MQTT client instance otherwise
+		 */
+		static std::unique_ptr<MqttClient> Create(std::shared_ptr<NetworkConnection> p_network_connection,
+												  std::chrono::milliseconds mqtt_command_timeout,
+												  util::memory::MemoryResource *p_memory_resource);
+
+		/**
+		 * @brief Create factory method for a client driven by a Client Reactor with its own memory resource
+		 *
+		 * Same as the Client Reactor overload, the event loop thread allocates from the resource while it processes
+		 * this client. See the memory resource overload for details on which allocations use the resource
+		 *
+		 * @param p_network_connection - Network connection to use with this MQTT Client instance
+		 * @param mqtt_command_timeout - Command timeout in milliseconds for internal blocking operations
+		 * @param p_client_reactor - Client Reactor to drive this instance
+		 * @param p_memory_resource - Memory resource for this client, nullptr for the process default
+		 *
+		 * @return nullptr on error, std::unique_ptr<MqttClient> pointing to a unique MQTT client instance otherwise
+		 */
+		static std::unique_ptr<MqttClient> Create(std::shared_ptr<NetworkConnection> p_network_connection,
+												  std::chrono::milliseconds mqtt_command_timeout,
+												  std::shared_ptr<ClientReactor> p_client_reactor,
+												  util::memory::MemoryResource *p_memory_resource);
+
 		// Sync API
 		/**
 		 * @brief Perform Sync Connect
@@ -126,11 +205,27 @@ namespace awsiotsdk {
 									 mqtt::QoS qos, const util::String &payload,
 									 std::chrono::milliseconds action_reponse_timeout);
 
+		/**
+		 * @brief Perform Sync Publish using a prepared header template
+		 *
+		 * Same as Publish, but the topic name, QoS and retained flag are taken from a PreparedPublish so the topic
+		 * name is not validated and encoded again for every message
+		 *
+		 * @param p_prepared_publish - Header template created once for the topic
+		 * @param payload - Message payload, moved into the packet
+		 * @param action_reponse_timeout - Timeout in milliseconds within which response should be obtained after request is sent
+		 *
+		 * @return ResponseCode indicating status of request
+		 */
+		virtual ResponseCode Publish(std::shared_ptr<const mqtt::PreparedPublish> p_prepared_publish,
+									 util::String payload, std::chrono::milliseconds action_reponse_timeout);
+
 		/**
 		 * @brief Perform Sync Subscribe
 		 *
 		 * Performs a MQTT Subscribe operation in blocking mode. Action timeout here is the time for which
-		 * the client waits for a response AFTER the request is sent.
+		 * the client waits for a response AFTER the request is sent. Fails with MQTT_INVALID_DATA_ERROR without
+		 * sending anything if any of the topic filters is invalid.
 		 *
 		 * @param p_subscribe_packet - Subscribe packet to use for the operation
 		 * @param action_reponse_timeout - Timeout in milliseconds within which response should be obtained after request is sent
@@ -154,6 +249,21 @@ namespace awsiotsdk {
 		virtual ResponseCode Unsubscribe(util::Vector<std::unique_ptr<Utf8String>> topic_list,
 										 std::chrono::milliseconds action_reponse_timeout);
 
+		/**
+		 * @brief Perform a batch of Publish requests in Blocking mode
+		 *
+		 * Serializes all packets into a single buffer which is written to the network in one write, saving
+		 * a write per message. Waits until all QoS1 packets have been acknowledged. Ack handlers set on the
+		 * packets are replaced
+		 *
+		 * @param publish_packets - Packets to publish, created using mqtt::PublishPacket::Create
+		 * @param action_reponse_timeout - Timeout in milliseconds within which all responses should be obtained
+		 *
+		 * @return ResponseCode SUCCESS if all packets were sent and acknowledged, the first failure otherwise
+		 */
+		virtual ResponseCode PublishBatch(util::Vector<std::shared_ptr<mqtt::PublishPacket>> publish_packets,
+										  std::chrono::milliseconds action_reponse_timeout);
+
 		// Async API
 
 		/**
@@ -176,13 +286,81 @@ namespace awsiotsdk {
 										  ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
 										  uint16_t &packet_id_out);
 
+		/**
+		 * @brief Perform Async Publish with the given priority
+		 *
+		 * Same as PublishAsync, but the request is queued with the provided priority instead of the default.
+		 * By default QoS1 requests are queued with High priority and QoS0 requests with Normal priority.
+		 * Acks and other control packets are always sent before queued publish requests
+		 *
+		 * @param p_publish_packet - Publish packet to use for the operation
+		 * @param p_async_ack_handler - AsyncAck notification handler to be called when response for this request is processed
+		 * @param action_priority - Priority to queue the request with
+		 * @param packet_id_out - Packet ID assigned to outgoing packet
+		 *
+		 * @return ResponseCode indicating status of request
+		 */
+		virtual ResponseCode PublishAsync(std::unique_ptr<Utf8String> p_topic_name, bool is_retained, bool is_duplicate,
+										  mqtt::QoS qos, const util::String &payload,
+										  ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+										  ActionPriority action_priority, uint16_t &packet_id_out);
+
+		/**
+		 * @brief Perform Async Publish using a prepared header template
+		 *
+		 * Same as PublishAsync, but the topic name, QoS and retained flag are taken from a PreparedPublish so the
+		 * topic name is not validated and encoded again for every message
+		 *
+		 * @param p_prepared_publish - Header template created once for the topic
+		 * @param payload - Message payload, moved into the packet
+		 * @param p_async_ack_handler - AsyncAck notification handler to be called when response for this request is processed
+		 * @param packet_id_out - Packet ID assigned to outgoing packet
+		 *
+		 * @return ResponseCode indicating status of request
+		 */
+		virtual ResponseCode PublishAsync(std::shared_ptr<const mqtt::PreparedPublish> p_prepared_publish,
+										  util::String payload,
+										  ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+										  uint16_t &packet_id_out);
+
+		/**
+		 * @brief Perform a batch of Async Publish requests
+		 *
+		 * Queues a single request that serializes all packets into one buffer and writes it to the network in one
+		 * write. Packet IDs are assigned to each packet when queued and can be obtained using GetPacketId. Acks are
+		 * tracked per packet, the Ack handler set on each packet is called as it would be for PublishAsync,
+		 * including when the batch fails or is dropped from the queue
+		 *
+		 * @param publish_packets - Packets to publish, created using mqtt::PublishPacket::Create
+		 * @param batch_id_out - Action ID assigned to the batch
+		 *
+		 * @return ResponseCode indicating status of request
+		 */
+		virtual ResponseCode PublishBatchAsync(util::Vector<std::shared_ptr<mqtt::PublishPacket>> publish_packets,
+											   uint16_t &batch_id_out);
+
+		/**
+		 * @brief Perform a batch of Async Publish requests and obtain a future for each packet
+		 *
+		 * Same as PublishBatchAsync, Ack handlers set on the packets are replaced by the returned futures
+		 *
+		 * @param publish_packets - Packets to publish, created using mqtt::PublishPacket::Create
+		 * @param futures_out[out] - Future for each packet, in the same order as the packets. If queuing fails, they
+		 * are ready with the failure code
+		 *
+		 * @return ResponseCode indicating status of request
+		 */
+		virtual ResponseCode PublishBatchAsync(util::Vector<std::shared_ptr<mqtt::PublishPacket>> publish_packets,
+											   util::Vector<ActionFuture> &futures_out);
+
 		/**
 		 * @brief Perform Async Subscribe
 		 *
 		 * Performs a MQTT Subscribe operation in Async mode. Packet ID obtained from this function can be
 		 * used to match Ack to specific requests if needed. The Subscribe request is queued up and Client automatically
 		 * activates Subscription if successful SUBACK is received. If not, the assigned Ack handler will be called
-		 * with the corrosponding ResponseCode
+		 * with the corrosponding ResponseCode. If any of the topic filters is invalid, nothing is sent and the Ack
+		 * handler is called with MQTT_INVALID_DATA_ERROR
 		 *
 		 * @param p_subscribe_packet - Subscribe packet to use for the operation
 		 * @param p_async_ack_handler - AsyncAck notification handler to be called when response for this request is processed
@@ -212,6 +390,42 @@ namespace awsiotsdk {
 											  ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
 											  uint16_t &packet_id_out);
 
+		/**
+		 * @brief Perform Async Publish and obtain a future for the response
+		 *
+		 * Same as PublishAsync, but instead of calling an Ack handler, the response is provided through the returned
+		 * future. QoS0 requests are ready once written to the network. Futures for multiple requests can be
+		 * collected using ActionFuture::WaitAll or ActionFuture::WaitAny
+		 *
+		 * @param future_out[out] - Future for the response. If queuing fails, it is ready with the failure code
+		 *
+		 * @return ResponseCode indicating status of request
+		 */
+		virtual ResponseCode PublishAsync(std::unique_ptr<Utf8String> p_topic_name, bool is_retained, bool is_duplicate,
+										  mqtt::QoS qos, const util::String &payload, ActionFuture &future_out);
+
+		/**
+		 * @brief Perform Async Subscribe and obtain a future for the response
+		 *
+		 * @param subscription_list - List of Subscription instances
+		 * @param future_out[out] - Future for the response. If queuing fails, it is ready with the failure code
+		 *
+		 * @return ResponseCode indicating status of request
+		 */
+		virtual ResponseCode SubscribeAsync(util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list,
+											ActionFuture &future_out);
+
+		/**
+		 * @brief Perform Async Unsubscribe and obtain a future for the response
+		 *
+		 * @param topic_list - List of topics to unsubscribe from
+		 * @param future_out[out] - Future for the response. If queuing fails, it is ready with the failure code
+		 *
+		 * @return ResponseCode indicating status of request
+		 */
+		virtual ResponseCode UnsubscribeAsync(util::Vector<std::unique_ptr<Utf8String>> topic_list,
+											  ActionFuture &future_out);
+
 		/**
 		 * @brief Check if Client is in Connected state
 		 *
@@ -232,5 +446,76 @@ namespace awsiotsdk {
 
 		virtual std::chrono::seconds GetMaxReconnectBackoffTimeout();
 		virtual void SetMaxReconnectBackoffTimeout(std::chrono::seconds max_reconnect_backoff_timeout);
+
+		/**
+		 * @brief Get max rate at which queued requests are sent
+		 *
+		 * @return uint32_t Rate in requests per second, 0 if rate limiting is disabled
+		 */
+		virtual uint32_t GetActionProcessingRate();
+
+		/**
+		 * @brief Set max rate at which queued requests are sent
+		 *
+		 * Async requests are sent as soon as they are queued by default. Setting a non-zero rate limits the number of
+		 * queued requests sent per second, which can be used to stay within service side throttling limits
+		 *
+		 * @param action_processing_rate_hz - Rate in requests per second, 0 disables rate limiting
+		 */
+		virtual void SetActionProcessingRate(uint32_t action_processing_rate_hz);
+
+		/**
+		 * @brief Set a rate limit for queued requests of a single type
+		 *
+		 * Requests of the given type are sent back to back up to burst_size and are then limited to rate_per_sec.
+		 * Requests waiting for budget do not delay requests of other types, so limiting publishes does not hold up
+		 * acks, pings or subscription requests. A publish limit counts every publish in a batch sent with PublishBatch
+		 *
+		 * @param action_type - Type of the request, eg. ActionType::PUBLISH
+		 * @param rate_per_sec - Sustained rate in requests per second, 0 removes the rate limit
+		 * @param burst_size - Number of requests that can be sent back to back
+		 * @return ResponseCode indicating result of the API call
+		 */
+		virtual ResponseCode SetActionRateLimit(ActionType action_type, uint32_t rate_per_sec, uint32_t burst_size);
+
+		/**
+		 * @brief Set what happens when an async request is made while the request queue is full
+		 *
+		 * Requests are rejected with ACTION_QUEUE_FULL by default. Ack handlers of queued requests that are dropped
+		 * to make room for newer ones are called with ACTION_DROPPED. Acks sent by the client for received messages
+		 * never block, with BLOCK_WITH_TIMEOUT they are queued past the limit. Once MAX_ACTION_QUEUE_CAPACITY requests
+		 * are queued they are rejected and reported to the action drop handler instead
+		 *
+		 * @param overflow_policy - Overflow policy
+		 * @param block_timeout - Max time to block the caller, only used by BLOCK_WITH_TIMEOUT
+		 */
+		virtual void SetActionQueueOverflowPolicy(ActionQueueOverflowPolicy overflow_policy,
+												  std::chrono::milliseconds block_timeout);
+
+		/**
+		 * @brief Set handler to be called for each async request that is rejected or dropped because the request
+		 * queue was full
+		 *
+		 * @param p_action_drop_handler - Handler, nullptr to remove
+		 */
+		virtual void SetActionDropHandler(ClientCoreState::ActionDropHandlerPtr p_action_drop_handler);
+
+		/**
+		 * @brief Get count of async requests that were rejected or dropped because the request queue was full
+		 * @return size_t Count of requests
+		 */
+		virtual size_t GetDroppedActionCount();
+
+		/**
+		 * @brief Configure coalescing of queued requests into shared network writes
+		 *
+		 * Disabled by default. When enabled, async requests that are queued back to back are written to the
+		 * network together, up to max_bytes per write. Writes are held back for at most max_delay. QoS0 requests
+		 * still complete once their write reached the network, with the result of the shared write
+		 *
+		 * @param max_bytes - Byte budget for a single write, 0 disables coalescing
+		 * @param max_delay - Max time to hold back a queued request's write
+		 */
+		virtual void SetWriteCoalescing(size_t max_bytes, std::chrono::microseconds max_delay);
 	};
 }
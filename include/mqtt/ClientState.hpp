@@ -22,6 +22,7 @@
 #pragma once
 
 #include <atomic>
+#include <mutex>
 
 #include "util/Utf8String.hpp"
 #include "util/memory/stl/Map.hpp"
@@ -30,6 +31,7 @@
 #include "ClientCore.hpp"
 
 #include "mqtt/Common.hpp"
+#include "mqtt/TopicFilterTrie.hpp"
 
 namespace awsiotsdk {
 	namespace mqtt {
@@ -42,7 +44,7 @@ namespace awsiotsdk {
 			std::atomic_bool is_auto_reconnect_required_;
 			std::atomic_bool is_pingreq_pending_;
 
-			uint16_t last_sent_packet_id_;
+			std::atomic<uint16_t> last_sent_packet_id_;
 
 			std::chrono::seconds keep_alive_timeout_;
 			std::chrono::seconds min_reconnect_backoff_timeout_;
@@ -50,9 +52,33 @@ namespace awsiotsdk {
 			std::chrono::milliseconds mqtt_command_timeout_;
 
 			std::shared_ptr<ActionData> p_connect_data_;
-		public:
-			util::Map<util::String, std::shared_ptr<Subscription>> subscription_map_;
 
+			/**
+			 * Current subscription table snapshot, never modified once published. Only accessed through
+			 * std::atomic_load/std::atomic_store
+			 */
+			std::shared_ptr<const TopicFilterTrie> p_subscription_table_;
+			std::atomic<uint32_t> subscription_table_version_;	///< Incremented after each new snapshot is published
+			std::mutex subscription_update_lock_;				///< Serializes snapshot updates and pending ack index changes
+			/**
+			 * Subscriptions waiting for a SUBACK/UNSUBACK, indexed by packet id and then by index in packet - 1
+			 */
+			util::Map<uint16_t, util::Vector<std::shared_ptr<Subscription>>> pending_ack_subscription_map_;
+
+			/**
+			 * @brief Remove a subscription from the pending ack index, subscription_update_lock_ must be held
+			 *
+			 * @param p_subscription - Subscription to remove, uses the packet id and index stored in the subscription
+			 */
+			void RemovePendingAckSubscription(std::shared_ptr<Subscription> p_subscription);
+
+			/**
+			 * @brief Publish a new snapshot without the given topic filter, subscription_update_lock_ must be held
+			 *
+			 * @param topic_filter - Topic filter of the subscription to remove
+			 */
+			void RemoveSubscriptionFromTable(const util::String &topic_filter);
+		public:
 			// Rule of 5 stuff
 			// Disable copying because class contains std::atomic<> types used for thread synchronization
 			ClientState() = delete;									// Default constructor
@@ -110,12 +136,84 @@ namespace awsiotsdk {
 
 			std::shared_ptr<Subscription> GetSubscription(util::String p_topic_name);
 
+			/**
+			 * @brief Get the current subscription table snapshot
+			 *
+			 * The snapshot is immutable and stays valid while referenced, subscription changes publish a new snapshot.
+			 * Readers can keep a snapshot and only fetch a new one when GetSubscriptionTableVersion changes.
+			 *
+			 * @return std::shared_ptr<const TopicFilterTrie> - Subscriptions indexed by topic filter, never nullptr
+			 */
+			std::shared_ptr<const TopicFilterTrie> GetSubscriptionTable() const {
+				return std::atomic_load(&p_subscription_table_);
+			}
+
+			/**
+			 * @brief Get the version of the subscription table
+			 *
+			 * @return uint32_t - Version, changes every time a new snapshot is published
+			 */
+			uint32_t GetSubscriptionTableVersion() const { return subscription_table_version_; }
+
+			/**
+			 * @brief Add a subscription, replacing the one stored for the same topic filter
+			 *
+			 * Publishes a new subscription table snapshot. Only the nodes on the path of the topic filter are copied.
+			 *
+			 * @param topic_filter - Topic filter of the subscription, may contain wildcards
+			 * @param p_subscription - Subscription to add
+			 * @return ResponseCode - SUCCESS or MQTT_INVALID_DATA_ERROR if the topic filter is not valid
+			 */
+			ResponseCode AddSubscription(util::String topic_filter, std::shared_ptr<Subscription> p_subscription);
+
+			/**
+			 * @brief Get all subscriptions whose topic filter matches a topic name
+			 *
+			 * @param topic_name - Topic name of an incoming message
+			 * @param matches_out - Matching subscriptions are appended to this vector
+			 */
+			void GetMatchingSubscriptions(util::StringView topic_name,
+										  util::Vector<std::shared_ptr<Subscription>> &matches_out);
+
+			/**
+			 * @brief Record the position of a subscription in a Subscribe/Unsubscribe request
+			 *
+			 * Indexes the subscription by packet id and index so the matching SUBACK/UNSUBACK can be processed without
+			 * scanning all subscriptions. Index 1 starts a new packet and drops any entries left for the same packet id
+			 * by a request that was never acknowledged.
+			 *
+			 * @param p_topic_name - Topic filter of the subscription
+			 * @param packet_id - Packet id of the request
+			 * @param index_in_packet - Index of the topic in the request, starting at 1
+			 * @return shared_ptr to the Subscription, nullptr if no subscription exists for the topic filter
+			 */
 			std::shared_ptr<Subscription> SetSubscriptionPacketInfo(util::String p_topic_name, uint16_t packet_id, uint8_t index_in_packet);
 
+			/**
+			 * @brief Mark the subscription at the given SUBACK position as active
+			 *
+			 * @param packet_id - Packet id of the SUBACK
+			 * @param index_in_sub_packet - Index in the SUBACK, starting at 1
+			 * @param max_qos - QoS granted by the server
+			 * @return ResponseCode - SUCCESS or FAILURE if no subscription is waiting for this Ack
+			 */
 			ResponseCode SetSubscriptionActive(uint16_t packet_id, uint8_t index_in_sub_packet, mqtt::QoS max_qos);
 
+			/**
+			 * @brief Remove the subscription at the given SUBACK position
+			 *
+			 * @param packet_id - Packet id of the SUBACK
+			 * @param index_in_sub_packet - Index in the SUBACK, starting at 1
+			 * @return ResponseCode - SUCCESS or FAILURE if no subscription is waiting for this Ack
+			 */
 			ResponseCode RemoveSubscription(uint16_t packet_id, uint8_t index_in_sub_packet);
 
+			/**
+			 * @brief Remove all subscriptions in the Unsubscribe request with the given packet id
+			 *
+			 * @param packet_id - Packet id of the UNSUBACK
+			 * @return ResponseCode - SUCCESS or FAILURE if no subscription is waiting for this Ack
+			 */
 			ResponseCode RemoveAllSubscriptionsForPacketId(uint16_t packet_id);
 
 			ResponseCode RemoveSubscription(util::String p_topic_name);
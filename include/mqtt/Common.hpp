@@ -21,7 +21,12 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "util/Utf8String.hpp"
+#include "util/StringView.hpp"
+#include "util/BufferLease.hpp"
+#include "util/OutputBuffer.hpp"
 #include "ResponseCode.hpp"
 
 #define MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET 8
@@ -146,7 +151,7 @@ namespace awsiotsdk {
 			 *
 			 * @param buf - Reference to target buffer
 			 */
-			void WriteToBuffer(util::String &buf);
+			void WriteToBuffer(util::OutputBuffer &buf);
 
 			/**
 			 * @brief Set Connect flags in the provided buffer based on Will Options instance
@@ -167,6 +172,81 @@ namespace awsiotsdk {
 			virtual ~SubscriptionHandlerContextData() = 0;
 		};
 
+		class InternedTopic;
+
+		/**
+		 * @brief View of an incoming MQTT Publish message
+		 *
+		 * Topic name and payload refer directly to the network receive buffer and are only valid for the duration of
+		 * the handler call they are passed to. Use LeaseTopicName()/LeasePayload() to keep the data for longer
+		 * without copying it, or StringView::ToString() to create a copy.
+		 */
+		class PublishView {
+		protected:
+			util::StringView topic_name_;										///< Topic name of the message
+			util::StringView payload_;											///< Payload of the message
+			QoS qos_;															///< QoS of the message
+			bool is_retained_;													///< MQTT Retained flag
+			bool is_duplicate_;													///< MQTT Duplicate flag
+			std::shared_ptr<const util::Vector<unsigned char>> p_buffer_;		///< Buffer containing topic name and payload
+			std::shared_ptr<const InternedTopic> p_interned_topic_;				///< Interned topic name, can be nullptr
+
+		public:
+			/**
+			 * @brief Constructor
+			 *
+			 * @param topic_name - Topic name view, must point into p_buffer
+			 * @param payload - Payload view, must point into p_buffer
+			 * @param qos - QoS of the message
+			 * @param is_retained - MQTT Retained flag
+			 * @param is_duplicate - MQTT Duplicate flag
+			 * @param p_buffer - Buffer containing the message
+			 * @param p_interned_topic - Interned handle for the topic name, can be nullptr
+			 */
+			PublishView(util::StringView topic_name, util::StringView payload, QoS qos, bool is_retained,
+						bool is_duplicate, std::shared_ptr<const util::Vector<unsigned char>> p_buffer,
+						std::shared_ptr<const InternedTopic> p_interned_topic = nullptr);
+
+			// Rule of 5 stuff
+			// Disabling default constructor, views are only created by the SDK
+			PublishView() = delete;											// Delete Default constructor
+			PublishView(const PublishView &) = default;						// Copy constructor
+			PublishView(PublishView &&) = default;							// Move constructor
+			PublishView &operator=(const PublishView &) & = default;		// Copy assignment operator
+			PublishView &operator=(PublishView &&) & = default;				// Move assignment operator
+			~PublishView() = default;										// Default destructor
+
+			util::StringView GetTopicName() const { return topic_name_; }
+			util::StringView GetPayload() const { return payload_; }
+			QoS GetQos() const { return qos_; }
+			bool IsRetained() const { return is_retained_; }
+			bool IsDuplicate() const { return is_duplicate_; }
+
+			/**
+			 * @brief Get the interned handle for the topic name
+			 *
+			 * Messages on the same topic name share the same handle while the topic stays in the client's intern pool.
+			 * The handle owns a copy of the topic name that can be kept without leasing the receive buffer.
+			 *
+			 * @return std::shared_ptr<const InternedTopic> - Handle, nullptr if the topic name was not interned
+			 */
+			std::shared_ptr<const InternedTopic> GetInternedTopic() const { return p_interned_topic_; }
+
+			/**
+			 * @brief Take a lease on the topic name, keeps it valid after the handler returns
+			 *
+			 * @return util::BufferLease lease on the topic name
+			 */
+			util::BufferLease LeaseTopicName() const { return util::BufferLease(p_buffer_, topic_name_); }
+
+			/**
+			 * @brief Take a lease on the payload, keeps it valid after the handler returns
+			 *
+			 * @return util::BufferLease lease on the payload
+			 */
+			util::BufferLease LeasePayload() const { return util::BufferLease(p_buffer_, payload_); }
+		};
+
 		/**
 		 * @brief MQTT Subscription Definition
 		 *
@@ -186,16 +266,24 @@ namespace awsiotsdk {
 			 */
 			typedef std::function<ResponseCode(util::String topic_name, util::String payload, std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data)> ApplicationCallbackHandlerPtr;
 
+			/**
+			 * @brief Define handler for Application Callbacks that receive a view of the message
+			 *
+			 * Avoids copying the topic name and payload, see PublishView for the lifetime of the data
+			 */
+			typedef std::function<ResponseCode(const PublishView &publish_view, std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data)> ApplicationViewCallbackHandlerPtr;
+
 			ApplicationCallbackHandlerPtr p_app_handler_;	///< Pointer to the Application Handler
+			ApplicationViewCallbackHandlerPtr p_app_view_handler_;	///< Pointer to the Application View Handler, used instead of p_app_handler_ if set
 			std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data_;				///< Data to be passed to the Application Handler
 
 			// Disabling default constructor. Defining a virtual destructor
-			// Ensure Subscription Instances can be copied/moved
+			// Ensure Subscription Instances can be copied/moved, status fields are atomic so these are user defined
 			Subscription() = delete;									// Delete Default constructor
-			Subscription(const Subscription &) = default;				// Delete Copy constructor
-			Subscription(Subscription &&) = default;					// Default Move constructor
-			Subscription& operator=(const Subscription &) & = default;	// Delete Copy assignment operator
-			Subscription& operator=(Subscription &&) & = default;		// Default Move assignment operator
+			Subscription(const Subscription &other);					// Copy constructor
+			Subscription(Subscription &&other);							// Move constructor
+			Subscription& operator=(const Subscription &other) &;		// Copy assignment operator
+			Subscription& operator=(Subscription &&other) &;			// Move assignment operator
 			virtual ~Subscription() {
 				// Do NOT delete App handler data
 			}
@@ -222,6 +310,18 @@ namespace awsiotsdk {
 			 */
 			static std::shared_ptr<Subscription> Create(std::unique_ptr<Utf8String> p_topic_name, QoS max_qos, ApplicationCallbackHandlerPtr p_app_handler, std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data);
 
+			/**
+			 * @brief Factory method to create a Subscription instance with a view handler
+			 *
+			 * @param p_topic_name - Topic name for this subscription
+			 * @param max_qos - Max QoS
+			 * @param p_app_view_handler - Application View Handler instance
+			 * @param p_app_handler_data - Data to be passed to application handler. Can be nullptr
+			 *
+			 * @return shared_ptr Subscription instance
+			 */
+			static std::shared_ptr<Subscription> Create(std::unique_ptr<Utf8String> p_topic_name, QoS max_qos, ApplicationViewCallbackHandlerPtr p_app_view_handler, std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data);
+
 			/**
 			 * @brief Is Subscription Active?
 			 *
@@ -241,7 +341,14 @@ namespace awsiotsdk {
 			 *
 			 * @return uint16_t ID of the packet
 			 */
-			uint16_t GetPacketId() { return packet_id_; }
+			uint16_t GetPacketId() { return static_cast<uint16_t>(ack_index_ >> 8); }
+
+			/**
+			 * @brief Get index of this subscription in its Subscribe/Unsubscribe request
+			 *
+			 * @return uint8_t Index in packet, starting at 1. 0 if the subscription is not waiting for an Ack
+			 */
+			uint8_t GetIndexInPacket() { return static_cast<uint8_t>(ack_index_ & 0xFF); }
 
 			/**
 			 * @brief Set expected index of Ack for this Subscription in the SUBACK packet
@@ -249,7 +356,7 @@ namespace awsiotsdk {
 			 * @param packet_id - Expected packet id
 			 * @param index_in_packet - Expected Index in packet
 			 */
-			void SetAckIndex(uint16_t packet_id, uint8_t index_in_packet) { packet_id_ = packet_id; index_in_packet_ = index_in_packet; }
+			void SetAckIndex(uint16_t packet_id, uint8_t index_in_packet) { ack_index_ = GetAckIndex(packet_id, index_in_packet); }
 
 			/**
 			 * @brief Get Max QoS for this subscription
@@ -281,13 +388,21 @@ namespace awsiotsdk {
 			 * @param index_in_packet - Index in SUBACK
 			 * @return boolean indicating whether this Subscription was the target for the received SUBACK
 			 */
-			bool IsInSuback(uint16_t packet_id, uint8_t index_in_packet) { return (packet_id == packet_id_ && index_in_packet == index_in_packet_); }
+			bool IsInSuback(uint16_t packet_id, uint8_t index_in_packet) { return GetAckIndex(packet_id, index_in_packet) == ack_index_; }
 		protected:
-			bool is_active_;							///< Boolean indicating weather the subscription is active or not
-			uint16_t packet_id_;						///< Packet Id of the Subscribe/Unsubscribe Packet
-			uint8_t index_in_packet_;					///< Index of the subscription in the Subscribe/Unsubscribe Packet
-			QoS max_qos_;								///< Max QoS for messages on this subscription
+			// Subscriptions are shared by the subscription table snapshots, status is updated by the keep alive and
+			// network read threads while other threads read it
+			std::atomic_bool is_active_;				///< Boolean indicating weather the subscription is active or not
+			std::atomic<uint32_t> ack_index_;			///< Packet Id of the Subscribe/Unsubscribe Packet and index of the subscription in it, updated together
+			std::atomic<QoS> max_qos_;					///< Max QoS for messages on this subscription
 			std::shared_ptr<Utf8String> p_topic_name_;	///< Topic Name for this subscription
+
+			/**
+			 * @brief Combine packet ID and index in packet into the value stored in ack_index_
+			 */
+			static uint32_t GetAckIndex(uint16_t packet_id, uint8_t index_in_packet) {
+				return (static_cast<uint32_t>(packet_id) << 8) | index_in_packet;
+			}
 		};
 	}
 }
@@ -103,10 +103,10 @@ namespace awsiotsdk {
 			static std::shared_ptr<ConnectPacket> Create(bool is_clean_session, mqtt::Version mqtt_version, std::chrono::seconds keep_alive_timeout, std::unique_ptr<Utf8String> p_client_id, std::unique_ptr<Utf8String> p_username, std::unique_ptr<Utf8String> p_password, std::unique_ptr<mqtt::WillOptions> p_will_msg);
 
 			/**
-			 * @brief Serialize this packet into a String
-			 * @return String containing serialized packet
+			 * @brief Serialize this packet by appending it to the provided buffer
+			 * @param buf Buffer to append the serialized packet to
 			 */
-			util::String ToString();
+			void SerializeTo(util::OutputBuffer &buf);
 
 			/**
 			 * @brief Get duration of Keep alive interval in seconds
@@ -147,10 +147,10 @@ namespace awsiotsdk {
 			static std::shared_ptr<DisconnectPacket> Create();
 
 			/**
-			 * @brief Serialize this packet into a String
-			 * @return String containing serialized packet
+			 * @brief Serialize this packet by appending it to the provided buffer
+			 * @param buf Buffer to append the serialized packet to
 			 */
-			util::String ToString();
+			void SerializeTo(util::OutputBuffer &buf);
 		};
 
 		class PingreqPacket : public Packet {
@@ -181,10 +181,10 @@ namespace awsiotsdk {
 			static std::shared_ptr<PingreqPacket> Create();
 
 			/**
-			 * @brief Serialize this packet into a String
-			 * @return String containing serialized packet
+			 * @brief Serialize this packet by appending it to the provided buffer
+			 * @param buf Buffer to append the serialized packet to
 			 */
-			util::String ToString();
+			void SerializeTo(util::OutputBuffer &buf);
 		};
 
 		/**
@@ -308,6 +308,15 @@ namespace awsiotsdk {
 		class KeepaliveActionRunner : public Action {
 		protected:
 			std::shared_ptr<ClientState> p_client_state_;	///< Shared Client State instance
+			std::chrono::steady_clock::time_point next_pingreq_time_;	///< Time of the next Ping request. Only used by PerformStep
+			bool was_connected_;							///< Was the client connected during the previous step. Only used by PerformStep
+
+			/**
+			 * @brief Disconnect from the network after the server stopped responding
+			 *
+			 * @return - ResponseCode indicating status of the operation
+			 */
+			ResponseCode DisconnectUnresponsive();
 		public:
 			// Disabling default, move and copy constructors to match Action parent
 			// Default virtual destructor
@@ -355,6 +364,19 @@ namespace awsiotsdk {
 			 * @return - ResponseCode indicating status of the operation
 			 */
 			ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ActionData> p_action_data);
+
+			/**
+			 * @brief Send out a Ping request if one is due
+			 *
+			 * Same Ping request handling as PerformAction, but does not reconnect. A Client Reactor can not perform
+			 * the blocking Connect, the application is expected to reconnect after the disconnect callback
+			 *
+			 * @param p_network_connection - Network connection instance to use for performing this action
+			 * @param [out] next_step_time_out - Time at which the next step should be performed
+			 * @return - ResponseCode indicating status of the operation
+			 */
+			ResponseCode PerformStep(std::shared_ptr<NetworkConnection> p_network_connection,
+									 std::chrono::steady_clock::time_point &next_step_time_out);
 		};
 	}
 }
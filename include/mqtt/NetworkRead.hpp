@@ -28,8 +28,21 @@
 #include "Connect.hpp"
 #include "Publish.hpp"
 #include "Subscribe.hpp"
+#include "PacketDecoder.hpp"
+#include "TopicFilterTrie.hpp"
+#include "TopicInternPool.hpp"
 
-#define MAX_NO_OF_REMAINING_LENGTH_BYTES 4
+/**
+ * Size of the receive buffer. Data is read from the network in chunks of up to this size and all complete packets
+ * in the buffer are processed before reading again. Grows to fit packets that are larger
+ */
+#ifndef NETWORK_READ_BUFFER_SIZE
+#define NETWORK_READ_BUFFER_SIZE 16384
+#endif
+
+#ifndef NETWORK_READ_MAX_PACKETS_PER_STEP
+#define NETWORK_READ_MAX_PACKETS_PER_STEP 64
+#endif
 
 namespace awsiotsdk {
 	namespace mqtt {
@@ -47,24 +60,88 @@ namespace awsiotsdk {
 
 			std::atomic_bool is_waiting_for_connack_;	///< Is this waiting for connack?
 
+			std::shared_ptr<util::Vector<unsigned char>> p_receive_buf_;	///< Data read from the network, shared with application leases
+			size_t receive_buf_start_;					///< Index of the first unprocessed byte in the receive buffer
+			size_t receive_buf_end_;					///< Index after the last byte read into the receive buffer
+			util::Vector<unsigned char> packet_body_buf_;	///< Body of the last non-Publish packet, reused to avoid allocating per packet
+			TopicInternPool topic_intern_pool_;								///< Topic names of incoming messages, with cached subscription matches
+			std::shared_ptr<const TopicFilterTrie> p_subscription_table_;	///< Last subscription table snapshot fetched from the client state
+			uint32_t subscription_table_version_;							///< Version of p_subscription_table_
+
 			/**
-			 * @brief Decode Remaining length from MQTT packet
+			 * @brief Decode Remaining length of the next packet in the receive buffer
 			 *
 			 * @param rem_len reference in which to store decoded length
+			 * @param rem_len_byte_count reference in which to store the number of bytes used to encode the length
+			 *
+			 * @return ResponseCode SUCCESS if decoded, NETWORK_SSL_NOTHING_TO_READ if more data is required,
+			 * MQTT_DECODE_REMAINING_LENGTH_ERROR if the encoding is invalid
+			 */
+			ResponseCode DecodeRemainingLength(size_t &rem_len, size_t &rem_len_byte_count);
+
+			/**
+			 * @brief Extract the next complete packet from the receive buffer
+			 *
+			 * The packet body is left in the receive buffer and remains valid until the next call to FillReceiveBuffer
+			 *
+			 * @param fixed_header_byte Reference in which Fixed header byte should be stored
+			 * @param packet_body_start_out Index of the packet body (after the fixed header) in the receive buffer
+			 * @param packet_body_length_out Length of the packet body
+			 * @param required_length_out Number of buffered bytes required to extract the packet, if incomplete
+			 *
+			 * @return ResponseCode SUCCESS if a packet was extracted, NETWORK_SSL_NOTHING_TO_READ if the buffer
+			 * does not contain a complete packet
+			 */
+			ResponseCode ExtractPacketFromReceiveBuffer(unsigned char &fixed_header_byte, size_t &packet_body_start_out,
+														size_t &packet_body_length_out, size_t &required_length_out);
+
+			/**
+			 * @brief Read the next chunk of data from the network into the receive buffer
+			 *
+			 * Switches to a new buffer if the current one is leased by the application
+			 * @param required_length Number of buffered bytes required for the next packet, the buffer is grown if needed
 			 *
 			 * @return ResponseCode indicating status of request
 			 */
-			ResponseCode DecodeRemainingLength(size_t &rem_len);
+			ResponseCode FillReceiveBuffer(size_t required_length);
+
+			/**
+			 * @brief Discard all buffered data, used when the stream can no longer be parsed
+			 */
+			void ResetReceiveBuffer();
 
 			/**
-			 * @brief Read MQTT Packet from buffer
+			 * @brief Check if the receive buffer contains a complete packet
+			 *
+			 * @return true if the next packet can be extracted without reading from the network
+			 */
+			bool HasBufferedPacket();
+
+			/**
+			 * @brief Read MQTT Packet from the receive buffer, reading from the network only if no complete packet
+			 * is buffered
 			 *
 			 * @param fixed_header_byte Reference to string in which Fixed header byte should be stored
-			 * @param read_buf Reference to string in which the rest of the packet should be stored
+			 * @param packet_body_start_out Index of the packet body (after the fixed header) in the receive buffer
+			 * @param packet_body_length_out Length of the packet body
+			 * @param is_single_read Read from the network at most once, used when the caller must not block
 			 *
 			 * @return ResponseCode indicating status of request
 			 */
-			ResponseCode ReadPacketFromNetwork(unsigned char &fixed_header_byte, util::Vector<unsigned char> &read_buf);
+			ResponseCode ReadPacketFromNetwork(unsigned char &fixed_header_byte, size_t &packet_body_start_out,
+											   size_t &packet_body_length_out, bool is_single_read);
+
+			/**
+			 * @brief Read the next MQTT Packet and handle it
+			 *
+			 * Requests a network reconnect if the read fails with an unhandled error
+			 *
+			 * @param is_single_read Read from the network at most once, used when the caller must not block
+			 *
+			 * @return ResponseCode NETWORK_SSL_NOTHING_TO_READ if no complete packet is available, otherwise
+			 * status of the packet handling
+			 */
+			ResponseCode ProcessIncomingPacket(bool is_single_read);
 
 			/**
 			 * @brief Handle MQTT Connack packet
@@ -78,14 +155,17 @@ namespace awsiotsdk {
 			/**
 			 * @brief Handle MQTT Publish packet
 			 *
-			 * @param read_buf Reference to string buffer containing the MQTT Publish payload
+			 * Topic name and payload are passed to view handlers directly from the receive buffer
+			 *
+			 * @param packet_body_start Index of the MQTT Publish packet body in the receive buffer
+			 * @param packet_body_length Length of the MQTT Publish packet body
 			 * @param is_duplicate MQTT Is Duplicate message flag
 			 * @param is_retained MQTT Is retained flag
 			 * @param qos QoS of received Publish message
 			 *
 			 * @return ResponseCode indicating status of request
 			 */
-			ResponseCode HandlePublish(const util::Vector<unsigned char> &read_buf, bool is_duplicate, bool is_retained, QoS qos);
+			ResponseCode HandlePublish(size_t packet_body_start, size_t packet_body_length, bool is_duplicate, bool is_retained, QoS qos);
 
 			/**
 			 * @brief Handle MQTT Puback packet
@@ -144,6 +224,19 @@ namespace awsiotsdk {
 			 * @return - ResponseCode indicating status of the operation
 			 */
 			ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ActionData> p_action_data);
+
+			/**
+			 * @brief Handle the packets that can be read without blocking
+			 *
+			 * Handles at most NETWORK_READ_MAX_PACKETS_PER_STEP packets so one busy connection can not starve others
+			 * driven by the same Client Reactor
+			 *
+			 * @param p_network_connection - Network connection instance to use for performing this action
+			 * @param [out] next_step_time_out - Time at which the next step should be performed
+			 * @return - ResponseCode indicating status of the operation
+			 */
+			ResponseCode PerformStep(std::shared_ptr<NetworkConnection> p_network_connection,
+									 std::chrono::steady_clock::time_point &next_step_time_out);
 		};
 	}
 }
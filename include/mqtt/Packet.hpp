@@ -24,6 +24,7 @@
 #include <iostream>
 #include <memory>
 
+#include "util/OutputBuffer.hpp"
 #include "util/Utf8String.hpp"
 
 #include "Action.hpp"
@@ -79,6 +80,12 @@ namespace awsiotsdk {
 			 */
 			MessageTypes GetMessageType();
 
+			/**
+			 * @brief Get the first byte of the fixed header
+			 * @return Message type and flags encoded as sent on the wire
+			 */
+			unsigned char GetFixedHeaderByte() { return fixed_header_byte_; }
+
 			/**
 			 * @brief Get remaining length
 			 * @return Remaining length
@@ -100,11 +107,20 @@ namespace awsiotsdk {
 			}
 
 			/**
-			 * @brief Append this header to a string
+			 * @brief Append this header to an output buffer
+			 *
+			 * @param buf Reference to target buffer
+			 */
+			void AppendToBuffer(util::OutputBuffer &buf);
+
+			/**
+			 * @brief Encode a remaining length value
 			 *
-			 * @param p_buf Reference to target string
+			 * @param rem_len Remaining length to encode
+			 * @param p_encoded_out Destination, must have room for at least 4 bytes
+			 * @return Number of bytes written
 			 */
-			void AppendToBuffer(util::String &p_buf);
+			static size_t EncodeRemainingLength(size_t rem_len, char *p_encoded_out);
 		};
 
 		/**
@@ -127,14 +143,28 @@ namespace awsiotsdk {
 
 			size_t Size() { return serialized_packet_length_; }
 
-			static void AppendUInt16ToBuffer(util::String &buf, uint16_t value);
-			static void AppendUtf8StringToBuffer(util::String &buf, std::unique_ptr<Utf8String> &utf8_str);
-			static void AppendUtf8StringToBuffer(util::String &buf, std::shared_ptr<Utf8String> &utf8_str);
+			static void AppendUInt16ToBuffer(util::OutputBuffer &buf, uint16_t value);
+			static void AppendUtf8StringToBuffer(util::OutputBuffer &buf, const Utf8String &utf8_str);
 
 			static uint16_t ReadUInt16FromBuffer(const util::Vector<unsigned char> &buf, size_t &extract_index);
 			static std::unique_ptr<Utf8String> ReadUtf8StringFromBuffer(const util::Vector<unsigned char> &buf, size_t &extract_index);
 
-			virtual util::String ToString() = 0;
+			/**
+			 * @brief Serialize the packet by appending it to an output buffer
+			 *
+			 * Writes the fixed header, variable header and payload directly into the buffer. Does not allocate if
+			 * the buffer already has enough capacity, the buffer is grown to fit the packet otherwise.
+			 *
+			 * @param buf Buffer to append the serialized packet to
+			 */
+			virtual void SerializeTo(util::OutputBuffer &buf) = 0;
+
+			/**
+			 * @brief Serialize the packet into a new string
+			 *
+			 * @return util::String containing the serialized packet
+			 */
+			virtual util::String ToString();
 			virtual ~Packet() { }
 		};
 	}
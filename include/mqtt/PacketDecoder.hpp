@@ -0,0 +1,172 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PacketDecoder.hpp
+ * @brief Incremental MQTT packet decoder
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "util/memory/stl/Vector.hpp"
+
+#include "ResponseCode.hpp"
+
+#define MAX_NO_OF_REMAINING_LENGTH_BYTES 4
+
+/**
+ * Largest remaining length accepted by the decoder. Defaults to the maximum that can be encoded in MQTT 3.1.1,
+ * lower it to bound the memory used for packets that arrive split across chunks
+ */
+#ifndef MQTT_PACKET_DECODER_MAX_REMAINING_LENGTH
+#define MQTT_PACKET_DECODER_MAX_REMAINING_LENGTH 268435455
+#endif
+
+namespace awsiotsdk {
+	namespace mqtt {
+		/**
+		 * @brief Incremental MQTT 3.1.1 packet decoder
+		 *
+		 * Push parser that accepts the byte stream in chunks of any size and calls the packet handler for every
+		 * complete packet. Decoding resumes where the previous chunk ended, including in the middle of the fixed
+		 * header, the remaining length or the packet body. Does not perform any I/O.
+		 *
+		 * Packet bodies that are fully contained in a chunk are passed to the handler directly from that chunk,
+		 * bodies split across chunks are collected in an internal buffer first.
+		 */
+		class PacketDecoder {
+		public:
+			/**
+			 * @brief Handler called for every complete packet
+			 *
+			 * The body is only valid during the call. p_body can be null if body_length is 0.
+			 * Returning anything other than SUCCESS stops the current Feed call.
+			 *
+			 * @param fixed_header_byte - First byte of the fixed header, packet type and flags
+			 * @param p_body - Packet body, everything after the remaining length
+			 * @param body_length - Length of the packet body
+			 */
+			typedef std::function<ResponseCode(unsigned char fixed_header_byte, const unsigned char *p_body,
+											   size_t body_length)> PacketHandlerPtr;
+
+		protected:
+			/**
+			 * @brief Part of the packet the next byte belongs to
+			 */
+			enum class DecodeState {
+				FIXED_HEADER,		///< Expecting the first byte of a packet
+				REMAINING_LENGTH,	///< Decoding the variable length remaining length field
+				BODY,				///< Collecting the packet body
+				FAILED				///< Stream could not be decoded, only Reset leaves this state
+			};
+
+			PacketHandlerPtr p_packet_handler_;			///< Handler called for every complete packet
+			size_t max_remaining_length_;				///< Largest accepted remaining length
+			DecodeState state_;							///< Current decode state
+			ResponseCode failure_rc_;					///< Error returned while in the FAILED state
+			unsigned char fixed_header_byte_;			///< Fixed header byte of the packet being decoded
+			size_t remaining_length_;					///< Remaining length decoded so far
+			size_t remaining_length_multiplier_;		///< Multiplier for the next remaining length byte
+			size_t remaining_length_byte_count_;		///< Number of remaining length bytes decoded so far
+			util::Vector<unsigned char> body_buf_;		///< Body of a packet that is split across chunks
+
+			/**
+			 * @brief Call the packet handler and get ready for the next packet
+			 *
+			 * @param p_body - Packet body
+			 * @return ResponseCode - Value returned by the handler
+			 */
+			ResponseCode EmitPacket(const unsigned char *p_body);
+
+			/**
+			 * @brief Enter the FAILED state
+			 *
+			 * @param rc - Error to report until the decoder is reset
+			 * @return ResponseCode - rc
+			 */
+			ResponseCode Fail(ResponseCode rc);
+
+		public:
+			// Disabling default and copy constructors.
+			PacketDecoder() = delete;										// Default constructor
+			PacketDecoder(const PacketDecoder &) = delete;					// Copy constructor
+			PacketDecoder(PacketDecoder &&) = delete;						// Move constructor
+			PacketDecoder &operator=(const PacketDecoder &) & = delete;		// Copy assignment operator
+			PacketDecoder &operator=(PacketDecoder &&) & = delete;			// Move assignment operator
+
+			/**
+			 * @brief Constructor
+			 *
+			 * @param p_packet_handler - Handler called for every complete packet
+			 * @param max_remaining_length - Largest accepted remaining length
+			 */
+			PacketDecoder(PacketHandlerPtr p_packet_handler, size_t max_remaining_length);
+
+			/**
+			 * @brief Factory Create method
+			 *
+			 * @param p_packet_handler - Handler called for every complete packet
+			 * @param max_remaining_length - Largest accepted remaining length
+			 * @return nullptr if no handler is provided, unique_ptr pointing to a PacketDecoder instance otherwise
+			 */
+			static std::unique_ptr<PacketDecoder> Create(PacketHandlerPtr p_packet_handler,
+														 size_t max_remaining_length = MQTT_PACKET_DECODER_MAX_REMAINING_LENGTH);
+
+			/**
+			 * @brief Decode the next chunk of the byte stream
+			 *
+			 * Calls the packet handler for every packet completed by this chunk. Bytes of an incomplete packet at the
+			 * end of the chunk are kept and decoding continues with the next call.
+			 *
+			 * @param p_data - Chunk of the byte stream
+			 * @param data_length - Length of the chunk
+			 * @param consumed_length_out - Number of bytes of the chunk that were decoded. Less than data_length only
+			 * if an error is returned, a call with the rest of the chunk resumes after a handler error
+			 * @return ResponseCode - SUCCESS, the error returned by the packet handler,
+			 * MQTT_RX_MESSAGE_PACKET_TYPE_INVALID_ERROR or MQTT_DECODE_REMAINING_LENGTH_ERROR if the stream is invalid
+			 */
+			ResponseCode Feed(const unsigned char *p_data, size_t data_length, size_t &consumed_length_out);
+
+			/**
+			 * @brief Discard any partially decoded packet and clear the error state
+			 */
+			void Reset();
+
+			/**
+			 * @brief Check if the decoder is between packets
+			 *
+			 * @return true if no partially decoded packet is held
+			 */
+			bool IsAtPacketBoundary();
+
+			/**
+			 * @brief Decode a remaining length field
+			 *
+			 * @param p_data - Start of the remaining length field
+			 * @param data_length - Number of bytes available at p_data
+			 * @param rem_len_out - Decoded remaining length
+			 * @param rem_len_byte_count_out - Number of bytes used to encode the remaining length
+			 * @return ResponseCode - SUCCESS if decoded, NETWORK_SSL_NOTHING_TO_READ if more data is required,
+			 * MQTT_DECODE_REMAINING_LENGTH_ERROR if the encoding is invalid
+			 */
+			static ResponseCode DecodeRemainingLength(const unsigned char *p_data, size_t data_length,
+													  size_t &rem_len_out, size_t &rem_len_byte_count_out);
+		};
+	}
+}
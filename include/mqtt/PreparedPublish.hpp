@@ -0,0 +1,105 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PreparedPublish.hpp
+ * @brief Pre-serialized Publish header for topics that are published to repeatedly
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "util/OutputBuffer.hpp"
+#include "util/Utf8String.hpp"
+#include "util/memory/stl/String.hpp"
+
+#include "mqtt/Common.hpp"
+
+namespace awsiotsdk {
+	namespace mqtt {
+		/**
+		 * @brief Publish header template for a (topic name, QoS, retained) combination
+		 *
+		 * The topic name is validated and encoded once when the instance is created. Publish packets created from it
+		 * only need the remaining length and packet id to be filled in when they are serialized. Instances never
+		 * change after creation and can be shared between threads and packets.
+		 */
+		class PreparedPublish {
+		protected:
+			util::String topic_name_;					///< Topic name messages are published to
+			util::String encoded_topic_name_;			///< Topic name as sent on the wire, 2 byte length followed by the name
+			unsigned char fixed_header_byte_;			///< First byte of the fixed header, includes QoS and retained flags
+			QoS qos_;									///< Message Quality of Service
+			bool is_retained_;							///< Is retained flag
+
+		public:
+			/**
+			 * @brief Constructor
+			 *
+			 * @warning This constructor can throw exceptions, it is recommended to use Factory create method
+			 * Constructor is kept public to not restrict usage possibilities (eg. make_shared)
+			 *
+			 * @param p_topic_name Topic name on which messages are to be published
+			 * @param qos QoS to use for the messages, QoS2 is not supported currently
+			 * @param is_retained Is retained flag
+			 */
+			PreparedPublish(std::unique_ptr<Utf8String> p_topic_name, QoS qos, bool is_retained);
+
+			// Rule of 5 stuff
+			// Instances are shared, disable copying
+			PreparedPublish() = delete;											// Delete Default constructor
+			PreparedPublish(const PreparedPublish &) = delete;					// Delete Copy constructor
+			PreparedPublish(PreparedPublish &&) = default;						// Move constructor
+			PreparedPublish &operator=(const PreparedPublish &) & = delete;		// Delete Copy assignment operator
+			PreparedPublish &operator=(PreparedPublish &&) & = default;			// Move assignment operator
+			~PreparedPublish() = default;										// Default destructor
+
+			/**
+			 * @brief Create Factory method
+			 *
+			 * @param p_topic_name Topic name on which messages are to be published
+			 * @param qos QoS to use for the messages, QoS2 is not supported currently
+			 * @param is_retained Is retained flag
+			 * @return nullptr on error, shared_ptr pointing to a created PreparedPublish instance if successful
+			 */
+			static std::shared_ptr<PreparedPublish> Create(std::unique_ptr<Utf8String> p_topic_name, QoS qos,
+														   bool is_retained);
+
+			const util::String &GetTopicName() const { return topic_name_; }
+			QoS GetQoS() const { return qos_; }
+			bool IsRetained() const { return is_retained_; }
+
+			/**
+			 * @brief Get the remaining length of a Publish packet using this template
+			 *
+			 * @param payload_length Length of the message payload
+			 * @return Remaining length to store in the fixed header
+			 */
+			size_t GetRemainingLength(size_t payload_length) const;
+
+			/**
+			 * @brief Serialize everything except the payload by appending it to the provided buffer
+			 *
+			 * @param buf Buffer to append the fixed header, topic name and packet id to
+			 * @param packet_id Packet id of the message, ignored for QoS0
+			 * @param payload_length Length of the payload that follows the header
+			 */
+			void SerializeHeaderTo(util::OutputBuffer &buf, uint16_t packet_id, size_t payload_length) const;
+		};
+	}
+}
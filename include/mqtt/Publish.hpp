@@ -25,6 +25,7 @@
 
 #include "mqtt/ClientState.hpp"
 #include "mqtt/Packet.hpp"
+#include "mqtt/PreparedPublish.hpp"
 
 namespace awsiotsdk {
 	namespace mqtt {
@@ -40,6 +41,10 @@ namespace awsiotsdk {
 			QoS qos_;                ///< Message Quality of Service
 			std::unique_ptr<Utf8String> p_topic_name_;    ///< Topic Name this packet was published to
 			util::String payload_;            ///< MQTT message payload
+			/**
+			 * Header template used instead of the topic name when set, p_topic_name_ is nullptr in that case
+			 */
+			std::shared_ptr<const PreparedPublish> p_prepared_publish_;
 		public:
 			// Ensure Default and Copy Constructors and Copy assignment operator are deleted
 			// Use default move constructors and assignment operators
@@ -71,6 +76,17 @@ namespace awsiotsdk {
 			 */
 			PublishPacket(std::unique_ptr<Utf8String> p_topic_name, bool is_retained, bool is_duplicate, QoS qos, const util::String &payload);
 
+			/**
+			 * @brief Constructor, using a prepared header template
+			 *
+			 * @warning This constructor can throw exceptions, it is recommended to use Factory create method
+			 * Constructor is kept public to not restrict usage possibilities (eg. make_shared)
+			 *
+			 * @param p_prepared_publish Topic name, QoS and retained flag to use for this message
+			 * @param payload String containing payload to send with message. Can be zero length.
+			 */
+			PublishPacket(std::shared_ptr<const PreparedPublish> p_prepared_publish, util::String payload);
+
 			/**
 			 * @brief Constructor, Deserializes data from buffer
 			 *
@@ -96,6 +112,18 @@ namespace awsiotsdk {
 			 */
 			static std::shared_ptr<PublishPacket> Create(std::unique_ptr<Utf8String> p_topic_name, bool is_retained, bool is_duplicate, QoS qos, const util::String &payload);
 
+			/**
+			 * @brief Create Factory method using a prepared header template
+			 *
+			 * Skips validating and encoding the topic name, which was done when the template was created
+			 *
+			 * @param p_prepared_publish Topic name, QoS and retained flag to use for this message
+			 * @param payload String containing payload to send with message. Can be zero length. Moved into the
+			 * packet, pass an rvalue to avoid copying it
+			 * @return nullptr on error, shared_ptr pointing to a created PublishPacket instance if successful
+			 */
+			static std::shared_ptr<PublishPacket> Create(std::shared_ptr<const PreparedPublish> p_prepared_publish, util::String payload);
+
 			/**
 			 * @brief Create Factory method which deserializes data from a buffer
 			 *
@@ -123,7 +151,9 @@ namespace awsiotsdk {
 			 * @brief Get String containing topic name for this message
 			 * @return util::String with topic name
 			 */
-			util::String GetTopicName() { return p_topic_name_->ToStdString(); }
+			util::String GetTopicName() {
+				return (nullptr != p_prepared_publish_) ? p_prepared_publish_->GetTopicName() : p_topic_name_->ToStdString();
+			}
 
 			/**
 			 * @brief Get string containing Payload
@@ -138,14 +168,88 @@ namespace awsiotsdk {
 			size_t GetPayloadLen() { return payload_.length(); }
 
 			/**
-			 * @brief Serialize this packet into a String
-			 * @return String containing serialized packet
+			 * @brief Get a view of the payload without copying it
+			 * @return util::StringView valid for the lifetime of this packet
 			 */
-			util::String ToString();
+			util::StringView GetPayloadView() const { return util::StringView(payload_); }
+
+			/**
+			 * @brief Serialize this packet by appending it to the provided buffer
+			 * @param buf Buffer to append the serialized packet to
+			 */
+			void SerializeTo(util::OutputBuffer &buf);
+
+			/**
+			 * @brief Serialize everything except the payload by appending it to the provided buffer
+			 *
+			 * Lets the header and the payload be written as separate segments so the payload is never copied
+			 *
+			 * @param buf Buffer to append the fixed header, topic name and packet id to
+			 */
+			void SerializeHeaderTo(util::OutputBuffer &buf);
 
 			QoS GetQoS() { return qos_; }
 		};
 
+		/**
+		 * @brief Define a class for a batch of Publish packets
+		 *
+		 * The packets in the batch are serialized into a single buffer and written to the network in one write.
+		 * Each packet keeps its own Packet ID and Ack handler, Acks are tracked per packet. The Ack handler of the
+		 * batch itself is called once the batch has been written, or with an error code if the batch failed
+		 */
+		class PublishBatchPacket : public ActionData {
+		protected:
+			util::Vector<std::shared_ptr<PublishPacket>> publish_packets_;	///< Packets in this batch
+			std::atomic_uint_fast16_t batch_id_;							///< Action ID of the batch itself
+			size_t serialized_batch_length_;								///< Serialized length of all packets in the batch
+		public:
+			// Ensure Default and Copy Constructors and Copy assignment operator are deleted
+			// Default virtual destructor
+			// Delete Default constructor
+			PublishBatchPacket() = delete;
+			// Delete Copy constructor
+			PublishBatchPacket(const PublishBatchPacket &) = delete;
+			// Delete Move constructor
+			PublishBatchPacket(PublishBatchPacket &&) = delete;
+			// Delete Copy assignment operator
+			PublishBatchPacket& operator=(const PublishBatchPacket &) & = delete;
+			// Delete Move assignment operator
+			PublishBatchPacket& operator=(PublishBatchPacket &&) & = delete;
+			// Default destructor
+			virtual ~PublishBatchPacket() = default;
+
+			PublishBatchPacket(util::Vector<std::shared_ptr<PublishPacket>> publish_packets);
+
+			/**
+			 * @brief Create a batch, fails if the list is empty or contains a nullptr
+			 *
+			 * @param publish_packets - Packets to include in the batch
+			 * @return std::shared_ptr<PublishBatchPacket> Batch, nullptr on failure
+			 */
+			static std::shared_ptr<PublishBatchPacket> Create(util::Vector<std::shared_ptr<PublishPacket>> publish_packets);
+
+			uint16_t GetActionId() { return batch_id_; }
+			void SetActionId(uint16_t action_id) { batch_id_ = action_id; }
+			uint32_t GetPacketCount() { return static_cast<uint32_t>(publish_packets_.size()); }
+
+			const util::Vector<std::shared_ptr<PublishPacket>> &GetPublishPackets() { return publish_packets_; }
+
+			size_t Size() { return serialized_batch_length_; }
+
+			/**
+			 * @brief Serialize all packets in the batch by appending them to the provided buffer
+			 * @param buf Buffer to append the serialized batch to
+			 */
+			void SerializeTo(util::OutputBuffer &buf);
+
+			/**
+			 * @brief Serialize all packets in the batch into a single buffer
+			 * @return util::String Serialized batch
+			 */
+			util::String ToString();
+		};
+
 		/**
 		 * @brief Define a class for Puback Packet type
 		 *
@@ -183,10 +287,10 @@ namespace awsiotsdk {
 			static std::shared_ptr<PubackPacket> Create(uint16_t packet_id);
 
 			/**
-			 * @brief Serialize this packet into a String
-			 * @return String containing serialized packet
+			 * @brief Serialize this packet by appending it to the provided buffer
+			 * @param buf Buffer to append the serialized packet to
 			 */
-			util::String ToString();
+			void SerializeTo(util::OutputBuffer &buf);
 		};
 
 		/**
@@ -244,6 +348,62 @@ namespace awsiotsdk {
 			ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ActionData> p_action_data);
 		};
 
+		/**
+		 * @brief Define a class for PublishBatchActionAsync
+		 *
+		 * This class defines an Asynchronous action for writing a batch of MQTT Publish packets to the network in
+		 * one write
+		 */
+		class PublishBatchActionAsync : public Action {
+		protected:
+			std::shared_ptr<ClientState> p_client_state_;	///< Shared Client State instance
+		public:
+			// Disabling default, move and copy constructors to match Action parent
+			// Default virtual destructor
+			PublishBatchActionAsync() = delete;
+			// Default Copy constructor
+			PublishBatchActionAsync(const PublishBatchActionAsync &) = delete;
+			// Default Move constructor
+			PublishBatchActionAsync(PublishBatchActionAsync &&) = delete;
+			// Default Copy assignment operator
+			PublishBatchActionAsync& operator=(const PublishBatchActionAsync &) & = delete;
+			// Default Move assignment operator
+			PublishBatchActionAsync& operator=(PublishBatchActionAsync &&) & = delete;
+			// Default destructor
+			virtual ~PublishBatchActionAsync() = default;
+
+			/**
+			 * @brief Constructor
+			 *
+			 * @warning This constructor can throw exceptions, it is recommended to use Factory create method
+			 * Constructor is kept public to not restrict usage possibilities (eg. make_shared)
+			 *
+			 * @param p_client_state - Shared Client State instance
+			 */
+			PublishBatchActionAsync(std::shared_ptr<ClientState> p_client_state);
+
+			/**
+			 * @brief Factory Create method
+			 *
+			 * @param p_client_state - Shared Client State instance
+			 * @return nullptr on error, unique_ptr pointing to a created PublishBatchActionAsync instance if successful
+			 */
+			static std::unique_ptr<Action> Create(std::shared_ptr<ActionState> p_action_state);
+
+			/**
+			 * @brief Perform MQTT Publish Batch Action in Async mode
+			 *
+			 * Registers the Ack handlers of the packets in the batch, then writes the whole batch to the network layer.
+			 * Handlers of QoS0 packets are called once the batch is written. If the write fails, the registered Acks
+			 * are removed again.
+			 *
+			 * @param p_network_connection - Network connection instance to use for performing this action
+			 * @param p_action_data - Action data specific to this execution of the Action
+			 * @return - ResponseCode indicating status of the operation
+			 */
+			ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ActionData> p_action_data);
+		};
+
 		/**
 		 * @brief Define a class for PubackActionAsync
 		 *
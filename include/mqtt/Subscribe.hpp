@@ -74,10 +74,10 @@ namespace awsiotsdk {
 			static std::shared_ptr<SubscribePacket> Create(util::Vector<std::shared_ptr<Subscription>> subscription_list);
 
 			/**
-			 * @brief Serialize this packet into a String
-			 * @return String containing serialized packet
+			 * @brief Serialize this packet by appending it to the provided buffer
+			 * @param buf Buffer to append the serialized packet to
 			 */
-			util::String ToString();
+			void SerializeTo(util::OutputBuffer &buf);
 		};
 
 		/**
@@ -123,10 +123,10 @@ namespace awsiotsdk {
 			static std::shared_ptr<SubackPacket> Create(const util::Vector<unsigned char> &buf);
 
 			/**
-			 * @brief Serialize this packet into a String
-			 * @return String containing serialized packet
+			 * @brief Serialize this packet by appending it to the provided buffer
+			 * @param buf Buffer to append the serialized packet to
 			 */
-			util::String ToString();
+			void SerializeTo(util::OutputBuffer &buf);
 		};
 
 		/**
@@ -171,10 +171,10 @@ namespace awsiotsdk {
 			static std::shared_ptr<UnsubscribePacket> Create(util::Vector<std::unique_ptr<Utf8String>> topic_list);
 
 			/**
-			 * @brief Serialize this packet into a String
-			 * @return String containing serialized packet
+			 * @brief Serialize this packet by appending it to the provided buffer
+			 * @param buf Buffer to append the serialized packet to
 			 */
-			util::String ToString();
+			void SerializeTo(util::OutputBuffer &buf);
 		};
 
 		/**
@@ -217,10 +217,10 @@ namespace awsiotsdk {
 			static std::shared_ptr<UnsubackPacket> Create(const util::Vector<unsigned char> &buf);
 
 			/**
-			 * @brief Serialize this packet into a String
-			 * @return String containing serialized packet
+			 * @brief Serialize this packet by appending it to the provided buffer
+			 * @param buf Buffer to append the serialized packet to
 			 */
-			util::String ToString();
+			void SerializeTo(util::OutputBuffer &buf);
 		};
 
 		/**
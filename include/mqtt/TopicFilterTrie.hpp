@@ -0,0 +1,182 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicFilterTrie.hpp
+ * @brief Trie of MQTT topic filters used to find the subscriptions matching an incoming topic
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "util/StringView.hpp"
+#include "util/memory/stl/Map.hpp"
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "ResponseCode.hpp"
+
+#include "mqtt/Common.hpp"
+
+namespace awsiotsdk {
+	namespace mqtt {
+		/**
+		 * @brief Topic filter trie
+		 *
+		 * Stores subscriptions keyed by topic filter, one trie level per topic level. Supports the MQTT 3.1.1 single
+		 * level (+) and multi level (#) wildcards. Matching a topic visits one node per topic level and wildcard
+		 * branch, independent of the number of stored filters.
+		 *
+		 * Copying a trie is O(1), the copy shares all nodes with the original. Insert and Remove never modify a node
+		 * that is shared with another trie, they copy the nodes on the path to the modified level instead. Literal
+		 * children of a node are split into hash buckets so copying a node with a large number of children only
+		 * copies the bucket list and one bucket. This allows publishing copies as read only snapshots to other
+		 * threads while a writer keeps modifying its own copy. A single trie instance is not thread safe.
+		 */
+		class TopicFilterTrie {
+		protected:
+			struct Node;
+
+			typedef util::Map<util::String, std::shared_ptr<const Node>> ChildBucket;	///< Literal children hashing to the same bucket
+
+			/**
+			 * @brief Trie node, represents one topic level of a filter
+			 */
+			struct Node {
+				util::Vector<std::shared_ptr<const ChildBucket>> child_buckets_;	///< Literal children, bucket count is a power of 2
+				size_t child_count_;												///< Number of literal children
+				std::shared_ptr<const Node> p_single_level_child_;					///< Child for the + wildcard
+				std::shared_ptr<Subscription> p_multi_level_subscription_;			///< Subscription for a # filter at this level
+				std::shared_ptr<Subscription> p_subscription_;						///< Subscription for a filter ending at this node
+
+				Node() : child_count_(0) { }
+
+				bool IsEmpty() const {
+					return 0 == child_count_ && nullptr == p_single_level_child_
+						   && nullptr == p_multi_level_subscription_ && nullptr == p_subscription_;
+				}
+
+				const Node *FindChild(const util::String &topic_level) const;
+			};
+
+			std::shared_ptr<const Node> p_root_;	///< Root node, its children are the first topic levels. nullptr if empty
+			size_t size_;							///< Number of stored filters
+
+			static Node *MakeWritable(std::shared_ptr<const Node> &p_node);
+
+			static std::shared_ptr<const Node> &GetWritableChildSlot(Node &node, const util::String &topic_level);
+
+			static void EraseChild(Node &node, const util::String &topic_level);
+
+			static void GrowChildBuckets(Node &node);
+
+			static bool InsertIntoNode(std::shared_ptr<const Node> &p_node, const char *p_level_start,
+									   const char *p_filter_end, std::shared_ptr<Subscription> p_subscription);
+
+			static void RemoveFromNode(Node &node, const char *p_level_start, const char *p_filter_end);
+
+			static void MatchLevel(const Node &node, const char *p_level_start, const char *p_topic_end,
+								   bool is_first_level, util::String &lookup_key,
+								   util::Vector<std::shared_ptr<Subscription>> &matches_out);
+
+			static void CollectSubscriptions(const Node &node,
+											 util::Vector<std::shared_ptr<Subscription>> &subscriptions_out);
+
+		public:
+			TopicFilterTrie() : size_(0) { }
+
+			// Rule of 5 stuff
+			// Copies share all nodes, defaults for everything
+			TopicFilterTrie(const TopicFilterTrie &) = default;					// Copy constructor
+			TopicFilterTrie(TopicFilterTrie &&) = default;						// Move constructor
+			TopicFilterTrie &operator=(const TopicFilterTrie &) & = default;	// Copy assignment operator
+			TopicFilterTrie &operator=(TopicFilterTrie &&) & = default;			// Move assignment operator
+			~TopicFilterTrie() = default;										// Default destructor
+
+			/**
+			 * @brief Add a subscription, replaces the subscription stored for the same filter
+			 *
+			 * @param topic_filter - Topic filter, may contain wildcards
+			 * @param p_subscription - Subscription to store
+			 * @return ResponseCode - SUCCESS, NULL_VALUE_ERROR or MQTT_INVALID_DATA_ERROR if the filter is not valid
+			 */
+			ResponseCode Insert(const util::String &topic_filter, std::shared_ptr<Subscription> p_subscription);
+
+			/**
+			 * @brief Remove the subscription stored for a filter
+			 *
+			 * @param topic_filter - Topic filter, compared literally
+			 * @return bool - true if a subscription was removed
+			 */
+			bool Remove(const util::String &topic_filter);
+
+			/**
+			 * @brief Get the subscription stored for a filter
+			 *
+			 * @param topic_filter - Topic filter, compared literally
+			 * @return std::shared_ptr<Subscription> - nullptr if no subscription is stored for the filter
+			 */
+			std::shared_ptr<Subscription> Find(const util::String &topic_filter) const;
+
+			/**
+			 * @brief Get all subscriptions whose filter matches a topic name
+			 *
+			 * Filters starting with a wildcard do not match topic names starting with $
+			 *
+			 * @param topic_name - Topic name of an incoming message
+			 * @param matches_out - Matching subscriptions are appended to this vector
+			 */
+			void Match(util::StringView topic_name, util::Vector<std::shared_ptr<Subscription>> &matches_out) const;
+
+			/**
+			 * @brief Get all stored subscriptions
+			 *
+			 * @param subscriptions_out - Subscriptions are appended to this vector
+			 */
+			void GetAll(util::Vector<std::shared_ptr<Subscription>> &subscriptions_out) const;
+
+			/**
+			 * @brief Get the number of stored filters
+			 *
+			 * @return size_t - Number of filters
+			 */
+			size_t Size() const { return size_; }
+
+			/**
+			 * @brief Remove all filters
+			 */
+			void Clear();
+
+			/**
+			 * @brief Check if a topic filter is valid
+			 *
+			 * @param topic_filter - Topic filter
+			 * @return bool - true if wildcards only occupy whole levels and # is the last level
+			 */
+			static bool IsValidFilter(const util::String &topic_filter);
+
+			/**
+			 * @brief Check if a topic name matches a single topic filter
+			 *
+			 * @param topic_filter - Valid topic filter
+			 * @param topic_name - Topic name
+			 * @return bool - true if the filter matches the topic name
+			 */
+			static bool IsMatch(util::StringView topic_filter, util::StringView topic_name);
+		};
+	}
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicInternPool.hpp
+ * @brief Pool of interned topic names for incoming messages
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "util/StringView.hpp"
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "mqtt/Common.hpp"
+
+/**
+ * Maximum number of topic names kept by a TopicInternPool. The pool is emptied when it is full, topics seen after that
+ * are interned again on first use
+ */
+#ifndef MQTT_TOPIC_INTERN_POOL_MAX_TOPICS
+#define MQTT_TOPIC_INTERN_POOL_MAX_TOPICS 1024
+#endif
+
+namespace awsiotsdk {
+	namespace mqtt {
+		/**
+		 * @brief Interned topic name
+		 *
+		 * Every incoming message on the same topic name refers to the same InternedTopic instance as long as it stays
+		 * in the pool, so the handle can be compared or used as a key instead of the topic name. The topic name never
+		 * changes and can be read from any thread. The cached subscription matches are only used by the network read
+		 * thread.
+		 */
+		class InternedTopic {
+		protected:
+			util::String topic_name_;												///< Topic name
+			uint64_t hash_;															///< Hash of the topic name
+			bool has_cached_matches_;												///< Whether cached_matches_ is set
+			uint32_t cached_matches_version_;										///< Subscription table version cached_matches_ was computed for
+			util::Vector<std::shared_ptr<Subscription>> cached_matches_;			///< Subscriptions matching the topic name
+
+		public:
+			InternedTopic(util::StringView topic_name, uint64_t hash);
+
+			// Rule of 5 stuff
+			// Handles are shared, disable copying
+			InternedTopic() = delete;												// Delete Default constructor
+			InternedTopic(const InternedTopic &) = delete;							// Delete Copy constructor
+			InternedTopic(InternedTopic &&) = default;								// Move constructor
+			InternedTopic &operator=(const InternedTopic &) & = delete;				// Delete Copy assignment operator
+			InternedTopic &operator=(InternedTopic &&) & = default;					// Move assignment operator
+			~InternedTopic() = default;												// Default destructor
+
+			const util::String &GetTopicName() const { return topic_name_; }
+			uint64_t GetHash() const { return hash_; }
+
+			/**
+			 * @brief Get the cached subscription matches
+			 *
+			 * @param subscription_table_version - Version of the current subscription table
+			 * @return Cached matches, nullptr if they were not computed for this version of the table
+			 */
+			const util::Vector<std::shared_ptr<Subscription>> *GetCachedMatches(uint32_t subscription_table_version) const {
+				return (has_cached_matches_ && subscription_table_version == cached_matches_version_) ? &cached_matches_
+																									  : nullptr;
+			}
+
+			/**
+			 * @brief Get the match cache storage to recompute it for a new version of the subscription table
+			 *
+			 * @param subscription_table_version - Version of the subscription table the matches are computed for
+			 * @return Cleared match vector to fill
+			 */
+			util::Vector<std::shared_ptr<Subscription>> &ResetCachedMatches(uint32_t subscription_table_version);
+		};
+
+		/**
+		 * @brief Topic intern pool
+		 *
+		 * Maps topic names to InternedTopic handles with a single hash probe and without allocating for topics that
+		 * are already interned. Once the pool is full, interning a new topic evicts a single topic that was not looked
+		 * up recently, chosen with the CLOCK algorithm. Meant to be owned by the network read thread of one client, not
+		 * thread safe.
+		 */
+		class TopicInternPool {
+		protected:
+			util::Vector<std::shared_ptr<InternedTopic>> slots_;	///< Open addressing table, size is a power of 2
+			util::Vector<bool> referenced_slots_;					///< Slots looked up since the clock hand last passed
+			size_t topic_count_;									///< Number of interned topics
+			size_t max_topics_;										///< Topic count at which topics are evicted
+			size_t clock_hand_;										///< Next slot considered for eviction
+
+			/**
+			 * @brief Advance the clock hand to the next occupied slot that was not referenced since its last pass
+			 *
+			 * Must only be called while the pool holds at least one topic
+			 *
+			 * @return size_t - Index of the slot to evict
+			 */
+			size_t FindEvictionSlot();
+
+			/**
+			 * @brief Remove the topic in a slot, moving later entries of its probe sequence back
+			 *
+			 * @param slot_index - Index of an occupied slot
+			 */
+			void RemoveSlot(size_t slot_index);
+
+		public:
+			/**
+			 * @brief Constructor
+			 *
+			 * @param max_topics - Maximum number of interned topics
+			 */
+			TopicInternPool(size_t max_topics = MQTT_TOPIC_INTERN_POOL_MAX_TOPICS);
+
+			// Rule of 5 stuff
+			// Defaults for everything
+			TopicInternPool(const TopicInternPool &) = default;					// Copy constructor
+			TopicInternPool(TopicInternPool &&) = default;						// Move constructor
+			TopicInternPool &operator=(const TopicInternPool &) & = default;	// Copy assignment operator
+			TopicInternPool &operator=(TopicInternPool &&) & = default;			// Move assignment operator
+			~TopicInternPool() = default;										// Default destructor
+
+			/**
+			 * @brief Get the interned handle for a topic name, interning it if required
+			 *
+			 * Handles of evicted topics stay valid, interning the same topic name again returns a new handle.
+			 *
+			 * @param topic_name - Topic name
+			 * @return std::shared_ptr<InternedTopic> - Handle, never nullptr
+			 */
+			std::shared_ptr<InternedTopic> Intern(util::StringView topic_name);
+
+			/**
+			 * @brief Get the number of interned topics
+			 *
+			 * @return size_t - Number of topics
+			 */
+			size_t Size() const { return topic_count_; }
+
+			/**
+			 * @brief Remove all topics from the pool, handles held elsewhere stay valid
+			 */
+			void Clear();
+
+			/**
+			 * @brief Hash a topic name
+			 *
+			 * @param topic_name - Topic name
+			 * @return uint64_t - FNV-1a hash of the topic name
+			 */
+			static uint64_t Hash(util::StringView topic_name);
+		};
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file BufferLease.hpp
+ * @brief Owning reference to a region of a shared buffer
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "util/memory/stl/Vector.hpp"
+#include "util/StringView.hpp"
+
+namespace awsiotsdk {
+	namespace util {
+		/**
+		 * @brief Lease on a region of a shared buffer
+		 *
+		 * Keeps the underlying buffer alive for as long as the lease exists, so the view it provides remains valid
+		 * after the call in which it was obtained. The buffer is never modified while leased, the owner switches to
+		 * a new buffer instead. No data is copied to create a lease.
+		 */
+		class BufferLease {
+		protected:
+			std::shared_ptr<const util::Vector<unsigned char>> p_buffer_;	///< Buffer kept alive by this lease
+			StringView view_;												///< Leased region of the buffer
+
+		public:
+			/**
+			 * @brief Constructor, creates an empty lease
+			 */
+			BufferLease() { }
+
+			/**
+			 * @brief Constructor
+			 *
+			 * @param p_buffer - Buffer to keep alive
+			 * @param view - Region of p_buffer covered by this lease
+			 */
+			BufferLease(std::shared_ptr<const util::Vector<unsigned char>> p_buffer, StringView view)
+				: p_buffer_(std::move(p_buffer)), view_(view) { }
+
+			// Rule of 5 stuff
+			// Leases can be copied and moved, each copy keeps the buffer alive
+			BufferLease(const BufferLease &) = default;						// Copy constructor
+			BufferLease(BufferLease &&) = default;							// Move constructor
+			BufferLease &operator=(const BufferLease &) & = default;		// Copy assignment operator
+			BufferLease &operator=(BufferLease &&) & = default;				// Move assignment operator
+			~BufferLease() = default;										// Default destructor
+
+			/**
+			 * @brief Does this lease hold a buffer?
+			 *
+			 * @return true if the lease holds a buffer
+			 */
+			bool IsValid() const { return nullptr != p_buffer_; }
+
+			/**
+			 * @brief Get the leased region
+			 *
+			 * @return StringView valid for the lifetime of this lease
+			 */
+			StringView GetView() const { return view_; }
+
+			/**
+			 * @brief Release the buffer, the view is empty afterwards
+			 */
+			void Release() { p_buffer_ = nullptr; view_ = StringView(); }
+		};
+	}
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file OutputBuffer.hpp
+ * @brief Reusable buffer for serializing outbound data
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "util/memory/stl/String.hpp"
+#include "util/StringView.hpp"
+
+namespace awsiotsdk {
+	namespace util {
+		/**
+		 * @brief Growable byte buffer that keeps its memory when cleared
+		 *
+		 * Meant to be owned by a connection and reused for every outbound packet. Once the buffer has grown to the
+		 * size of the largest packet, serializing into it does not allocate. The bytes are stored in a util::String
+		 * so they can be handed to NetworkConnection::Write without a copy.
+		 */
+		class OutputBuffer {
+		protected:
+			util::String buf_;	///< Serialized bytes, capacity is kept across Clear()
+
+		public:
+			/**
+			 * @brief Constructor, creates an empty buffer
+			 */
+			OutputBuffer() { }
+
+			/**
+			 * @brief Constructor
+			 *
+			 * @param initial_capacity - Number of bytes to reserve up front
+			 */
+			explicit OutputBuffer(std::size_t initial_capacity) { buf_.reserve(initial_capacity); }
+
+			// Rule of 5 stuff
+			// Default for everything, copies allocate their own storage
+			OutputBuffer(const OutputBuffer &) = default;					// Copy constructor
+			OutputBuffer(OutputBuffer &&) = default;						// Move constructor
+			OutputBuffer &operator=(const OutputBuffer &) & = default;		// Copy assignment operator
+			OutputBuffer &operator=(OutputBuffer &&) & = default;			// Move assignment operator
+			~OutputBuffer() = default;										// Default destructor
+
+			/**
+			 * @brief Make sure the buffer can hold at least capacity bytes without growing
+			 *
+			 * @param capacity - Total number of bytes, including the ones already in the buffer
+			 */
+			void Reserve(std::size_t capacity) {
+				if(buf_.capacity() < capacity) {
+					buf_.reserve(capacity);
+				}
+			}
+
+			/**
+			 * @brief Remove all bytes, the allocated memory is kept for the next use
+			 */
+			void Clear() { buf_.clear(); }
+
+			void Append(const char *p_data, std::size_t length) { buf_.append(p_data, length); }
+			void Append(StringView data) { buf_.append(data.data(), data.length()); }
+			void AppendByte(unsigned char value) { buf_.push_back(static_cast<char>(value)); }
+
+			/**
+			 * @brief Append a 16 bit value in network byte order (MSB first)
+			 *
+			 * @param value - Value to append
+			 */
+			void AppendUInt16(uint16_t value) {
+				char bytes[2] = {static_cast<char>(value >> 8), static_cast<char>(value & 0xFF)};
+				buf_.append(bytes, 2);
+			}
+
+			std::size_t Size() const { return buf_.length(); }
+			std::size_t Capacity() const { return buf_.capacity(); }
+			bool IsEmpty() const { return buf_.empty(); }
+
+			/**
+			 * @brief Get the serialized bytes
+			 *
+			 * @return const util::String& - Valid until the buffer is modified
+			 */
+			const util::String &GetBuffer() const { return buf_; }
+
+			StringView GetView() const { return StringView(buf_); }
+
+			/**
+			 * @brief Move the serialized bytes out of the buffer, the buffer is empty and has no storage afterwards
+			 *
+			 * @return util::String containing the serialized bytes
+			 */
+			util::String Release() {
+				util::String released = std::move(buf_);
+				buf_ = util::String();
+				return released;
+			}
+		};
+	}
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file StringView.hpp
+ * @brief Non-owning view of a sequence of characters
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include "util/memory/stl/String.hpp"
+
+namespace awsiotsdk {
+	namespace util {
+		/**
+		 * @brief Non-owning view of a sequence of characters
+		 *
+		 * Refers to characters stored elsewhere without copying them. The view is only valid as long as the storage it
+		 * refers to. Use ToString() to create an owned copy.
+		 */
+		class StringView {
+		protected:
+			const char *p_data_;	///< First character of the view, nullptr for an empty view
+			std::size_t length_;	///< Number of characters in the view
+
+		public:
+			StringView() : p_data_(nullptr), length_(0) { }
+			StringView(const char *p_data, std::size_t length) : p_data_(p_data), length_(length) { }
+			StringView(const util::String &str) : p_data_(str.data()), length_(str.length()) { }
+
+			// Rule of 5 stuff
+			// Views are trivially copyable, defaults for everything
+			StringView(const StringView &) = default;					// Copy constructor
+			StringView(StringView &&) = default;						// Move constructor
+			StringView &operator=(const StringView &) & = default;		// Copy assignment operator
+			StringView &operator=(StringView &&) & = default;			// Move assignment operator
+			~StringView() = default;									// Default destructor
+
+			const char *data() const { return p_data_; }
+			std::size_t length() const { return length_; }
+			std::size_t size() const { return length_; }
+			bool empty() const { return 0 == length_; }
+
+			const char *begin() const { return p_data_; }
+			const char *end() const { return p_data_ + length_; }
+
+			char operator[](std::size_t index) const { return p_data_[index]; }
+
+			/**
+			 * @brief Create an owned copy of the viewed characters
+			 *
+			 * @return util::String copy
+			 */
+			util::String ToString() const { return (0 == length_) ? util::String() : util::String(p_data_, length_); }
+
+			bool operator==(const StringView &other) const {
+				return length_ == other.length_ && (0 == length_ || 0 == memcmp(p_data_, other.p_data_, length_));
+			}
+
+			bool operator!=(const StringView &other) const { return !(*this == other); }
+		};
+	}
+}
@@ -55,5 +55,12 @@ namespace awsiotsdk {
 		std::size_t Length();
 
 		util::String ToStdString();
+
+		/**
+		 * @brief Get the encoded bytes without copying them
+		 *
+		 * @return const util::String& - Valid for the lifetime of this Utf8String
+		 */
+		const util::String &GetData() const;
 	};
 }
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file MemoryResource.hpp
+ * @brief Memory resource interface and the allocator used to route container allocations to it
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+
+#include "util/Core_EXPORTS.hpp"
+
+namespace awsiotsdk {
+	namespace util {
+		namespace memory {
+			/**
+			 * @brief Memory Resource
+			 *
+			 * Source of memory for ResourceAllocator, implement this interface to place SDK allocations in an arena,
+			 * a bounded pool or thread-local pools. Modeled after std::pmr::memory_resource, which is not available in
+			 * C++11. Resources must be thread safe, containers can be created and destroyed on different threads.
+			 * The SDK is built without exceptions, so a resource must not return nullptr. It should abort when it is
+			 * exhausted, ResourceAllocator aborts if it does not.
+			 */
+			class AWS_API_EXPORT MemoryResource {
+			protected:
+				static std::atomic<MemoryResource *> p_default_resource_;	///< Default resource, nullptr for the new/delete resource
+
+				virtual void *DoAllocate(std::size_t bytes, std::size_t alignment) = 0;
+				virtual void DoDeallocate(void *p, std::size_t bytes, std::size_t alignment) = 0;
+				virtual bool DoIsEqual(const MemoryResource &other) const = 0;
+
+			public:
+				MemoryResource() { }
+
+				// Rule of 5 stuff
+				// Resources are referenced by pointer from allocators, disable copying
+				MemoryResource(const MemoryResource &) = delete;					// Delete Copy constructor
+				MemoryResource(MemoryResource &&) = delete;							// Delete Move constructor
+				MemoryResource &operator=(const MemoryResource &) & = delete;		// Delete Copy assignment operator
+				MemoryResource &operator=(MemoryResource &&) & = delete;			// Delete Move assignment operator
+				virtual ~MemoryResource() { }										// Virtual destructor
+
+				/**
+				 * @brief Allocate memory
+				 *
+				 * @param bytes - Size of the allocation
+				 * @param alignment - Required alignment
+				 * @return Pointer to the allocated memory, never nullptr. Abort if the resource is exhausted
+				 */
+				void *Allocate(std::size_t bytes, std::size_t alignment) { return DoAllocate(bytes, alignment); }
+
+				/**
+				 * @brief Free memory obtained from Allocate
+				 *
+				 * @param p - Memory to free
+				 * @param bytes - Size passed to Allocate
+				 * @param alignment - Alignment passed to Allocate
+				 */
+				void Deallocate(void *p, std::size_t bytes, std::size_t alignment) { DoDeallocate(p, bytes, alignment); }
+
+				/**
+				 * @brief Can memory allocated from this resource be freed by the other resource and the other way around?
+				 *
+				 * @param other - Resource to compare with
+				 * @return true if the resources are interchangeable
+				 */
+				bool IsEqual(const MemoryResource &other) const { return this == &other || DoIsEqual(other); }
+
+				/**
+				 * @brief Get the resource that uses the global operator new and operator delete
+				 *
+				 * @return Resource, never nullptr
+				 */
+				static MemoryResource *GetNewDeleteResource();
+
+				/**
+				 * @brief Get the resource used by default constructed ResourceAllocator instances
+				 *
+				 * This is the default resource of the calling thread if one is set, the process wide default otherwise
+				 *
+				 * @return Resource, never nullptr
+				 */
+				static MemoryResource *GetDefaultResource();
+
+				/**
+				 * @brief Get the default resource of the calling thread
+				 *
+				 * @return Resource, nullptr if the thread uses the process wide default
+				 */
+				static MemoryResource *GetThreadDefaultResource();
+
+				/**
+				 * @brief Replace the default resource of the calling thread
+				 *
+				 * Takes precedence over the process wide default on this thread only, so clients can use separate
+				 * resources. Clients created with a resource set it on their own threads, see ThreadResourceScope for
+				 * application threads.
+				 *
+				 * @param p_resource - New default resource, nullptr to use the process wide default
+				 * @return Previous default resource of the thread, nullptr if it used the process wide default
+				 */
+				static MemoryResource *SetThreadDefaultResource(MemoryResource *p_resource);
+
+				/**
+				 * @brief Replace the resource used by default constructed ResourceAllocator instances
+				 *
+				 * Containers keep the resource they were created with, so the resource must outlive every container
+				 * created while it was the default. Set it before creating any client. To give each client its own
+				 * resource, pass it to MqttClient::Create instead.
+				 *
+				 * @param p_resource - New default resource, nullptr to restore the new/delete resource
+				 * @return Previous default resource
+				 */
+				static MemoryResource *SetDefaultResource(MemoryResource *p_resource);
+			};
+
+			/**
+			 * @brief Thread Resource Scope
+			 *
+			 * Sets the default resource of the calling thread for the lifetime of the instance and restores the
+			 * previous one when destroyed. Does nothing if created with nullptr.
+			 */
+			class ThreadResourceScope {
+			protected:
+				MemoryResource *p_previous_resource_;	///< Default resource of the thread before this scope
+				bool is_set_;							///< Was a resource set by this scope?
+
+			public:
+				/**
+				 * @brief Constructor
+				 *
+				 * @param p_resource - Default resource for the calling thread, nullptr to keep the current one
+				 */
+				explicit ThreadResourceScope(MemoryResource *p_resource)
+					: p_previous_resource_(nullptr), is_set_(nullptr != p_resource) {
+					if(is_set_) {
+						p_previous_resource_ = MemoryResource::SetThreadDefaultResource(p_resource);
+					}
+				}
+
+				// Rule of 5 stuff
+				// Scopes restore state of the thread that created them, disable copying and moving
+				ThreadResourceScope(const ThreadResourceScope &) = delete;						// Delete Copy constructor
+				ThreadResourceScope(ThreadResourceScope &&) = delete;							// Delete Move constructor
+				ThreadResourceScope &operator=(const ThreadResourceScope &) & = delete;		// Delete Copy assignment operator
+				ThreadResourceScope &operator=(ThreadResourceScope &&) & = delete;			// Delete Move assignment operator
+				~ThreadResourceScope() {
+					if(is_set_) {
+						MemoryResource::SetThreadDefaultResource(p_previous_resource_);
+					}
+				}
+			};
+
+			/**
+			 * @brief Resource Allocator
+			 *
+			 * Allocator that forwards to a MemoryResource. The resource is chosen when the allocator is created and is
+			 * kept by copies, so a container always frees memory through the resource it allocated it from.
+			 * Define AWS_IOT_SDK_STL_ALLOCATOR as awsiotsdk::util::memory::ResourceAllocator to use it for all the
+			 * util::memory::stl aliases.
+			 *
+			 * @tparam T Value type
+			 */
+			template<typename T>
+			class ResourceAllocator {
+			protected:
+				MemoryResource *p_resource_;	///< Resource allocations are forwarded to
+
+			public:
+				typedef T value_type;
+
+				/**
+				 * @brief Constructor, uses the current default resource
+				 */
+				ResourceAllocator() : p_resource_(MemoryResource::GetDefaultResource()) { }
+
+				/**
+				 * @brief Constructor
+				 *
+				 * @param p_resource - Resource to forward allocations to, must not be nullptr
+				 */
+				ResourceAllocator(MemoryResource *p_resource) : p_resource_(p_resource) { }
+
+				template<typename U>
+				ResourceAllocator(const ResourceAllocator<U> &other) : p_resource_(other.GetResource()) { }
+
+				T *allocate(std::size_t n) {
+					void *p = p_resource_->Allocate(n * sizeof(T), alignof(T));
+					if(nullptr == p) {
+						// Containers can not be told about the failure without exceptions
+						std::abort();
+					}
+					return static_cast<T *>(p);
+				}
+
+				void deallocate(T *p, std::size_t n) {
+					p_resource_->Deallocate(p, n * sizeof(T), alignof(T));
+				}
+
+				MemoryResource *GetResource() const { return p_resource_; }
+			};
+
+			template<typename T, typename U>
+			bool operator==(const ResourceAllocator<T> &lhs, const ResourceAllocator<U> &rhs) {
+				return lhs.GetResource()->IsEqual(*rhs.GetResource());
+			}
+
+			template<typename T, typename U>
+			bool operator!=(const ResourceAllocator<T> &lhs, const ResourceAllocator<U> &rhs) {
+				return !(lhs == rhs);
+			}
+		}
+	}
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PoolAllocator.hpp
+ * @brief Allocator that recycles fixed size blocks through a lock-free free list
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "util/threading/LockFreeQueue.hpp"
+
+/**
+ * Maximum number of freed blocks kept for reuse by each PoolAllocator value type. Blocks freed while the free list is
+ * full are returned to the heap
+ */
+#ifndef POOL_ALLOCATOR_MAX_FREE_BLOCKS
+#define POOL_ALLOCATOR_MAX_FREE_BLOCKS 256
+#endif
+
+namespace awsiotsdk {
+	namespace util {
+		namespace memory {
+			/**
+			 * @brief Pool Allocator
+			 *
+			 * Single object allocations are served from a free list of blocks previously freed through an allocator
+			 * of the same value type, and only go to the heap when the free list is empty. The free list is a bounded
+			 * lock-free queue shared by all instances for a value type, so blocks can be allocated and freed from
+			 * any thread. Intended for std::allocate_shared, which allocates the object and its control block as a
+			 * single block of a fixed size. Array allocations always go to the heap.
+			 *
+			 * @tparam T Value type
+			 */
+			template<typename T>
+			class PoolAllocator {
+			protected:
+				/**
+				 * @brief Get the free list for this value type
+				 *
+				 * Never destroyed, so blocks can still be freed while static objects are being destroyed
+				 *
+				 * @return Free list of blocks
+				 */
+				static util::Threading::LockFreeQueue<void *> &GetFreeList() {
+					static util::Threading::LockFreeQueue<void *> *p_free_list
+						= new util::Threading::LockFreeQueue<void *>(POOL_ALLOCATOR_MAX_FREE_BLOCKS);
+					return *p_free_list;
+				}
+
+			public:
+				typedef T value_type;
+
+				PoolAllocator() { }
+				template<typename U>
+				PoolAllocator(const PoolAllocator<U> &) { }
+
+				/**
+				 * @brief Allocate storage for n objects
+				 *
+				 * @param n - Number of objects
+				 * @return Pointer to uninitialized storage
+				 */
+				T *allocate(std::size_t n) {
+					void *p_block = nullptr;
+					if(1 == n && GetFreeList().TryDequeue(p_block)) {
+						return static_cast<T *>(p_block);
+					}
+					return static_cast<T *>(::operator new(n * sizeof(T)));
+				}
+
+				/**
+				 * @brief Free storage obtained from allocate
+				 *
+				 * @param p - Storage to free
+				 * @param n - Number of objects p was allocated for
+				 */
+				void deallocate(T *p, std::size_t n) {
+					void *p_block = p;
+					if(1 != n || !GetFreeList().TryEnqueue(p_block)) {
+						::operator delete(p_block);
+					}
+				}
+			};
+
+			template<typename T, typename U>
+			bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &) { return true; }
+
+			template<typename T, typename U>
+			bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &) { return false; }
+		}
+	}
+}
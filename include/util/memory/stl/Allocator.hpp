@@ -0,0 +1,43 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file Allocator.hpp
+ * @brief Allocator used by the util::memory::stl container aliases
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "util/Core_EXPORTS.hpp"
+#include "util/memory/MemoryResource.hpp"
+
+/**
+ * Allocator template used by all util::memory::stl aliases. The default, std::allocator, makes the aliases the plain
+ * std types. Define as awsiotsdk::util::memory::ResourceAllocator, or any other allocator template, to route the
+ * container allocations of the SDK elsewhere. The SDK, the network layer and the application must be built with the
+ * same value
+ */
+#ifndef AWS_IOT_SDK_STL_ALLOCATOR
+#define AWS_IOT_SDK_STL_ALLOCATOR std::allocator
+#endif
+
+namespace awsiotsdk {
+	namespace util {
+		template<typename T> using Allocator = AWS_IOT_SDK_STL_ALLOCATOR<T>;
+	} // namespace util
+} // namespace awsiotsdk
@@ -21,10 +21,13 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 
+#include "util/memory/stl/Allocator.hpp"
+
 namespace awsiotsdk {
 	namespace util {
-		template<typename K, typename V> using Map = std::map<K, V>;
+		template<typename K, typename V> using Map = std::map<K, V, std::less<K>, Allocator<std::pair<const K, V>>>;
 	} // namespace util
 } // namespace awsiotsdk
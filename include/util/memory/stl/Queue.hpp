@@ -23,12 +23,13 @@
 #pragma once
 
 #include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/Allocator.hpp"
 
 #include <deque>
 #include <queue>
 
 namespace awsiotsdk {
 	namespace util {
-		template<typename T> using Queue = std::queue<T>;
+		template<typename T> using Queue = std::queue<T, std::deque<T, Allocator<T>>>;
 	} // namespace util
 } // namespace awsiotsdk
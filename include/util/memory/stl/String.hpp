@@ -22,15 +22,30 @@
 #pragma once
 
 #include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/Allocator.hpp"
 #include <functional>
 #include <string>
 
 namespace awsiotsdk {
 	namespace util {
-		using String = std::basic_string<char, std::char_traits<char>>;
+		using String = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
+
+		/**
+		 * @brief Convert a numeric value to a String
+		 *
+		 * Same as std::to_string, which always returns a std::string, for use when String has a different allocator
+		 *
+		 * @param value - Value to convert
+		 * @return String containing the decimal representation of value
+		 */
+		template<typename T>
+		String ToString(T value) {
+			std::string str = std::to_string(value);
+			return String(str.data(), str.length());
+		}
 
 #ifdef _WIN32
-		using WString = std::basic_string<wchar_t, std::char_traits<wchar_t>>;
+		using WString = std::basic_string<wchar_t, std::char_traits<wchar_t>, Allocator<wchar_t>>;
 #endif
 	} // namespace util
 } // namespace awsiotsdk
@@ -22,14 +22,15 @@
 #pragma once
 
 #include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/Allocator.hpp"
 
 #include <sstream>
 
 namespace awsiotsdk {
 	namespace util {
-		typedef std::basic_stringstream<char, std::char_traits<char> > StringStream;
-		typedef std::basic_istringstream<char, std::char_traits<char> > IStringStream;
-		typedef std::basic_ostringstream<char, std::char_traits<char> > OStringStream;
-		typedef std::basic_stringbuf<char, std::char_traits<char> > StringBuf;
+		typedef std::basic_stringstream<char, std::char_traits<char>, Allocator<char> > StringStream;
+		typedef std::basic_istringstream<char, std::char_traits<char>, Allocator<char> > IStringStream;
+		typedef std::basic_ostringstream<char, std::char_traits<char>, Allocator<char> > OStringStream;
+		typedef std::basic_stringbuf<char, std::char_traits<char>, Allocator<char> > StringBuf;
 	} // namespace util
 } // namespace awsiotsdk
@@ -22,10 +22,11 @@
 #pragma once
 
 #include "util/Core_EXPORTS.hpp"
+#include "util/memory/stl/Allocator.hpp"
 #include <vector>
 
 namespace awsiotsdk {
 	namespace util {
-		template<typename T> using Vector = std::vector<T>;
+		template<typename T> using Vector = std::vector<T, Allocator<T>>;
 	} // namespace util
 } // namespace awsiotsdk
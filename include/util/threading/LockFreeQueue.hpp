@@ -0,0 +1,176 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file LockFreeQueue.hpp
+ * @brief Bounded lock-free queue used to pass data between threads
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace awsiotsdk {
+	namespace util {
+		namespace Threading {
+			/**
+			 * @brief Bounded Lock-free Queue
+			 *
+			 * Fixed capacity ring buffer that can be used by any number of producer and consumer threads without locks.
+			 * Each cell carries a sequence number which tells producers and consumers whether the cell is ready to be
+			 * written or read for the current position, so a thread only ever contends on the position counters.
+			 * Capacity is rounded up to the next power of two and storage is allocated once, in the constructor.
+			 *
+			 * @tparam T Element type, must be default constructible and move assignable
+			 */
+			template<typename T>
+			class LockFreeQueue {
+			private:
+				/**
+				 * @brief Ring buffer cell
+				 */
+				struct Cell {
+					std::atomic_size_t sequence_;	///< Position for which this cell is ready to be written or read
+					T data_;						///< Stored element
+				};
+
+				// Keep the producer and consumer positions on separate cache lines
+				static const size_t CACHE_LINE_SIZE = 64;
+
+				std::unique_ptr<Cell[]> p_cells_;	///< Ring buffer storage
+				size_t mask_;						///< Capacity - 1, used to map positions to cells
+				char pad_0_[CACHE_LINE_SIZE];
+				std::atomic_size_t enqueue_pos_;	///< Next position to be written by a producer
+				char pad_1_[CACHE_LINE_SIZE];
+				std::atomic_size_t dequeue_pos_;	///< Next position to be read by a consumer
+				char pad_2_[CACHE_LINE_SIZE];
+
+			public:
+				/**
+				 * @brief Constructor
+				 *
+				 * @param capacity - Minimum number of elements the queue should be able to hold, rounded up to a power of two
+				 */
+				explicit LockFreeQueue(size_t capacity) {
+					size_t rounded_capacity = 2;
+					while(rounded_capacity < capacity) {
+						rounded_capacity <<= 1;
+					}
+					p_cells_ = std::unique_ptr<Cell[]>(new Cell[rounded_capacity]);
+					mask_ = rounded_capacity - 1;
+					for(size_t itr = 0; itr < rounded_capacity; itr++) {
+						p_cells_[itr].sequence_.store(itr, std::memory_order_relaxed);
+					}
+					enqueue_pos_.store(0, std::memory_order_relaxed);
+					dequeue_pos_.store(0, std::memory_order_relaxed);
+				}
+
+				// Rule of 5 stuff
+				// Contains atomic positions shared between threads, should not be moved or copied
+				LockFreeQueue() = delete;											// Delete Default constructor
+				LockFreeQueue(const LockFreeQueue &) = delete;						// Delete Copy constructor
+				LockFreeQueue(LockFreeQueue &&) = delete;							// Delete Move constructor
+				LockFreeQueue &operator=(const LockFreeQueue &) & = delete;			// Delete Copy assignment operator
+				LockFreeQueue &operator=(LockFreeQueue &&) & = delete;				// Delete Move assignment operator
+				~LockFreeQueue() { }
+
+				/**
+				 * @brief Get the capacity of the queue
+				 * @return size_t Capacity
+				 */
+				size_t Capacity() const { return mask_ + 1; }
+
+				/**
+				 * @brief Enqueue an element
+				 *
+				 * @param data - Element to move into the queue. Left untouched if the queue is full
+				 * @return true if the element was enqueued, false if the queue is full
+				 */
+				bool TryEnqueue(T &data) {
+					Cell *p_cell = nullptr;
+					size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+					for(;;) {
+						p_cell = &p_cells_[pos & mask_];
+						size_t sequence = p_cell->sequence_.load(std::memory_order_acquire);
+						intptr_t diff = (intptr_t) sequence - (intptr_t) pos;
+						if(0 == diff) {
+							if(enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+								break;
+							}
+						} else if(0 > diff) {
+							// Cell still holds an element from the previous lap
+							return false;
+						} else {
+							pos = enqueue_pos_.load(std::memory_order_relaxed);
+						}
+					}
+
+					p_cell->data_ = std::move(data);
+					p_cell->sequence_.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+
+				/**
+				 * @brief Dequeue the oldest element
+				 *
+				 * @param data[out] - Dequeued element
+				 * @return true if an element was dequeued, false if no element is ready
+				 */
+				bool TryDequeue(T &data) {
+					Cell *p_cell = nullptr;
+					size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+					for(;;) {
+						p_cell = &p_cells_[pos & mask_];
+						size_t sequence = p_cell->sequence_.load(std::memory_order_acquire);
+						intptr_t diff = (intptr_t) sequence - (intptr_t) (pos + 1);
+						if(0 == diff) {
+							if(dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+								break;
+							}
+						} else if(0 > diff) {
+							// Cell has not been written for this position yet
+							return false;
+						} else {
+							pos = dequeue_pos_.load(std::memory_order_relaxed);
+						}
+					}
+
+					data = std::move(p_cell->data_);
+					// Release references held by the moved from element before the cell is reused
+					p_cell->data_ = T();
+					p_cell->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+					return true;
+				}
+
+				/**
+				 * @brief Check whether an element is ready to be dequeued
+				 *
+				 * The result is only a snapshot when other threads are using the queue concurrently
+				 *
+				 * @return true if no element is ready to be dequeued
+				 */
+				bool IsEmpty() const {
+					size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+					return p_cells_[pos & mask_].sequence_.load(std::memory_order_acquire) != pos + 1;
+				}
+			};
+		}
+	}
+}
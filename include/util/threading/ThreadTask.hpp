@@ -26,6 +26,7 @@
 #include <atomic>
 
 #include "util/Core_EXPORTS.hpp"
+#include "util/memory/MemoryResource.hpp"
 
 #include "NetworkConnection.hpp"
 #include "Action.hpp"
@@ -42,6 +43,9 @@ namespace awsiotsdk {
 			public:
 				ThreadTask(DestructorAction destructor_action, std::shared_ptr<std::atomic_bool> sync_point,
 						   util::String thread_descriptor);
+				// The memory resource is set as the default resource of the thread, nullptr for the process default
+				ThreadTask(DestructorAction destructor_action, std::shared_ptr<std::atomic_bool> sync_point,
+						   util::String thread_descriptor, util::memory::MemoryResource *p_memory_resource);
 				~ThreadTask();
 
 				// Rule of 5 stuff.
@@ -53,12 +57,20 @@ namespace awsiotsdk {
 
 				template<class Fn, class ... Args>
 				void Run(Fn&& fn, Args&& ... args) {
-					m_thread_ = std::thread(std::bind(std::forward<Fn>(fn), std::forward<Args>(args)...));
+					auto task = std::bind(std::forward<Fn>(fn), std::forward<Args>(args)...);
+					m_thread_ = std::thread(&ThreadTask::RunTask<decltype(task)>, p_memory_resource_, std::move(task));
 				}
 
 				void Stop();
 			private:
+				template<class Task>
+				static void RunTask(util::memory::MemoryResource *p_memory_resource, Task task) {
+					util::memory::ThreadResourceScope resource_scope(p_memory_resource);
+					task();
+				}
+
 				DestructorAction destructor_action_;
+				util::memory::MemoryResource *p_memory_resource_;
 				std::shared_ptr<std::atomic_bool> m_continue_;
 				std::thread m_thread_;
 				util::String thread_descriptor_;
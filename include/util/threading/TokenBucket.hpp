@@ -0,0 +1,96 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TokenBucket.hpp
+ * @brief Token bucket used to limit the rate of operations
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "util/Core_EXPORTS.hpp"
+
+namespace awsiotsdk {
+	namespace util {
+		namespace Threading {
+			/**
+			 * @brief Token Bucket
+			 *
+			 * Allows up to burst_size operations back to back and refills at rate_per_sec tokens per second after that.
+			 * The bucket starts full. Not thread safe, callers sharing a bucket across threads must synchronize access.
+			 */
+			class AWS_API_EXPORT TokenBucket {
+			protected:
+				double rate_per_sec_;										///< Tokens added per second
+				double burst_size_;											///< Maximum number of tokens the bucket can hold
+				double available_tokens_;									///< Currently available tokens
+				std::chrono::steady_clock::time_point last_refill_time_;	///< Time at which tokens were last added
+
+				/**
+				 * @brief Add tokens for the time elapsed since the last refill
+				 *
+				 * @param now - Current time
+				 */
+				void Refill(std::chrono::steady_clock::time_point now);
+
+			public:
+				/**
+				 * @brief Constructor
+				 *
+				 * @param rate_per_sec - Sustained rate in operations per second, must be greater than 0
+				 * @param burst_size - Number of operations allowed back to back, values less than 1 are treated as 1
+				 */
+				TokenBucket(uint32_t rate_per_sec, uint32_t burst_size);
+
+				/**
+				 * @brief Change rate and burst size, currently available tokens are capped to the new burst size
+				 *
+				 * @param rate_per_sec - Sustained rate in operations per second, must be greater than 0
+				 * @param burst_size - Number of operations allowed back to back, values less than 1 are treated as 1
+				 */
+				void Configure(uint32_t rate_per_sec, uint32_t burst_size);
+
+				uint32_t GetRate() { return static_cast<uint32_t>(rate_per_sec_); }
+				uint32_t GetBurstSize() { return static_cast<uint32_t>(burst_size_); }
+
+				/**
+				 * @brief Take tokens if available
+				 *
+				 * Requests for more tokens than the burst size wait for a full bucket and leave it in debt, so that the
+				 * sustained rate still holds
+				 *
+				 * @param now - Current time
+				 * @param token_count - Number of tokens to take
+				 * @return true if the tokens were taken, false if the operation has to wait
+				 */
+				bool TryConsume(std::chrono::steady_clock::time_point now, uint32_t token_count = 1);
+
+				/**
+				 * @brief Get time after which the requested number of tokens will be available
+				 *
+				 * @param now - Current time
+				 * @param token_count - Number of tokens that will be requested
+				 * @return std::chrono::steady_clock::time_point Time at which TryConsume will succeed
+				 */
+				std::chrono::steady_clock::time_point GetNextAvailableTime(std::chrono::steady_clock::time_point now,
+																		   uint32_t token_count = 1);
+			};
+		}
+	}
+}
@@ -55,6 +55,10 @@ namespace awsiotsdk {
 			return true;
 		}
 
+		int MbedTLSConnection::GetSocketDescriptor() {
+			return server_fd_.fd;
+		}
+
 		bool MbedTLSConnection::IsConnected() {
 			return is_connected_;
 		}
@@ -230,10 +234,41 @@ namespace awsiotsdk {
 		}
 
 		ResponseCode MbedTLSConnection::WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+			return WriteBytes((const unsigned char *)(buf.c_str()), buf.length(), size_written_bytes_out);
+		}
+
+		ResponseCode MbedTLSConnection::WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+													   size_t &size_written_bytes_out) {
+			if(1 < segment_count && NETWORK_WRITEV_COALESCE_MAX_BYTES >= GetSegmentsLength(p_segments, segment_count)) {
+				// One record costs less than encrypting and framing each small segment separately
+				const util::String &joined_buf = JoinSegments(p_segments, segment_count);
+				return WriteBytes((const unsigned char *)(joined_buf.c_str()), joined_buf.length(), size_written_bytes_out);
+			}
+
+			ResponseCode rc = ResponseCode::SUCCESS;
+			size_t total_written_length = 0;
+			for(size_t itr = 0; itr < segment_count && ResponseCode::SUCCESS == rc; itr++) {
+				if(p_segments[itr].empty()) {
+					continue;
+				}
+				size_t cur_written_length = 0;
+				rc = WriteBytes((const unsigned char *)(p_segments[itr].data()), p_segments[itr].length(),
+								cur_written_length);
+				total_written_length += cur_written_length;
+				if(cur_written_length != p_segments[itr].length()) {
+					// Caller resumes from the reported byte count
+					break;
+				}
+			}
+
+			size_written_bytes_out = total_written_length;
+			return rc;
+		}
+
+		ResponseCode MbedTLSConnection::WriteBytes(const unsigned char *buf_cstr, size_t bytes_to_write,
+												   size_t &size_written_bytes_out) {
 			size_t total_written_length = 0;
 			ResponseCode rc = ResponseCode::SUCCESS;
-			size_t bytes_to_write = buf.length();
-			const unsigned char *buf_cstr = (const unsigned char *)(buf.c_str());
 			bool isErrorFlag = false;
 			int ret;
 
@@ -278,23 +313,64 @@ namespace awsiotsdk {
 					buf_read_offset += ret;
 					total_read_length += ret;
 					remaining_bytes_to_read -= ret;
-					size_read_bytes_out = total_read_length;
+					// Return what is available instead of waiting for the rest of the requested bytes
+					if(0 == mbedtls_ssl_get_bytes_avail(&ssl_)) {
+						break;
+					}
 				} else if(ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE && ret != MBEDTLS_ERR_SSL_TIMEOUT) {
 					return ResponseCode::NETWORK_SSL_READ_ERROR;
 				}
-			} while(remaining_bytes_to_read > 0 && timeout < std::chrono::system_clock::now());
+			} while(remaining_bytes_to_read > 0 && std::chrono::system_clock::now() < timeout);
 
 			if(0 == total_read_length) {
 				return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
-			} else if(size_read_bytes_out == size_bytes_to_read) {
+			}
+
+			size_read_bytes_out = total_read_length;
+			return ResponseCode::SUCCESS;
+		}
+
+		int MbedTLSConnection::PollSocket(short events, std::chrono::milliseconds timeout) {
+#ifdef WIN32
+			WSAPOLLFD poll_fd;
+			poll_fd.fd = server_fd_.fd;
+			poll_fd.events = events;
+			poll_fd.revents = 0;
+			return WSAPoll(&poll_fd, 1, static_cast<int>(timeout.count()));
+#else
+			struct pollfd poll_fd;
+			poll_fd.fd = server_fd_.fd;
+			poll_fd.events = events;
+			poll_fd.revents = 0;
+			return poll(&poll_fd, 1, static_cast<int>(timeout.count()));
+#endif
+		}
+
+		ResponseCode MbedTLSConnection::WaitForReadableInternal(std::chrono::milliseconds timeout) {
+			// Records that were already decrypted are not visible on the socket
+			if(0 < mbedtls_ssl_get_bytes_avail(&ssl_)) {
 				return ResponseCode::SUCCESS;
-			} else if(0 < total_read_length) {
-				return ResponseCode::NETWORK_SSL_READ_TIMEOUT_ERROR;
 			}
 
+			int ret = PollSocket(POLLIN, timeout);
+			if(0 < ret) {
+				return ResponseCode::SUCCESS;
+			} else if(0 == ret) {
+				return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+			}
 			return ResponseCode::NETWORK_SSL_READ_ERROR;
 		}
 
+		ResponseCode MbedTLSConnection::WaitForWritableInternal(std::chrono::milliseconds timeout) {
+			int ret = PollSocket(POLLOUT, timeout);
+			if(0 < ret) {
+				return ResponseCode::SUCCESS;
+			} else if(0 == ret) {
+				return ResponseCode::NETWORK_SSL_WRITE_TIMEOUT_ERROR;
+			}
+			return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+		}
+
 		ResponseCode MbedTLSConnection::DisconnectInternal() {
 			int ret = 0;
 			do {
@@ -20,6 +20,12 @@
 
 #pragma once
 
+#ifdef WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
 #include "mbedtls/config.h"
 
 #include "mbedtls/platform.h"
@@ -86,6 +92,29 @@ namespace awsiotsdk {
 			 */
 			ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out);
 
+			/**
+			 * @brief Write a list of buffer segments to the network socket
+			 *
+			 * Small writes are joined and sent as one TLS record, larger ones are encrypted directly from each segment
+			 *
+			 * @param const util::StringView * - segments to write, in order
+			 * @param size_t - number of segments
+			 * @param size_t - reference to store number of bytes written
+			 * @return ResponseCode - successful write or Network error code
+			 */
+			ResponseCode WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+										size_t &size_written_bytes_out);
+
+			/**
+			 * @brief Write bytes from a caller provided buffer to the network socket
+			 *
+			 * @param const unsigned char * - bytes to write
+			 * @param size_t - number of bytes to write
+			 * @param size_t - reference to store number of bytes written
+			 * @return ResponseCode - successful write or Network error code
+			 */
+			ResponseCode WriteBytes(const unsigned char *buf_cstr, size_t bytes_to_write, size_t &size_written_bytes_out);
+
 			/**
 			 * @brief Read bytes from the network socket
 			 *
@@ -104,6 +133,31 @@ namespace awsiotsdk {
 			 */
 			ResponseCode DisconnectInternal();
 
+			/**
+			 * @brief Poll the socket for the requested events
+			 *
+			 * @param events - Events to wait for, POLLIN or POLLOUT
+			 * @param timeout - Max time to wait
+			 * @return int - Positive if ready, 0 on timeout, negative on error
+			 */
+			int PollSocket(short events, std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Wait until data can be read from the network socket
+			 *
+			 * @param std::chrono::milliseconds - max time to wait
+			 * @return ResponseCode - SUCCESS if data is available, NETWORK_SSL_NOTHING_TO_READ on timeout or TLS error code
+			 */
+			ResponseCode WaitForReadableInternal(std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Wait until data can be written to the network socket
+			 *
+			 * @param std::chrono::milliseconds - max time to wait
+			 * @return ResponseCode - SUCCESS if data can be written, NETWORK_SSL_WRITE_TIMEOUT_ERROR on timeout or TLS error code
+			 */
+			ResponseCode WaitForWritableInternal(std::chrono::milliseconds timeout);
+
 		public:
 			static int VerifyCertificate(void *data, mbedtls_x509_crt *crt, int depth, uint32_t *flags);
 
@@ -147,6 +201,13 @@ namespace awsiotsdk {
 			 */
 			bool IsPhysicalLayerConnected();
 
+			/**
+			 * @brief Get the OS socket descriptor used by this connection
+			 *
+			 * @return int - Socket descriptor, only valid while connected
+			 */
+			int GetSocketDescriptor();
+
 			virtual ~MbedTLSConnection();
 		};
 	}
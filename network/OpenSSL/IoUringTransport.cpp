@@ -0,0 +1,498 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file IoUringTransport.cpp
+ * @brief
+ *
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "IoUringTransport.hpp"
+#include "util/logging/LogMacros.hpp"
+
+#define IO_URING_TRANSPORT_LOG_TAG "[io_uring Transport]"
+
+#define IO_URING_RECEIVE_QUEUE_DEPTH 2
+#define IO_URING_SEND_QUEUE_DEPTH 2
+
+#define IO_URING_USER_DATA_RECEIVE 1
+#define IO_URING_USER_DATA_SEND 2
+
+namespace awsiotsdk {
+	namespace network {
+#ifdef AWS_IOT_IO_URING_SUPPORTED
+		IoUringRing::IoUringRing() {
+			ring_fd_ = -1;
+			p_sq_ring_ = MAP_FAILED;
+			sq_ring_size_ = 0;
+			p_cq_ring_ = MAP_FAILED;
+			cq_ring_size_ = 0;
+			p_sqes_ = static_cast<struct io_uring_sqe *>(MAP_FAILED);
+			sqes_size_ = 0;
+			sq_tail_ = 0;
+			pending_submit_count_ = 0;
+		}
+
+		ResponseCode IoUringRing::Initialize(unsigned queue_depth) {
+			struct io_uring_params params;
+			memset(&params, 0, sizeof(params));
+
+			ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, queue_depth, &params));
+			if(0 > ring_fd_) {
+				AWS_LOG_WARN(IO_URING_TRANSPORT_LOG_TAG, "io_uring_setup - %s", strerror(errno));
+				return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+			}
+
+			// Timed waits need IORING_ENTER_EXT_ARG, added in Linux 5.11
+			if(0 == (params.features & IORING_FEAT_EXT_ARG)) {
+				AWS_LOG_WARN(IO_URING_TRANSPORT_LOG_TAG, "Kernel does not support timed io_uring waits");
+				return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+			}
+
+			sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+			bool is_single_mmap = (0 != (params.features & IORING_FEAT_SINGLE_MMAP));
+			if(is_single_mmap && cq_ring_size_ > sq_ring_size_) {
+				sq_ring_size_ = cq_ring_size_;
+			}
+
+			p_sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+							  ring_fd_, IORING_OFF_SQ_RING);
+			if(MAP_FAILED == p_sq_ring_) {
+				return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+			}
+
+			if(is_single_mmap) {
+				p_cq_ring_ = p_sq_ring_;
+				cq_ring_size_ = 0;
+			} else {
+				p_cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+								  ring_fd_, IORING_OFF_CQ_RING);
+				if(MAP_FAILED == p_cq_ring_) {
+					return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+				}
+			}
+
+			sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+			p_sqes_ = static_cast<struct io_uring_sqe *>(mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+															  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES));
+			if(MAP_FAILED == p_sqes_) {
+				return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+			}
+
+			unsigned char *p_sq = static_cast<unsigned char *>(p_sq_ring_);
+			p_sq_head_ = reinterpret_cast<unsigned *>(p_sq + params.sq_off.head);
+			p_sq_tail_ = reinterpret_cast<unsigned *>(p_sq + params.sq_off.tail);
+			p_sq_ring_mask_ = reinterpret_cast<unsigned *>(p_sq + params.sq_off.ring_mask);
+			p_sq_ring_entries_ = reinterpret_cast<unsigned *>(p_sq + params.sq_off.ring_entries);
+			p_sq_array_ = reinterpret_cast<unsigned *>(p_sq + params.sq_off.array);
+
+			unsigned char *p_cq = static_cast<unsigned char *>(p_cq_ring_);
+			p_cq_head_ = reinterpret_cast<unsigned *>(p_cq + params.cq_off.head);
+			p_cq_tail_ = reinterpret_cast<unsigned *>(p_cq + params.cq_off.tail);
+			p_cq_ring_mask_ = reinterpret_cast<unsigned *>(p_cq + params.cq_off.ring_mask);
+			p_cqes_ = reinterpret_cast<struct io_uring_cqe *>(p_cq + params.cq_off.cqes);
+
+			sq_tail_ = *p_sq_tail_;
+
+			return ResponseCode::SUCCESS;
+		}
+
+		std::unique_ptr<IoUringRing> IoUringRing::Create(unsigned queue_depth) {
+			std::unique_ptr<IoUringRing> p_ring = std::unique_ptr<IoUringRing>(new IoUringRing());
+			if(ResponseCode::SUCCESS != p_ring->Initialize(queue_depth)) {
+				return nullptr;
+			}
+			return p_ring;
+		}
+
+		struct io_uring_sqe *IoUringRing::GetSubmissionEntry() {
+			unsigned head = __atomic_load_n(p_sq_head_, __ATOMIC_ACQUIRE);
+			if(sq_tail_ - head >= *p_sq_ring_entries_) {
+				return nullptr;
+			}
+
+			unsigned index = sq_tail_ & *p_sq_ring_mask_;
+			struct io_uring_sqe *p_sqe = &p_sqes_[index];
+			memset(p_sqe, 0, sizeof(struct io_uring_sqe));
+			p_sq_array_[index] = index;
+			sq_tail_++;
+			pending_submit_count_++;
+			return p_sqe;
+		}
+
+		int IoUringRing::Enter(bool wait_for_completion, std::chrono::milliseconds timeout) {
+			if(!wait_for_completion && 0 == pending_submit_count_) {
+				return 0;
+			}
+
+			// Publish the entries filled in since the last call
+			__atomic_store_n(p_sq_tail_, sq_tail_, __ATOMIC_RELEASE);
+
+			unsigned flags = 0;
+			unsigned min_complete = 0;
+			struct __kernel_timespec wait_timeout;
+			struct io_uring_getevents_arg getevents_arg;
+			memset(&getevents_arg, 0, sizeof(getevents_arg));
+			void *p_arg = nullptr;
+			size_t arg_size = 0;
+			if(wait_for_completion) {
+				if(0 > timeout.count()) {
+					timeout = std::chrono::milliseconds(0);
+				}
+				wait_timeout.tv_sec = timeout.count() / 1000;
+				wait_timeout.tv_nsec = (timeout.count() % 1000) * 1000000;
+				getevents_arg.sigmask_sz = _NSIG / 8;
+				getevents_arg.ts = reinterpret_cast<uint64_t>(&wait_timeout);
+				flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+				min_complete = 1;
+				p_arg = &getevents_arg;
+				arg_size = sizeof(getevents_arg);
+			}
+
+			long rc = syscall(__NR_io_uring_enter, ring_fd_, pending_submit_count_, min_complete, flags, p_arg, arg_size);
+			if(0 > rc) {
+				return -errno;
+			}
+
+			pending_submit_count_ -= (static_cast<unsigned>(rc) < pending_submit_count_)
+									 ? static_cast<unsigned>(rc) : pending_submit_count_;
+			return 0;
+		}
+
+		struct io_uring_cqe *IoUringRing::PeekCompletion() {
+			unsigned head = *p_cq_head_;
+			if(head == __atomic_load_n(p_cq_tail_, __ATOMIC_ACQUIRE)) {
+				return nullptr;
+			}
+			return &p_cqes_[head & *p_cq_ring_mask_];
+		}
+
+		void IoUringRing::ConsumeCompletion() {
+			__atomic_store_n(p_cq_head_, *p_cq_head_ + 1, __ATOMIC_RELEASE);
+		}
+
+		ResponseCode IoUringRing::RegisterBuffers(const struct iovec *p_iovecs, unsigned count) {
+			if(0 > syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS, p_iovecs, count)) {
+				AWS_LOG_WARN(IO_URING_TRANSPORT_LOG_TAG, "io_uring_register - %s", strerror(errno));
+				return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+			}
+			return ResponseCode::SUCCESS;
+		}
+
+		int IoUringRing::GetRingDescriptor() {
+			return ring_fd_;
+		}
+
+		IoUringRing::~IoUringRing() {
+			if(MAP_FAILED != p_sqes_) {
+				munmap(p_sqes_, sqes_size_);
+			}
+			if(MAP_FAILED != p_cq_ring_ && p_cq_ring_ != p_sq_ring_) {
+				munmap(p_cq_ring_, cq_ring_size_);
+			}
+			if(MAP_FAILED != p_sq_ring_) {
+				munmap(p_sq_ring_, sq_ring_size_);
+			}
+			if(0 <= ring_fd_) {
+				close(ring_fd_);
+			}
+		}
+
+		IoUringTransport::IoUringTransport(std::unique_ptr<IoUringRing> p_receive_ring,
+										   std::unique_ptr<IoUringRing> p_send_ring, size_t receive_buffer_size) {
+			p_receive_ring_ = std::move(p_receive_ring);
+			p_send_ring_ = std::move(p_send_ring);
+			receive_buf_.resize(receive_buffer_size);
+			Reset();
+		}
+
+		std::unique_ptr<IoUringTransport> IoUringTransport::Create(size_t receive_buffer_size) {
+			if(0 == receive_buffer_size) {
+				return nullptr;
+			}
+
+			std::unique_ptr<IoUringRing> p_receive_ring = IoUringRing::Create(IO_URING_RECEIVE_QUEUE_DEPTH);
+			std::unique_ptr<IoUringRing> p_send_ring = IoUringRing::Create(IO_URING_SEND_QUEUE_DEPTH);
+			if(nullptr == p_receive_ring || nullptr == p_send_ring) {
+				return nullptr;
+			}
+
+			std::unique_ptr<IoUringTransport> p_transport = std::unique_ptr<IoUringTransport>(
+				new IoUringTransport(std::move(p_receive_ring), std::move(p_send_ring), receive_buffer_size));
+
+			struct iovec receive_iovec;
+			receive_iovec.iov_base = p_transport->receive_buf_.data();
+			receive_iovec.iov_len = p_transport->receive_buf_.size();
+			if(ResponseCode::SUCCESS != p_transport->p_receive_ring_->RegisterBuffers(&receive_iovec, 1)) {
+				return nullptr;
+			}
+
+			return p_transport;
+		}
+
+		void IoUringTransport::Reset() {
+			receive_buf_offset_ = 0;
+			receive_buf_length_ = 0;
+			is_receive_armed_ = false;
+			receive_result_ = 1;
+			send_buf_offset_ = 0;
+			send_buf_.clear();
+			is_send_pending_ = false;
+			is_send_failed_ = false;
+		}
+
+		void IoUringTransport::ProcessReceiveCompletions() {
+			struct io_uring_cqe *p_cqe;
+			while(nullptr != (p_cqe = p_receive_ring_->PeekCompletion())) {
+				if(IO_URING_USER_DATA_RECEIVE == p_cqe->user_data) {
+					is_receive_armed_ = false;
+					if(0 < p_cqe->res) {
+						receive_buf_offset_ = 0;
+						receive_buf_length_ = static_cast<size_t>(p_cqe->res);
+					} else if(-EINTR != p_cqe->res && -EAGAIN != p_cqe->res) {
+						receive_result_ = p_cqe->res;
+					}
+				}
+				p_receive_ring_->ConsumeCompletion();
+			}
+		}
+
+		void IoUringTransport::ProcessSendCompletions() {
+			struct io_uring_cqe *p_cqe;
+			while(nullptr != (p_cqe = p_send_ring_->PeekCompletion())) {
+				if(IO_URING_USER_DATA_SEND == p_cqe->user_data) {
+					is_send_pending_ = false;
+					if(0 < p_cqe->res) {
+						send_buf_offset_ += static_cast<size_t>(p_cqe->res);
+					} else if(-EINTR != p_cqe->res && -EAGAIN != p_cqe->res) {
+						AWS_LOG_ERROR(IO_URING_TRANSPORT_LOG_TAG, "Send failed - %s", strerror(-p_cqe->res));
+						is_send_failed_ = true;
+					}
+				}
+				p_send_ring_->ConsumeCompletion();
+			}
+		}
+
+		ResponseCode IoUringTransport::WaitForReceive(int socket_fd, std::chrono::milliseconds timeout) {
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+			do {
+				ProcessReceiveCompletions();
+				if(0 < receive_buf_length_ || 1 != receive_result_) {
+					return ResponseCode::SUCCESS;
+				}
+
+				if(!is_receive_armed_) {
+					struct io_uring_sqe *p_sqe = p_receive_ring_->GetSubmissionEntry();
+					if(nullptr == p_sqe) {
+						return ResponseCode::NETWORK_SSL_READ_ERROR;
+					}
+					p_sqe->opcode = IORING_OP_READ_FIXED;
+					p_sqe->fd = socket_fd;
+					p_sqe->addr = reinterpret_cast<uint64_t>(receive_buf_.data());
+					p_sqe->len = static_cast<uint32_t>(receive_buf_.size());
+					p_sqe->buf_index = 0;
+					p_sqe->user_data = IO_URING_USER_DATA_RECEIVE;
+					is_receive_armed_ = true;
+				}
+
+				std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+					deadline - std::chrono::steady_clock::now());
+				int rc = p_receive_ring_->Enter(0 < remaining.count(), remaining);
+				if(0 > rc && -ETIME != rc && -EINTR != rc) {
+					AWS_LOG_ERROR(IO_URING_TRANSPORT_LOG_TAG, "io_uring_enter - %s", strerror(-rc));
+					return ResponseCode::NETWORK_SSL_READ_ERROR;
+				}
+			} while(std::chrono::steady_clock::now() < deadline);
+
+			ProcessReceiveCompletions();
+			if(0 < receive_buf_length_ || 1 != receive_result_) {
+				return ResponseCode::SUCCESS;
+			}
+			return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+		}
+
+		ResponseCode IoUringTransport::Receive(int socket_fd, std::chrono::milliseconds timeout,
+											   const unsigned char *&p_data_out, size_t &data_length_out) {
+			ResponseCode rc = WaitForReceive(socket_fd, timeout);
+			if(ResponseCode::SUCCESS != rc) {
+				return rc;
+			}
+
+			if(0 < receive_buf_length_) {
+				p_data_out = &receive_buf_[receive_buf_offset_];
+				data_length_out = receive_buf_length_;
+				return ResponseCode::SUCCESS;
+			}
+
+			if(0 == receive_result_) {
+				return ResponseCode::NETWORK_SSL_CONNECTION_CLOSED_ERROR;
+			}
+			AWS_LOG_ERROR(IO_URING_TRANSPORT_LOG_TAG, "Receive failed - %s", strerror(-receive_result_));
+			return ResponseCode::NETWORK_SSL_READ_ERROR;
+		}
+
+		void IoUringTransport::ConsumeReceived(size_t length) {
+			if(length >= receive_buf_length_) {
+				receive_buf_offset_ = 0;
+				receive_buf_length_ = 0;
+			} else {
+				receive_buf_offset_ += length;
+				receive_buf_length_ -= length;
+			}
+		}
+
+		ResponseCode IoUringTransport::Send(int socket_fd, const unsigned char *p_data, size_t data_length,
+											std::chrono::milliseconds timeout) {
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+
+			// A send that timed out earlier must complete before its buffer can be reused
+			while(is_send_pending_) {
+				std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+					deadline - std::chrono::steady_clock::now());
+				if(0 >= remaining.count()) {
+					return ResponseCode::NETWORK_SSL_WRITE_TIMEOUT_ERROR;
+				}
+				p_send_ring_->Enter(true, remaining);
+				ProcessSendCompletions();
+			}
+
+			send_buf_.assign(p_data, p_data + data_length);
+			send_buf_offset_ = 0;
+			is_send_failed_ = false;
+
+			while(send_buf_offset_ < send_buf_.size()) {
+				if(!is_send_pending_) {
+					struct io_uring_sqe *p_sqe = p_send_ring_->GetSubmissionEntry();
+					if(nullptr == p_sqe) {
+						return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+					}
+					p_sqe->opcode = IORING_OP_SEND;
+					p_sqe->fd = socket_fd;
+					p_sqe->addr = reinterpret_cast<uint64_t>(&send_buf_[send_buf_offset_]);
+					p_sqe->len = static_cast<uint32_t>(send_buf_.size() - send_buf_offset_);
+					p_sqe->msg_flags = MSG_NOSIGNAL;
+					p_sqe->user_data = IO_URING_USER_DATA_SEND;
+					is_send_pending_ = true;
+				}
+
+				std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+					deadline - std::chrono::steady_clock::now());
+				int rc = p_send_ring_->Enter(0 < remaining.count(), remaining);
+				if(0 > rc && -ETIME != rc && -EINTR != rc) {
+					AWS_LOG_ERROR(IO_URING_TRANSPORT_LOG_TAG, "io_uring_enter - %s", strerror(-rc));
+					return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+				}
+				ProcessSendCompletions();
+
+				if(is_send_failed_) {
+					return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+				}
+				if(is_send_pending_ && std::chrono::steady_clock::now() >= deadline) {
+					return ResponseCode::NETWORK_SSL_WRITE_TIMEOUT_ERROR;
+				}
+			}
+
+			return ResponseCode::SUCCESS;
+		}
+
+		void IoUringTransport::Drain(std::chrono::milliseconds timeout) {
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+			ProcessReceiveCompletions();
+			ProcessSendCompletions();
+			while(is_receive_armed_ || is_send_pending_) {
+				std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+					deadline - std::chrono::steady_clock::now());
+				if(0 >= remaining.count()) {
+					AWS_LOG_WARN(IO_URING_TRANSPORT_LOG_TAG, "Socket operations still in flight after disconnect");
+					break;
+				}
+				if(is_receive_armed_) {
+					p_receive_ring_->Enter(true, remaining);
+					ProcessReceiveCompletions();
+				} else {
+					p_send_ring_->Enter(true, remaining);
+					ProcessSendCompletions();
+				}
+			}
+		}
+
+		int IoUringTransport::GetReceiveDescriptor() {
+			return p_receive_ring_->GetRingDescriptor();
+		}
+#else
+		IoUringRing::IoUringRing() {
+		}
+
+		ResponseCode IoUringRing::Initialize(unsigned queue_depth) {
+			return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+		}
+
+		std::unique_ptr<IoUringRing> IoUringRing::Create(unsigned queue_depth) {
+			return nullptr;
+		}
+
+		int IoUringRing::GetRingDescriptor() {
+			return -1;
+		}
+
+		IoUringRing::~IoUringRing() {
+		}
+
+		std::unique_ptr<IoUringTransport> IoUringTransport::Create(size_t receive_buffer_size) {
+			return nullptr;
+		}
+
+		void IoUringTransport::Reset() {
+		}
+
+		ResponseCode IoUringTransport::WaitForReceive(int socket_fd, std::chrono::milliseconds timeout) {
+			return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+		}
+
+		ResponseCode IoUringTransport::Receive(int socket_fd, std::chrono::milliseconds timeout,
+											   const unsigned char *&p_data_out, size_t &data_length_out) {
+			return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+		}
+
+		void IoUringTransport::ConsumeReceived(size_t length) {
+		}
+
+		ResponseCode IoUringTransport::Send(int socket_fd, const unsigned char *p_data, size_t data_length,
+											std::chrono::milliseconds timeout) {
+			return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+		}
+
+		void IoUringTransport::Drain(std::chrono::milliseconds timeout) {
+		}
+
+		int IoUringTransport::GetReceiveDescriptor() {
+			return -1;
+		}
+#endif
+	}
+}
@@ -0,0 +1,263 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file IoUringTransport.hpp
+ * @brief Defines an io_uring based socket transport used by the OpenSSL wrapper on Linux
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+// Headers older than Linux 5.11 lack the timed wait interface, use the stub there as on older kernels
+#ifdef IORING_FEAT_EXT_ARG
+#define AWS_IOT_IO_URING_SUPPORTED
+#endif
+#endif
+#endif
+
+#include "util/memory/stl/Vector.hpp"
+#include "ResponseCode.hpp"
+
+#ifndef IO_URING_TRANSPORT_RECEIVE_BUFFER_SIZE
+#define IO_URING_TRANSPORT_RECEIVE_BUFFER_SIZE 16 * 1024
+#endif
+
+namespace awsiotsdk {
+	namespace network {
+		/**
+		 * @brief io_uring Ring
+		 *
+		 * Minimal wrapper around a single io_uring instance using the raw system calls. A ring is only used from one
+		 * thread at a time, the owner is responsible for serializing access.
+		 */
+		class IoUringRing {
+		protected:
+#ifdef AWS_IOT_IO_URING_SUPPORTED
+			int ring_fd_;								///< Descriptor returned by io_uring_setup
+			void *p_sq_ring_;							///< Mapped submission queue ring
+			size_t sq_ring_size_;						///< Size of the submission queue ring mapping
+			void *p_cq_ring_;							///< Mapped completion queue ring, same as p_sq_ring_ with single mmap
+			size_t cq_ring_size_;						///< Size of the completion queue ring mapping
+			struct io_uring_sqe *p_sqes_;				///< Mapped submission queue entries
+			size_t sqes_size_;							///< Size of the submission queue entry mapping
+			unsigned *p_sq_head_;						///< Submission queue head, advanced by the kernel
+			unsigned *p_sq_tail_;						///< Submission queue tail, advanced by us
+			unsigned *p_sq_ring_mask_;					///< Submission queue index mask
+			unsigned *p_sq_array_;						///< Submission queue index array
+			unsigned *p_cq_head_;						///< Completion queue head, advanced by us
+			unsigned *p_cq_tail_;						///< Completion queue tail, advanced by the kernel
+			unsigned *p_cq_ring_mask_;					///< Completion queue index mask
+			struct io_uring_cqe *p_cqes_;				///< Completion queue entries
+			unsigned *p_sq_ring_entries_;				///< Number of submission queue entries
+			unsigned sq_tail_;							///< Local submission queue tail, published on Enter
+			unsigned pending_submit_count_;				///< Entries queued since the last io_uring_enter
+#endif
+
+			IoUringRing();
+
+			ResponseCode Initialize(unsigned queue_depth);
+		public:
+			// Disabling default and copy constructors.
+			IoUringRing(const IoUringRing &) = delete;					// Copy constructor
+			IoUringRing(IoUringRing &&) = delete;						// Move constructor
+			IoUringRing &operator=(const IoUringRing &) & = delete;		// Copy assignment operator
+			IoUringRing &operator=(IoUringRing &&) & = delete;			// Move assignment operator
+
+			/**
+			 * @brief Create a ring
+			 *
+			 * @param queue_depth - Number of submission queue entries
+			 * @return std::unique_ptr<IoUringRing> - nullptr if io_uring is not available on this system
+			 */
+			static std::unique_ptr<IoUringRing> Create(unsigned queue_depth);
+
+#ifdef AWS_IOT_IO_URING_SUPPORTED
+			/**
+			 * @brief Get a free submission queue entry
+			 *
+			 * The entry is zeroed and is submitted on the next call to Enter
+			 *
+			 * @return io_uring_sqe * - nullptr if the submission queue is full
+			 */
+			struct io_uring_sqe *GetSubmissionEntry();
+
+			/**
+			 * @brief Submit queued entries and optionally wait for completions
+			 *
+			 * The wait can end early, callers check the completion queue and their own deadline after every call.
+			 *
+			 * @param wait_for_completion - true to wait until at least one completion is available
+			 * @param timeout - max time to wait, only used when wait_for_completion is true
+			 * @return int - 0 or a negative errno value, -ETIME if the wait timed out
+			 */
+			int Enter(bool wait_for_completion, std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Get the oldest completion without consuming it
+			 *
+			 * @return io_uring_cqe * - nullptr if the completion queue is empty
+			 */
+			struct io_uring_cqe *PeekCompletion();
+
+			/**
+			 * @brief Consume the completion returned by PeekCompletion
+			 */
+			void ConsumeCompletion();
+
+			/**
+			 * @brief Register buffers with the ring so the kernel does not have to map them on every operation
+			 *
+			 * @param p_iovecs - Buffers to register
+			 * @param count - Number of buffers
+			 * @return ResponseCode - SUCCESS or NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR
+			 */
+			ResponseCode RegisterBuffers(const struct iovec *p_iovecs, unsigned count);
+#endif
+
+			/**
+			 * @brief Get the ring descriptor
+			 *
+			 * The descriptor is readable while completions are waiting to be consumed
+			 *
+			 * @return int - Ring descriptor
+			 */
+			int GetRingDescriptor();
+
+			~IoUringRing();
+		};
+
+		/**
+		 * @brief io_uring Transport
+		 *
+		 * Drives the socket I/O of a connection through io_uring. Receives are made into a buffer registered with the
+		 * receive ring and are kept armed so data is picked up as soon as it arrives. Sends are submitted and waited
+		 * for with a single system call on a separate ring, allowing reads and writes to run concurrently from
+		 * different threads the same way they do on the socket.
+		 */
+		class IoUringTransport {
+		protected:
+			std::unique_ptr<IoUringRing> p_receive_ring_;	///< Ring used by the read path
+			std::unique_ptr<IoUringRing> p_send_ring_;		///< Ring used by the write path
+			util::Vector<unsigned char> receive_buf_;		///< Registered receive buffer
+			size_t receive_buf_offset_;						///< Start of the unconsumed data in receive_buf_
+			size_t receive_buf_length_;						///< Length of the unconsumed data in receive_buf_
+			bool is_receive_armed_;							///< A receive was queued and has not completed
+			int receive_result_;							///< Result of the last receive that did not return data, 1 if none
+			util::Vector<unsigned char> send_buf_;			///< Data of the current send, owned so a timed out send stays valid
+			size_t send_buf_offset_;						///< Bytes of send_buf_ already sent
+			bool is_send_pending_;							///< A send was submitted and has not completed
+			bool is_send_failed_;							///< The last send completed with an error
+
+			IoUringTransport(std::unique_ptr<IoUringRing> p_receive_ring, std::unique_ptr<IoUringRing> p_send_ring,
+							 size_t receive_buffer_size);
+
+			void ProcessReceiveCompletions();
+			void ProcessSendCompletions();
+		public:
+			// Disabling default and copy constructors.
+			IoUringTransport() = delete;										// Default constructor
+			IoUringTransport(const IoUringTransport &) = delete;				// Copy constructor
+			IoUringTransport(IoUringTransport &&) = delete;						// Move constructor
+			IoUringTransport &operator=(const IoUringTransport &) & = delete;	// Copy assignment operator
+			IoUringTransport &operator=(IoUringTransport &&) & = delete;		// Move assignment operator
+
+			/**
+			 * @brief Create a transport
+			 *
+			 * @param receive_buffer_size - Size of the registered receive buffer
+			 * @return std::unique_ptr<IoUringTransport> - nullptr if io_uring is not available on this system
+			 */
+			static std::unique_ptr<IoUringTransport> Create(size_t receive_buffer_size);
+
+			/**
+			 * @brief Prepare the transport for a new connection
+			 *
+			 * Must be called while no socket operation is in flight
+			 */
+			void Reset();
+
+			/**
+			 * @brief Wait until received data is available
+			 *
+			 * Arms a receive on the socket if there is none in flight. A zero timeout only submits the receive.
+			 *
+			 * @param socket_fd - Connected socket
+			 * @param timeout - Max time to wait
+			 * @return ResponseCode - SUCCESS if data or a socket error is available, NETWORK_SSL_NOTHING_TO_READ on timeout
+			 */
+			ResponseCode WaitForReceive(int socket_fd, std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Get received data
+			 *
+			 * Waits for data the same way as WaitForReceive. The returned data stays valid until the next call to
+			 * ConsumeReceived.
+			 *
+			 * @param socket_fd - Connected socket
+			 * @param timeout - Max time to wait
+			 * @param p_data_out - Set to the start of the received data
+			 * @param data_length_out - Set to the length of the received data
+			 * @return ResponseCode - SUCCESS, NETWORK_SSL_NOTHING_TO_READ on timeout,
+			 * NETWORK_SSL_CONNECTION_CLOSED_ERROR if the peer closed the socket or NETWORK_SSL_READ_ERROR
+			 */
+			ResponseCode Receive(int socket_fd, std::chrono::milliseconds timeout,
+								 const unsigned char *&p_data_out, size_t &data_length_out);
+
+			/**
+			 * @brief Mark received data as consumed
+			 *
+			 * @param length - Number of bytes consumed from the data returned by Receive
+			 */
+			void ConsumeReceived(size_t length);
+
+			/**
+			 * @brief Send data
+			 *
+			 * Partial sends are resubmitted until all data has been written or the timeout expires. The data is copied
+			 * so a send that is still in flight after a timeout does not reference memory owned by the caller.
+			 *
+			 * @param socket_fd - Connected socket
+			 * @param p_data - Data to send
+			 * @param data_length - Length of the data
+			 * @param timeout - Max time to wait for all data to be sent
+			 * @return ResponseCode - SUCCESS, NETWORK_SSL_WRITE_TIMEOUT_ERROR or NETWORK_SSL_WRITE_ERROR
+			 */
+			ResponseCode Send(int socket_fd, const unsigned char *p_data, size_t data_length,
+							  std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Wait for operations that are still in flight to complete
+			 *
+			 * Must be called after the socket was shut down and before it is closed
+			 *
+			 * @param timeout - Max time to wait
+			 */
+			void Drain(std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Get the descriptor that becomes readable when a receive completes
+			 *
+			 * @return int - Receive ring descriptor
+			 */
+			int GetReceiveDescriptor();
+		};
+	}
+}
@@ -36,8 +36,14 @@
 
 #define OPENSSL_WRAPPER_LOG_TAG "[OpenSSL Wrapper]"
 
+#define TLS_RECORD_HEADER_LENGTH 5
+
 namespace awsiotsdk {
 	namespace network {
+		static std::chrono::milliseconds TimevalToMilliseconds(const struct timeval &tv) {
+			return std::chrono::milliseconds(tv.tv_sec * 1000 + tv.tv_usec / 1000);
+		}
+
 		OpenSSLConnection::OpenSSLConnection(util::String endpoint, uint16_t endpoint_port,
 											 std::chrono::milliseconds tls_handshake_timeout,
 											 std::chrono::milliseconds tls_read_timeout,
@@ -54,6 +60,11 @@ namespace awsiotsdk {
 			tls_write_timeout_ = { timeout_ms / 1000, (timeout_ms % 1000) * 1000};
 
 			is_connected_ = false;
+			transport_ = Transport::SOCKET;
+			p_ssl_context_ = nullptr;
+			p_ssl_handle_ = nullptr;
+			p_network_read_bio_ = nullptr;
+			p_network_write_bio_ = nullptr;
 		}
 
 		OpenSSLConnection::OpenSSLConnection(util::String endpoint, uint16_t endpoint_port, util::String root_ca_location,
@@ -127,11 +138,43 @@ namespace awsiotsdk {
 			return ResponseCode::SUCCESS;
 		}
 
+		ResponseCode OpenSSLConnection::SetTransport(Transport transport) {
+			if(is_connected_) {
+				return ResponseCode::NETWORK_ALREADY_CONNECTED_ERROR;
+			}
+
+			if(Transport::IO_URING == transport) {
+				if(nullptr == p_io_uring_transport_) {
+					p_io_uring_transport_ = IoUringTransport::Create(IO_URING_TRANSPORT_RECEIVE_BUFFER_SIZE);
+					if(nullptr == p_io_uring_transport_) {
+						AWS_LOG_ERROR(OPENSSL_WRAPPER_LOG_TAG, "io_uring transport is not supported on this system");
+						return ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR;
+					}
+				}
+			} else {
+				p_io_uring_transport_.reset();
+			}
+
+			transport_ = transport;
+			return ResponseCode::SUCCESS;
+		}
+
+		OpenSSLConnection::Transport OpenSSLConnection::GetTransport() {
+			return transport_;
+		}
+
 		bool OpenSSLConnection::IsPhysicalLayerConnected() {
 			// Use this to add implementation which can check for physical layer disconnect
 			return true;
 		}
 
+		int OpenSSLConnection::GetSocketDescriptor() {
+			if(Transport::IO_URING == transport_) {
+				return p_io_uring_transport_->GetReceiveDescriptor();
+			}
+			return server_tcp_socket_fd_;
+		}
+
 		bool OpenSSLConnection::IsConnected() {
 			return is_connected_;
 		}
@@ -241,6 +284,86 @@ namespace awsiotsdk {
 			return ret_val;
 		}
 
+		ResponseCode OpenSSLConnection::FlushTransportWrites(std::chrono::milliseconds timeout) {
+			char *p_data = nullptr;
+			long data_length = BIO_get_mem_data(p_network_write_bio_, &p_data);
+			if(0 >= data_length) {
+				return ResponseCode::SUCCESS;
+			}
+
+			// All records written since the last flush go out in a single submission
+			ResponseCode rc = p_io_uring_transport_->Send(server_tcp_socket_fd_,
+														  reinterpret_cast<const unsigned char *>(p_data),
+														  static_cast<size_t>(data_length), timeout);
+			(void)BIO_reset(p_network_write_bio_);
+			return rc;
+		}
+
+		ResponseCode OpenSSLConnection::FillTransportReads(std::chrono::milliseconds timeout) {
+			const unsigned char *p_data = nullptr;
+			size_t data_length = 0;
+			ResponseCode rc = p_io_uring_transport_->Receive(server_tcp_socket_fd_, timeout, p_data, data_length);
+			if(ResponseCode::SUCCESS != rc) {
+				return rc;
+			}
+
+			int written = BIO_write(p_network_read_bio_, p_data, static_cast<int>(data_length));
+			if(0 >= written) {
+				return ResponseCode::NETWORK_SSL_READ_ERROR;
+			}
+			p_io_uring_transport_->ConsumeReceived(static_cast<size_t>(written));
+			return ResponseCode::SUCCESS;
+		}
+
+		bool OpenSSLConnection::HasBufferedRecord() {
+			char *p_data = nullptr;
+			long data_length = BIO_get_mem_data(p_network_read_bio_, &p_data);
+			if(TLS_RECORD_HEADER_LENGTH > data_length) {
+				return false;
+			}
+
+			const unsigned char *p_header = reinterpret_cast<const unsigned char *>(p_data);
+			long record_length = TLS_RECORD_HEADER_LENGTH + ((p_header[3] << 8) | p_header[4]);
+			return data_length >= record_length;
+		}
+
+		ResponseCode OpenSSLConnection::AttemptTransportConnect() {
+			std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now()
+				+ TimevalToMilliseconds(tls_handshake_timeout_);
+			ResponseCode ret_val = ResponseCode::FAILURE;
+
+			do {
+				int rc = SSL_connect(p_ssl_handle_);
+				std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+					deadline - std::chrono::steady_clock::now());
+
+				// Send the flight produced by this step before waiting for the reply
+				ret_val = FlushTransportWrites(remaining);
+				if(ResponseCode::NETWORK_SSL_WRITE_TIMEOUT_ERROR == ret_val) {
+					AWS_LOG_ERROR(OPENSSL_WRAPPER_LOG_TAG, " SSL Connect time out while waiting for write");
+					return ResponseCode::NETWORK_SSL_CONNECT_TIMEOUT_ERROR;
+				} else if(ResponseCode::SUCCESS != ret_val) {
+					return ResponseCode::NETWORK_SSL_CONNECT_ERROR;
+				}
+
+				if(1 == rc) { //1 = SSL_CONNECTED, <= 0 is Error
+					return ResponseCode::SUCCESS;
+				}
+
+				if(SSL_ERROR_WANT_READ != SSL_get_error(p_ssl_handle_, rc)) {
+					return ResponseCode::NETWORK_SSL_CONNECT_ERROR;
+				}
+
+				ret_val = FillTransportReads(remaining);
+				if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ == ret_val) {
+					AWS_LOG_ERROR(OPENSSL_WRAPPER_LOG_TAG, " SSL Connect time out while waiting for read");
+					return ResponseCode::NETWORK_SSL_CONNECT_TIMEOUT_ERROR;
+				}
+			} while(ResponseCode::SUCCESS == ret_val);
+
+			return ResponseCode::NETWORK_SSL_CONNECT_ERROR;
+		}
+
 		ResponseCode OpenSSLConnection::ConnectInternal() {
 			ResponseCode networkResponse = ResponseCode::SUCCESS;
 
@@ -291,15 +414,32 @@ namespace awsiotsdk {
 				return networkResponse;
 			}
 
-			SSL_set_fd(p_ssl_handle_, server_tcp_socket_fd_);
+			if(Transport::IO_URING == transport_) {
+				// The socket stays blocking, io_uring waits for readiness itself
+				p_network_read_bio_ = BIO_new(BIO_s_mem());
+				p_network_write_bio_ = BIO_new(BIO_s_mem());
+				if(nullptr == p_network_read_bio_ || nullptr == p_network_write_bio_) {
+					BIO_free(p_network_read_bio_);
+					BIO_free(p_network_write_bio_);
+					p_network_read_bio_ = nullptr;
+					p_network_write_bio_ = nullptr;
+					return ResponseCode::NETWORK_SSL_INIT_ERROR;
+				}
+				SSL_set_bio(p_ssl_handle_, p_network_read_bio_, p_network_write_bio_);
+				p_io_uring_transport_->Reset();
 
-			networkResponse = SetSocketToNonBlocking();
-			if(ResponseCode::SUCCESS != networkResponse) {
-				AWS_LOG_ERROR(OPENSSL_WRAPPER_LOG_TAG, " Unable to set the socket to Non-Blocking");
-				return networkResponse;
-			}
+				networkResponse = AttemptTransportConnect();
+			} else {
+				SSL_set_fd(p_ssl_handle_, server_tcp_socket_fd_);
+
+				networkResponse = SetSocketToNonBlocking();
+				if(ResponseCode::SUCCESS != networkResponse) {
+					AWS_LOG_ERROR(OPENSSL_WRAPPER_LOG_TAG, " Unable to set the socket to Non-Blocking");
+					return networkResponse;
+				}
 
-			networkResponse = AttemptConnect();
+				networkResponse = AttemptConnect();
+			}
 			if(X509_V_OK != SSL_get_verify_result(p_ssl_handle_)) {
 				AWS_LOG_ERROR(OPENSSL_WRAPPER_LOG_TAG, " Server Certificate Verification failed");
 				networkResponse = ResponseCode::NETWORK_SSL_CONNECT_ERROR;
@@ -319,17 +459,70 @@ namespace awsiotsdk {
 		}
 
 		ResponseCode OpenSSLConnection::WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+			return WriteBytes(buf.c_str(), buf.length(), size_written_bytes_out);
+		}
+
+		ResponseCode OpenSSLConnection::WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+													   size_t &size_written_bytes_out) {
+			if(1 < segment_count && NETWORK_WRITEV_COALESCE_MAX_BYTES >= GetSegmentsLength(p_segments, segment_count)) {
+				// One record costs less than encrypting and framing each small segment separately
+				const util::String &joined_buf = JoinSegments(p_segments, segment_count);
+				return WriteBytes(joined_buf.c_str(), joined_buf.length(), size_written_bytes_out);
+			}
+
+			ResponseCode rc = ResponseCode::SUCCESS;
+			size_t total_written_length = 0;
+			for(size_t itr = 0; itr < segment_count && ResponseCode::SUCCESS == rc; itr++) {
+				if(p_segments[itr].empty()) {
+					continue;
+				}
+				size_t cur_written_length = 0;
+				rc = WriteBytes(p_segments[itr].data(), p_segments[itr].length(), cur_written_length);
+				if(ResponseCode::SUCCESS == rc) {
+					total_written_length += cur_written_length;
+					if(cur_written_length != p_segments[itr].length()) {
+						// Caller resumes from the reported byte count
+						break;
+					}
+				}
+			}
+
+			if(0 < total_written_length) {
+				// Bytes already sent must be reported, a failure is returned again when the caller resumes
+				size_written_bytes_out = total_written_length;
+				return ResponseCode::SUCCESS;
+			}
+			if(ResponseCode::SUCCESS == rc) {
+				size_written_bytes_out = 0;
+			}
+			return rc;
+		}
+
+		ResponseCode OpenSSLConnection::WriteBytes(const char *p_buf, size_t bytes_to_write,
+												   size_t &size_written_bytes_out) {
 			int error_code = 0;
 			int select_retCode = -1;
 			int cur_written_length = 0;
 			size_t total_written_length = 0;
 			ResponseCode rc = ResponseCode::SUCCESS;
 			fd_set write_fds;
-			size_t bytes_to_write = buf.length();
 			struct timeval timeout = {tls_write_timeout_.tv_sec, tls_write_timeout_.tv_usec};
 
+			if(Transport::IO_URING == transport_) {
+				// Memory BIOs never block, the whole buffer is encrypted in one call
+				cur_written_length = SSL_write(p_ssl_handle_, p_buf, bytes_to_write);
+				if(0 >= cur_written_length) {
+					return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+				}
+				rc = FlushTransportWrites(TimevalToMilliseconds(tls_write_timeout_));
+				if(ResponseCode::SUCCESS == rc) {
+					size_written_bytes_out = (size_t) cur_written_length;
+				}
+				return rc;
+			}
+
 			do {
-				cur_written_length = SSL_write(p_ssl_handle_, buf.c_str(), bytes_to_write);
+				cur_written_length = SSL_write(p_ssl_handle_, p_buf, bytes_to_write);
 				error_code = SSL_get_error(p_ssl_handle_, cur_written_length);
 				if(0 < cur_written_length) {
 					total_written_length += (size_t) cur_written_length;
@@ -361,7 +554,7 @@ namespace awsiotsdk {
 													 size_t size_bytes_to_read, size_t &size_read_bytes_out) {
 			int ssl_retcode;
 			int select_retCode;
-			size_t total_read_length = buf_read_offset;
+			size_t total_read_length = 0;
 			size_t remaining_bytes_to_read = size_bytes_to_read;
 			int cur_read_len = 0;
 			ResponseCode errorStatus = ResponseCode::SUCCESS;
@@ -369,14 +562,32 @@ namespace awsiotsdk {
 			struct timeval timeout = {tls_read_timeout_.tv_sec, tls_read_timeout_.tv_usec};
 
 			do {
-				cur_read_len = SSL_read(p_ssl_handle_, &buf[total_read_length], (int) remaining_bytes_to_read);
+				cur_read_len = SSL_read(p_ssl_handle_, &buf[buf_read_offset + total_read_length], (int) remaining_bytes_to_read);
 				if(0 < cur_read_len) {
 					total_read_length += (size_t) cur_read_len;
 					remaining_bytes_to_read -= cur_read_len;
+					// Return what is available instead of waiting for the rest of the requested bytes
+					if(0 == SSL_pending(p_ssl_handle_)
+					   && (Transport::IO_URING != transport_ || !HasBufferedRecord())) {
+						break;
+					}
 				} else {
 					ssl_retcode = SSL_get_error(p_ssl_handle_, cur_read_len);
 					switch(ssl_retcode) {
 						case SSL_ERROR_WANT_READ:
+							if(0 < total_read_length) {
+								break;
+							}
+							if(Transport::IO_URING == transport_) {
+								errorStatus = FillTransportReads(TimevalToMilliseconds(tls_read_timeout_));
+								if(ResponseCode::SUCCESS == errorStatus) {
+									continue;
+								} else if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ != errorStatus &&
+										  ResponseCode::NETWORK_SSL_CONNECTION_CLOSED_ERROR != errorStatus) {
+									errorStatus = ResponseCode::NETWORK_SSL_READ_ERROR;
+								}
+								break;
+							}
 							FD_ZERO(&readFds);
 							FD_SET(server_tcp_socket_fd_, &readFds);
 							select_retCode = select(server_tcp_socket_fd_ + 1, &readFds, NULL, NULL, &timeout);
@@ -395,13 +606,9 @@ namespace awsiotsdk {
 							errorStatus = ResponseCode::NETWORK_SSL_READ_ERROR;
 							break;
 					}
-				}
-				if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ == errorStatus ||
-				   ResponseCode::NETWORK_SSL_READ_ERROR == errorStatus ||
-				   ResponseCode::NETWORK_SSL_CONNECTION_CLOSED_ERROR == errorStatus) {
 					break;
 				}
-			} while(is_connected_ && total_read_length < size_bytes_to_read);
+			} while(is_connected_ && 0 < remaining_bytes_to_read);
 
 			if(ResponseCode::SUCCESS == errorStatus) {
 				size_read_bytes_out = total_read_length;
@@ -410,9 +617,75 @@ namespace awsiotsdk {
 			return errorStatus;
 		}
 
+		int OpenSSLConnection::PollSocket(short events, std::chrono::milliseconds timeout) {
+#ifdef WIN32
+			WSAPOLLFD poll_fd;
+			poll_fd.fd = server_tcp_socket_fd_;
+			poll_fd.events = events;
+			poll_fd.revents = 0;
+			return WSAPoll(&poll_fd, 1, static_cast<int>(timeout.count()));
+#else
+			struct pollfd poll_fd;
+			poll_fd.fd = server_tcp_socket_fd_;
+			poll_fd.events = events;
+			poll_fd.revents = 0;
+			return poll(&poll_fd, 1, static_cast<int>(timeout.count()));
+#endif
+		}
+
+		ResponseCode OpenSSLConnection::WaitForReadableInternal(std::chrono::milliseconds timeout) {
+			// Records that were already decrypted are not visible on the socket
+			if(0 < SSL_pending(p_ssl_handle_)) {
+				return ResponseCode::SUCCESS;
+			}
+
+			if(Transport::IO_URING == transport_) {
+				if(HasBufferedRecord()) {
+					return ResponseCode::SUCCESS;
+				}
+				// Keeps a receive armed so the descriptor returned by GetSocketDescriptor signals new data
+				ResponseCode rc = p_io_uring_transport_->WaitForReceive(server_tcp_socket_fd_, timeout);
+				if(ResponseCode::SUCCESS == rc || ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc) {
+					return rc;
+				}
+				return ResponseCode::NETWORK_SSL_READ_ERROR;
+			}
+
+			int poll_retcode = PollSocket(POLLIN, timeout);
+			if(0 < poll_retcode) {
+				return ResponseCode::SUCCESS;
+			} else if(0 == poll_retcode) {
+				return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+			}
+			return ResponseCode::NETWORK_SSL_READ_ERROR;
+		}
+
+		ResponseCode OpenSSLConnection::WaitForWritableInternal(std::chrono::milliseconds timeout) {
+			if(Transport::IO_URING == transport_) {
+				// Sends are queued by the ring, writes never need to wait for the socket
+				return ResponseCode::SUCCESS;
+			}
+
+			int poll_retcode = PollSocket(POLLOUT, timeout);
+			if(0 < poll_retcode) {
+				return ResponseCode::SUCCESS;
+			} else if(0 == poll_retcode) {
+				return ResponseCode::NETWORK_SSL_WRITE_TIMEOUT_ERROR;
+			}
+			return ResponseCode::NETWORK_SSL_WRITE_ERROR;
+		}
+
 		ResponseCode OpenSSLConnection::DisconnectInternal() {
 			is_connected_ = false;
 			SSL_shutdown(p_ssl_handle_);
+#ifndef WIN32
+			if(Transport::IO_URING == transport_) {
+				FlushTransportWrites(TimevalToMilliseconds(tls_write_timeout_));
+				// Completes the armed receive so the ring no longer references the socket
+				shutdown(server_tcp_socket_fd_, SHUT_RDWR);
+				p_io_uring_transport_->Drain(TimevalToMilliseconds(tls_write_timeout_));
+			}
+#endif
 #ifdef WIN32
 			closesocket(server_tcp_socket_fd_);
 #else
@@ -28,6 +28,7 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/select.h>
+#include <poll.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <netdb.h>
@@ -45,6 +46,7 @@
 
 #include "NetworkConnection.hpp"
 #include "ResponseCode.hpp"
+#include "IoUringTransport.hpp"
 
 namespace awsiotsdk {
 	namespace network {
@@ -54,6 +56,15 @@ namespace awsiotsdk {
 		 * Defines a reference wrapper for OpenSSL libraries
 		 */
 		class OpenSSLConnection : public NetworkConnection {
+		public:
+			/**
+			 * @brief Transport used for the socket I/O underneath the TLS layer
+			 */
+			enum class Transport {
+				SOCKET = 0,		///< Non-blocking socket driven with select, OpenSSL reads and writes the socket directly
+				IO_URING = 1	///< Linux io_uring, OpenSSL works on memory BIOs and the ring moves the data
+			};
+
 		protected:
 			util::String root_ca_location_;				///< Pointer to string containing the filename (including path) of the root CA file.
 			util::String device_cert_location_;			///< Pointer to string containing the filename (including path) of the device certificate.
@@ -72,6 +83,10 @@ namespace awsiotsdk {
 			SSL *p_ssl_handle_;							///< SSL Handle
 			int server_tcp_socket_fd_;					///< Server Socket descriptor
 
+			Transport transport_;						///< Transport selected for the next connection
+			std::unique_ptr<IoUringTransport> p_io_uring_transport_;	///< io_uring transport, only set for Transport::IO_URING
+			BIO *p_network_read_bio_;					///< Memory BIO OpenSSL reads records from, owned by p_ssl_handle_
+			BIO *p_network_write_bio_;					///< Memory BIO OpenSSL writes records to, owned by p_ssl_handle_
 
 			/**
 			 * @brief Set TLS socket to non-blocking mode
@@ -98,6 +113,36 @@ namespace awsiotsdk {
 			 */
 			ResponseCode AttemptConnect();
 
+			/**
+			 * @brief Attempt connection using the io_uring transport
+			 *
+			 * @return ResponseCode - successful connection or TLS error
+			 */
+			ResponseCode AttemptTransportConnect();
+
+			/**
+			 * @brief Send all records OpenSSL wrote to the network write BIO
+			 *
+			 * @param std::chrono::milliseconds - max time to wait for the data to be sent
+			 * @return ResponseCode - SUCCESS or the transport send error
+			 */
+			ResponseCode FlushTransportWrites(std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Move received data from the transport to the network read BIO
+			 *
+			 * @param std::chrono::milliseconds - max time to wait for data
+			 * @return ResponseCode - SUCCESS or the transport receive error
+			 */
+			ResponseCode FillTransportReads(std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Check if the network read BIO holds at least one complete TLS record
+			 *
+			 * @return bool - true if a record can be decrypted without receiving more data
+			 */
+			bool HasBufferedRecord();
+
 			/**
 			 * @brief Create a TLS socket and open the connection
 			 *
@@ -116,6 +161,29 @@ namespace awsiotsdk {
 			 */
 			ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out);
 
+			/**
+			 * @brief Write a list of buffer segments to the network socket
+			 *
+			 * Small writes are joined and sent as one TLS record, larger ones are encrypted directly from each segment
+			 *
+			 * @param const util::StringView * - segments to write, in order
+			 * @param size_t - number of segments
+			 * @param size_t - reference to store number of bytes written
+			 * @return ResponseCode - successful write or Network error code
+			 */
+			ResponseCode WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+										size_t &size_written_bytes_out);
+
+			/**
+			 * @brief Write bytes from a caller provided buffer to the network socket
+			 *
+			 * @param const char * - bytes to write
+			 * @param size_t - number of bytes to write
+			 * @param size_t - reference to store number of bytes written
+			 * @return ResponseCode - successful write or Network error code
+			 */
+			ResponseCode WriteBytes(const char *p_buf, size_t bytes_to_write, size_t &size_written_bytes_out);
+
 			/**
 			 * @brief Read bytes from the network socket
 			 *
@@ -134,6 +202,31 @@ namespace awsiotsdk {
 			 */
 			ResponseCode DisconnectInternal();
 
+			/**
+			 * @brief Poll the socket for the requested events
+			 *
+			 * @param events - Events to wait for, POLLIN or POLLOUT
+			 * @param timeout - Max time to wait
+			 * @return int - Positive if ready, 0 on timeout, negative on error
+			 */
+			int PollSocket(short events, std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Wait until data can be read from the network socket
+			 *
+			 * @param std::chrono::milliseconds - max time to wait
+			 * @return ResponseCode - SUCCESS if data is available, NETWORK_SSL_NOTHING_TO_READ on timeout or TLS error code
+			 */
+			ResponseCode WaitForReadableInternal(std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Wait until data can be written to the network socket
+			 *
+			 * @param std::chrono::milliseconds - max time to wait
+			 * @return ResponseCode - SUCCESS if data can be written, NETWORK_SSL_WRITE_TIMEOUT_ERROR on timeout or TLS error code
+			 */
+			ResponseCode WaitForWritableInternal(std::chrono::milliseconds timeout);
+
 		public:
 
 			OpenSSLConnection(util::String endpoint, uint16_t endpoint_port,
@@ -171,6 +264,24 @@ namespace awsiotsdk {
 
 			ResponseCode Initialize();
 
+			/**
+			 * @brief Select the transport used for the socket I/O
+			 *
+			 * Takes effect on the next connection. Transport::IO_URING is only available on Linux kernels
+			 * supporting timed io_uring waits (5.11 and above).
+			 *
+			 * @param transport - Transport to use
+			 * @return ResponseCode - SUCCESS, NETWORK_ALREADY_CONNECTED_ERROR or NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR
+			 */
+			ResponseCode SetTransport(Transport transport);
+
+			/**
+			 * @brief Get the selected transport
+			 *
+			 * @return Transport - Transport used for the next connection
+			 */
+			Transport GetTransport();
+
 			/**
 			 * @brief Check if TLS layer is still connected
 			 *
@@ -189,6 +300,15 @@ namespace awsiotsdk {
 			 */
 			bool IsPhysicalLayerConnected();
 
+			/**
+			 * @brief Get the OS descriptor that becomes readable when this connection has data to read
+			 *
+			 * This is the socket for Transport::SOCKET and the receive ring for Transport::IO_URING
+			 *
+			 * @return int - Descriptor, only valid while connected
+			 */
+			int GetSocketDescriptor();
+
 			virtual ~OpenSSLConnection();
 		};
 	}
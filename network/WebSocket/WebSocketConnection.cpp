@@ -26,6 +26,7 @@
 #include <iostream>
 #include <thread>
 #include <iterator>
+#include <algorithm>
 #include <ctime>
 #include <random>
 
@@ -165,23 +166,19 @@ namespace awsiotsdk {
 			bool continue_polling = true;
 
 			do {
-				// See if we already have enough bytes for this read request
-				if (curr_read_buf_size_ >= size_bytes_to_read) {
-					auto in_buf_itr = std::next(buf.begin(), buf_read_offset);
-					if (in_buf_itr != buf.end()) {
-						buf.erase(in_buf_itr, buf.end());
-					}
-					// Yes we have. Retrieve from the buffer and update the buffer status
-					std::vector<unsigned char>::iterator itr = std::next(read_buf_.begin(), size_bytes_to_read);
-					std::move(read_buf_.begin(), itr, std::back_inserter(buf));
+				// Return whatever is already buffered, partial reads are allowed
+				if (0 < curr_read_buf_size_) {
+					size_t bytes_to_copy = std::min(curr_read_buf_size_, size_bytes_to_read);
+					std::vector<unsigned char>::iterator itr = std::next(read_buf_.begin(), bytes_to_copy);
+					std::copy(read_buf_.begin(), itr, std::next(buf.begin(), buf_read_offset));
 					read_buf_.erase(read_buf_.begin(), itr);
 
 					// Update buffer status
-					curr_read_buf_size_ -= size_bytes_to_read;
-					size_read_bytes_out = size_bytes_to_read;
+					curr_read_buf_size_ -= bytes_to_copy;
+					size_read_bytes_out = bytes_to_copy;
 					continue_polling = false;
 				} else {
-					// Unfortunately we don't. Retrieve a new wss frame from network
+					// Nothing buffered. Retrieve a new wss frame from network
 					wslay_frame_iocb *new_ws_frame = static_cast<wslay_frame_iocb *> (wss_frame_read_.get());
 					ssize_t ws_read_res = wslay_frame_recv(p_wslay_frame_Context_, new_ws_frame);
 					if (ws_read_res < 0) {
@@ -212,6 +209,18 @@ namespace awsiotsdk {
 			return ret_code;
 		}
 
+		ResponseCode WebSocketConnection::WaitForReadableInternal(std::chrono::milliseconds timeout) {
+			// Data from a previously received frame can be returned right away
+			if(0 < curr_read_buf_size_) {
+				return ResponseCode::SUCCESS;
+			}
+			return openssl_connection_.WaitForReadable(timeout);
+		}
+
+		ResponseCode WebSocketConnection::WaitForWritableInternal(std::chrono::milliseconds timeout) {
+			return openssl_connection_.WaitForWritable(timeout);
+		}
+
 		size_t WebSocketConnection::AppendBytesToBuffer(const char *dest_buf, size_t num_bytes_to_append) {
 			size_t itr;
 			for (itr = 0; itr < num_bytes_to_append; itr++) {
@@ -238,11 +247,26 @@ namespace awsiotsdk {
 		}
 
 		ResponseCode WebSocketConnection::WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+			return SendBinaryFrame((const unsigned char *)(buf.c_str()), buf.length(), size_written_bytes_out);
+		}
+
+		ResponseCode WebSocketConnection::WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+														 size_t &size_written_bytes_out) {
+			if(1 == segment_count) {
+				return SendBinaryFrame((const unsigned char *)(p_segments[0].data()), p_segments[0].length(),
+									   size_written_bytes_out);
+			}
+			// Per-message deflate requires a complete Mqtt packet being packed into ONE ws frame
+			const util::String &joined_buf = JoinSegments(p_segments, segment_count);
+			return SendBinaryFrame((const unsigned char *)(joined_buf.c_str()), joined_buf.length(),
+								   size_written_bytes_out);
+		}
+
+		ResponseCode WebSocketConnection::SendBinaryFrame(const unsigned char *buf_temp, size_t size_bytes_to_write,
+														  size_t &size_written_bytes_out) {
 			ResponseCode ret_code = ResponseCode::SUCCESS;
-			size_t size_bytes_to_write = buf.length();
 			// Per-message deflate requires a complete Mqtt packet being packed into ONE ws frame
 			wslay_frame_iocb *new_ws_frame = static_cast<wslay_frame_iocb *>(wss_frame_write_.get());
-			const unsigned char *buf_temp = (const unsigned char *)(buf.c_str());
 			EncodeWsFrameAsFinNoRsvNoExt(new_ws_frame, WSLAY_BINARY_FRAME, 1, buf_temp, size_bytes_to_write);
 
 			// Send out this ws frame
@@ -288,6 +312,10 @@ namespace awsiotsdk {
 			return openssl_connection_.IsPhysicalLayerConnected();
 		}
 
+		int WebSocketConnection::GetSocketDescriptor() {
+			return openssl_connection_.GetSocketDescriptor();
+		}
+
 		WebSocketConnection::~WebSocketConnection() {
 			delete p_wslay_frame_Callbacks_;
 			wslay_frame_context_free(p_wslay_frame_Context_);
@@ -685,13 +713,21 @@ namespace awsiotsdk {
 
 		ResponseCode WebSocketConnection::ReadFromNetworkBuffer(util::Vector<unsigned char> &read_buf, size_t bytes_to_read) {
 			size_t total_read_bytes = 0;
+			size_t cur_read_bytes = 0;
+			ResponseCode rc = ResponseCode::SUCCESS;
 
 			read_buf.resize(bytes_to_read);
-			// TODO: Add support for partial reads
-			ResponseCode rc = openssl_connection_.Read(read_buf, 0, bytes_to_read, total_read_bytes);
-
-			if(ResponseCode::SUCCESS == rc && total_read_bytes != bytes_to_read) {
-				rc = ResponseCode::NETWORK_SSL_READ_ERROR;
+			// Reads can return partial data, keep reading until the requested bytes are received
+			while(total_read_bytes < bytes_to_read) {
+				cur_read_bytes = 0;
+				rc = openssl_connection_.Read(read_buf, total_read_bytes, bytes_to_read - total_read_bytes, cur_read_bytes);
+				if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc && 0 < total_read_bytes) {
+					// Rest of the frame is still in flight
+					continue;
+				} else if(ResponseCode::SUCCESS != rc) {
+					break;
+				}
+				total_read_bytes += cur_read_bytes;
 			}
 
 			return rc;
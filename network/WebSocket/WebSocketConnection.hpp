@@ -132,6 +132,31 @@ namespace awsiotsdk {
 			 */
 			ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out);
 
+			/**
+			 * @brief Write a list of buffer segments to the network WebSocket
+			 *
+			 * Every write is sent as one binary frame. A single segment is framed directly from the caller's buffer,
+			 * several segments are joined first
+			 *
+			 * @param const util::StringView * - segments to write, in order
+			 * @param size_t - number of segments
+			 * @param size_t - reference to store number of bytes written
+			 * @return ResponseCode - successful write or WebSocket error code
+			 */
+			ResponseCode WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+										size_t &size_written_bytes_out);
+
+			/**
+			 * @brief Send bytes as one binary WebSocket frame
+			 *
+			 * @param const unsigned char * - bytes to send
+			 * @param size_t - number of bytes to send
+			 * @param size_t - reference to store number of bytes written
+			 * @return ResponseCode - successful write or WebSocket error code
+			 */
+			ResponseCode SendBinaryFrame(const unsigned char *buf_temp, size_t size_bytes_to_write,
+										 size_t &size_written_bytes_out);
+
 			/**
 			 * @brief Read bytes from the network WebSocket
 			 *
@@ -150,6 +175,22 @@ namespace awsiotsdk {
 			 */
 			ResponseCode DisconnectInternal();
 
+			/**
+			 * @brief Wait until data can be read from the network socket
+			 *
+			 * @param std::chrono::milliseconds - max time to wait
+			 * @return ResponseCode - SUCCESS if data is available, NETWORK_SSL_NOTHING_TO_READ on timeout or TLS error code
+			 */
+			ResponseCode WaitForReadableInternal(std::chrono::milliseconds timeout);
+
+			/**
+			 * @brief Wait until data can be written to the network socket
+			 *
+			 * @param std::chrono::milliseconds - max time to wait
+			 * @return ResponseCode - SUCCESS if data can be written, NETWORK_SSL_WRITE_TIMEOUT_ERROR on timeout or TLS error code
+			 */
+			ResponseCode WaitForWritableInternal(std::chrono::milliseconds timeout);
+
 			void InitializeCredentialScope(const char *date_stamp, size_t date_stamp_len,
 										   util::String &credential_scope,
 										   util::String &credential_scope_url_encode) const;
@@ -226,6 +267,13 @@ namespace awsiotsdk {
 			 */
 			bool IsPhysicalLayerConnected();
 
+			/**
+			 * @brief Get the OS socket descriptor used by this connection
+			 *
+			 * @return int - Socket descriptor, only valid while connected
+			 */
+			int GetSocketDescriptor();
+
 			virtual ~WebSocketConnection();
 		};
 
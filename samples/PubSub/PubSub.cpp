@@ -53,7 +53,7 @@ namespace awsiotsdk {
 
 			do {
 				util::String payload = "Hello from SDK : ";
-				payload.append(std::to_string(itr));
+				payload.append(util::ToString(itr));
 				std::cout << "Publish Payload : " << payload << std::endl;
 
 				std::unique_ptr<Utf8String> p_topic_name = Utf8String::Create(p_topic_name_str);
@@ -172,10 +172,11 @@ namespace awsiotsdk {
 			if(nullptr == p_iot_client_) {
 				return ResponseCode::FAILURE;
 			}
+			p_iot_client_->SetActionProcessingRate(ConfigCommon::action_processing_rate_hz_);
 
 			util::String client_id_tagged = ConfigCommon::base_client_id_;
 			client_id_tagged.append("_pub_sub_tester_");
-			client_id_tagged.append(std::to_string(rand()));
+			client_id_tagged.append(util::ToString(rand()));
 			std::unique_ptr<Utf8String> client_id = Utf8String::Create(client_id_tagged);
 
 			rc = p_iot_client_->Connect(ConfigCommon::mqtt_command_timeout_, ConfigCommon::is_clean_session_,
@@ -148,10 +148,11 @@ namespace awsiotsdk {
 			if(nullptr == p_iot_client_) {
 				return ResponseCode::FAILURE;
 			}
+			p_iot_client_->SetActionProcessingRate(ConfigCommon::action_processing_rate_hz_);
 
 			util::String client_id_tagged = ConfigCommon::base_client_id_;
 			client_id_tagged.append("_shadow_delta_tester_");
-			client_id_tagged.append(std::to_string(rand()));
+			client_id_tagged.append(util::ToString(rand()));
 			std::unique_ptr<Utf8String> client_id = Utf8String::Create(client_id_tagged);
 
 			rc = p_iot_client_->Connect(ConfigCommon::mqtt_command_timeout_, ConfigCommon::is_clean_session_,
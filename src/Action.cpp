@@ -47,10 +47,16 @@ namespace awsiotsdk {
 		std::atomic_bool & _p_thread_continue_ = *p_thread_continue_;
 		read_buf.resize(bytes_to_read);
 		do {
+			cur_read_bytes = 0;
 			rc = p_network_connection->Read(read_buf, total_read_bytes, bytes_to_read - total_read_bytes, cur_read_bytes);
+			if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc && 0 < total_read_bytes) {
+				// Rest of a partially read request has not arrived yet, keep waiting for it
+				rc = ResponseCode::SUCCESS;
+			}
 			total_read_bytes += cur_read_bytes;
-			if(total_read_bytes != bytes_to_read) {
-				std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS));
+			if(ResponseCode::SUCCESS == rc && total_read_bytes != bytes_to_read && 0 == cur_read_bytes) {
+				// Returns as soon as the rest of the data arrives
+				p_network_connection->WaitForReadable(std::chrono::milliseconds(DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS));
 			}
 		} while(_p_thread_continue_ && total_read_bytes != bytes_to_read && ResponseCode::SUCCESS == rc);
 
@@ -66,9 +72,6 @@ namespace awsiotsdk {
 	}
 
 	ResponseCode Action::WriteToNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection, const util::String &write_buf) {
-		// TODO : Check if there are corner cases for this function not terminating until it has written the required number of bytes
-		// TODO : Is there a more efficient way to do this?
-
 		if(nullptr == p_network_connection) {
 			return ResponseCode::NULL_VALUE_ERROR;
 		}
@@ -77,21 +80,65 @@ namespace awsiotsdk {
 			return ResponseCode::NETWORK_NOTHING_TO_WRITE_ERROR;
 		}
 
+		// Complete writes go out straight from write_buf, partial writes are resumed as a vectored write
+		size_t written_bytes = 0;
+		ResponseCode rc = p_network_connection->Write(write_buf, written_bytes);
+		if(ResponseCode::SUCCESS != rc || write_buf.length() == written_bytes) {
+			return rc;
+		}
+
+		if(!*p_thread_continue_) {
+			return ResponseCode::THREAD_EXITING;
+		}
+
+		util::StringView remaining_buf(write_buf.data() + written_bytes, write_buf.length() - written_bytes);
+		// Returns as soon as the socket can accept more data
+		p_network_connection->WaitForWritable(std::chrono::milliseconds(DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS));
+		return WriteToNetworkBuffer(p_network_connection, &remaining_buf, 1);
+	}
+
+	ResponseCode Action::WriteToNetworkBuffer(std::shared_ptr<NetworkConnection> p_network_connection,
+											  const util::StringView *p_segments, size_t segment_count) {
+		if(nullptr == p_network_connection || nullptr == p_segments) {
+			return ResponseCode::NULL_VALUE_ERROR;
+		}
+
+		size_t bytes_to_write = NetworkConnection::GetSegmentsLength(p_segments, segment_count);
+		if(0 == bytes_to_write) {
+			return ResponseCode::NETWORK_NOTHING_TO_WRITE_ERROR;
+		}
+
 		size_t total_written_bytes = 0;
-		size_t cur_written_bytes = 0;
-		size_t bytes_to_write = write_buf.length();
+		size_t segment_index = 0;
+		size_t segment_offset = 0;
 		ResponseCode rc = ResponseCode::FAILURE;
 
 		std::atomic_bool & _p_thread_continue_ = *p_thread_continue_;
-		util::String temp_buf = write_buf;
 		do {
-			rc = p_network_connection->Write(temp_buf, cur_written_bytes);
+			size_t cur_written_bytes = 0;
+			if(0 == segment_offset) {
+				rc = p_network_connection->WriteV(p_segments + segment_index, segment_count - segment_index,
+												  cur_written_bytes);
+			} else {
+				// Resume inside a segment, the rest of it is written on its own before the following segments
+				util::StringView remaining_segment(p_segments[segment_index].data() + segment_offset,
+												   p_segments[segment_index].length() - segment_offset);
+				rc = p_network_connection->WriteV(&remaining_segment, 1, cur_written_bytes);
+			}
 			total_written_bytes += cur_written_bytes;
-			if(total_written_bytes != bytes_to_write) {
-				temp_buf = write_buf.substr(total_written_bytes);
-				std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS));
+
+			// Skip past the segments that are completely written
+			segment_offset += cur_written_bytes;
+			while(segment_index < segment_count && segment_offset >= p_segments[segment_index].length()) {
+				segment_offset -= p_segments[segment_index].length();
+				segment_index++;
+			}
+
+			if(ResponseCode::SUCCESS == rc && total_written_bytes != bytes_to_write) {
+				// Returns as soon as the socket can accept more data
+				p_network_connection->WaitForWritable(std::chrono::milliseconds(DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS));
 			}
-		} while(_p_thread_continue_ && total_written_bytes != cur_written_bytes && ResponseCode::SUCCESS == rc);
+		} while(_p_thread_continue_ && total_written_bytes != bytes_to_write && ResponseCode::SUCCESS == rc);
 
 		if(ResponseCode::SUCCESS == rc && total_written_bytes != bytes_to_write) {
 			if(!_p_thread_continue_) {
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ActionCompletion.cpp
+ * @brief Completion state of a single request
+ *
+ */
+
+#include "ActionCompletion.hpp"
+
+namespace awsiotsdk {
+	void ActionCompletion::Signal::Notify() {
+		std::lock_guard<std::mutex> signal_lock(signal_lock_);
+		is_signalled_ = true;
+		signal_wait_.notify_all();
+	}
+
+	bool ActionCompletion::Signal::WaitUntil(std::chrono::steady_clock::time_point deadline) {
+		std::unique_lock<std::mutex> signal_lock(signal_lock_);
+		return signal_wait_.wait_until(signal_lock, deadline, [this] { return is_signalled_; });
+	}
+
+	ActionCompletion::ActionCompletion() {
+		is_complete_ = false;
+		response_ = ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR;
+	}
+
+	std::shared_ptr<ActionCompletion> ActionCompletion::Create() {
+		return std::make_shared<ActionCompletion>();
+	}
+
+	ActionData::AsyncAckNotificationHandlerPtr ActionCompletion::GetAckHandler(
+			std::shared_ptr<ActionCompletion> p_action_completion) {
+		return [p_action_completion](uint16_t action_id, ResponseCode rc) {
+			p_action_completion->Complete(rc);
+		};
+	}
+
+	bool ActionCompletion::Complete(ResponseCode rc) {
+		util::Vector<std::shared_ptr<Signal>> signals;
+		{
+			std::lock_guard<std::mutex> completion_lock(completion_lock_);
+			if(is_complete_) {
+				return false;
+			}
+			response_ = rc;
+			is_complete_ = true;
+			completion_wait_.notify_all();
+			signals.swap(signals_);
+		}
+
+		// Signals have their own locks, notify them after releasing the completion lock
+		for(std::shared_ptr<Signal> &p_signal : signals) {
+			p_signal->Notify();
+		}
+		return true;
+	}
+
+	bool ActionCompletion::IsComplete() {
+		std::lock_guard<std::mutex> completion_lock(completion_lock_);
+		return is_complete_;
+	}
+
+	ResponseCode ActionCompletion::GetResponseCode() {
+		std::lock_guard<std::mutex> completion_lock(completion_lock_);
+		return response_;
+	}
+
+	bool ActionCompletion::WaitFor(std::chrono::milliseconds timeout) {
+		std::unique_lock<std::mutex> completion_lock(completion_lock_);
+		return completion_wait_.wait_for(completion_lock, timeout, [this] { return is_complete_; });
+	}
+
+	bool ActionCompletion::WaitUntil(std::chrono::steady_clock::time_point deadline) {
+		std::unique_lock<std::mutex> completion_lock(completion_lock_);
+		return completion_wait_.wait_until(completion_lock, deadline, [this] { return is_complete_; });
+	}
+
+	bool ActionCompletion::AddSignal(std::shared_ptr<Signal> p_signal) {
+		std::lock_guard<std::mutex> completion_lock(completion_lock_);
+		if(is_complete_) {
+			return false;
+		}
+		signals_.push_back(p_signal);
+		return true;
+	}
+
+	void ActionCompletion::RemoveSignal(const std::shared_ptr<Signal> &p_signal) {
+		std::lock_guard<std::mutex> completion_lock(completion_lock_);
+		for(util::Vector<std::shared_ptr<Signal>>::iterator itr = signals_.begin(); itr != signals_.end(); itr++) {
+			if(*itr == p_signal) {
+				signals_.erase(itr);
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ActionFuture.cpp
+ * @brief Handle to the result of an Async request
+ *
+ */
+
+#include "ActionFuture.hpp"
+
+namespace awsiotsdk {
+	ActionFuture::ActionFuture() : p_action_completion_(nullptr), action_id_(0) { }
+
+	ActionFuture::ActionFuture(std::shared_ptr<ActionCompletion> p_action_completion, uint16_t action_id)
+			: p_action_completion_(p_action_completion), action_id_(action_id) { }
+
+	ActionFuture ActionFuture::CreateReady(ResponseCode rc) {
+		std::shared_ptr<ActionCompletion> p_action_completion = ActionCompletion::Create();
+		p_action_completion->Complete(rc);
+		return ActionFuture(p_action_completion, 0);
+	}
+
+	bool ActionFuture::IsReady() const {
+		return nullptr != p_action_completion_ && p_action_completion_->IsComplete();
+	}
+
+	bool ActionFuture::WaitFor(std::chrono::milliseconds timeout) const {
+		return nullptr != p_action_completion_ && p_action_completion_->WaitFor(timeout);
+	}
+
+	ResponseCode ActionFuture::GetResponseCode() const {
+		if(nullptr == p_action_completion_) {
+			return ResponseCode::NULL_VALUE_ERROR;
+		}
+		return p_action_completion_->GetResponseCode();
+	}
+
+	ResponseCode ActionFuture::WaitAll(const util::Vector<ActionFuture> &futures, std::chrono::milliseconds timeout) {
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+		for(const ActionFuture &future : futures) {
+			if(nullptr != future.p_action_completion_ && !future.p_action_completion_->WaitUntil(deadline)) {
+				return ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR;
+			}
+		}
+		return ResponseCode::SUCCESS;
+	}
+
+	ResponseCode ActionFuture::WaitAny(const util::Vector<ActionFuture> &futures, std::chrono::milliseconds timeout,
+									   size_t &ready_index_out) {
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+		std::shared_ptr<ActionCompletion::Signal> p_signal = std::make_shared<ActionCompletion::Signal>();
+
+		// Attach the signal to every pending completion, stop early if one is already complete
+		size_t attached_count = 0;
+		bool is_any_valid = false;
+		bool is_any_ready = false;
+		for(; attached_count < futures.size(); attached_count++) {
+			const std::shared_ptr<ActionCompletion> &p_action_completion = futures[attached_count].p_action_completion_;
+			if(nullptr == p_action_completion) {
+				continue;
+			}
+			is_any_valid = true;
+			if(!p_action_completion->AddSignal(p_signal)) {
+				is_any_ready = true;
+				break;
+			}
+		}
+
+		if(is_any_valid && !is_any_ready) {
+			p_signal->WaitUntil(deadline);
+		}
+
+		for(size_t itr = 0; itr < attached_count; itr++) {
+			if(nullptr != futures[itr].p_action_completion_) {
+				futures[itr].p_action_completion_->RemoveSignal(p_signal);
+			}
+		}
+
+		if(!is_any_valid) {
+			return ResponseCode::NULL_VALUE_ERROR;
+		}
+
+		for(size_t itr = 0; itr < futures.size(); itr++) {
+			if(futures[itr].IsReady()) {
+				ready_index_out = itr;
+				return ResponseCode::SUCCESS;
+			}
+		}
+		return ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR;
+	}
+}
@@ -35,19 +35,52 @@ namespace awsiotsdk {
 		return std::unique_ptr<ClientCore>(new ClientCore(p_network_connection, p_state));
 	}
 
+	std::unique_ptr<ClientCore> ClientCore::Create(std::shared_ptr<NetworkConnection> p_network_connection,
+												   std::shared_ptr<ClientCoreState> p_state,
+												   std::shared_ptr<ClientReactor> p_client_reactor) {
+		if(nullptr == p_network_connection || nullptr == p_state || nullptr == p_client_reactor) {
+			return nullptr;
+		}
+
+		std::unique_ptr<ClientCore> p_client_core
+				= std::unique_ptr<ClientCore>(new ClientCore(p_network_connection, p_state, p_client_reactor));
+		if(nullptr == p_client_core->p_client_reactor_) {
+			return nullptr;
+		}
+		return p_client_core;
+	}
+
 	ClientCore::ClientCore(std::shared_ptr<NetworkConnection> p_network_connection,
 						   std::shared_ptr<ClientCoreState> p_state) {
 		p_client_core_state_ = p_state;
 		p_client_core_state_->p_network_connection_ = p_network_connection;
 		p_client_core_state_->SetProcessQueuedActions(false);
+		reactor_client_id_ = 0;
 
 		std::shared_ptr<std::atomic_bool> thread_task_out_sync = std::make_shared<std::atomic_bool>(true);
 		std::shared_ptr<util::Threading::ThreadTask> thread_task_out = std::shared_ptr<util::Threading::ThreadTask>(
-				new util::Threading::ThreadTask(util::Threading::DestructorAction::JOIN, thread_task_out_sync, "Outbound Action Processing"));
+				new util::Threading::ThreadTask(util::Threading::DestructorAction::JOIN, thread_task_out_sync, "Outbound Action Processing",
+												p_client_core_state_->p_memory_resource_));
 		thread_map_.insert(std::make_pair(ActionType::CORE_PROCESS_OUTBOUND, thread_task_out));
 		thread_task_out->Run(&ClientCoreState::ProcessOutboundActionQueue, p_client_core_state_, thread_task_out_sync);
 	}
 
+	ClientCore::ClientCore(std::shared_ptr<NetworkConnection> p_network_connection,
+						   std::shared_ptr<ClientCoreState> p_state, std::shared_ptr<ClientReactor> p_client_reactor) {
+		p_client_core_state_ = p_state;
+		p_client_core_state_->p_network_connection_ = p_network_connection;
+		p_client_core_state_->SetProcessQueuedActions(false);
+
+		reactor_client_id_ = 0;
+		ResponseCode rc = p_client_reactor->AddClient(p_client_core_state_, reactor_client_id_);
+		if(ResponseCode::SUCCESS != rc) {
+			AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE, "Adding client to the Client Reactor failed with return code : %d",
+						  static_cast<int>(rc));
+		} else {
+			p_client_reactor_ = p_client_reactor;
+		}
+	}
+
 	ResponseCode ClientCore::RegisterAction(ActionType action_type, Action::CreateHandlerPtr p_action_create_handler) {
 		return p_client_core_state_->RegisterAction(action_type, p_action_create_handler, p_client_core_state_);
 	}
@@ -62,6 +95,11 @@ namespace awsiotsdk {
 		return p_client_core_state_->EnqueueOutboundAction(action_type, p_action_data, action_id_out);
 	}
 
+	ResponseCode ClientCore::PerformActionAsync(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+												ActionPriority action_priority, uint16_t &action_id_out) {
+		return p_client_core_state_->EnqueueOutboundAction(action_type, p_action_data, action_priority, action_id_out);
+	}
+
 	ResponseCode ClientCore::CreateActionRunner(ActionType action_type, std::shared_ptr<ActionData> p_action_data) {
 		Action::CreateHandlerPtr p_action_create_handler = nullptr;
 		std::unique_ptr<Action> p_action = nullptr;
@@ -74,11 +112,14 @@ namespace awsiotsdk {
 		p_action = p_action_create_handler(p_client_core_state_);
 		if(nullptr == p_action) {
 			rc = ResponseCode::NULL_VALUE_ERROR;
+		} else if(nullptr != p_client_reactor_) {
+			rc = p_client_reactor_->AddActionRunner(reactor_client_id_, std::move(p_action));
 		} else {
 			std::shared_ptr<std::atomic_bool> thread_task_sync = std::make_shared<std::atomic_bool>(true);
 			p_action->SetParentThreadSync(thread_task_sync);
 			std::shared_ptr<util::Threading::ThreadTask> thread_task = std::shared_ptr<util::Threading::ThreadTask>(
-					new util::Threading::ThreadTask(util::Threading::DestructorAction::JOIN, thread_task_sync, p_action->GetActionInfo()));
+					new util::Threading::ThreadTask(util::Threading::DestructorAction::JOIN, thread_task_sync, p_action->GetActionInfo(),
+													p_client_core_state_->p_memory_resource_));
 			thread_map_.insert(std::make_pair(action_type, thread_task));
 			thread_task->Run(&Action::PerformAction, std::move(p_action), p_client_core_state_->p_network_connection_,
 							 p_action_data);
@@ -88,6 +129,9 @@ namespace awsiotsdk {
 	}
 
 	ClientCore::~ClientCore() {
+		if(nullptr != p_client_reactor_) {
+			p_client_reactor_->RemoveClient(reactor_client_id_);
+		}
 		thread_map_.clear();
 	}
 }
@@ -19,20 +19,39 @@
  *
  */
 
+#include <algorithm>
+
 #include "util/logging/LogMacros.hpp"
 
 #include "ClientCoreState.hpp"
 
-#ifndef MAX_CORE_ACTION_PROCESSING_RATE_HZ
-#define MAX_CORE_ACTION_PROCESSING_RATE_HZ 5
-#endif
-
 #define LOG_TAG_CLIENT_CORE_STATE "[Client Core State]"
 
 namespace awsiotsdk {
-	ClientCoreState::ClientCoreState() {
+	ClientCoreState::ClientCoreState()
+			: pending_ack_tracker_(PENDING_ACK_TABLE_SIZE, std::chrono::milliseconds(PENDING_ACK_TIMER_TICK_MS)) {
 		continue_execution_ = std::make_shared<std::atomic_bool>(true);
+		p_memory_resource_ = nullptr;
+		// Each lane can hold the whole queue, the max queue size is shared between lanes
+		for(size_t itr = 0; itr < ACTION_PRIORITY_LANE_COUNT; itr++) {
+			p_outbound_action_queues_[itr] = std::unique_ptr<OutboundActionQueue>(
+					new OutboundActionQueue(MAX_ACTION_QUEUE_CAPACITY));
+		}
+		high_priority_drain_count_ = 0;
+		overflow_policy_ = ActionQueueOverflowPolicy::REJECT;
+		overflow_block_timeout_ms_ = 0;
+		dropped_action_count_ = 0;
+		blocked_producer_count_ = 0;
+		ack_timeout_ = std::chrono::milliseconds(DEFAULT_PENDING_ACK_TIMEOUT_MS);
+		next_ack_expiry_check_time_ = std::chrono::steady_clock::now();
+		next_rate_limited_action_time_ = next_ack_expiry_check_time_;
+		p_outbound_action_notify_handler_ = nullptr;
+		is_outbound_thread_waiting_ = false;
+		outbound_action_queue_length_ = 0;
 		max_queue_size_ = DEFAULT_MAX_QUEUE_SIZE;
+		action_processing_rate_hz_ = DEFAULT_ACTION_PROCESSING_RATE_HZ;
+		write_coalescing_max_bytes_ = DEFAULT_WRITE_COALESCING_MAX_BYTES;
+		write_coalescing_max_delay_us_ = DEFAULT_WRITE_COALESCING_MAX_DELAY_US;
 		max_hardware_threads_ = std::thread::hardware_concurrency();
 		cur_core_threads_ = 0;
 		next_action_id_ = 1;
@@ -69,18 +88,199 @@ namespace awsiotsdk {
 	ResponseCode
 	ClientCoreState::EnqueueOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
 										   uint16_t &action_id_out) {
-		if(outbound_action_queue_.size() >= max_queue_size_) {
-			// TODO : Add option to overwrite oldest action
-			return ResponseCode::ACTION_QUEUE_FULL;
+		ActionPriority action_priority = (ActionType::PUBLISH == action_type || ActionType::PUBLISH_BATCH == action_type)
+										 ? ActionPriority::NORMAL : ActionPriority::CONTROL;
+		return EnqueueOutboundAction(action_type, p_action_data, action_priority, action_id_out);
+	}
+
+	ResponseCode
+	ClientCoreState::EnqueueOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+										   ActionPriority action_priority, uint16_t &action_id_out) {
+		// Reserve a slot first, the queue itself is sized for the largest allowed max_queue_size_
+		ResponseCode rc = ReserveOutboundQueueSlot(action_priority);
+		if(ResponseCode::SUCCESS != rc) {
+			NotifyActionDropped(action_type, p_action_data, rc);
+			return rc;
 		}
 
 		action_id_out = GetNextActionId();
 		p_action_data->SetActionId(action_id_out);
-		outbound_action_queue_.push(std::make_pair(action_type, p_action_data));
+		std::pair<ActionType, std::shared_ptr<ActionData>> queued_action = std::make_pair(action_type, p_action_data);
+		if(!p_outbound_action_queues_[static_cast<size_t>(action_priority)]->TryEnqueue(queued_action)) {
+			// Reserved slots, including Control slots past the limit, never exceed the lane capacity. Report the
+			// action as dropped anyway in case that invariant is ever broken
+			ReleaseOutboundQueueSlot();
+			NotifyActionDropped(action_type, p_action_data, ResponseCode::ACTION_QUEUE_FULL);
+			return ResponseCode::ACTION_QUEUE_FULL;
+		}
 
+		NotifyOutboundThread();
 		return ResponseCode::SUCCESS;
 	}
 
+	ResponseCode ClientCoreState::ReserveOutboundQueueSlot(ActionPriority action_priority) {
+		ActionQueueOverflowPolicy overflow_policy = overflow_policy_;
+		std::chrono::steady_clock::time_point block_deadline = std::chrono::steady_clock::now()
+															   + std::chrono::milliseconds(overflow_block_timeout_ms_);
+		bool is_drop_attempted = false;
+		for(;;) {
+			size_t cur_queue_length = outbound_action_queue_length_;
+			while(cur_queue_length < max_queue_size_) {
+				if(outbound_action_queue_length_.compare_exchange_weak(cur_queue_length, cur_queue_length + 1)) {
+					return ResponseCode::SUCCESS;
+				}
+			}
+
+			if(ActionQueueOverflowPolicy::DROP_OLDEST == overflow_policy
+			   || ActionQueueOverflowPolicy::DROP_OLDEST_NORMAL_PRIORITY_FIRST == overflow_policy) {
+				if(DropOldestQueuedAction(overflow_policy, action_priority)) {
+					return ResponseCode::SUCCESS;
+				}
+				// Nothing that can be dropped is queued, retry once in case the outbound thread freed up space
+				if(is_drop_attempted) {
+					return ResponseCode::ACTION_QUEUE_FULL;
+				}
+				is_drop_attempted = true;
+			} else if(ActionQueueOverflowPolicy::BLOCK_WITH_TIMEOUT == overflow_policy
+					  && ActionPriority::CONTROL == action_priority) {
+				// Control actions are enqueued by the network read thread (eg. Pubacks), which can also be the thread
+				// draining the queue. Take a slot past the limit instead of blocking, up to the lane capacity
+				while(cur_queue_length < MAX_ACTION_QUEUE_CAPACITY) {
+					if(outbound_action_queue_length_.compare_exchange_weak(cur_queue_length, cur_queue_length + 1)) {
+						return ResponseCode::SUCCESS;
+					}
+				}
+				return ResponseCode::ACTION_QUEUE_FULL;
+			} else if(ActionQueueOverflowPolicy::BLOCK_WITH_TIMEOUT == overflow_policy) {
+				std::unique_lock<std::mutex> space_lock(outbound_action_queue_space_lock_);
+				blocked_producer_count_++;
+				bool is_space_available = outbound_action_queue_space_wait_.wait_until(space_lock, block_deadline, [this] {
+					// Pairs with the fence in ReleaseOutboundQueueSlot
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					return outbound_action_queue_length_ < max_queue_size_;
+				});
+				blocked_producer_count_--;
+				if(!is_space_available) {
+					return ResponseCode::ACTION_QUEUE_FULL;
+				}
+			} else {
+				return ResponseCode::ACTION_QUEUE_FULL;
+			}
+		}
+	}
+
+	bool ClientCoreState::DropOldestQueuedAction(ActionQueueOverflowPolicy overflow_policy,
+												 ActionPriority action_priority) {
+		// Control actions are never dropped
+		ActionPriority drop_order[2] = {ActionPriority::NORMAL, ActionPriority::HIGH};
+		if(ActionQueueOverflowPolicy::DROP_OLDEST == overflow_policy && ActionPriority::HIGH == action_priority) {
+			drop_order[0] = ActionPriority::HIGH;
+			drop_order[1] = ActionPriority::NORMAL;
+		}
+
+		std::pair<ActionType, std::shared_ptr<ActionData>> dropped_action;
+		for(ActionPriority drop_priority : drop_order) {
+			if(p_outbound_action_queues_[static_cast<size_t>(drop_priority)]->TryDequeue(dropped_action)) {
+				ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler = dropped_action.second->p_async_ack_handler_;
+				if(nullptr != p_async_ack_handler) {
+					p_async_ack_handler(dropped_action.second->GetActionId(), ResponseCode::ACTION_DROPPED);
+				}
+				NotifyActionDropped(dropped_action.first, dropped_action.second, ResponseCode::ACTION_DROPPED);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ClientCoreState::NotifyActionDropped(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+											  ResponseCode rc) {
+		dropped_action_count_++;
+
+		ActionDropHandlerPtr p_action_drop_handler = nullptr;
+		{
+			std::lock_guard<std::mutex> drop_handler_lock(action_drop_handler_lock_);
+			p_action_drop_handler = p_action_drop_handler_;
+		}
+		if(nullptr != p_action_drop_handler) {
+			p_action_drop_handler(action_type, p_action_data, rc);
+		}
+	}
+
+	void ClientCoreState::ReleaseOutboundQueueSlot() {
+		outbound_action_queue_length_--;
+		// Pairs with the fence in ReserveOutboundQueueSlot, either the blocked producer count is seen here
+		// or the producer sees the released slot before going to sleep
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(0 < blocked_producer_count_) {
+			std::lock_guard<std::mutex> space_lock(outbound_action_queue_space_lock_);
+			outbound_action_queue_space_wait_.notify_one();
+		}
+	}
+
+	void ClientCoreState::SetActionQueueOverflowPolicy(ActionQueueOverflowPolicy overflow_policy,
+													   std::chrono::milliseconds block_timeout) {
+		overflow_block_timeout_ms_ = static_cast<uint32_t>(block_timeout.count());
+		overflow_policy_ = overflow_policy;
+	}
+
+	void ClientCoreState::SetActionDropHandler(ActionDropHandlerPtr p_action_drop_handler) {
+		std::lock_guard<std::mutex> drop_handler_lock(action_drop_handler_lock_);
+		p_action_drop_handler_ = p_action_drop_handler;
+	}
+
+	void ClientCoreState::SetWriteCoalescing(size_t max_bytes, std::chrono::microseconds max_delay) {
+		write_coalescing_max_delay_us_ = static_cast<uint32_t>(max_delay.count());
+		write_coalescing_max_bytes_ = max_bytes;
+		NotifyOutboundThread();
+	}
+
+	void ClientCoreState::NotifyOutboundThread() {
+		// Pairs with the fence in ProcessOutboundActionQueue, either the waiting flag is seen here
+		// or the outbound thread sees the queued action before going to sleep
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(is_outbound_thread_waiting_) {
+			std::lock_guard<std::mutex> queue_lock(outbound_action_queue_lock_);
+			outbound_action_queue_wait_.notify_one();
+		}
+		if(nullptr != p_outbound_action_notify_handler_) {
+			p_outbound_action_notify_handler_();
+		}
+	}
+
+	bool ClientCoreState::IsOutboundActionQueueEmpty() const {
+		for(size_t itr = 0; itr < ACTION_PRIORITY_LANE_COUNT; itr++) {
+			if(!p_outbound_action_queues_[itr]->IsEmpty()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ClientCoreState::DequeueDataAction(std::pair<ActionType, std::shared_ptr<ActionData>> &queued_action) {
+		OutboundActionQueue &high_priority_queue = *p_outbound_action_queues_[static_cast<size_t>(ActionPriority::HIGH)];
+		OutboundActionQueue &normal_priority_queue = *p_outbound_action_queues_[static_cast<size_t>(ActionPriority::NORMAL)];
+
+		if(HIGH_PRIORITY_ACTION_DRAIN_WEIGHT <= high_priority_drain_count_ && normal_priority_queue.TryDequeue(queued_action)) {
+			high_priority_drain_count_ = 0;
+			return true;
+		}
+		if(high_priority_queue.TryDequeue(queued_action)) {
+			high_priority_drain_count_++;
+			return true;
+		}
+		if(normal_priority_queue.TryDequeue(queued_action)) {
+			high_priority_drain_count_ = 0;
+			return true;
+		}
+		return false;
+	}
+
+	void ClientCoreState::SetProcessQueuedActions(bool process_queued_actions) {
+		process_queued_actions_ = process_queued_actions;
+		NotifyOutboundThread();
+	}
+
 	ResponseCode
 	ClientCoreState::GetActionCreateHandler(ActionType action_type, Action::CreateHandlerPtr *p_action_create_handler) {
 		ResponseCode rc = ResponseCode::FAILURE;
@@ -94,94 +294,320 @@ namespace awsiotsdk {
 		return rc;
 	}
 
-	void ClientCoreState::SyncActionHandler(uint16_t action_id, ResponseCode rc) {
-		std::lock_guard<std::mutex> block_handler_lock(sync_action_response_lock_);
-		sync_action_response_ = rc;
-		sync_action_response_wait_.notify_all();
-	}
-
 	ResponseCode ClientCoreState::PerformAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
 												std::chrono::milliseconds action_reponse_timeout) {
-		std::lock_guard<std::mutex> sync_action_lock(sync_action_request_lock_);
-		ResponseCode rc = ResponseCode::FAILURE;
-
 		util::Map<ActionType, std::unique_ptr<Action>>::const_iterator itr = action_map_.find(action_type);
 		if(itr == action_map_.end()) {
-			rc = ResponseCode::ACTION_NOT_REGISTERED_ERROR;
+			return ResponseCode::ACTION_NOT_REGISTERED_ERROR;
+		}
+
+		std::shared_ptr<ActionCompletion> p_action_completion = ActionCompletion::Create();
+		p_action_data->p_async_ack_handler_ = ActionCompletion::GetAckHandler(p_action_completion);
+		p_action_data->SetActionId(GetNextActionId());
+
+		ResponseCode rc = ResponseCode::FAILURE;
+		{
+			std::lock_guard<std::mutex> perform_action_lock(perform_action_lock_);
+			rc = itr->second->PerformAction(p_network_connection_, p_action_data);
+		}
+		if(nullptr != p_outbound_action_notify_handler_) {
+			// Lets a Client Reactor pick up a connection that was just established by this Action
+			p_outbound_action_notify_handler_();
+		}
+
+		// Actions can change the Action ID, eg. Connect uses a reserved ID. An Ack that is being dispatched is still
+		// reported as pending, so if it is not pending and not complete no Ack was registered for this Action
+		uint16_t action_id = p_action_data->GetActionId();
+		if(ResponseCode::SUCCESS == rc && (IsAckPending(action_id) || p_action_completion->IsComplete())) {
+			if(p_action_completion->WaitFor(action_reponse_timeout)) {
+				rc = p_action_completion->GetResponseCode();
+			} else {
+				DeletePendingAck(action_id);
+				rc = ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR;
+			}
+		}
+
+		return rc;
+	}
+
+	ResponseCode ClientCoreState::SetActionRateLimit(ActionType action_type, uint32_t rate_per_sec,
+													 uint32_t burst_size) {
+		std::lock_guard<std::mutex> rate_limit_lock(action_rate_limit_lock_);
+		util::Map<ActionType, std::unique_ptr<util::Threading::TokenBucket>>::iterator itr
+				= action_rate_limit_map_.find(action_type);
+		if(0 == rate_per_sec) {
+			if(itr != action_rate_limit_map_.end()) {
+				action_rate_limit_map_.erase(itr);
+			}
+		} else if(itr != action_rate_limit_map_.end()) {
+			itr->second->Configure(rate_per_sec, burst_size);
 		} else {
-			std::unique_lock<std::mutex> block_handler_lock(sync_action_response_lock_);
-			{
-				sync_action_response_ = ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR;
-				p_action_data->p_async_ack_handler_ = std::bind(&ClientCoreState::SyncActionHandler, this,
-															   std::placeholders::_1, std::placeholders::_2);
-				p_action_data->SetActionId(GetNextActionId());
-				rc = itr->second->PerformAction(p_network_connection_, p_action_data);
+			action_rate_limit_map_.insert(std::make_pair(action_type, std::unique_ptr<util::Threading::TokenBucket>(
+					new util::Threading::TokenBucket(rate_per_sec, burst_size))));
+		}
+
+		return ResponseCode::SUCCESS;
+	}
+
+	bool ClientCoreState::TryTakeActionToken(ActionType action_type, const std::shared_ptr<ActionData> &p_action_data,
+											 std::chrono::steady_clock::time_point now,
+											 std::chrono::steady_clock::time_point &next_wakeup_time) {
+		std::lock_guard<std::mutex> rate_limit_lock(action_rate_limit_lock_);
+		util::Threading::TokenBucket *p_action_bucket = nullptr;
+		util::Threading::TokenBucket *p_publish_bucket = nullptr;
+		util::Map<ActionType, std::unique_ptr<util::Threading::TokenBucket>>::iterator itr
+				= action_rate_limit_map_.find(action_type);
+		if(itr != action_rate_limit_map_.end()) {
+			p_action_bucket = itr->second.get();
+		}
+		uint32_t packet_count = 1;
+		if(ActionType::PUBLISH_BATCH == action_type) {
+			packet_count = p_action_data->GetPacketCount();
+			itr = action_rate_limit_map_.find(ActionType::PUBLISH);
+			if(itr != action_rate_limit_map_.end()) {
+				p_publish_bucket = itr->second.get();
 			}
+		}
 
-			if(ResponseCode::SUCCESS == rc && pending_ack_map_.find(p_action_data->GetActionId()) != pending_ack_map_.end()) {
-				sync_action_response_wait_.wait_for(block_handler_lock, action_reponse_timeout);
-				rc = sync_action_response_;
+		std::chrono::steady_clock::time_point available_time = now;
+		if(nullptr != p_action_bucket) {
+			available_time = std::max(available_time, p_action_bucket->GetNextAvailableTime(now));
+		}
+		if(nullptr != p_publish_bucket) {
+			available_time = std::max(available_time, p_publish_bucket->GetNextAvailableTime(now, packet_count));
+		}
+		if(available_time > now) {
+			if(available_time < next_wakeup_time) {
+				next_wakeup_time = available_time;
 			}
+			return false;
 		}
 
-		return rc;
+		if(nullptr != p_action_bucket) {
+			p_action_bucket->TryConsume(now);
+		}
+		if(nullptr != p_publish_bucket) {
+			p_publish_bucket->TryConsume(now, packet_count);
+		}
+		return true;
 	}
 
-	void ClientCoreState::ProcessOutboundActionQueue(std::shared_ptr<std::atomic_bool> thread_task_out_sync) {
-		ResponseCode rc = ResponseCode::SUCCESS;
-		int action_execution_delay = 1000 / MAX_CORE_ACTION_PROCESSING_RATE_HZ;
-		std::atomic_bool &_thread_task_out_sync = *thread_task_out_sync;
-		do {
-			// Reset ResponseCode state
-			rc = ResponseCode::SUCCESS;
-			if(/*!process_queued_actions_ || */outbound_action_queue_.empty()) {
-				std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS));
-				continue;
+	bool ClientCoreState::GetNextOutboundAction(std::chrono::steady_clock::time_point now,
+												std::chrono::steady_clock::time_point &next_wakeup_time,
+												ActionType &action_type_out,
+												std::shared_ptr<ActionData> &p_action_data_out) {
+		std::pair<ActionType, std::shared_ptr<ActionData>> control_action;
+		OutboundActionQueue &control_queue = *p_outbound_action_queues_[static_cast<size_t>(ActionPriority::CONTROL)];
+		while(control_queue.TryDequeue(control_action)) {
+			if(TakeOrDeferAction(control_action, now, next_wakeup_time, action_type_out, p_action_data_out)) {
+				return true;
+			}
+		}
+
+		// Deferred actions were queued before any data action that is still in the queue
+		for(auto &deferred_actions : deferred_action_map_) {
+			if(!deferred_actions.second.empty()
+			   && TryTakeActionToken(deferred_actions.first, deferred_actions.second.front(), now, next_wakeup_time)) {
+				action_type_out = deferred_actions.first;
+				p_action_data_out = std::move(deferred_actions.second.front());
+				deferred_actions.second.pop();
+				return true;
 			}
-			std::lock_guard<std::mutex> sync_action_lock(sync_action_request_lock_);
-			auto next = std::chrono::system_clock::now() + std::chrono::milliseconds(action_execution_delay);
-			ActionType action_type = outbound_action_queue_.front().first;
-			std::shared_ptr<ActionData> p_action_data = outbound_action_queue_.front().second;
+		}
 
-			outbound_action_queue_.pop();
-			util::Map<ActionType, std::unique_ptr<Action>>::const_iterator itr = action_map_.find(action_type);
-			ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler =  p_action_data->p_async_ack_handler_;
-			if(itr != action_map_.end()) {
-				if(nullptr != p_async_ack_handler) {
-					// Add Ack before sending request. Read request runs in separate thread and may receive response
-					// before ack is added, if we add it after sending the request.
-					rc = RegisterPendingAck(p_action_data->GetActionId(), p_async_ack_handler);
-					if(ResponseCode::SUCCESS != rc) {
-						p_async_ack_handler(p_action_data->GetActionId(), rc);
-						AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
-									  "Registering Ack Handler for Outbound Queued Action failed with return code : %d",
-									  static_cast<int>(rc));
-					}
+		std::pair<ActionType, std::shared_ptr<ActionData>> queued_action;
+		while(DequeueDataAction(queued_action)) {
+			if(TakeOrDeferAction(queued_action, now, next_wakeup_time, action_type_out, p_action_data_out)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool ClientCoreState::TakeOrDeferAction(std::pair<ActionType, std::shared_ptr<ActionData>> &queued_action,
+											std::chrono::steady_clock::time_point now,
+											std::chrono::steady_clock::time_point &next_wakeup_time,
+											ActionType &action_type_out,
+											std::shared_ptr<ActionData> &p_action_data_out) {
+		util::Queue<std::shared_ptr<ActionData>> &deferred_actions = deferred_action_map_[queued_action.first];
+		// Keep actions of the same type in order, others can still go ahead
+		if(deferred_actions.empty()
+		   && TryTakeActionToken(queued_action.first, queued_action.second, now, next_wakeup_time)) {
+			action_type_out = queued_action.first;
+			p_action_data_out = std::move(queued_action.second);
+			return true;
+		}
+		deferred_actions.push(std::move(queued_action.second));
+		return false;
+	}
+
+	void ClientCoreState::PerformOutboundAction(ActionType action_type, std::shared_ptr<ActionData> p_action_data,
+												std::shared_ptr<NetworkConnection> p_network_connection) {
+		ResponseCode rc = ResponseCode::SUCCESS;
+		util::Map<ActionType, std::unique_ptr<Action>>::const_iterator itr = action_map_.find(action_type);
+		ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler = p_action_data->p_async_ack_handler_;
+		if(itr != action_map_.end()) {
+			if(nullptr != p_async_ack_handler) {
+				// Add Ack before sending request. Read request runs in separate thread and may receive response
+				// before ack is added, if we add it after sending the request.
+				rc = RegisterPendingAck(p_action_data->GetActionId(), p_async_ack_handler);
+				if(ResponseCode::SUCCESS != rc) {
+					p_async_ack_handler(p_action_data->GetActionId(), rc);
+					AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
+								  "Registering Ack Handler for Outbound Queued Action failed with return code : %d",
+								  static_cast<int>(rc));
+				}
+			}
+			// rc will be ResponseCode::SUCCESS by default at this point if no Ack handler was provided
+			if(ResponseCode::SUCCESS == rc) {
+				{
+					std::lock_guard<std::mutex> perform_action_lock(perform_action_lock_);
+					rc = itr->second->PerformAction(p_network_connection, p_action_data);
 				}
-				// rc will be ResponseCode::SUCCESS by default at this point if no Ack handler was provided
-				if(ResponseCode::SUCCESS == rc) {
-					rc = itr->second->PerformAction(p_network_connection_, p_action_data);
-					if(ResponseCode::SUCCESS != rc) {
-						if(nullptr != p_async_ack_handler) {
-							// Delete waiting for Ack for Failed Actions
-							DeletePendingAck(p_action_data->GetActionId());
-							p_async_ack_handler(p_action_data->GetActionId(), rc);
-						}
-						AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
-									  "Performing Outbound Queued Action failed with return code : %d",
-									  static_cast<int>(rc));
+				if(ResponseCode::SUCCESS != rc) {
+					if(nullptr != p_async_ack_handler) {
+						// Delete waiting for Ack for Failed Actions
+						DeletePendingAck(p_action_data->GetActionId());
+						p_async_ack_handler(p_action_data->GetActionId(), rc);
 					}
+					AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
+								  "Performing Outbound Queued Action failed with return code : %d",
+								  static_cast<int>(rc));
 				}
-			} else {
-				rc = ResponseCode::ACTION_NOT_REGISTERED_ERROR;
+			}
+		} else {
+			rc = ResponseCode::ACTION_NOT_REGISTERED_ERROR;
+			AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
+						  "Performing Outbound Queued Action failed with return code : %d",
+						  static_cast<int>(rc));
+		}
+	}
+
+	bool ClientCoreState::IsCoalescableAction(ActionType action_type) {
+		return ActionType::PUBLISH == action_type || ActionType::PUBACK == action_type
+			   || ActionType::SUBSCRIBE == action_type || ActionType::UNSUBSCRIBE == action_type;
+	}
+
+	void ClientCoreState::PerformOrCoalesceOutboundAction(ActionType action_type,
+														  std::shared_ptr<ActionData> p_action_data,
+														  const std::atomic_bool &thread_continue) {
+		size_t write_coalescing_max_bytes = write_coalescing_max_bytes_;
+		if(0 == write_coalescing_max_bytes || !IsCoalescableAction(action_type) || nullptr == p_network_connection_) {
+			// Keep the order of writes, anything coalesced so far goes first
+			FlushCoalescedWrites(thread_continue);
+			PerformOutboundAction(action_type, std::move(p_action_data), p_network_connection_);
+			return;
+		}
+
+		if(nullptr == p_coalescing_network_connection_) {
+			p_coalescing_network_connection_ = std::make_shared<CoalescingNetworkConnection>(p_network_connection_);
+		}
+		if(0 == p_coalescing_network_connection_->GetCoalescedLength()) {
+			coalesced_write_deadline_ = std::chrono::steady_clock::now()
+										+ std::chrono::microseconds(write_coalescing_max_delay_us_);
+		}
+
+		coalesced_action_ids_.push_back(p_action_data->GetActionId());
+		PerformOutboundAction(action_type, std::move(p_action_data), p_coalescing_network_connection_);
+
+		if(write_coalescing_max_bytes <= p_coalescing_network_connection_->GetCoalescedLength()
+		   || std::chrono::steady_clock::now() >= coalesced_write_deadline_) {
+			FlushCoalescedWrites(thread_continue);
+		}
+	}
+
+	void ClientCoreState::FlushCoalescedWrites(const std::atomic_bool &thread_continue) {
+		ResponseCode rc = ResponseCode::SUCCESS;
+		if(nullptr != p_coalescing_network_connection_ && 0 != p_coalescing_network_connection_->GetCoalescedLength()) {
+			{
+				// Sync Actions write to the connection directly, keep their packets out of a partially flushed buffer
+				std::lock_guard<std::mutex> perform_action_lock(perform_action_lock_);
+				rc = p_coalescing_network_connection_->Flush(thread_continue);
+			}
+			if(ResponseCode::SUCCESS != rc) {
 				AWS_LOG_ERROR(LOG_TAG_CLIENT_CORE_STATE,
-							  "Performing Outbound Queued Action failed with return code : %d",
-							  static_cast<int>(rc));
+							  "Writing %d coalesced Outbound Actions failed with return code : %d",
+							  static_cast<int>(coalesced_action_ids_.size()), static_cast<int>(rc));
 			}
+		}
+
+		// Actions without a response were held back until their request reached the network
+		for(uint16_t action_id : coalesced_written_ack_ids_) {
+			ForwardReceivedAck(action_id, rc);
+		}
+		if(ResponseCode::SUCCESS != rc) {
+			// Actions without a pending Ack have either been completed above or did not register one
+			for(uint16_t action_id : coalesced_action_ids_) {
+				ForwardReceivedAck(action_id, rc);
+			}
+		}
+		coalesced_written_ack_ids_.clear();
+		coalesced_action_ids_.clear();
+	}
+
+	bool ClientCoreState::ProcessNextOutboundAction(const std::atomic_bool &thread_continue,
+													std::chrono::steady_clock::time_point &next_wakeup_time_out) {
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if(now >= next_ack_expiry_check_time_) {
+			DeleteExpiredAcks();
+			next_ack_expiry_check_time_ = now + std::chrono::milliseconds(PENDING_ACK_TIMER_TICK_MS);
+		}
+
+		// Wake up is bounded so that the caller can still exit when its sync point is cleared
+		next_wakeup_time_out = now + std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+		if(now < next_rate_limited_action_time_) {
+			// Writes of the previous action were flushed when it was performed
+			if(next_rate_limited_action_time_ < next_wakeup_time_out) {
+				next_wakeup_time_out = next_rate_limited_action_time_;
+			}
+			return false;
+		}
+
+		ActionType action_type = ActionType::RESERVED_ACTION;
+		std::shared_ptr<ActionData> p_action_data = nullptr;
+		if(!process_queued_actions_
+		   || !GetNextOutboundAction(now, next_wakeup_time_out, action_type, p_action_data)) {
+			// Nothing else is ready, send coalesced writes before going to sleep
+			FlushCoalescedWrites(thread_continue);
+			return false;
+		}
+		ReleaseOutboundQueueSlot();
+
+		uint32_t action_processing_rate_hz = action_processing_rate_hz_;
+		if(0 != action_processing_rate_hz) {
 			// This is not perfect since we have no control over how long an action takes.
 			// But it will definitely ensure that we don't exceed the max rate
-			std::this_thread::sleep_until(next);
+			next_rate_limited_action_time_ = std::chrono::steady_clock::now()
+											 + std::chrono::microseconds(1000000 / action_processing_rate_hz);
+		}
+
+		PerformOrCoalesceOutboundAction(action_type, std::move(p_action_data), thread_continue);
+
+		if(0 != action_processing_rate_hz) {
+			FlushCoalescedWrites(thread_continue);
+		}
+		return true;
+	}
+
+	void ClientCoreState::ProcessOutboundActionQueue(std::shared_ptr<std::atomic_bool> thread_task_out_sync) {
+		std::atomic_bool &_thread_task_out_sync = *thread_task_out_sync;
+		std::chrono::steady_clock::time_point next_wakeup_time;
+		do {
+			if(ProcessNextOutboundAction(_thread_task_out_sync, next_wakeup_time)) {
+				continue;
+			}
+
+			std::unique_lock<std::mutex> queue_lock(outbound_action_queue_lock_);
+			is_outbound_thread_waiting_ = true;
+			outbound_action_queue_wait_.wait_until(queue_lock, next_wakeup_time, [this] {
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				return process_queued_actions_ && !IsOutboundActionQueueEmpty()
+					   && std::chrono::steady_clock::now() >= next_rate_limited_action_time_;
+			});
+			is_outbound_thread_waiting_ = false;
 		} while(_thread_task_out_sync);
+		FlushCoalescedWrites(_thread_task_out_sync);
 	}
 
 	ResponseCode ClientCoreState::RegisterPendingAck(uint16_t action_id,
@@ -190,44 +616,70 @@ namespace awsiotsdk {
 			return ResponseCode::NULL_VALUE_ERROR;
 		}
 
-		std::unique_ptr<PendingAckData> p_pending_ack_data = std::unique_ptr<PendingAckData>(new PendingAckData());
-		p_pending_ack_data->p_async_ack_handler_ = p_async_ack_handler;
-		p_pending_ack_data->time_of_request_ = std::chrono::system_clock::now();
-
 		std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
-		pending_ack_map_.insert(std::make_pair(action_id, std::move(p_pending_ack_data)));
-		return ResponseCode::SUCCESS;
+		return pending_ack_tracker_.Register(action_id, std::move(p_async_ack_handler),
+											 std::chrono::steady_clock::now() + ack_timeout_);
 	}
 
 	void ClientCoreState::DeletePendingAck(uint16_t action_id) {
+		ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler = nullptr;
 		std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
-		util::Map<uint16_t, std::unique_ptr<PendingAckData>>::const_iterator itr = pending_ack_map_.find(action_id);
-		if(itr != pending_ack_map_.end()) {
-			pending_ack_map_.erase(itr);
-		}
+		pending_ack_tracker_.Remove(action_id, p_async_ack_handler);
 	}
 
-	void ClientCoreState::DeleteExpiredAcks() {
+	bool ClientCoreState::IsAckPending(uint16_t action_id) {
 		std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
-		std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-		util::Map<uint16_t, std::unique_ptr<PendingAckData>>::const_iterator itr = pending_ack_map_.begin();
-		while(itr != pending_ack_map_.end()) {
-			std::chrono::seconds diff = std::chrono::duration_cast<std::chrono::seconds>(
-					now - itr->second->time_of_request_);
-			if(diff > ack_timeout_) {
-				itr->second->p_async_ack_handler_(itr->first, ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR);
-				pending_ack_map_.erase(itr);
-			}
+		return pending_ack_tracker_.IsPending(action_id);
+	}
+
+	void ClientCoreState::DeleteExpiredAcks() {
+		std::lock_guard<std::mutex> expired_ack_lock(expired_ack_lock_);
+		{
+			std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
+			pending_ack_tracker_.BeginDispatchExpired(std::chrono::steady_clock::now(), expired_ack_list_);
+		}
+
+		// Handlers may take time or register new Acks, call them without holding the Ack lock
+		for(PendingAckTracker::ExpiredAck &expired_ack : expired_ack_list_) {
+			expired_ack.second(expired_ack.first, ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR);
+			std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
+			pending_ack_tracker_.EndDispatch(expired_ack.first);
 		}
+		expired_ack_list_.clear();
 	}
 
 	void ClientCoreState::ForwardReceivedAck(uint16_t action_id, ResponseCode rc) {
-		std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
 		// No response code because all Acks might not have registered handlers. No other possible error
-		util::Map<uint16_t, std::unique_ptr<PendingAckData>>::const_iterator itr = pending_ack_map_.find(action_id);
-		if(itr != pending_ack_map_.end()) {
-			itr->second->p_async_ack_handler_(action_id, rc);
-			pending_ack_map_.erase(itr);
+		ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler = nullptr;
+		{
+			std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
+			if(!pending_ack_tracker_.BeginDispatch(action_id, p_async_ack_handler)) {
+				return;
+			}
 		}
+		p_async_ack_handler(action_id, rc);
+
+		std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
+		pending_ack_tracker_.EndDispatch(action_id);
+	}
+
+	void ClientCoreState::ForwardWrittenAck(uint16_t action_id,
+											const std::shared_ptr<NetworkConnection> &p_network_connection) {
+		// Only the outbound thread writes to a coalescing connection, the Ack is completed when it flushes
+		if(nullptr != std::dynamic_pointer_cast<CoalescingNetworkConnection>(p_network_connection)) {
+			coalesced_written_ack_ids_.push_back(action_id);
+			return;
+		}
+		ForwardReceivedAck(action_id, ResponseCode::SUCCESS);
+	}
+
+	std::chrono::milliseconds ClientCoreState::GetAckTimeout() {
+		std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
+		return ack_timeout_;
+	}
+
+	void ClientCoreState::SetAckTimeout(std::chrono::milliseconds ack_timeout) {
+		std::lock_guard<std::mutex> sync_action_lock(ack_map_lock_);
+		ack_timeout_ = ack_timeout;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,379 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ClientReactor.cpp
+ * @brief
+ *
+ */
+
+#include <limits>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include "util/logging/LogMacros.hpp"
+#include "ClientReactor.hpp"
+
+#define LOG_TAG_CLIENT_REACTOR "[Client Reactor]"
+
+// epoll user data of the wakeup descriptor, client IDs are 32 bit
+#define CLIENT_REACTOR_WAKEUP_ID std::numeric_limits<uint64_t>::max()
+
+namespace awsiotsdk {
+#ifdef __linux__
+	namespace {
+		void WakeUpEventLoop(int wakeup_fd) {
+			uint64_t wakeup_count = 1;
+			ssize_t written_bytes = write(wakeup_fd, &wakeup_count, sizeof(wakeup_count));
+			// Counter can only overflow if the event loop is not running, it wakes up anyway in that case
+			IOT_UNUSED(written_bytes);
+		}
+	}
+#endif
+
+	// Event loop run by the current thread, nullptr on application threads
+	static thread_local const void *p_current_event_loop = nullptr;
+
+	ClientReactor::ClientReactor() {
+		next_client_id_ = 0;
+	}
+
+	std::shared_ptr<ClientReactor> ClientReactor::Create(size_t thread_count) {
+#ifdef __linux__
+		if(0 == thread_count) {
+			return nullptr;
+		}
+
+		std::shared_ptr<ClientReactor> p_client_reactor = std::shared_ptr<ClientReactor>(new ClientReactor());
+		for(size_t itr = 0; itr < thread_count; itr++) {
+			std::unique_ptr<EventLoop> p_event_loop = std::unique_ptr<EventLoop>(new EventLoop());
+			p_event_loop->epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+			p_event_loop->wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			EventLoop &event_loop = *p_event_loop;
+			// Destructor closes the descriptors of every event loop added here
+			p_client_reactor->event_loops_.push_back(std::move(p_event_loop));
+			if(0 > event_loop.epoll_fd_ || 0 > event_loop.wakeup_fd_) {
+				AWS_LOG_ERROR(LOG_TAG_CLIENT_REACTOR, "Creating event loop descriptors failed with errno : %d", errno);
+				return nullptr;
+			}
+
+			epoll_event wakeup_event;
+			wakeup_event.events = EPOLLIN;
+			wakeup_event.data.u64 = CLIENT_REACTOR_WAKEUP_ID;
+			if(0 != epoll_ctl(event_loop.epoll_fd_, EPOLL_CTL_ADD, event_loop.wakeup_fd_, &wakeup_event)) {
+				AWS_LOG_ERROR(LOG_TAG_CLIENT_REACTOR, "Registering wakeup descriptor failed with errno : %d", errno);
+				return nullptr;
+			}
+
+			event_loop.p_thread_continue_ = std::make_shared<std::atomic_bool>(true);
+			event_loop.p_thread_task_ = std::unique_ptr<util::Threading::ThreadTask>(
+					new util::Threading::ThreadTask(util::Threading::DestructorAction::JOIN,
+													event_loop.p_thread_continue_, "Client Reactor Event Loop"));
+			event_loop.p_thread_task_->Run(&ClientReactor::RunEventLoop, p_client_reactor.get(), &event_loop);
+		}
+
+		return p_client_reactor;
+#else
+		IOT_UNUSED(thread_count);
+		return nullptr;
+#endif
+	}
+
+	ResponseCode ClientReactor::AddClient(std::shared_ptr<ClientCoreState> p_client_core_state,
+										  uint32_t &client_id_out) {
+		if(nullptr == p_client_core_state || nullptr == p_client_core_state->p_network_connection_) {
+			return ResponseCode::NULL_VALUE_ERROR;
+		}
+
+		uint32_t client_id = next_client_id_++;
+		EventLoop &event_loop = GetEventLoop(client_id);
+		std::shared_ptr<ReactorClient> p_client = std::make_shared<ReactorClient>();
+		p_client->client_id_ = client_id;
+		p_client->p_client_core_state_ = p_client_core_state;
+		p_client->outbound_step_time_ = std::chrono::steady_clock::now();
+		p_client->is_outbound_pending_ = false;
+		p_client->is_readable_ = false;
+		p_client->registered_fd_ = -1;
+		p_client->wakeup_fd_ = event_loop.wakeup_fd_;
+		p_client->is_removed_ = false;
+
+		// Handler is cleared by RemoveClient, the weak reference only avoids a cycle through the client state
+		std::weak_ptr<ReactorClient> p_weak_client = p_client;
+		p_client_core_state->SetOutboundActionNotifyHandler([p_weak_client]() {
+			std::shared_ptr<ReactorClient> p_notified_client = p_weak_client.lock();
+			// Only the first notification after the event loop processed the queue needs to wake it up
+			if(nullptr != p_notified_client && !p_notified_client->is_outbound_pending_.exchange(true)) {
+#ifdef __linux__
+				WakeUpEventLoop(p_notified_client->wakeup_fd_);
+#endif
+			}
+		});
+
+		{
+			std::lock_guard<std::mutex> client_map_lock(event_loop.client_map_lock_);
+			event_loop.client_map_.insert(std::make_pair(client_id, p_client));
+		}
+#ifdef __linux__
+		WakeUpEventLoop(event_loop.wakeup_fd_);
+#endif
+
+		client_id_out = client_id;
+		return ResponseCode::SUCCESS;
+	}
+
+	ResponseCode ClientReactor::AddActionRunner(uint32_t client_id, std::unique_ptr<Action> p_action_runner) {
+		if(nullptr == p_action_runner) {
+			return ResponseCode::NULL_VALUE_ERROR;
+		}
+
+		EventLoop &event_loop = GetEventLoop(client_id);
+		{
+			std::lock_guard<std::mutex> client_map_lock(event_loop.client_map_lock_);
+			util::Map<uint32_t, std::shared_ptr<ReactorClient>>::iterator itr = event_loop.client_map_.find(client_id);
+			if(itr == event_loop.client_map_.end()) {
+				return ResponseCode::FAILURE;
+			}
+			p_action_runner->SetParentThreadSync(event_loop.p_thread_continue_);
+			// Event loop may be processing the client, it picks up the runner in its next iteration
+			itr->second->pending_action_runners_.push_back(std::move(p_action_runner));
+		}
+#ifdef __linux__
+		WakeUpEventLoop(event_loop.wakeup_fd_);
+#endif
+
+		return ResponseCode::SUCCESS;
+	}
+
+	void ClientReactor::RemoveClient(uint32_t client_id) {
+		EventLoop &event_loop = GetEventLoop(client_id);
+		// Waiting for another event loop could deadlock if it is removing a client of this thread at the same time
+		bool is_other_event_loop = (nullptr != p_current_event_loop && &event_loop != p_current_event_loop);
+		std::shared_ptr<ReactorClient> p_client;
+		{
+			std::lock_guard<std::mutex> client_map_lock(event_loop.client_map_lock_);
+			util::Map<uint32_t, std::shared_ptr<ReactorClient>>::iterator itr = event_loop.client_map_.find(client_id);
+			if(itr == event_loop.client_map_.end()) {
+				return;
+			}
+			p_client = itr->second;
+			p_client->is_removed_ = true;
+			p_client->pending_action_runners_.clear();
+			event_loop.client_map_.erase(itr);
+			if(is_other_event_loop) {
+				event_loop.removed_clients_.push_back(p_client);
+			}
+		}
+
+		p_client->p_client_core_state_->SetOutboundActionNotifyHandler(nullptr);
+		if(is_other_event_loop) {
+#ifdef __linux__
+			WakeUpEventLoop(event_loop.wakeup_fd_);
+#endif
+			return;
+		}
+
+		// Event loop holds the lock while processing its clients and drops its references before releasing it
+		std::unique_lock<std::mutex> process_lock(event_loop.process_lock_, std::defer_lock);
+		if(&event_loop != p_current_event_loop) {
+			process_lock.lock();
+		}
+		ReleaseClient(event_loop, *p_client);
+	}
+
+	void ClientReactor::ReleaseClient(EventLoop &event_loop, ReactorClient &client) {
+#ifdef __linux__
+		// A socket that is still open stays registered and would keep waking up the event loop
+		std::shared_ptr<NetworkConnection> p_network_connection = client.p_client_core_state_->p_network_connection_;
+		if(0 <= client.registered_fd_ && p_network_connection->IsConnected()
+		   && client.registered_fd_ == p_network_connection->GetSocketDescriptor()) {
+			epoll_ctl(event_loop.epoll_fd_, EPOLL_CTL_DEL, client.registered_fd_, nullptr);
+		}
+#else
+		IOT_UNUSED(event_loop);
+#endif
+		client.registered_fd_ = -1;
+		client.action_runners_.clear();
+		client.runner_step_times_.clear();
+	}
+
+	void ClientReactor::UpdateSocketRegistration(EventLoop &event_loop, ReactorClient &client) {
+#ifdef __linux__
+		NetworkConnection &network_connection = *client.p_client_core_state_->p_network_connection_;
+		int socket_fd = network_connection.IsConnected() ? network_connection.GetSocketDescriptor() : -1;
+		if(socket_fd == client.registered_fd_) {
+			return;
+		}
+
+		// Closed sockets are removed from epoll by the kernel, the old descriptor may already belong to another client
+		client.registered_fd_ = socket_fd;
+		if(0 > socket_fd) {
+			return;
+		}
+
+		epoll_event socket_event;
+		socket_event.events = EPOLLIN;
+		socket_event.data.u64 = client.client_id_;
+		if(0 != epoll_ctl(event_loop.epoll_fd_, EPOLL_CTL_ADD, socket_fd, &socket_event)
+		   && (EEXIST != errno || 0 != epoll_ctl(event_loop.epoll_fd_, EPOLL_CTL_MOD, socket_fd, &socket_event))) {
+			// Action runners still run on their timers, only the wake up on incoming data is lost
+			AWS_LOG_WARN(LOG_TAG_CLIENT_REACTOR, "Registering socket failed with errno : %d", errno);
+		}
+#else
+		IOT_UNUSED(event_loop);
+		IOT_UNUSED(client);
+#endif
+	}
+
+	void ClientReactor::ProcessClient(EventLoop &event_loop, ReactorClient &client,
+									  std::chrono::steady_clock::time_point now,
+									  std::chrono::steady_clock::time_point &next_wakeup_time) {
+		ClientCoreState &client_core_state = *client.p_client_core_state_;
+		// Clients share the event loop thread, each one allocates from its own resource while it is processed
+		util::memory::ThreadResourceScope resource_scope(client_core_state.p_memory_resource_);
+		for(size_t itr = 0; itr < client.action_runners_.size(); itr++) {
+			std::chrono::steady_clock::time_point &step_time = client.runner_step_times_[itr];
+			if(client.is_readable_ || now >= step_time) {
+				ResponseCode rc = client.action_runners_[itr]->PerformStep(client_core_state.p_network_connection_,
+																		   step_time);
+				if(ResponseCode::ACTION_STEP_NOT_SUPPORTED_ERROR == rc) {
+					AWS_LOG_ERROR(LOG_TAG_CLIENT_REACTOR, "Action runner %s can not be performed in steps",
+								  client.action_runners_[itr]->GetActionInfo().c_str());
+					step_time = std::chrono::steady_clock::time_point::max();
+				} else if(ResponseCode::SUCCESS != rc) {
+					AWS_LOG_DEBUG(LOG_TAG_CLIENT_REACTOR, "Action runner step returned : %d", static_cast<int>(rc));
+				}
+			}
+			if(step_time < next_wakeup_time) {
+				next_wakeup_time = step_time;
+			}
+		}
+		client.is_readable_ = false;
+
+		if(client.is_outbound_pending_.exchange(false) || now >= client.outbound_step_time_) {
+			size_t action_count = 0;
+			while(action_count < CLIENT_REACTOR_MAX_ACTIONS_PER_STEP
+				  && client_core_state.ProcessNextOutboundAction(*event_loop.p_thread_continue_,
+																 client.outbound_step_time_)) {
+				action_count++;
+			}
+			if(CLIENT_REACTOR_MAX_ACTIONS_PER_STEP == action_count) {
+				// Continue right after the other clients had their turn
+				client.outbound_step_time_ = now;
+			}
+		}
+		if(client.outbound_step_time_ < next_wakeup_time) {
+			next_wakeup_time = client.outbound_step_time_;
+		}
+	}
+
+	void ClientReactor::RunEventLoop(EventLoop *p_event_loop) {
+#ifdef __linux__
+		EventLoop &event_loop = *p_event_loop;
+		std::atomic_bool &thread_continue = *event_loop.p_thread_continue_;
+		epoll_event events[CLIENT_REACTOR_MAX_EVENTS];
+		int wait_timeout_ms = 0;
+		p_current_event_loop = p_event_loop;
+
+		while(thread_continue) {
+			int event_count = epoll_wait(event_loop.epoll_fd_, events, CLIENT_REACTOR_MAX_EVENTS, wait_timeout_ms);
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+			{
+				std::lock_guard<std::mutex> client_map_lock(event_loop.client_map_lock_);
+				for(int itr = 0; itr < event_count; itr++) {
+					if(CLIENT_REACTOR_WAKEUP_ID == events[itr].data.u64) {
+						uint64_t wakeup_count = 0;
+						ssize_t read_bytes = read(event_loop.wakeup_fd_, &wakeup_count, sizeof(wakeup_count));
+						IOT_UNUSED(read_bytes);
+						continue;
+					}
+					util::Map<uint32_t, std::shared_ptr<ReactorClient>>::iterator client_itr
+							= event_loop.client_map_.find(static_cast<uint32_t>(events[itr].data.u64));
+					if(client_itr != event_loop.client_map_.end()) {
+						client_itr->second->is_readable_ = true;
+					}
+				}
+
+				for(auto &client : event_loop.client_map_) {
+					ReactorClient &reactor_client = *client.second;
+					for(std::unique_ptr<Action> &p_action_runner : reactor_client.pending_action_runners_) {
+						reactor_client.action_runners_.push_back(std::move(p_action_runner));
+						reactor_client.runner_step_times_.push_back(now);
+					}
+					reactor_client.pending_action_runners_.clear();
+					event_loop.active_clients_.push_back(client.second);
+				}
+				for(std::shared_ptr<ReactorClient> &p_removed_client : event_loop.removed_clients_) {
+					event_loop.active_clients_.push_back(std::move(p_removed_client));
+				}
+				event_loop.removed_clients_.clear();
+			}
+
+			// Processed without the client map lock, so that callbacks can add and remove clients
+			std::chrono::steady_clock::time_point next_wakeup_time
+					= now + std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+			{
+				std::lock_guard<std::mutex> process_lock(event_loop.process_lock_);
+				for(std::shared_ptr<ReactorClient> &p_client : event_loop.active_clients_) {
+					if(p_client->is_removed_) {
+						// Clients removed from this thread are already released, releasing again is a no-op
+						ReleaseClient(event_loop, *p_client);
+						continue;
+					}
+					UpdateSocketRegistration(event_loop, *p_client);
+					ProcessClient(event_loop, *p_client, now, next_wakeup_time);
+				}
+				// References are dropped before RemoveClient can return on another thread
+				event_loop.active_clients_.clear();
+			}
+
+			now = std::chrono::steady_clock::now();
+			wait_timeout_ms = 0;
+			if(next_wakeup_time > now) {
+				// Round up, waking up early would only lead to an iteration without any work
+				wait_timeout_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+						next_wakeup_time - now + std::chrono::microseconds(999)).count());
+			}
+		}
+#else
+		IOT_UNUSED(p_event_loop);
+#endif
+	}
+
+	ClientReactor::~ClientReactor() {
+		// Stop all event loops before any of their descriptors are closed
+		for(std::unique_ptr<EventLoop> &p_event_loop : event_loops_) {
+			p_event_loop->p_thread_task_.reset();
+			for(auto &client : p_event_loop->client_map_) {
+				client.second->p_client_core_state_->SetOutboundActionNotifyHandler(nullptr);
+			}
+		}
+#ifdef __linux__
+		for(std::unique_ptr<EventLoop> &p_event_loop : event_loops_) {
+			if(0 <= p_event_loop->epoll_fd_) {
+				close(p_event_loop->epoll_fd_);
+			}
+			if(0 <= p_event_loop->wakeup_fd_) {
+				close(p_event_loop->wakeup_fd_);
+			}
+		}
+#endif
+	}
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file CoalescingNetworkConnection.cpp
+ * @brief Network connection wrapper that collects writes and sends them together
+ *
+ */
+
+#include "Action.hpp"
+#include "CoalescingNetworkConnection.hpp"
+
+namespace awsiotsdk {
+	CoalescingNetworkConnection::CoalescingNetworkConnection(std::shared_ptr<NetworkConnection> p_network_connection)
+			: p_network_connection_(p_network_connection) { }
+
+	ResponseCode CoalescingNetworkConnection::ConnectInternal() {
+		return p_network_connection_->Connect();
+	}
+
+	ResponseCode CoalescingNetworkConnection::WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+		coalesced_buf_.append(buf);
+		size_written_bytes_out = buf.length();
+		return ResponseCode::SUCCESS;
+	}
+
+	ResponseCode CoalescingNetworkConnection::WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+															 size_t &size_written_bytes_out) {
+		size_t length_before = coalesced_buf_.length();
+		for(size_t itr = 0; itr < segment_count; itr++) {
+			coalesced_buf_.append(p_segments[itr].data(), p_segments[itr].length());
+		}
+		size_written_bytes_out = coalesced_buf_.length() - length_before;
+		return ResponseCode::SUCCESS;
+	}
+
+	ResponseCode CoalescingNetworkConnection::ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+														   size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+		return p_network_connection_->Read(buf, buf_read_offset, size_bytes_to_read, size_read_bytes_out);
+	}
+
+	ResponseCode CoalescingNetworkConnection::WaitForReadableInternal(std::chrono::milliseconds timeout) {
+		return p_network_connection_->WaitForReadable(timeout);
+	}
+
+	ResponseCode CoalescingNetworkConnection::WaitForWritableInternal(std::chrono::milliseconds timeout) {
+		// Coalesced writes never block, only the wrapped connection can be full
+		return p_network_connection_->WaitForWritable(timeout);
+	}
+
+	ResponseCode CoalescingNetworkConnection::DisconnectInternal() {
+		return p_network_connection_->Disconnect();
+	}
+
+	bool CoalescingNetworkConnection::IsConnected() {
+		return p_network_connection_->IsConnected();
+	}
+
+	bool CoalescingNetworkConnection::IsPhysicalLayerConnected() {
+		return p_network_connection_->IsPhysicalLayerConnected();
+	}
+
+	int CoalescingNetworkConnection::GetSocketDescriptor() {
+		return p_network_connection_->GetSocketDescriptor();
+	}
+
+	ResponseCode CoalescingNetworkConnection::Flush(const std::atomic_bool &thread_continue) {
+		if(coalesced_buf_.empty()) {
+			return ResponseCode::SUCCESS;
+		}
+
+		ResponseCode rc = ResponseCode::SUCCESS;
+		size_t total_written_bytes = 0;
+		do {
+			size_t cur_written_bytes = 0;
+			if(0 == total_written_bytes) {
+				rc = p_network_connection_->Write(coalesced_buf_, cur_written_bytes);
+			} else {
+				// Resume from the first unsent byte without copying the rest of the buffer
+				util::StringView remaining_buf(coalesced_buf_.data() + total_written_bytes,
+											   coalesced_buf_.length() - total_written_bytes);
+				rc = p_network_connection_->WriteV(&remaining_buf, 1, cur_written_bytes);
+			}
+			total_written_bytes += cur_written_bytes;
+			if(ResponseCode::SUCCESS == rc && total_written_bytes < coalesced_buf_.length()) {
+				p_network_connection_->WaitForWritable(std::chrono::milliseconds(DEFAULT_NETWORK_ACTION_THREAD_SLEEP_DURATION_MS));
+			}
+		} while(thread_continue && ResponseCode::SUCCESS == rc && total_written_bytes < coalesced_buf_.length());
+
+		if(ResponseCode::SUCCESS == rc && total_written_bytes < coalesced_buf_.length()) {
+			rc = ResponseCode::THREAD_EXITING;
+		}
+		coalesced_buf_.clear();
+		return rc;
+	}
+}
@@ -22,6 +22,8 @@
  *
  */
 
+#include <thread>
+
 #include "util/memory/stl/String.hpp"
 #include "NetworkConnection.hpp"
 
@@ -47,6 +49,43 @@ namespace awsiotsdk {
 		return rc;
 	}
 
+	ResponseCode NetworkConnection::WriteV(const util::StringView *p_segments, size_t segment_count,
+										   size_t &size_written_bytes_out) {
+		ResponseCode rc;
+		std::lock_guard<std::mutex> write_guard(write_mutex);
+		{
+			// Check connection state before calling internal write
+			if(IsConnected()) {
+				rc = WriteVInternal(p_segments, segment_count, size_written_bytes_out);
+			} else {
+				rc = ResponseCode::NETWORK_DISCONNECTED_ERROR;
+			}
+		}
+		return rc;
+	}
+
+	size_t NetworkConnection::GetSegmentsLength(const util::StringView *p_segments, size_t segment_count) {
+		size_t length = 0;
+		for(size_t itr = 0; itr < segment_count; itr++) {
+			length += p_segments[itr].length();
+		}
+		return length;
+	}
+
+	const util::String &NetworkConnection::JoinSegments(const util::StringView *p_segments, size_t segment_count) {
+		write_segments_buf_.clear();
+		write_segments_buf_.reserve(GetSegmentsLength(p_segments, segment_count));
+		for(size_t itr = 0; itr < segment_count; itr++) {
+			write_segments_buf_.append(p_segments[itr].data(), p_segments[itr].length());
+		}
+		return write_segments_buf_;
+	}
+
+	ResponseCode NetworkConnection::WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+												   size_t &size_written_bytes_out) {
+		return WriteInternal(JoinSegments(p_segments, segment_count), size_written_bytes_out);
+	}
+
 	ResponseCode NetworkConnection::Read(util::Vector<unsigned char> &buf, size_t buf_read_offset,
 										 size_t size_bytes_to_read, size_t &size_read_bytes_out) {
 		ResponseCode rc;
@@ -66,4 +105,42 @@ namespace awsiotsdk {
 		// Disconnect irrespective of state of other requests
 		return DisconnectInternal();
 	}
+
+	ResponseCode NetworkConnection::WaitForReadable(std::chrono::milliseconds timeout) {
+		ResponseCode rc;
+		std::lock_guard<std::mutex> read_guard(read_mutex);
+		{
+			// Nothing to wait for if the connection is down
+			if(IsConnected()) {
+				rc = WaitForReadableInternal(timeout);
+			} else {
+				rc = ResponseCode::NETWORK_DISCONNECTED_ERROR;
+			}
+		}
+		return rc;
+	}
+
+	ResponseCode NetworkConnection::WaitForWritable(std::chrono::milliseconds timeout) {
+		ResponseCode rc;
+		std::lock_guard<std::mutex> write_guard(write_mutex);
+		{
+			// Nothing to wait for if the connection is down
+			if(IsConnected()) {
+				rc = WaitForWritableInternal(timeout);
+			} else {
+				rc = ResponseCode::NETWORK_DISCONNECTED_ERROR;
+			}
+		}
+		return rc;
+	}
+
+	ResponseCode NetworkConnection::WaitForReadableInternal(std::chrono::milliseconds timeout) {
+		std::this_thread::sleep_for(timeout);
+		return ResponseCode::SUCCESS;
+	}
+
+	ResponseCode NetworkConnection::WaitForWritableInternal(std::chrono::milliseconds timeout) {
+		std::this_thread::sleep_for(timeout);
+		return ResponseCode::SUCCESS;
+	}
 }
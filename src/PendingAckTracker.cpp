@@ -0,0 +1,248 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PendingAckTracker.cpp
+ * @brief Table of pending Acks with timer based expiry
+ *
+ */
+
+#include "PendingAckTracker.hpp"
+
+namespace awsiotsdk {
+	const size_t PendingAckTracker::WHEEL_LEVEL_0_BITS;
+	const size_t PendingAckTracker::WHEEL_LEVEL_0_SIZE;
+	const size_t PendingAckTracker::WHEEL_LEVEL_1_SIZE;
+	const int32_t PendingAckTracker::INVALID_INDEX;
+
+	PendingAckTracker::PendingAckTracker(size_t table_size, std::chrono::milliseconds tick_duration) {
+		size_t rounded_table_size = 1;
+		while(rounded_table_size < table_size && rounded_table_size < (static_cast<size_t>(UINT16_MAX) + 1)) {
+			rounded_table_size <<= 1;
+		}
+		slots_.resize(rounded_table_size);
+		for(size_t slot_index = 0; slot_index < rounded_table_size; slot_index++) {
+			Slot &slot = slots_[slot_index];
+			slot.p_async_ack_handler_ = nullptr;
+			slot.expiry_tick_ = 0;
+			slot.bucket_ = INVALID_INDEX;
+			slot.prev_ = INVALID_INDEX;
+			slot.next_ = INVALID_INDEX;
+			slot.chain_next_ = (slot_index + 1 < rounded_table_size) ? static_cast<int32_t>(slot_index + 1)
+																	 : INVALID_INDEX;
+			slot.action_id_ = 0;
+			slot.is_in_use_ = false;
+			slot.is_dispatching_ = false;
+		}
+		bucket_heads_.assign(WHEEL_LEVEL_0_SIZE + WHEEL_LEVEL_1_SIZE, INVALID_INDEX);
+		chain_heads_.assign(rounded_table_size, INVALID_INDEX);
+		free_head_ = 0;
+		mask_ = rounded_table_size - 1;
+		pending_ack_count_ = 0;
+		tick_duration_ = (std::chrono::milliseconds(0) < tick_duration) ? tick_duration : std::chrono::milliseconds(1);
+		current_tick_ = GetTick(std::chrono::steady_clock::now());
+	}
+
+	uint64_t PendingAckTracker::GetTick(std::chrono::steady_clock::time_point time_point) {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+				time_point.time_since_epoch()).count() / tick_duration_.count());
+	}
+
+	int32_t PendingAckTracker::FindSlot(uint16_t action_id) {
+		int32_t slot_index = chain_heads_[action_id & mask_];
+		while(INVALID_INDEX != slot_index && action_id != slots_[slot_index].action_id_) {
+			slot_index = slots_[slot_index].chain_next_;
+		}
+		return slot_index;
+	}
+
+	void PendingAckTracker::LinkSlot(int32_t slot_index) {
+		Slot &slot = slots_[slot_index];
+		if(slot.expiry_tick_ <= current_tick_) {
+			// Current tick has already been processed
+			slot.expiry_tick_ = current_tick_ + 1;
+		}
+
+		uint64_t ticks_remaining = slot.expiry_tick_ - current_tick_;
+		if(WHEEL_LEVEL_0_SIZE > ticks_remaining) {
+			slot.bucket_ = static_cast<int32_t>(slot.expiry_tick_ & (WHEEL_LEVEL_0_SIZE - 1));
+		} else if(WHEEL_LEVEL_0_SIZE * WHEEL_LEVEL_1_SIZE > ticks_remaining) {
+			slot.bucket_ = static_cast<int32_t>(WHEEL_LEVEL_0_SIZE
+												+ ((slot.expiry_tick_ >> WHEEL_LEVEL_0_BITS) & (WHEEL_LEVEL_1_SIZE - 1)));
+		} else {
+			// Out of range, park in the last level 1 bucket to be rescheduled when it is reached
+			slot.bucket_ = static_cast<int32_t>(WHEEL_LEVEL_0_SIZE + (((current_tick_ >> WHEEL_LEVEL_0_BITS)
+																	   + WHEEL_LEVEL_1_SIZE - 1) & (WHEEL_LEVEL_1_SIZE - 1)));
+		}
+
+		slot.prev_ = INVALID_INDEX;
+		slot.next_ = bucket_heads_[slot.bucket_];
+		if(INVALID_INDEX != slot.next_) {
+			slots_[slot.next_].prev_ = slot_index;
+		}
+		bucket_heads_[slot.bucket_] = slot_index;
+	}
+
+	void PendingAckTracker::UnlinkSlot(int32_t slot_index) {
+		Slot &slot = slots_[slot_index];
+		if(INVALID_INDEX != slot.prev_) {
+			slots_[slot.prev_].next_ = slot.next_;
+		} else {
+			bucket_heads_[slot.bucket_] = slot.next_;
+		}
+		if(INVALID_INDEX != slot.next_) {
+			slots_[slot.next_].prev_ = slot.prev_;
+		}
+		slot.bucket_ = INVALID_INDEX;
+		slot.prev_ = INVALID_INDEX;
+		slot.next_ = INVALID_INDEX;
+	}
+
+	void PendingAckTracker::ReleaseSlot(int32_t slot_index) {
+		Slot &slot = slots_[slot_index];
+		if(!slot.is_dispatching_) {
+			UnlinkSlot(slot_index);
+		}
+
+		int32_t *p_chain_link = &chain_heads_[slot.action_id_ & mask_];
+		while(slot_index != *p_chain_link) {
+			p_chain_link = &slots_[*p_chain_link].chain_next_;
+		}
+		*p_chain_link = slot.chain_next_;
+		slot.chain_next_ = free_head_;
+		free_head_ = slot_index;
+
+		slot.is_in_use_ = false;
+		slot.is_dispatching_ = false;
+		pending_ack_count_--;
+	}
+
+	ResponseCode PendingAckTracker::Register(uint16_t action_id,
+											 ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+											 std::chrono::steady_clock::time_point expiry_time) {
+		if(nullptr == p_async_ack_handler) {
+			return ResponseCode::NULL_VALUE_ERROR;
+		}
+
+		int32_t slot_index = FindSlot(action_id);
+		if(INVALID_INDEX != slot_index) {
+			if(slots_[slot_index].is_dispatching_) {
+				return ResponseCode::ACTION_QUEUE_FULL;
+			}
+			UnlinkSlot(slot_index);
+		} else {
+			if(INVALID_INDEX == free_head_) {
+				return ResponseCode::ACTION_QUEUE_FULL;
+			}
+			slot_index = free_head_;
+			free_head_ = slots_[slot_index].chain_next_;
+			slots_[slot_index].chain_next_ = chain_heads_[action_id & mask_];
+			chain_heads_[action_id & mask_] = slot_index;
+			slots_[slot_index].is_in_use_ = true;
+			slots_[slot_index].action_id_ = action_id;
+			pending_ack_count_++;
+		}
+
+		Slot &slot = slots_[slot_index];
+		slot.p_async_ack_handler_ = std::move(p_async_ack_handler);
+		slot.expiry_tick_ = GetTick(expiry_time);
+		LinkSlot(slot_index);
+		return ResponseCode::SUCCESS;
+	}
+
+	bool PendingAckTracker::Remove(uint16_t action_id,
+								   ActionData::AsyncAckNotificationHandlerPtr &p_async_ack_handler_out) {
+		int32_t slot_index = FindSlot(action_id);
+		if(INVALID_INDEX == slot_index || slots_[slot_index].is_dispatching_) {
+			return false;
+		}
+
+		Slot &slot = slots_[slot_index];
+
+		p_async_ack_handler_out = std::move(slot.p_async_ack_handler_);
+		slot.p_async_ack_handler_ = nullptr;
+		ReleaseSlot(slot_index);
+		return true;
+	}
+
+	bool PendingAckTracker::BeginDispatch(uint16_t action_id,
+										  ActionData::AsyncAckNotificationHandlerPtr &p_async_ack_handler_out) {
+		int32_t slot_index = FindSlot(action_id);
+		if(INVALID_INDEX == slot_index || slots_[slot_index].is_dispatching_) {
+			return false;
+		}
+
+		Slot &slot = slots_[slot_index];
+
+		p_async_ack_handler_out = std::move(slot.p_async_ack_handler_);
+		slot.p_async_ack_handler_ = nullptr;
+		UnlinkSlot(slot_index);
+		slot.is_dispatching_ = true;
+		return true;
+	}
+
+	void PendingAckTracker::EndDispatch(uint16_t action_id) {
+		int32_t slot_index = FindSlot(action_id);
+		if(INVALID_INDEX != slot_index && slots_[slot_index].is_dispatching_) {
+			ReleaseSlot(slot_index);
+		}
+	}
+
+	bool PendingAckTracker::IsPending(uint16_t action_id) {
+		return INVALID_INDEX != FindSlot(action_id);
+	}
+
+	void PendingAckTracker::BeginDispatchExpired(std::chrono::steady_clock::time_point now,
+												 util::Vector<ExpiredAck> &expired_acks_out) {
+		uint64_t target_tick = GetTick(now);
+		if(0 == pending_ack_count_) {
+			// Nothing to expire, skip ahead
+			if(target_tick > current_tick_) {
+				current_tick_ = target_tick;
+			}
+			return;
+		}
+
+		while(current_tick_ < target_tick) {
+			current_tick_++;
+			if(0 == (current_tick_ & (WHEEL_LEVEL_0_SIZE - 1))) {
+				// Start of a level 0 rotation, move Acks expiring in it down from level 1
+				size_t level_1_bucket = WHEEL_LEVEL_0_SIZE
+										+ ((current_tick_ >> WHEEL_LEVEL_0_BITS) & (WHEEL_LEVEL_1_SIZE - 1));
+				int32_t slot_index = bucket_heads_[level_1_bucket];
+				bucket_heads_[level_1_bucket] = INVALID_INDEX;
+				while(INVALID_INDEX != slot_index) {
+					int32_t next_slot_index = slots_[slot_index].next_;
+					LinkSlot(slot_index);
+					slot_index = next_slot_index;
+				}
+			}
+
+			size_t level_0_bucket = current_tick_ & (WHEEL_LEVEL_0_SIZE - 1);
+			int32_t slot_index = bucket_heads_[level_0_bucket];
+			while(INVALID_INDEX != slot_index) {
+				int32_t next_slot_index = slots_[slot_index].next_;
+				Slot &slot = slots_[slot_index];
+				if(slot.expiry_tick_ <= current_tick_) {
+					expired_acks_out.push_back(std::make_pair(slot.action_id_, std::move(slot.p_async_ack_handler_)));
+					slot.p_async_ack_handler_ = nullptr;
+					UnlinkSlot(slot_index);
+					slot.is_dispatching_ = true;
+				}
+				slot_index = next_slot_index;
+			}
+		}
+	}
+}
@@ -31,21 +31,73 @@
 
 namespace awsiotsdk {
 	std::unique_ptr<MqttClient> MqttClient::Create(std::shared_ptr<NetworkConnection> networkConnection, std::chrono::milliseconds mqtt_command_timeout) {
+		return Create(networkConnection, mqtt_command_timeout, static_cast<util::memory::MemoryResource *>(nullptr));
+	}
+
+	std::unique_ptr<MqttClient> MqttClient::Create(std::shared_ptr<NetworkConnection> networkConnection,
+												   std::chrono::milliseconds mqtt_command_timeout,
+												   std::shared_ptr<ClientReactor> p_client_reactor) {
+		return Create(networkConnection, mqtt_command_timeout, p_client_reactor, nullptr);
+	}
+
+	std::unique_ptr<MqttClient> MqttClient::Create(std::shared_ptr<NetworkConnection> networkConnection,
+												   std::chrono::milliseconds mqtt_command_timeout,
+												   util::memory::MemoryResource *p_memory_resource) {
 		if(nullptr == networkConnection) {
 			return nullptr;
 		}
 
-		return std::unique_ptr<MqttClient>(new MqttClient(networkConnection, mqtt_command_timeout));
+		return std::unique_ptr<MqttClient>(new MqttClient(networkConnection, mqtt_command_timeout, nullptr,
+														  p_memory_resource));
+	}
+
+	std::unique_ptr<MqttClient> MqttClient::Create(std::shared_ptr<NetworkConnection> networkConnection,
+												   std::chrono::milliseconds mqtt_command_timeout,
+												   std::shared_ptr<ClientReactor> p_client_reactor,
+												   util::memory::MemoryResource *p_memory_resource) {
+		if(nullptr == networkConnection || nullptr == p_client_reactor) {
+			return nullptr;
+		}
+
+		std::unique_ptr<MqttClient> p_client
+				= std::unique_ptr<MqttClient>(new MqttClient(networkConnection, mqtt_command_timeout, p_client_reactor,
+															 p_memory_resource));
+		if(nullptr == p_client->p_client_core_) {
+			return nullptr;
+		}
+		return p_client;
+	}
+
+	MqttClient::MqttClient(std::shared_ptr<NetworkConnection> p_network_connection, std::chrono::milliseconds mqtt_command_timeout)
+			: MqttClient(p_network_connection, mqtt_command_timeout, nullptr) {
+	}
+
+	MqttClient::MqttClient(std::shared_ptr<NetworkConnection> p_network_connection, std::chrono::milliseconds mqtt_command_timeout,
+						   std::shared_ptr<ClientReactor> p_client_reactor)
+			: MqttClient(p_network_connection, mqtt_command_timeout, p_client_reactor, nullptr) {
 	}
 
-	MqttClient::MqttClient(std::shared_ptr<NetworkConnection> p_network_connection, std::chrono::milliseconds mqtt_command_timeout) {
+	MqttClient::MqttClient(std::shared_ptr<NetworkConnection> p_network_connection, std::chrono::milliseconds mqtt_command_timeout,
+						   std::shared_ptr<ClientReactor> p_client_reactor, util::memory::MemoryResource *p_memory_resource) {
+		// Client state and the actions created here allocate their buffers from the resource of this client
+		p_memory_resource_ = p_memory_resource;
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
 		p_client_state_ = mqtt::ClientState::Create(mqtt_command_timeout);
+		p_client_state_->p_memory_resource_ = p_memory_resource_;
 
 		// Construct Full MQTT Client
-		p_client_core_ = std::unique_ptr<ClientCore>(ClientCore::Create(p_network_connection, p_client_state_));
+		if(nullptr == p_client_reactor) {
+			p_client_core_ = std::unique_ptr<ClientCore>(ClientCore::Create(p_network_connection, p_client_state_));
+		} else {
+			p_client_core_ = ClientCore::Create(p_network_connection, p_client_state_, p_client_reactor);
+			if(nullptr == p_client_core_) {
+				return;
+			}
+		}
 		p_client_core_->RegisterAction(ActionType::CONNECT, mqtt::ConnectActionAsync::Create);
 		p_client_core_->RegisterAction(ActionType::PUBLISH, mqtt::PublishActionAsync::Create);
 		p_client_core_->RegisterAction(ActionType::PUBACK, mqtt::PubackActionAsync::Create);
+		p_client_core_->RegisterAction(ActionType::PUBLISH_BATCH, mqtt::PublishBatchActionAsync::Create);
 		p_client_core_->RegisterAction(ActionType::SUBSCRIBE, mqtt::SubscribeActionAsync::Create);
 		p_client_core_->RegisterAction(ActionType::UNSUBSCRIBE, mqtt::UnsubscribeActionAsync::Create);
 		p_client_core_->RegisterAction(ActionType::DISCONNECT, mqtt::DisconnectActionAsync::Create);
@@ -61,6 +113,7 @@ namespace awsiotsdk {
 									 std::unique_ptr<Utf8String> p_client_id, std::unique_ptr<Utf8String> p_username,
 									 std::unique_ptr<Utf8String> p_password,
 									 std::unique_ptr<mqtt::WillOptions> p_will_msg) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
 		std::shared_ptr<mqtt::ConnectPacket> p_connect_packet
 				= std::make_shared<mqtt::ConnectPacket>(is_clean_session, mqtt_version, keep_alive_timeout,
 														std::move(p_client_id), std::move(p_username),
@@ -69,6 +122,7 @@ namespace awsiotsdk {
 	}
 
 	ResponseCode MqttClient::Disconnect(std::chrono::milliseconds action_reponse_timeout) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
 		std::shared_ptr<mqtt::DisconnectPacket> p_disconnect_packet = std::make_shared<mqtt::DisconnectPacket>();
 		return p_client_core_->PerformAction(ActionType::DISCONNECT, p_disconnect_packet, action_reponse_timeout);
 	}
@@ -76,17 +130,49 @@ namespace awsiotsdk {
 	ResponseCode MqttClient::Publish(std::unique_ptr<Utf8String> p_topic_name, bool is_retained, bool is_duplicate,
 									 mqtt::QoS qos, const util::String &payload,
 									 std::chrono::milliseconds action_reponse_timeout) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
 		if(nullptr == p_topic_name){
 			return ResponseCode::MQTT_INVALID_DATA_ERROR;
 		}
 		std::shared_ptr<mqtt::PublishPacket> p_publish_packet
-				= std::make_shared<mqtt::PublishPacket>(std::move(p_topic_name), is_retained, is_duplicate, qos,
-														payload);
+				= mqtt::PublishPacket::Create(std::move(p_topic_name), is_retained, is_duplicate, qos, payload);
+		return p_client_core_->PerformAction(ActionType::PUBLISH, p_publish_packet, action_reponse_timeout);
+	}
+
+	ResponseCode MqttClient::Publish(std::shared_ptr<const mqtt::PreparedPublish> p_prepared_publish,
+									 util::String payload, std::chrono::milliseconds action_reponse_timeout) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
+		std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(std::move(p_prepared_publish), std::move(payload));
+		if(nullptr == p_publish_packet) {
+			return ResponseCode::MQTT_INVALID_DATA_ERROR;
+		}
 		return p_client_core_->PerformAction(ActionType::PUBLISH, p_publish_packet, action_reponse_timeout);
 	}
 
+	ResponseCode MqttClient::PublishBatch(util::Vector<std::shared_ptr<mqtt::PublishPacket>> publish_packets,
+										  std::chrono::milliseconds action_reponse_timeout) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
+		util::Vector<ActionFuture> futures;
+		ResponseCode rc = PublishBatchAsync(std::move(publish_packets), futures);
+		if(ResponseCode::SUCCESS != rc) {
+			return rc;
+		}
+
+		rc = ActionFuture::WaitAll(futures, action_reponse_timeout);
+		if(ResponseCode::SUCCESS != rc) {
+			return rc;
+		}
+		for(const ActionFuture &future : futures) {
+			if(ResponseCode::SUCCESS != future.GetResponseCode()) {
+				return future.GetResponseCode();
+			}
+		}
+		return ResponseCode::SUCCESS;
+	}
+
 	ResponseCode MqttClient::Subscribe(util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list,
 									   std::chrono::milliseconds action_reponse_timeout) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
 		if(subscription_list.empty()) {
 			return ResponseCode::MQTT_INVALID_DATA_ERROR;
 		} else if(MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET < subscription_list.size()) {
@@ -99,6 +185,7 @@ namespace awsiotsdk {
 
 	ResponseCode MqttClient::Unsubscribe(util::Vector<std::unique_ptr<Utf8String>> topic_list,
 										 std::chrono::milliseconds action_reponse_timeout) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
 		if(topic_list.empty()){
 			return ResponseCode::MQTT_INVALID_DATA_ERROR;
 		} else if(MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET < topic_list.size()) {
@@ -113,18 +200,107 @@ namespace awsiotsdk {
 										  mqtt::QoS qos, const util::String &payload,
 										  ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
 										  uint16_t &packet_id_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
+		ActionPriority action_priority = (mqtt::QoS::QOS0 == qos) ? ActionPriority::NORMAL : ActionPriority::HIGH;
+		return PublishAsync(std::move(p_topic_name), is_retained, is_duplicate, qos, payload, p_async_ack_handler,
+							action_priority, packet_id_out);
+	}
+
+	ResponseCode MqttClient::PublishAsync(std::unique_ptr<Utf8String> p_topic_name, bool is_retained, bool is_duplicate,
+										  mqtt::QoS qos, const util::String &payload,
+										  ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+										  ActionPriority action_priority, uint16_t &packet_id_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
 		if(nullptr == p_topic_name){
 			return ResponseCode::MQTT_INVALID_DATA_ERROR;
 		}
 
-		std::shared_ptr<mqtt::PublishPacket> p_publish_packet = std::make_shared<mqtt::PublishPacket>(std::move(p_topic_name), is_retained, is_duplicate, qos, payload);
+		std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(std::move(p_topic_name), is_retained, is_duplicate, qos, payload);
 		p_publish_packet->p_async_ack_handler_ = p_async_ack_handler;
-		return p_client_core_->PerformActionAsync(ActionType::PUBLISH, p_publish_packet, packet_id_out);
+		return p_client_core_->PerformActionAsync(ActionType::PUBLISH, p_publish_packet, action_priority, packet_id_out);
+	}
+
+	ResponseCode MqttClient::PublishAsync(std::shared_ptr<const mqtt::PreparedPublish> p_prepared_publish,
+										  util::String payload,
+										  ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
+										  uint16_t &packet_id_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
+		std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(std::move(p_prepared_publish), std::move(payload));
+		if(nullptr == p_publish_packet) {
+			return ResponseCode::MQTT_INVALID_DATA_ERROR;
+		}
+
+		ActionPriority action_priority = (mqtt::QoS::QOS0 == p_publish_packet->GetQoS()) ? ActionPriority::NORMAL : ActionPriority::HIGH;
+		p_publish_packet->p_async_ack_handler_ = p_async_ack_handler;
+		return p_client_core_->PerformActionAsync(ActionType::PUBLISH, p_publish_packet, action_priority, packet_id_out);
+	}
+
+	ResponseCode MqttClient::PublishBatchAsync(util::Vector<std::shared_ptr<mqtt::PublishPacket>> publish_packets,
+											   uint16_t &batch_id_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
+		std::shared_ptr<mqtt::PublishBatchPacket> p_batch_packet = mqtt::PublishBatchPacket::Create(std::move(publish_packets));
+		if(nullptr == p_batch_packet) {
+			return ResponseCode::MQTT_INVALID_DATA_ERROR;
+		}
+
+		ActionPriority action_priority = ActionPriority::NORMAL;
+		for(const std::shared_ptr<mqtt::PublishPacket> &p_publish_packet : p_batch_packet->GetPublishPackets()) {
+			p_publish_packet->SetPacketId(p_client_state_->GetNextActionId());
+			if(mqtt::QoS::QOS0 != p_publish_packet->GetQoS()) {
+				action_priority = ActionPriority::HIGH;
+			}
+		}
+
+		// Failures of the batch as a whole are reported through the Ack handlers of the individual packets
+		std::weak_ptr<mqtt::PublishBatchPacket> p_batch_packet_weak = p_batch_packet;
+		p_batch_packet->p_async_ack_handler_ = [p_batch_packet_weak](uint16_t batch_id, ResponseCode rc) {
+			std::shared_ptr<mqtt::PublishBatchPacket> p_batch_packet = p_batch_packet_weak.lock();
+			if(ResponseCode::SUCCESS == rc || nullptr == p_batch_packet) {
+				return;
+			}
+			for(const std::shared_ptr<mqtt::PublishPacket> &p_publish_packet : p_batch_packet->GetPublishPackets()) {
+				if(nullptr != p_publish_packet->p_async_ack_handler_) {
+					p_publish_packet->p_async_ack_handler_(p_publish_packet->GetPacketId(), rc);
+				}
+			}
+		};
+		return p_client_core_->PerformActionAsync(ActionType::PUBLISH_BATCH, p_batch_packet, action_priority,
+												  batch_id_out);
+	}
+
+	ResponseCode MqttClient::PublishBatchAsync(util::Vector<std::shared_ptr<mqtt::PublishPacket>> publish_packets,
+											   util::Vector<ActionFuture> &futures_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
+		util::Vector<std::shared_ptr<ActionCompletion>> completions;
+		completions.reserve(publish_packets.size());
+		for(std::shared_ptr<mqtt::PublishPacket> &p_publish_packet : publish_packets) {
+			std::shared_ptr<ActionCompletion> p_action_completion = ActionCompletion::Create();
+			if(nullptr != p_publish_packet) {
+				p_publish_packet->p_async_ack_handler_ = ActionCompletion::GetAckHandler(p_action_completion);
+			}
+			completions.push_back(p_action_completion);
+		}
+
+		util::Vector<std::shared_ptr<mqtt::PublishPacket>> queued_packets = publish_packets;
+		uint16_t batch_id = 0;
+		ResponseCode rc = PublishBatchAsync(std::move(queued_packets), batch_id);
+
+		futures_out.clear();
+		futures_out.reserve(publish_packets.size());
+		for(size_t itr = 0; itr < publish_packets.size(); itr++) {
+			if(ResponseCode::SUCCESS != rc) {
+				futures_out.push_back(ActionFuture::CreateReady(rc));
+			} else {
+				futures_out.push_back(ActionFuture(completions[itr], publish_packets[itr]->GetPacketId()));
+			}
+		}
+		return rc;
 	}
 
 	ResponseCode MqttClient::SubscribeAsync(util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list,
 											ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
 											uint16_t &packet_id_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
 		if(subscription_list.empty()) {
 			return ResponseCode::MQTT_INVALID_DATA_ERROR;
 		} else if(MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET < subscription_list.size()) {
@@ -139,6 +315,7 @@ namespace awsiotsdk {
 	ResponseCode MqttClient::UnsubscribeAsync(util::Vector<std::unique_ptr<Utf8String>> topic_list,
 											  ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler,
 											  uint16_t &packet_id_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
 		if(topic_list.empty()){
 			return ResponseCode::MQTT_INVALID_DATA_ERROR;
 		} else if(MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET < topic_list.size()) {
@@ -149,6 +326,51 @@ namespace awsiotsdk {
 		return p_client_core_->PerformActionAsync(ActionType::UNSUBSCRIBE, p_unsubscribe_packet, packet_id_out);
 	}
 
+	ResponseCode MqttClient::PublishAsync(std::unique_ptr<Utf8String> p_topic_name, bool is_retained, bool is_duplicate,
+										  mqtt::QoS qos, const util::String &payload, ActionFuture &future_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
+		std::shared_ptr<ActionCompletion> p_action_completion = ActionCompletion::Create();
+		uint16_t packet_id = 0;
+		ResponseCode rc = PublishAsync(std::move(p_topic_name), is_retained, is_duplicate, qos, payload,
+									   ActionCompletion::GetAckHandler(p_action_completion), packet_id);
+		if(ResponseCode::SUCCESS != rc) {
+			future_out = ActionFuture::CreateReady(rc);
+		} else {
+			future_out = ActionFuture(p_action_completion, packet_id);
+		}
+		return rc;
+	}
+
+	ResponseCode MqttClient::SubscribeAsync(util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list,
+											ActionFuture &future_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
+		std::shared_ptr<ActionCompletion> p_action_completion = ActionCompletion::Create();
+		uint16_t packet_id = 0;
+		ResponseCode rc = SubscribeAsync(subscription_list, ActionCompletion::GetAckHandler(p_action_completion),
+										 packet_id);
+		if(ResponseCode::SUCCESS != rc) {
+			future_out = ActionFuture::CreateReady(rc);
+		} else {
+			future_out = ActionFuture(p_action_completion, packet_id);
+		}
+		return rc;
+	}
+
+	ResponseCode MqttClient::UnsubscribeAsync(util::Vector<std::unique_ptr<Utf8String>> topic_list,
+											  ActionFuture &future_out) {
+		util::memory::ThreadResourceScope resource_scope(p_memory_resource_);
+		std::shared_ptr<ActionCompletion> p_action_completion = ActionCompletion::Create();
+		uint16_t packet_id = 0;
+		ResponseCode rc = UnsubscribeAsync(std::move(topic_list), ActionCompletion::GetAckHandler(p_action_completion),
+										   packet_id);
+		if(ResponseCode::SUCCESS != rc) {
+			future_out = ActionFuture::CreateReady(rc);
+		} else {
+			future_out = ActionFuture(p_action_completion, packet_id);
+		}
+		return rc;
+	}
+
 	bool MqttClient::IsConnected() {
 		return p_client_state_->IsConnected();
 	}
@@ -159,6 +381,24 @@ namespace awsiotsdk {
 	std::chrono::seconds MqttClient::GetMaxReconnectBackoffTimeout() { return p_client_state_->GetMaxReconnectBackoffTimeout(); }
 	void MqttClient::SetMaxReconnectBackoffTimeout(std::chrono::seconds max_reconnect_backoff_timeout) { p_client_state_->SetMaxReconnectBackoffTimeout(max_reconnect_backoff_timeout); }
 
+	uint32_t MqttClient::GetActionProcessingRate() { return p_client_state_->GetActionProcessingRate(); }
+	void MqttClient::SetActionProcessingRate(uint32_t action_processing_rate_hz) { p_client_state_->SetActionProcessingRate(action_processing_rate_hz); }
+	ResponseCode MqttClient::SetActionRateLimit(ActionType action_type, uint32_t rate_per_sec, uint32_t burst_size) {
+		return p_client_state_->SetActionRateLimit(action_type, rate_per_sec, burst_size);
+	}
+	void MqttClient::SetActionQueueOverflowPolicy(ActionQueueOverflowPolicy overflow_policy,
+												  std::chrono::milliseconds block_timeout) {
+		p_client_state_->SetActionQueueOverflowPolicy(overflow_policy, block_timeout);
+	}
+	void MqttClient::SetActionDropHandler(ClientCoreState::ActionDropHandlerPtr p_action_drop_handler) {
+		p_client_state_->SetActionDropHandler(p_action_drop_handler);
+	}
+	size_t MqttClient::GetDroppedActionCount() { return p_client_state_->GetDroppedActionCount(); }
+
+	void MqttClient::SetWriteCoalescing(size_t max_bytes, std::chrono::microseconds max_delay) {
+		p_client_state_->SetWriteCoalescing(max_bytes, max_delay);
+	}
+
 	MqttClient::~MqttClient() {
 		if(IsConnected()) {
 			ResponseCode rc = Disconnect(p_client_state_->GetMqttCommandTimeout());
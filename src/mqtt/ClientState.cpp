@@ -37,86 +37,166 @@ namespace awsiotsdk {
 			p_connect_data_ = nullptr;
 			min_reconnect_backoff_timeout_ = std::chrono::seconds(MIN_RECONNECT_BACKOFF_DEFAULT_SEC);
 			max_reconnect_backoff_timeout_ = std::chrono::seconds(MAX_RECONNECT_BACKOFF_DEFAULT_SEC);
+			p_subscription_table_ = std::make_shared<const TopicFilterTrie>();
+			subscription_table_version_ = 0;
 		}
 		std::shared_ptr<ClientState> ClientState::Create(std::chrono::milliseconds mqtt_command_timeout) {
 			return std::make_shared<ClientState>(mqtt_command_timeout);
 		}
 
 		uint16_t ClientState::GetNextPacketId() {
-			if(UINT16_MAX == last_sent_packet_id_) {
+			uint16_t last_sent_packet_id = last_sent_packet_id_;
+			uint16_t next_packet_id = 0;
+			do {
 				// 0 is reserved for CONNACK
-				last_sent_packet_id_ = 1;
-			} else {
-				++last_sent_packet_id_;
-			}
-			return last_sent_packet_id_;
+				next_packet_id = (UINT16_MAX == last_sent_packet_id) ? (uint16_t) 1 : (uint16_t) (last_sent_packet_id + 1);
+			} while(!last_sent_packet_id_.compare_exchange_weak(last_sent_packet_id, next_packet_id));
+			return next_packet_id;
 		}
 
 		std::shared_ptr<Subscription> ClientState::GetSubscription(util::String p_topic_name) {
-			std::shared_ptr<Subscription> p_sub = nullptr;
-			util::Map<util::String, std::shared_ptr<Subscription>>::const_iterator itr = subscription_map_.find(p_topic_name);
-			if(itr != subscription_map_.end()) {
-				p_sub = itr->second;
+			return GetSubscriptionTable()->Find(p_topic_name);
+		}
+
+		ResponseCode ClientState::AddSubscription(util::String topic_filter, std::shared_ptr<Subscription> p_subscription) {
+			std::lock_guard<std::mutex> update_guard(subscription_update_lock_);
+			std::shared_ptr<TopicFilterTrie> p_new_table = std::make_shared<TopicFilterTrie>(*p_subscription_table_);
+			ResponseCode rc = p_new_table->Insert(topic_filter, p_subscription);
+			if(ResponseCode::SUCCESS == rc) {
+				std::atomic_store(&p_subscription_table_, std::shared_ptr<const TopicFilterTrie>(p_new_table));
+				subscription_table_version_++;
+			}
+			return rc;
+		}
+
+		void ClientState::RemoveSubscriptionFromTable(const util::String &topic_filter) {
+			std::shared_ptr<TopicFilterTrie> p_new_table = std::make_shared<TopicFilterTrie>(*p_subscription_table_);
+			if(p_new_table->Remove(topic_filter)) {
+				std::atomic_store(&p_subscription_table_, std::shared_ptr<const TopicFilterTrie>(p_new_table));
+				subscription_table_version_++;
 			}
+		}
 
-			return p_sub;
+		void ClientState::GetMatchingSubscriptions(util::StringView topic_name,
+												   util::Vector<std::shared_ptr<Subscription>> &matches_out) {
+			GetSubscriptionTable()->Match(topic_name, matches_out);
+		}
+
+		void ClientState::RemovePendingAckSubscription(std::shared_ptr<Subscription> p_subscription) {
+			uint8_t index_in_packet = p_subscription->GetIndexInPacket();
+			if(0 == index_in_packet) {
+				return;
+			}
+
+			auto packet_itr = pending_ack_subscription_map_.find(p_subscription->GetPacketId());
+			if(pending_ack_subscription_map_.end() == packet_itr || packet_itr->second.size() < index_in_packet
+			   || packet_itr->second[index_in_packet - 1] != p_subscription) {
+				return;
+			}
+
+			packet_itr->second[index_in_packet - 1] = nullptr;
+			for(const std::shared_ptr<Subscription> &p_sub : packet_itr->second) {
+				if(nullptr != p_sub) {
+					return;
+				}
+			}
+			pending_ack_subscription_map_.erase(packet_itr);
 		}
 
 		std::shared_ptr<Subscription> ClientState::SetSubscriptionPacketInfo(util::String p_topic_name, uint16_t packet_id, uint8_t index_in_packet) {
-			std::shared_ptr<Subscription> p_sub = nullptr;
-			util::Map<util::String, std::shared_ptr<Subscription>>::const_iterator itr = subscription_map_.find(p_topic_name);
-			if(itr != subscription_map_.end()) {
-				itr->second->SetAckIndex(packet_id, index_in_packet);
+			std::lock_guard<std::mutex> update_guard(subscription_update_lock_);
+			std::shared_ptr<Subscription> p_sub = p_subscription_table_->Find(p_topic_name);
+			if(nullptr == p_sub || 0 == index_in_packet) {
+				return nullptr;
+			}
+
+			RemovePendingAckSubscription(p_sub);
+
+			util::Vector<std::shared_ptr<Subscription>> &packet_subscriptions = pending_ack_subscription_map_[packet_id];
+			if(1 == index_in_packet) {
+				// Packet ids cycle, anything left here belongs to an older request that was never acknowledged
+				for(std::shared_ptr<Subscription> &p_stale_sub : packet_subscriptions) {
+					if(nullptr != p_stale_sub && p_stale_sub->IsInSuback(packet_id, p_stale_sub->GetIndexInPacket())) {
+						p_stale_sub->SetAckIndex(0, 0);
+					}
+				}
+				packet_subscriptions.clear();
+			}
+			p_sub->SetAckIndex(packet_id, index_in_packet);
+			if(packet_subscriptions.size() < index_in_packet) {
+				packet_subscriptions.resize(index_in_packet);
 			}
+			packet_subscriptions[index_in_packet - 1] = p_sub;
 
 			return p_sub;
 		}
 
 		ResponseCode ClientState::SetSubscriptionActive(uint16_t packet_id, uint8_t index_in_sub_packet, mqtt::QoS max_qos) {
-			ResponseCode rc = ResponseCode::FAILURE;
-			util::Map<util::String, std::shared_ptr<Subscription>>::const_iterator itr = subscription_map_.begin();
-			while(itr != subscription_map_.end()) {
-				if(itr->second->IsInSuback(packet_id, index_in_sub_packet)) {
-					itr->second->SetActive(true);
-					itr->second->SetMaxQos(max_qos);
-					itr->second->SetAckIndex(0, 0); // Reset Packet index to prevent corruptions when packetid cycles back
-					rc = ResponseCode::SUCCESS;
-					break;
-				}
-				itr++;
+			std::lock_guard<std::mutex> update_guard(subscription_update_lock_);
+			auto packet_itr = pending_ack_subscription_map_.find(packet_id);
+			if(pending_ack_subscription_map_.end() == packet_itr || 0 == index_in_sub_packet
+			   || packet_itr->second.size() < index_in_sub_packet) {
+				return ResponseCode::FAILURE;
 			}
-			return rc;
+
+			std::shared_ptr<Subscription> p_sub = packet_itr->second[index_in_sub_packet - 1];
+			if(nullptr == p_sub || !p_sub->IsInSuback(packet_id, index_in_sub_packet)) {
+				return ResponseCode::FAILURE;
+			}
+
+			p_sub->SetActive(true);
+			p_sub->SetMaxQos(max_qos);
+			RemovePendingAckSubscription(p_sub);
+			p_sub->SetAckIndex(0, 0); // Reset Packet index to prevent corruptions when packetid cycles back
+			return ResponseCode::SUCCESS;
 		}
 
 		ResponseCode ClientState::RemoveSubscription(util::String p_topic_name) {
-			subscription_map_.erase(p_topic_name);
+			std::lock_guard<std::mutex> update_guard(subscription_update_lock_);
+			std::shared_ptr<Subscription> p_sub = p_subscription_table_->Find(p_topic_name);
+			if(nullptr != p_sub) {
+				RemovePendingAckSubscription(p_sub);
+				RemoveSubscriptionFromTable(p_topic_name);
+			}
 			return ResponseCode::SUCCESS;
 		}
 
 		ResponseCode ClientState::RemoveSubscription(uint16_t packet_id, uint8_t index_in_sub_packet) {
-			ResponseCode rc = ResponseCode::FAILURE;
-			util::Map<util::String, std::shared_ptr<Subscription>>::const_iterator itr = subscription_map_.begin();
-			while(itr != subscription_map_.end()) {
-				if(itr->second->IsInSuback(packet_id, index_in_sub_packet)) {
-					itr = subscription_map_.erase(itr);
-					break;
-				}
-				itr++;
+			std::lock_guard<std::mutex> update_guard(subscription_update_lock_);
+			auto packet_itr = pending_ack_subscription_map_.find(packet_id);
+			if(pending_ack_subscription_map_.end() == packet_itr || 0 == index_in_sub_packet
+			   || packet_itr->second.size() < index_in_sub_packet) {
+				return ResponseCode::FAILURE;
 			}
-			return rc;
+
+			std::shared_ptr<Subscription> p_sub = packet_itr->second[index_in_sub_packet - 1];
+			if(nullptr == p_sub || !p_sub->IsInSuback(packet_id, index_in_sub_packet)) {
+				return ResponseCode::FAILURE;
+			}
+
+			RemovePendingAckSubscription(p_sub);
+			RemoveSubscriptionFromTable(p_sub->GetTopicName()->ToStdString());
+			return ResponseCode::SUCCESS;
 		}
 
 		ResponseCode ClientState::RemoveAllSubscriptionsForPacketId(uint16_t packet_id) {
-			ResponseCode rc = ResponseCode::FAILURE;
-			util::Map<util::String, std::shared_ptr<Subscription>>::const_iterator itr = subscription_map_.begin();
-			while(itr != subscription_map_.end()) {
-				if(itr->second->GetPacketId() == packet_id) {
-					itr = subscription_map_.erase(itr);
-				} else {
-					itr++;
+			std::lock_guard<std::mutex> update_guard(subscription_update_lock_);
+			auto packet_itr = pending_ack_subscription_map_.find(packet_id);
+			if(pending_ack_subscription_map_.end() == packet_itr) {
+				return ResponseCode::FAILURE;
+			}
+
+			util::Vector<std::shared_ptr<Subscription>> packet_subscriptions;
+			packet_subscriptions.swap(packet_itr->second);
+			pending_ack_subscription_map_.erase(packet_itr);
+
+			for(const std::shared_ptr<Subscription> &p_sub : packet_subscriptions) {
+				if(nullptr != p_sub && packet_id == p_sub->GetPacketId()) {
+					p_sub->SetAckIndex(0, 0);
+					RemoveSubscriptionFromTable(p_sub->GetTopicName()->ToStdString());
 				}
 			}
-			return rc;
+			return ResponseCode::SUCCESS;
 		}
 	}
 }
@@ -56,27 +56,17 @@ namespace awsiotsdk {
 
 		// Could have used helper functions defined in packet if they were placed in a common Helper class
 		// Did not make sense to define such a class since outside of packets, this is the only usage
-		void WillOptions::WriteToBuffer(util::String &buf) {
-			size_t length = p_topic_name_->Length();
+		void WillOptions::WriteToBuffer(util::OutputBuffer &buf) {
+			const util::String &topic_name = p_topic_name_->GetData();
 
-			if(length > 0) {
-				char temp_byte = (char) (length / 256);
-				buf.append(&temp_byte, 1);
-				temp_byte = (char) (length % 256);
-				buf.append(&temp_byte, 1);
-
-				buf.append(p_topic_name_->ToStdString());
+			if(!topic_name.empty()) {
+				buf.AppendUInt16(static_cast<uint16_t>(topic_name.length()));
+				buf.Append(topic_name.data(), topic_name.length());
 			}
 
-			length = message_.length();
-
-			if(length > 0) {
-				char temp_byte = (char) (length / 256);
-				buf.append(&temp_byte, 1);
-				temp_byte = (char) (length % 256);
-				buf.append(&temp_byte, 1);
-
-				buf.append(message_);
+			if(!message_.empty()) {
+				buf.AppendUInt16(static_cast<uint16_t>(message_.length()));
+				buf.Append(message_.data(), message_.length());
 			}
 		}
 
@@ -107,12 +97,64 @@ namespace awsiotsdk {
 
 		Subscription::Subscription(std::unique_ptr<Utf8String> p_topic_name, QoS max_qos, ApplicationCallbackHandlerPtr p_app_handler, std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data) {
 			is_active_ = false;
-			index_in_packet_ = 0;
-			packet_id_ = 0;
+			ack_index_ = 0;
 			p_topic_name_ = std::shared_ptr<Utf8String>(std::move(p_topic_name));
 			max_qos_ = max_qos;
 			p_app_handler_ = p_app_handler;
+			p_app_view_handler_ = nullptr;
 			p_app_handler_data_ = p_app_handler_data;
 		}
+
+		std::shared_ptr<Subscription> Subscription::Create(std::unique_ptr<Utf8String> p_topic_name, QoS max_qos, ApplicationViewCallbackHandlerPtr p_app_view_handler, std::shared_ptr<SubscriptionHandlerContextData> p_app_handler_data) {
+			if(nullptr == p_topic_name || nullptr == p_app_view_handler) {
+				return nullptr;
+			}
+
+			std::shared_ptr<Subscription> p_subscription = std::shared_ptr<Subscription>(new Subscription(std::move(p_topic_name), max_qos, nullptr, p_app_handler_data));
+			p_subscription->p_app_view_handler_ = p_app_view_handler;
+			return p_subscription;
+		}
+
+		Subscription::Subscription(const Subscription &other)
+			: p_app_handler_(other.p_app_handler_), p_app_view_handler_(other.p_app_view_handler_),
+			  p_app_handler_data_(other.p_app_handler_data_), is_active_(other.is_active_.load()),
+			  ack_index_(other.ack_index_.load()), max_qos_(other.max_qos_.load()), p_topic_name_(other.p_topic_name_) {
+		}
+
+		Subscription::Subscription(Subscription &&other)
+			: p_app_handler_(std::move(other.p_app_handler_)), p_app_view_handler_(std::move(other.p_app_view_handler_)),
+			  p_app_handler_data_(std::move(other.p_app_handler_data_)), is_active_(other.is_active_.load()),
+			  ack_index_(other.ack_index_.load()), max_qos_(other.max_qos_.load()),
+			  p_topic_name_(std::move(other.p_topic_name_)) {
+		}
+
+		Subscription &Subscription::operator=(const Subscription &other) & {
+			p_app_handler_ = other.p_app_handler_;
+			p_app_view_handler_ = other.p_app_view_handler_;
+			p_app_handler_data_ = other.p_app_handler_data_;
+			is_active_ = other.is_active_.load();
+			ack_index_ = other.ack_index_.load();
+			max_qos_ = other.max_qos_.load();
+			p_topic_name_ = other.p_topic_name_;
+			return *this;
+		}
+
+		Subscription &Subscription::operator=(Subscription &&other) & {
+			p_app_handler_ = std::move(other.p_app_handler_);
+			p_app_view_handler_ = std::move(other.p_app_view_handler_);
+			p_app_handler_data_ = std::move(other.p_app_handler_data_);
+			is_active_ = other.is_active_.load();
+			ack_index_ = other.ack_index_.load();
+			max_qos_ = other.max_qos_.load();
+			p_topic_name_ = std::move(other.p_topic_name_);
+			return *this;
+		}
+
+		PublishView::PublishView(util::StringView topic_name, util::StringView payload, QoS qos, bool is_retained,
+								 bool is_duplicate, std::shared_ptr<const util::Vector<unsigned char>> p_buffer,
+								 std::shared_ptr<const InternedTopic> p_interned_topic)
+			: topic_name_(topic_name), payload_(payload), qos_(qos), is_retained_(is_retained),
+			  is_duplicate_(is_duplicate), p_buffer_(std::move(p_buffer)), p_interned_topic_(std::move(p_interned_topic)) {
+		}
 	}
 }
@@ -20,6 +20,7 @@
  */
 
 #include "util/logging/LogMacros.hpp"
+#include "util/memory/PoolAllocator.hpp"
 
 #include "mqtt/ClientState.hpp"
 #include "mqtt/NetworkRead.hpp"
@@ -96,17 +97,14 @@ namespace awsiotsdk {
 			return std::make_shared<ConnectPacket>(is_clean_session, mqtt_version, keep_alive_timeout, std::move(p_client_id), std::move(p_username), std::move(p_password), std::move(p_will_msg));
 		}
 
-		util::String ConnectPacket::ToString() {
-			util::String buf;
-			buf.reserve(serialized_packet_length_);
+		void ConnectPacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_packet_length_);
 
 			fixed_header_.AppendToBuffer(buf);
 
-			AppendUtf8StringToBuffer(buf, p_protocol_id_);
-			char temp = static_cast<char>(mqtt_version_);
-			buf.append(&temp, 1);
-			temp = static_cast<char>(connect_flags_);
-			buf.append(&temp, 1);
+			AppendUtf8StringToBuffer(buf, *p_protocol_id_);
+			buf.AppendByte(static_cast<unsigned char>(mqtt_version_));
+			buf.AppendByte(static_cast<unsigned char>(connect_flags_));
 
 			// Ensure the value provided for keep alive is not too large to fit
 			// This can happen if the constructor was used directly instead of the Create Factory method
@@ -121,7 +119,7 @@ namespace awsiotsdk {
 				// No client id provided, server should assign one
 				AppendUInt16ToBuffer(buf, static_cast<uint16_t>(0));
 			} else {
-				AppendUtf8StringToBuffer(buf, p_client_id_);
+				AppendUtf8StringToBuffer(buf, *p_client_id_);
 			}
 
 			if(nullptr != p_will_msg_) {
@@ -135,8 +133,6 @@ namespace awsiotsdk {
 			if(nullptr != p_password_) {
 				AppendUtf8StringToBuffer(buf, p_password_);;
 			}*/
-
-			return buf;
 		}
 
 		/***********************************************
@@ -152,13 +148,10 @@ namespace awsiotsdk {
 			return std::make_shared<DisconnectPacket>();
 		}
 
-		util::String DisconnectPacket::ToString() {
-			util::String buf;
-			buf.reserve(serialized_packet_length_);
+		void DisconnectPacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_packet_length_);
 
 			fixed_header_.AppendToBuffer(buf);
-
-			return buf;
 		}
 
 		/********************************************
@@ -171,16 +164,13 @@ namespace awsiotsdk {
 		}
 
 		std::shared_ptr<PingreqPacket> PingreqPacket::Create() {
-			return std::make_shared<PingreqPacket>();
+			return std::allocate_shared<PingreqPacket>(util::memory::PoolAllocator<PingreqPacket>());
 		}
 
-		util::String PingreqPacket::ToString() {
-			util::String buf;
-			buf.reserve(serialized_packet_length_);
+		void PingreqPacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_packet_length_);
 
 			fixed_header_.AppendToBuffer(buf);
-
-			return buf;
 		}
 
 		/***************************************************
@@ -233,8 +223,9 @@ namespace awsiotsdk {
 				return rc;
 			}
 
-			const util::String packet_data = p_connect_packet->ToString();
-			rc = WriteToNetworkBuffer(p_network_connection, packet_data);
+			output_buffer_.Clear();
+			p_connect_packet->SerializeTo(output_buffer_);
+			rc = WriteToNetworkBuffer(p_network_connection, output_buffer_.GetBuffer());
 			if(ResponseCode::SUCCESS != rc) {
 				if(is_ack_registered) {
 					p_client_state_->DeletePendingAck(CONNACK_RESERVED_PACKET_ID);
@@ -278,7 +269,9 @@ namespace awsiotsdk {
 				std::shared_ptr<DisconnectPacket> p_disconnect_packet = std::dynamic_pointer_cast<DisconnectPacket>(
 						p_action_data);
 				if(nullptr != p_disconnect_packet) {
-					rc = WriteToNetworkBuffer(p_network_connection, p_disconnect_packet->ToString());
+					output_buffer_.Clear();
+					p_disconnect_packet->SerializeTo(output_buffer_);
+					rc = WriteToNetworkBuffer(p_network_connection, output_buffer_.GetBuffer());
 					if(ResponseCode::SUCCESS != rc) {
 						AWS_LOG_WARN(DISCONNECT_LOG_TAG, "Received Response Code %d on MQTT Disconnect",
 									 static_cast<int>(rc));
@@ -301,6 +294,7 @@ namespace awsiotsdk {
 		KeepaliveActionRunner::KeepaliveActionRunner(std::shared_ptr<ClientState> p_client_state)
 				: Action(ActionType::KEEP_ALIVE, KEEPALIVE_ACTION_DESCRIPTION) {
 			p_client_state_ = p_client_state;
+			was_connected_ = false;
 		}
 
 		std::unique_ptr<Action> KeepaliveActionRunner::Create(std::shared_ptr<ActionState> p_action_state) {
@@ -349,10 +343,14 @@ namespace awsiotsdk {
 					if(ResponseCode::MQTT_CONNACK_CONNECTION_ACCEPTED == rc) {
 						do_once = true;
 						util::Vector<std::shared_ptr<mqtt::Subscription>> topic_vector;
-
-						util::Map<util::String, std::shared_ptr<Subscription>>::const_iterator itr = p_client_state_->subscription_map_.begin();
-						while(itr != p_client_state_->subscription_map_.end()) {
-							topic_vector.push_back(itr->second);
+						util::Vector<std::shared_ptr<mqtt::Subscription>> subscriptions;
+						p_client_state_->GetSubscriptionTable()->GetAll(subscriptions);
+
+						util::Vector<std::shared_ptr<mqtt::Subscription>>::const_iterator itr = subscriptions.begin();
+						while(itr != subscriptions.end()) {
+							// Inactive until the new SUBACK arrives, otherwise the Subscribe action skips it as already subscribed
+							(*itr)->SetActive(false);
+							topic_vector.push_back(*itr);
 							itr++;
 							if(topic_vector.size() == MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET) {
 								std::shared_ptr<mqtt::SubscribePacket> p_subscribe_packet = mqtt::SubscribePacket::Create(topic_vector);
@@ -365,8 +363,13 @@ namespace awsiotsdk {
 							}
 						}
 
-						std::shared_ptr<mqtt::SubscribePacket> p_subscribe_packet = mqtt::SubscribePacket::Create(topic_vector);
-						rc = WriteToNetworkBuffer(p_network_connection, p_subscribe_packet->ToString());
+						if(!topic_vector.empty()) {
+							std::shared_ptr<mqtt::SubscribePacket> p_subscribe_packet = mqtt::SubscribePacket::Create(topic_vector);
+							rc = p_client_state_->PerformAction(ActionType::SUBSCRIBE, p_subscribe_packet, p_client_state_->GetMqttCommandTimeout());
+							if(ResponseCode::SUCCESS != rc) {
+								AWS_LOG_ERROR(KEEPALIVE_LOG_TAG, "Resubscribe attempt returned unhandled error : %d!!", static_cast<int>(rc));
+							}
+						}
 
 						p_client_state_->SetAutoReconnectRequired(false);
 						continue;
@@ -394,7 +397,9 @@ namespace awsiotsdk {
 						p_client_state_->SetAutoReconnectRequired(true);
 						continue;
 					} else if(p_client_state_->IsConnected()) {
-						rc = WriteToNetworkBuffer(p_network_connection, p_pingreq_packet->ToString());
+						output_buffer_.Clear();
+						p_pingreq_packet->SerializeTo(output_buffer_);
+						rc = WriteToNetworkBuffer(p_network_connection, output_buffer_.GetBuffer());
 
 						if(ResponseCode::SUCCESS != rc) {
 							AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
@@ -417,6 +422,62 @@ namespace awsiotsdk {
 
 			return rc;
 		}
+
+		ResponseCode KeepaliveActionRunner::DisconnectUnresponsive() {
+			ResponseCode rc = p_client_state_->PerformAction(ActionType::DISCONNECT, DisconnectPacket::Create(), p_client_state_->GetMqttCommandTimeout());
+			if(ResponseCode::SUCCESS != rc) {
+				AWS_LOG_ERROR(KEEPALIVE_LOG_TAG, "Network Disconnect attempt returned unhandled error : %d!!", static_cast<int>(rc));
+			}
+			p_client_state_->SetAutoReconnectRequired(true);
+			was_connected_ = false;
+			return rc;
+		}
+
+		ResponseCode KeepaliveActionRunner::PerformStep(std::shared_ptr<NetworkConnection> p_network_connection,
+														std::chrono::steady_clock::time_point &next_step_time_out) {
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			next_step_time_out = now + std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+
+			// Keep alive data is not available until connected, an interval of 0 disables keep alive
+			std::chrono::seconds keep_alive_interval = p_client_state_->GetKeepAliveTimeout()/2;
+			if(!p_client_state_->IsConnected() || 0 == keep_alive_interval.count()) {
+				was_connected_ = false;
+				return ResponseCode::SUCCESS;
+			}
+
+			if(!was_connected_) {
+				// Responses to Ping requests sent before a reconnect will never arrive
+				was_connected_ = true;
+				p_client_state_->SetPingreqPending(false);
+				next_pingreq_time_ = now + keep_alive_interval;
+			} else if(now >= next_pingreq_time_) {
+				if(p_client_state_->IsPingreqPending()) {
+					return DisconnectUnresponsive();
+				}
+
+				std::shared_ptr<PingreqPacket> p_pingreq_packet = PingreqPacket::Create();
+				if(nullptr == p_pingreq_packet) {
+					return ResponseCode::NULL_VALUE_ERROR;
+				}
+				output_buffer_.Clear();
+				p_pingreq_packet->SerializeTo(output_buffer_);
+				ResponseCode rc = WriteToNetworkBuffer(p_network_connection, output_buffer_.GetBuffer());
+				if(ResponseCode::SUCCESS != rc) {
+					AWS_LOG_ERROR(KEEPALIVE_LOG_TAG,
+								  "Writing PingReq to Network Failed with Error Code : %d. Disconnecting!!",
+								  static_cast<int>(rc));
+					DisconnectUnresponsive();
+					return rc;
+				}
+
+				p_client_state_->SetPingreqPending(true);
+				next_pingreq_time_ = now + keep_alive_interval;
+			}
+
+			if(next_pingreq_time_ < next_step_time_out) {
+				next_step_time_out = next_pingreq_time_;
+			}
+			return ResponseCode::SUCCESS;
+		}
 	}
 }
- 
@@ -20,7 +20,9 @@
  */
 
 #include <iostream>
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <thread>
 
 #include "util/logging/LogMacros.hpp"
@@ -28,9 +30,6 @@
 #include "mqtt/ClientState.hpp"
 #include "mqtt/NetworkRead.hpp"
 
-#define MAX_NO_OF_REMAINING_LENGTH_BYTES 4
-
-
 #define NETWORK_READ_LOG_TAG "[Network Read]"
 
 #define CONNACK_RESERVED_PACKET_ID 0
@@ -42,6 +41,10 @@ namespace awsiotsdk {
 				: Action(ActionType::READ_INCOMING, "TLS Read Action Runner") {
 			p_client_state_ = p_client_state;
 			is_waiting_for_connack_ = true;
+			p_receive_buf_ = std::make_shared<util::Vector<unsigned char>>(NETWORK_READ_BUFFER_SIZE);
+			receive_buf_start_ = 0;
+			receive_buf_end_ = 0;
+			subscription_table_version_ = 0;
 		}
 
 		std::unique_ptr<Action> NetworkReadActionRunner::Create(std::shared_ptr<ActionState> p_action_state) {
@@ -53,51 +56,186 @@ namespace awsiotsdk {
 			return std::unique_ptr<NetworkReadActionRunner>(new NetworkReadActionRunner(p_client_state));
 		}
 
-		ResponseCode NetworkReadActionRunner::DecodeRemainingLength(size_t &rem_len) {
-			util::String encoded_byte_str;
-			encoded_byte_str.reserve(1);
-			size_t multiplier = 1;
-			size_t len = 0;
-			ResponseCode rc;
-			rem_len = 0;
-			util::Vector<unsigned char> temp_buf;
+		ResponseCode NetworkReadActionRunner::DecodeRemainingLength(size_t &rem_len, size_t &rem_len_byte_count) {
+			// Remaining length follows the fixed header byte
+			size_t decode_index = receive_buf_start_ + 1;
+			return PacketDecoder::DecodeRemainingLength(p_receive_buf_->data() + decode_index,
+														receive_buf_end_ - decode_index, rem_len, rem_len_byte_count);
+		}
 
-			do {
-				temp_buf.clear();
-				if(++len > MAX_NO_OF_REMAINING_LENGTH_BYTES) {
-					/* bad data */
-					rc = ResponseCode::FAILURE;
-					break;
-				}
+		ResponseCode NetworkReadActionRunner::ExtractPacketFromReceiveBuffer(unsigned char &fixed_header_byte,
+																			 size_t &packet_body_start_out,
+																			 size_t &packet_body_length_out,
+																			 size_t &required_length_out) {
+			size_t buffered_length = receive_buf_end_ - receive_buf_start_;
+			// Fixed header byte and at least one byte of remaining length
+			required_length_out = 2;
+			if(required_length_out > buffered_length) {
+				return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+			}
 
-				rc = ReadFromNetworkBuffer(p_network_connection_, temp_buf, 1);
-				if(ResponseCode::SUCCESS != rc) {
-					break;
-				}
-				rem_len += (size_t)((temp_buf[0] & 127) * multiplier);
-				multiplier *= 128;
-			} while(0 != (temp_buf[0] & 128));
+			size_t rem_len = 0;
+			size_t rem_len_byte_count = 0;
+			ResponseCode rc = DecodeRemainingLength(rem_len, rem_len_byte_count);
+			if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc) {
+				required_length_out = buffered_length + 1;
+				return rc;
+			} else if(ResponseCode::SUCCESS != rc) {
+				return rc;
+			}
 
-			return rc;
+			required_length_out = 1 + rem_len_byte_count + rem_len;
+			if(required_length_out > buffered_length) {
+				return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+			}
+
+			// Packet body stays in the buffer until the next fill, it is not copied out here
+			fixed_header_byte = (*p_receive_buf_)[receive_buf_start_];
+			packet_body_start_out = receive_buf_start_ + 1 + rem_len_byte_count;
+			packet_body_length_out = rem_len;
+			receive_buf_start_ += required_length_out;
+			if(receive_buf_start_ == receive_buf_end_) {
+				receive_buf_start_ = 0;
+				receive_buf_end_ = 0;
+			}
+			return ResponseCode::SUCCESS;
 		}
 
-		ResponseCode NetworkReadActionRunner::ReadPacketFromNetwork(unsigned char &fixed_header_byte, util::Vector<unsigned char> &read_buf) {
-			read_buf.clear();
-			ResponseCode rc = ReadFromNetworkBuffer(p_network_connection_, read_buf, 1);
-			if(ResponseCode::SUCCESS != rc) {
-				return rc;
+		ResponseCode NetworkReadActionRunner::FillReceiveBuffer(size_t required_length) {
+			size_t buffered_length = receive_buf_end_ - receive_buf_start_;
+			if(1 < p_receive_buf_.use_count()) {
+				// Buffer is leased by the application and must not be modified, continue in a new one
+				std::shared_ptr<util::Vector<unsigned char>> p_new_buf = std::make_shared<util::Vector<unsigned char>>(
+					std::max(required_length, static_cast<size_t>(NETWORK_READ_BUFFER_SIZE)));
+				std::copy(p_receive_buf_->begin() + receive_buf_start_, p_receive_buf_->begin() + receive_buf_end_,
+						  p_new_buf->begin());
+				p_receive_buf_ = p_new_buf;
+				receive_buf_start_ = 0;
+				receive_buf_end_ = buffered_length;
+			} else if(0 < receive_buf_start_) {
+				// Move the partial packet to the front to make room for the rest of it
+				memmove(&(*p_receive_buf_)[0], &(*p_receive_buf_)[receive_buf_start_], buffered_length);
+				receive_buf_start_ = 0;
+				receive_buf_end_ = buffered_length;
+			}
+			util::Vector<unsigned char> &receive_buf = *p_receive_buf_;
+			if(receive_buf.size() < required_length) {
+				receive_buf.resize(required_length);
+			}
+
+			size_t read_bytes = 0;
+			ResponseCode rc = p_network_connection_->Read(receive_buf, receive_buf_end_,
+														  receive_buf.size() - receive_buf_end_, read_bytes);
+			if(ResponseCode::SUCCESS == rc) {
+				if(0 == read_bytes) {
+					return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+				}
+				receive_buf_end_ += read_bytes;
+			} else if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ != rc) {
+				ResetReceiveBuffer();
 			}
+			return rc;
+		}
+
+		void NetworkReadActionRunner::ResetReceiveBuffer() {
+			receive_buf_start_ = 0;
+			receive_buf_end_ = 0;
+		}
 
-			fixed_header_byte = read_buf[0];
-			read_buf.clear();
+		bool NetworkReadActionRunner::HasBufferedPacket() {
 			size_t rem_len = 0;
-			rc = DecodeRemainingLength(rem_len);
+			size_t rem_len_byte_count = 0;
+			size_t buffered_length = receive_buf_end_ - receive_buf_start_;
+			if(2 > buffered_length || ResponseCode::SUCCESS != DecodeRemainingLength(rem_len, rem_len_byte_count)) {
+				return false;
+			}
+			return 1 + rem_len_byte_count + rem_len <= buffered_length;
+		}
+
+		ResponseCode NetworkReadActionRunner::ReadPacketFromNetwork(unsigned char &fixed_header_byte, size_t &packet_body_start_out,
+																	size_t &packet_body_length_out, bool is_single_read) {
+			size_t required_length = 0;
+			bool is_read_done = false;
+			// Only read from the network once every complete packet in the buffer has been processed
+			ResponseCode rc = ExtractPacketFromReceiveBuffer(fixed_header_byte, packet_body_start_out,
+															 packet_body_length_out, required_length);
+			while(ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc && !(is_single_read && is_read_done)) {
+				rc = FillReceiveBuffer(required_length);
+				if(ResponseCode::SUCCESS != rc) {
+					return rc;
+				}
+				is_read_done = true;
+				rc = ExtractPacketFromReceiveBuffer(fixed_header_byte, packet_body_start_out,
+													packet_body_length_out, required_length);
+			}
+
 			if(ResponseCode::SUCCESS != rc) {
-				return rc;
+				// Stream can not be parsed any further
+				ResetReceiveBuffer();
 			}
+			return rc;
+		}
 
-			if(0 < rem_len) {
-				rc = ReadFromNetworkBuffer(p_network_connection_, read_buf, rem_len);
+		ResponseCode NetworkReadActionRunner::ProcessIncomingPacket(bool is_single_read) {
+			AWS_LOG_TRACE(NETWORK_READ_LOG_TAG, " Network Read Thread, TLS Status : %d", p_network_connection_->IsConnected());
+			unsigned char fixed_header_byte = 0x00;
+			size_t packet_body_start = 0;
+			size_t packet_body_length = 0;
+			ResponseCode rc = ReadPacketFromNetwork(fixed_header_byte, packet_body_start, packet_body_length,
+													is_single_read);
+			if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc) {
+				return rc;
+			} else if(ResponseCode::SUCCESS == rc) {
+				unsigned char message_type_byte = fixed_header_byte;
+				message_type_byte >>= 4; // Packet type is in first 4 bits
+				message_type_byte &= 0x0F; // Only keep the least significant 4 bits
+				MessageTypes messageType = (MessageTypes) message_type_byte;
+				util::Vector<unsigned char> &read_buf = packet_body_buf_;
+				if(MessageTypes::PUBLISH != messageType) {
+					// Publish payloads are handled in place, other packets are small and copied out into a reused buffer
+					read_buf.assign(p_receive_buf_->begin() + packet_body_start,
+									p_receive_buf_->begin() + packet_body_start + packet_body_length);
+				}
+				switch(messageType) {
+					case MessageTypes::CONNACK:
+						rc = HandleConnack(read_buf);
+						break;
+					case MessageTypes::PUBLISH: {
+							bool is_retained = ((fixed_header_byte & 0x01) == 0x01);
+							bool is_duplicate = ((fixed_header_byte & 0x08) == 0x08);
+							QoS qos = ((fixed_header_byte & 0x02) == 0x02) ? QoS::QOS1 : QoS::QOS0;
+							rc = HandlePublish(packet_body_start, packet_body_length, is_duplicate, is_retained, qos);
+						}
+						break;
+					case MessageTypes::PUBACK:
+						rc = HandlePuback(read_buf);
+						break;
+					case MessageTypes::SUBACK:
+						rc = HandleSuback(read_buf);
+						break;
+					case MessageTypes::UNSUBACK:
+						rc = HandleUnsuback(read_buf);
+						break;
+					case MessageTypes::PINGRESP:
+						p_client_state_->SetPingreqPending(false);
+						rc = ResponseCode::SUCCESS;
+						break;
+					default:
+						// Any type values other than above are either unsupported or invalid
+						// Packet types used for QoS2 are currently unsupported
+						break;
+				}
+			} else if(!is_waiting_for_connack_) {
+				is_waiting_for_connack_ = true;
+				if(*p_thread_continue_ && p_client_state_->IsConnected()) {
+					AWS_LOG_ERROR(NETWORK_READ_LOG_TAG, "Network Read attempt returned unhandled error : %d!! Requesting  Network Reconnect.", static_cast<int>(rc));
+					rc = p_client_state_->PerformAction(ActionType::DISCONNECT, DisconnectPacket::Create(), p_client_state_->GetMqttCommandTimeout());
+					if(ResponseCode::SUCCESS != rc) {
+						AWS_LOG_ERROR(NETWORK_READ_LOG_TAG, "Network Disconnect attempt returned unhandled error : %d!!", static_cast<int>(rc));
+						// No further action being taken. Assumption is that reconnect logic should bring SDK back to working state
+					}
+					p_client_state_->SetAutoReconnectRequired(true);
+				}
 			}
 			return rc;
 		}
@@ -107,78 +245,55 @@ namespace awsiotsdk {
 				return ResponseCode::NULL_VALUE_ERROR;
 			}
 
-			bool is_duplicate;
-			bool is_retained;
-			QoS qos;
-			unsigned char fixed_header_byte;
-			unsigned char message_type_byte;
-			util::Vector<unsigned char> read_buf;
 			ResponseCode rc = ResponseCode::SUCCESS;
 			p_network_connection_ = p_network_connection;
 			std::atomic_bool & _p_thread_continue_ = *p_thread_continue_;
-			std::chrono::milliseconds thread_sleep_duration(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+			std::chrono::milliseconds wait_duration(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
 
 			is_waiting_for_connack_ = !(p_client_state_->IsConnected());
 
 			do {
-				AWS_LOG_TRACE(NETWORK_READ_LOG_TAG, " Network Read Thread, TLS Status : %d", p_network_connection->IsConnected());
-				// Clear buffers
-				fixed_header_byte = 0x00;
-				read_buf.clear();
-				rc = ReadPacketFromNetwork(fixed_header_byte, read_buf);
+				rc = ProcessIncomingPacket(false);
 				if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc) {
-					std::this_thread::sleep_for(thread_sleep_duration);
-					continue;
-				} else if(ResponseCode::SUCCESS == rc) {
-					message_type_byte = fixed_header_byte;
-					message_type_byte >>= 4; // Packet type is in first 4 bits
-					message_type_byte &= 0x0F; // Only keep the least significant 4 bits
-					MessageTypes messageType = (MessageTypes) message_type_byte;
-					switch(messageType) {
-						case MessageTypes::CONNACK:
-							rc = HandleConnack(read_buf);
-							break;
-						case MessageTypes::PUBLISH: {
-								is_retained = ((fixed_header_byte & 0x01) == 0x01);
-								is_duplicate = ((fixed_header_byte & 0x08) == 0x08);
-								qos = ((fixed_header_byte & 0x02) == 0x02) ? QoS::QOS1 : QoS::QOS0;
-								rc = HandlePublish(read_buf, is_duplicate, is_retained, qos);
-							}
-							break;
-						case MessageTypes::PUBACK:
-							rc = HandlePuback(read_buf);
-							break;
-						case MessageTypes::SUBACK:
-							rc = HandleSuback(read_buf);
-							break;
-						case MessageTypes::UNSUBACK:
-							rc = HandleUnsuback(read_buf);
-							break;
-						case MessageTypes::PINGRESP:
-							p_client_state_->SetPingreqPending(false);
-							rc = ResponseCode::SUCCESS;
-							break;
-						default:
-							// Any type values other than above are either unsupported or invalid
-							// Packet types used for QoS2 are currently unsupported
-							break;
-					}
-				} else if(!is_waiting_for_connack_) {
-					is_waiting_for_connack_ = true;
-					if(_p_thread_continue_ && p_client_state_->IsConnected()) {
-						AWS_LOG_ERROR(NETWORK_READ_LOG_TAG, "Network Read attempt returned unhandled error : %d!! Requesting  Network Reconnect.", static_cast<int>(rc));
-						rc = p_client_state_->PerformAction(ActionType::DISCONNECT, DisconnectPacket::Create(), p_client_state_->GetMqttCommandTimeout());
-						if(ResponseCode::SUCCESS != rc) {
-							AWS_LOG_ERROR(NETWORK_READ_LOG_TAG, "Network Disconnect attempt returned unhandled error : %d!!", static_cast<int>(rc));
-							// No further action being taken. Assumption is that reconnect logic should bring SDK back to working state
-						}
-						p_client_state_->SetAutoReconnectRequired(true);
-					}
+					// Wakes up as soon as data arrives instead of after a fixed sleep
+					p_network_connection->WaitForReadable(wait_duration);
 				}
 			} while(_p_thread_continue_);
 			return rc;
 		}
 
+		ResponseCode NetworkReadActionRunner::PerformStep(std::shared_ptr<NetworkConnection> p_network_connection,
+														  std::chrono::steady_clock::time_point &next_step_time_out) {
+			if(nullptr == p_network_connection) {
+				return ResponseCode::NULL_VALUE_ERROR;
+			}
+
+			if(nullptr == p_network_connection_) {
+				p_network_connection_ = p_network_connection;
+				is_waiting_for_connack_ = !(p_client_state_->IsConnected());
+			}
+
+			ResponseCode rc = ResponseCode::SUCCESS;
+			// Reads are only attempted when they can not block, a packet split across reads is completed in a later step
+			for(size_t packet_count = 0; packet_count < NETWORK_READ_MAX_PACKETS_PER_STEP; packet_count++) {
+				if(!HasBufferedPacket()
+				   && ResponseCode::SUCCESS != p_network_connection_->WaitForReadable(std::chrono::milliseconds(0))) {
+					rc = ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+				} else {
+					rc = ProcessIncomingPacket(true);
+				}
+				if(ResponseCode::NETWORK_SSL_NOTHING_TO_READ == rc) {
+					next_step_time_out = std::chrono::steady_clock::now()
+										 + std::chrono::milliseconds(DEFAULT_CORE_THREAD_SLEEP_DURATION_MS);
+					return ResponseCode::SUCCESS;
+				}
+			}
+
+			// Step budget is used up, continue right after the other connections had their turn
+			next_step_time_out = std::chrono::steady_clock::now();
+			return rc;
+		}
+
 		ResponseCode NetworkReadActionRunner::HandleConnack(const util::Vector<unsigned char> &read_buf) {
 			ResponseCode rc = ResponseCode::SUCCESS;
 			if(2 != read_buf.size()) {
@@ -218,26 +333,72 @@ namespace awsiotsdk {
 			return rc;
 		}
 
-		ResponseCode NetworkReadActionRunner::HandlePublish(const util::Vector<unsigned char> &read_buf, bool is_retained, bool is_duplicate, QoS qos){
+		ResponseCode NetworkReadActionRunner::HandlePublish(size_t packet_body_start, size_t packet_body_length,
+															bool is_duplicate, bool is_retained, QoS qos) {
 			ResponseCode rc = ResponseCode::FAILURE;
-			std::shared_ptr<mqtt::PublishPacket> p_publish_packet = PublishPacket::Create(read_buf, is_retained, is_duplicate, qos);
+			const util::Vector<unsigned char> &receive_buf = *p_receive_buf_;
+			const char *p_body = reinterpret_cast<const char *>(&receive_buf[packet_body_start]);
+
+			// Topic name length (2 bytes), topic name and packet id (2 bytes) for QoS1
+			size_t extract_index = 0;
+			if(2 > packet_body_length) {
+				return ResponseCode::MQTT_UNEXPECTED_PACKET_FORMAT_ERROR;
+			}
+			size_t topic_name_length = static_cast<size_t>(((uint16_t)receive_buf[packet_body_start] << 8)
+														   | receive_buf[packet_body_start + 1]);
+			extract_index += 2;
+			size_t header_length = extract_index + topic_name_length + ((QoS::QOS0 != qos) ? 2 : 0);
+			if(0 == topic_name_length || header_length > packet_body_length) {
+				return ResponseCode::MQTT_UNEXPECTED_PACKET_FORMAT_ERROR;
+			}
+
+			util::StringView topic_name(p_body + extract_index, topic_name_length);
+			extract_index += topic_name_length;
+			uint16_t packet_id = 0;
+			if(QoS::QOS0 != qos) {
+				packet_id = static_cast<uint16_t>(((uint16_t)receive_buf[packet_body_start + extract_index] << 8)
+												  | receive_buf[packet_body_start + extract_index + 1]);
+				extract_index += 2;
+			}
+			util::StringView payload(p_body + extract_index, packet_body_length - extract_index);
+
+			// Only fetch a new snapshot when subscriptions changed, keeps the lookup free of locks and reference counting
+			uint32_t subscription_table_version = p_client_state_->GetSubscriptionTableVersion();
+			if(nullptr == p_subscription_table_ || subscription_table_version != subscription_table_version_) {
+				p_subscription_table_ = p_client_state_->GetSubscriptionTable();
+				subscription_table_version_ = subscription_table_version;
+			}
 
-			util::String topic_name = p_publish_packet->GetTopicName();
-			std::shared_ptr<Subscription> p_sub = p_client_state_->GetSubscription(topic_name);
+			// Every subscription whose filter matches gets the message, including wildcard filters. Matches are cached
+			// per interned topic until the subscription table changes
+			std::shared_ptr<InternedTopic> p_interned_topic = topic_intern_pool_.Intern(topic_name);
+			const util::Vector<std::shared_ptr<Subscription>> *p_matches
+				= p_interned_topic->GetCachedMatches(subscription_table_version_);
+			if(nullptr == p_matches) {
+				util::Vector<std::shared_ptr<Subscription>> &matches
+					= p_interned_topic->ResetCachedMatches(subscription_table_version_);
+				p_subscription_table_->Match(topic_name, matches);
+				p_matches = &matches;
+			}
 
-			if(nullptr != p_sub) {
+			rc = ResponseCode::MQTT_NO_SUBSCRIPTION_FOUND;
+			for(const std::shared_ptr<Subscription> &p_sub : *p_matches) {
 				if(p_sub->IsActive()) {
-					p_sub->p_app_handler_(topic_name, p_publish_packet->GetPayload(), p_sub->p_app_handler_data_);
+					if(nullptr != p_sub->p_app_view_handler_) {
+						PublishView publish_view(topic_name, payload, qos, is_retained, is_duplicate, p_receive_buf_,
+												 p_interned_topic);
+						p_sub->p_app_view_handler_(publish_view, p_sub->p_app_handler_data_);
+					} else {
+						p_sub->p_app_handler_(p_interned_topic->GetTopicName(), payload.ToString(), p_sub->p_app_handler_data_);
+					}
 					rc = ResponseCode::SUCCESS;
-				} else {
+				} else if(ResponseCode::SUCCESS != rc) {
 					rc = ResponseCode::MQTT_SUBSCRIPTION_NOT_ACTIVE;
 				}
-			} else {
-				rc = ResponseCode::MQTT_NO_SUBSCRIPTION_FOUND;
 			}
 
 			if(ResponseCode::SUCCESS == rc && QoS::QOS0 != qos) {
-				std::shared_ptr<mqtt::PubackPacket> p_puback_packet = PubackPacket::Create(p_publish_packet->GetPacketId());
+				std::shared_ptr<mqtt::PubackPacket> p_puback_packet = PubackPacket::Create(packet_id);
 				uint16_t action_id = 0;
 				/* TODO: nullchecks */
 				//Ignore action_id, we don't support QoS2 at the moment
@@ -165,31 +165,37 @@ namespace awsiotsdk {
 			return length;
 		}
 
-		void PacketFixedHeader::AppendToBuffer(util::String &p_buf) {
-			unsigned char encoded_byte = (unsigned char)0;
-			size_t length = remaining_length_;
-
-			p_buf.append((char *)&fixed_header_byte_, 1);
-
-			if(0 < remaining_length_) {
-				do {
-					encoded_byte = (unsigned char) (length % 128);
-					length /= 128;
-					if(length > 0) {
-						encoded_byte |= 0x80;
-					}
-					p_buf.append((char *)&encoded_byte, 1);
-				} while(length > 0);
-			} else {
-				p_buf.append((char *)&encoded_byte, 1);
-			}
+		void PacketFixedHeader::AppendToBuffer(util::OutputBuffer &buf) {
+			// Fixed header byte followed by at most 4 bytes of remaining length, written with a single append
+			char header_bytes[5];
+			header_bytes[0] = (char) fixed_header_byte_;
+			size_t header_length = 1 + EncodeRemainingLength(remaining_length_, &header_bytes[1]);
+
+			buf.Append(header_bytes, header_length);
+		}
+
+		size_t PacketFixedHeader::EncodeRemainingLength(size_t rem_len, char *p_encoded_out) {
+			size_t encoded_length = 0;
+			do {
+				unsigned char encoded_byte = (unsigned char) (rem_len % 128);
+				rem_len /= 128;
+				if(rem_len > 0) {
+					encoded_byte |= 0x80;
+				}
+				p_encoded_out[encoded_length++] = (char) encoded_byte;
+			} while(rem_len > 0 && encoded_length < 4);
+
+			return encoded_length;
+		}
+
+		util::String Packet::ToString() {
+			util::OutputBuffer buf(serialized_packet_length_);
+			SerializeTo(buf);
+			return buf.Release();
 		}
 
-		void Packet::AppendUInt16ToBuffer(util::String &buf, uint16_t value) {
-			char first_byte = (char) (value / 256);
-			char second_byte = (char) (value % 256);
-			buf.append(&first_byte, 1);
-			buf.append(&second_byte, 1);
+		void Packet::AppendUInt16ToBuffer(util::OutputBuffer &buf, uint16_t value) {
+			buf.AppendUInt16(value);
 		}
 
 		uint16_t Packet::ReadUInt16FromBuffer(const util::Vector<unsigned char> &buf, size_t &extract_index) {
@@ -213,29 +219,12 @@ namespace awsiotsdk {
 			return nullptr;
 		}
 
-		void Packet::AppendUtf8StringToBuffer(util::String &buf, std::unique_ptr<Utf8String> &utf8_str) {
-			size_t length = utf8_str->Length();
-
-			if(length > 0) {
-				char temp_byte = (char) (length / 256);
-				buf.append(&temp_byte, 1);
-				temp_byte = (char) (length % 256);
-				buf.append(&temp_byte, 1);
-
-				buf.append(utf8_str->ToStdString());
-			}
-		}
-
-		void Packet::AppendUtf8StringToBuffer(util::String &buf, std::shared_ptr<Utf8String> &utf8_str) {
-			size_t length = utf8_str->Length();
-
-			if(length > 0) {
-				char temp_byte = (char) (length / 256);
-				buf.append(&temp_byte, 1);
-				temp_byte = (char) (length % 256);
-				buf.append(&temp_byte, 1);
+		void Packet::AppendUtf8StringToBuffer(util::OutputBuffer &buf, const Utf8String &utf8_str) {
+			const util::String &data = utf8_str.GetData();
 
-				buf.append(utf8_str->ToStdString());
+			if(!data.empty()) {
+				buf.AppendUInt16(static_cast<uint16_t>(data.length()));
+				buf.Append(data.data(), data.length());
 			}
 		}
 	}
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PacketDecoder.cpp
+ * @brief
+ *
+ */
+
+#include <algorithm>
+
+#include "util/logging/LogMacros.hpp"
+
+#include "mqtt/PacketDecoder.hpp"
+
+#define PACKET_DECODER_LOG_TAG "[Packet Decoder]"
+
+#define PACKET_TYPE_RESERVED_LOW 0
+#define PACKET_TYPE_RESERVED_HIGH 15
+
+namespace awsiotsdk {
+	namespace mqtt {
+		PacketDecoder::PacketDecoder(PacketHandlerPtr p_packet_handler, size_t max_remaining_length) {
+			p_packet_handler_ = p_packet_handler;
+			max_remaining_length_ = max_remaining_length;
+			Reset();
+		}
+
+		std::unique_ptr<PacketDecoder> PacketDecoder::Create(PacketHandlerPtr p_packet_handler,
+															 size_t max_remaining_length) {
+			if(nullptr == p_packet_handler) {
+				return nullptr;
+			}
+
+			return std::unique_ptr<PacketDecoder>(new PacketDecoder(p_packet_handler, max_remaining_length));
+		}
+
+		void PacketDecoder::Reset() {
+			state_ = DecodeState::FIXED_HEADER;
+			failure_rc_ = ResponseCode::SUCCESS;
+			fixed_header_byte_ = 0;
+			remaining_length_ = 0;
+			remaining_length_multiplier_ = 1;
+			remaining_length_byte_count_ = 0;
+			body_buf_.clear();
+		}
+
+		bool PacketDecoder::IsAtPacketBoundary() {
+			return DecodeState::FIXED_HEADER == state_;
+		}
+
+		ResponseCode PacketDecoder::EmitPacket(const unsigned char *p_body) {
+			// State is updated first so the handler can Reset the decoder
+			state_ = DecodeState::FIXED_HEADER;
+			ResponseCode rc = p_packet_handler_(fixed_header_byte_, p_body, remaining_length_);
+			body_buf_.clear();
+			return rc;
+		}
+
+		ResponseCode PacketDecoder::Fail(ResponseCode rc) {
+			AWS_LOG_ERROR(PACKET_DECODER_LOG_TAG, "Unable to decode packet stream : %d", static_cast<int>(rc));
+			state_ = DecodeState::FAILED;
+			failure_rc_ = rc;
+			body_buf_.clear();
+			return rc;
+		}
+
+		ResponseCode PacketDecoder::Feed(const unsigned char *p_data, size_t data_length, size_t &consumed_length_out) {
+			consumed_length_out = 0;
+			if(DecodeState::FAILED == state_) {
+				return failure_rc_;
+			}
+			if(nullptr == p_data && 0 < data_length) {
+				return ResponseCode::NULL_VALUE_ERROR;
+			}
+
+			ResponseCode rc = ResponseCode::SUCCESS;
+			size_t index = 0;
+			while(index < data_length && ResponseCode::SUCCESS == rc) {
+				switch(state_) {
+					case DecodeState::FIXED_HEADER: {
+							unsigned char packet_type = static_cast<unsigned char>(p_data[index] >> 4);
+							if(PACKET_TYPE_RESERVED_LOW == packet_type || PACKET_TYPE_RESERVED_HIGH == packet_type) {
+								consumed_length_out = index;
+								return Fail(ResponseCode::MQTT_RX_MESSAGE_PACKET_TYPE_INVALID_ERROR);
+							}
+							fixed_header_byte_ = p_data[index++];
+							remaining_length_ = 0;
+							remaining_length_multiplier_ = 1;
+							remaining_length_byte_count_ = 0;
+							state_ = DecodeState::REMAINING_LENGTH;
+						}
+						break;
+					case DecodeState::REMAINING_LENGTH: {
+							unsigned char encoded_byte = p_data[index++];
+							remaining_length_ += (encoded_byte & 127) * remaining_length_multiplier_;
+							remaining_length_multiplier_ *= 128;
+							remaining_length_byte_count_++;
+							if(0 != (encoded_byte & 128)) {
+								if(MAX_NO_OF_REMAINING_LENGTH_BYTES <= remaining_length_byte_count_) {
+									consumed_length_out = index;
+									return Fail(ResponseCode::MQTT_DECODE_REMAINING_LENGTH_ERROR);
+								}
+							} else if(remaining_length_ > max_remaining_length_) {
+								consumed_length_out = index;
+								return Fail(ResponseCode::MQTT_DECODE_REMAINING_LENGTH_ERROR);
+							} else if(0 == remaining_length_) {
+								rc = EmitPacket(nullptr);
+							} else {
+								state_ = DecodeState::BODY;
+							}
+						}
+						break;
+					case DecodeState::BODY: {
+							size_t available_length = data_length - index;
+							if(body_buf_.empty() && available_length >= remaining_length_) {
+								// Whole body is in this chunk, no need to copy it
+								index += remaining_length_;
+								rc = EmitPacket(&p_data[index - remaining_length_]);
+							} else {
+								if(body_buf_.empty()) {
+									body_buf_.reserve(remaining_length_);
+								}
+								size_t copy_length = std::min(available_length, remaining_length_ - body_buf_.size());
+								body_buf_.insert(body_buf_.end(), p_data + index, p_data + index + copy_length);
+								index += copy_length;
+								if(body_buf_.size() == remaining_length_) {
+									rc = EmitPacket(body_buf_.data());
+								}
+							}
+						}
+						break;
+					case DecodeState::FAILED:
+						consumed_length_out = index;
+						return failure_rc_;
+				}
+			}
+
+			consumed_length_out = index;
+			return rc;
+		}
+
+		ResponseCode PacketDecoder::DecodeRemainingLength(const unsigned char *p_data, size_t data_length,
+														  size_t &rem_len_out, size_t &rem_len_byte_count_out) {
+			size_t multiplier = 1;
+			size_t len = 0;
+			unsigned char encoded_byte = 0;
+			rem_len_out = 0;
+			rem_len_byte_count_out = 0;
+
+			do {
+				if(++len > MAX_NO_OF_REMAINING_LENGTH_BYTES) {
+					/* bad data */
+					return ResponseCode::MQTT_DECODE_REMAINING_LENGTH_ERROR;
+				}
+				if(len > data_length) {
+					return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+				}
+
+				encoded_byte = p_data[len - 1];
+				rem_len_out += (size_t)((encoded_byte & 127) * multiplier);
+				multiplier *= 128;
+			} while(0 != (encoded_byte & 128));
+
+			rem_len_byte_count_out = len;
+			return ResponseCode::SUCCESS;
+		}
+	}
+}
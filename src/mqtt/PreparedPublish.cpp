@@ -0,0 +1,74 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PreparedPublish.cpp
+ * @brief Pre-serialized Publish header for topics that are published to repeatedly
+ *
+ */
+
+#include "mqtt/Packet.hpp"
+#include "mqtt/PreparedPublish.hpp"
+
+namespace awsiotsdk {
+	namespace mqtt {
+		PreparedPublish::PreparedPublish(std::unique_ptr<Utf8String> p_topic_name, QoS qos, bool is_retained) {
+			topic_name_ = p_topic_name->ToStdString();
+			qos_ = qos;
+			is_retained_ = is_retained;
+
+			util::OutputBuffer encoded_topic_name(topic_name_.length() + 2);
+			encoded_topic_name.AppendUInt16(static_cast<uint16_t>(topic_name_.length()));
+			encoded_topic_name.Append(topic_name_.data(), topic_name_.length());
+			encoded_topic_name_ = encoded_topic_name.Release();
+
+			// Remaining length is filled in for each message, only the first byte is kept
+			PacketFixedHeader fixed_header;
+			fixed_header.Initialize(MessageTypes::PUBLISH, false, qos, is_retained, 0);
+			fixed_header_byte_ = fixed_header.GetFixedHeaderByte();
+		}
+
+		std::shared_ptr<PreparedPublish> PreparedPublish::Create(std::unique_ptr<Utf8String> p_topic_name, QoS qos,
+																 bool is_retained) {
+			if(nullptr == p_topic_name || 0 == p_topic_name->Length()) {
+				return nullptr;
+			}
+			return std::make_shared<PreparedPublish>(std::move(p_topic_name), qos, is_retained);
+		}
+
+		size_t PreparedPublish::GetRemainingLength(size_t payload_length) const {
+			size_t remaining_length = encoded_topic_name_.length() + payload_length;
+			if(QoS::QOS0 != qos_) {
+				remaining_length += 2; // Packet ID requires 2 bytes in case of QoS1 and QoS2
+			}
+			return remaining_length;
+		}
+
+		void PreparedPublish::SerializeHeaderTo(util::OutputBuffer &buf, uint16_t packet_id,
+												size_t payload_length) const {
+			char header_bytes[5];
+			header_bytes[0] = (char) fixed_header_byte_;
+			size_t header_length = 1 + PacketFixedHeader::EncodeRemainingLength(GetRemainingLength(payload_length),
+																				 &header_bytes[1]);
+
+			buf.Append(header_bytes, header_length);
+			buf.Append(encoded_topic_name_.data(), encoded_topic_name_.length());
+
+			if(QoS::QOS0 != qos_) {
+				buf.AppendUInt16(packet_id);
+			}
+		}
+	}
+}
@@ -22,15 +22,18 @@
  */
 
 #include "util/logging/LogMacros.hpp"
+#include "util/memory/PoolAllocator.hpp"
 
 #include "mqtt/ClientState.hpp"
 #include "mqtt/Publish.hpp"
 
 #define PUBLISH_ACTION_DESCRIPTION "MQTT Publish Action"
 #define PUBACK_ACTION_DESCRIPTION "MQTT Puback Action"
+#define PUBLISH_BATCH_ACTION_DESCRIPTION "MQTT Publish Batch Action"
 
 #define PUBLISH_ACTION_LOG_TAG "[Publish]"
 #define PUBACK_ACTION_LOG_TAG "[Puback]"
+#define PUBLISH_BATCH_ACTION_LOG_TAG "[Publish Batch]"
 
 namespace awsiotsdk {
 	namespace mqtt {
@@ -67,6 +70,20 @@ namespace awsiotsdk {
 			serialized_packet_length_ = packet_size_ + fixed_header_.Length();
 		}
 
+		PublishPacket::PublishPacket(std::shared_ptr<const PreparedPublish> p_prepared_publish, util::String payload) {
+			payload_ = std::move(payload);
+			is_retained_ = p_prepared_publish->IsRetained();
+			is_duplicate_ = false;
+			qos_ = p_prepared_publish->GetQoS();
+			packet_id_ = 0; // Initialized by ClientCore
+			packet_size_ = p_prepared_publish->GetRemainingLength(payload_.length());
+			p_prepared_publish_ = std::move(p_prepared_publish);
+
+			fixed_header_.Initialize(MessageTypes::PUBLISH, is_duplicate_, qos_, is_retained_, packet_size_);
+
+			serialized_packet_length_ = packet_size_ + fixed_header_.Length();
+		}
+
 		PublishPacket::PublishPacket(const util::Vector<unsigned char> &buf, bool is_retained, bool is_duplicate, QoS qos) {
 			size_t extract_index = 0;
 
@@ -98,7 +115,16 @@ namespace awsiotsdk {
 			if(nullptr == p_topic_name) {
 				return nullptr;
 			}
-			return std::make_shared<PublishPacket>(std::move(p_topic_name), is_retained, is_duplicate, qos, payload);
+			return std::allocate_shared<PublishPacket>(util::memory::PoolAllocator<PublishPacket>(), std::move(p_topic_name),
+													   is_retained, is_duplicate, qos, payload);
+		}
+
+		std::shared_ptr<PublishPacket> PublishPacket::Create(std::shared_ptr<const PreparedPublish> p_prepared_publish, util::String payload) {
+			if(nullptr == p_prepared_publish) {
+				return nullptr;
+			}
+			return std::allocate_shared<PublishPacket>(util::memory::PoolAllocator<PublishPacket>(),
+													   std::move(p_prepared_publish), std::move(payload));
 		}
 
 		std::shared_ptr<PublishPacket> PublishPacket::Create(const util::Vector<unsigned char> &buf, bool is_retained, bool is_duplicate, QoS qos) {
@@ -106,22 +132,66 @@ namespace awsiotsdk {
 				// Must be at least length 3 to be contain a valid Utf8String
 				return nullptr;
 			}
-			return std::make_shared<PublishPacket>(buf, is_retained, is_duplicate, qos);
+			return std::allocate_shared<PublishPacket>(util::memory::PoolAllocator<PublishPacket>(), buf, is_retained,
+													   is_duplicate, qos);
+		}
+
+		void PublishPacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_packet_length_);
+
+			SerializeHeaderTo(buf);
+			buf.Append(payload_.data(), payload_.length());
 		}
 
-		util::String PublishPacket::ToString() {
-			util::String buf;
-			buf.reserve(serialized_packet_length_);
+		void PublishPacket::SerializeHeaderTo(util::OutputBuffer &buf) {
+			if(nullptr != p_prepared_publish_) {
+				p_prepared_publish_->SerializeHeaderTo(buf, GetPacketId(), payload_.length());
+				return;
+			}
 
 			fixed_header_.AppendToBuffer(buf);
-			AppendUtf8StringToBuffer(buf, p_topic_name_);
+			AppendUtf8StringToBuffer(buf, *p_topic_name_);
 
 			if(QoS::QOS0 != qos_) {
 				AppendUInt16ToBuffer(buf, GetPacketId());
 			}
+		}
 
-			buf.append(payload_);
-			return buf;
+		/*************************************************
+		 * PublishBatchPacket class function definitions *
+		 ************************************************/
+		PublishBatchPacket::PublishBatchPacket(util::Vector<std::shared_ptr<PublishPacket>> publish_packets) {
+			publish_packets_ = std::move(publish_packets);
+			batch_id_ = 0; // Initialized by ClientCore
+			serialized_batch_length_ = 0;
+			for(std::shared_ptr<PublishPacket> &p_publish_packet : publish_packets_) {
+				serialized_batch_length_ += p_publish_packet->Size();
+			}
+		}
+
+		std::shared_ptr<PublishBatchPacket> PublishBatchPacket::Create(util::Vector<std::shared_ptr<PublishPacket>> publish_packets) {
+			if(publish_packets.empty()) {
+				return nullptr;
+			}
+			for(std::shared_ptr<PublishPacket> &p_publish_packet : publish_packets) {
+				if(nullptr == p_publish_packet) {
+					return nullptr;
+				}
+			}
+			return std::make_shared<PublishBatchPacket>(std::move(publish_packets));
+		}
+
+		void PublishBatchPacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_batch_length_);
+			for(std::shared_ptr<PublishPacket> &p_publish_packet : publish_packets_) {
+				p_publish_packet->SerializeTo(buf);
+			}
+		}
+
+		util::String PublishBatchPacket::ToString() {
+			util::OutputBuffer buf(serialized_batch_length_);
+			SerializeTo(buf);
+			return buf.Release();
 		}
 
 		/*******************************************
@@ -135,16 +205,13 @@ namespace awsiotsdk {
 		}
 
 		std::shared_ptr<PubackPacket> PubackPacket::Create(uint16_t packet_id) {
-			return std::make_shared<PubackPacket>(packet_id);
+			return std::allocate_shared<PubackPacket>(util::memory::PoolAllocator<PubackPacket>(), packet_id);
 		}
 
-		util::String PubackPacket::ToString() {
-			util::String buf;
-			buf.reserve(serialized_packet_length_);
+		void PubackPacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_packet_length_);
 			fixed_header_.AppendToBuffer(buf);
 			AppendUInt16ToBuffer(buf, packet_id_);
-
-			return buf;
 		}
 
 		/*************************************************
@@ -184,14 +251,95 @@ namespace awsiotsdk {
 				}
 			}
 
-			const util::String packet_data = p_publish_packet->ToString();
-			rc = WriteToNetworkBuffer(p_network_connection, packet_data);
+			// Only the header is serialized, the payload is written straight from the packet
+			output_buffer_.Clear();
+			p_publish_packet->SerializeHeaderTo(output_buffer_);
+			util::StringView publish_segments[2] = {output_buffer_.GetView(), p_publish_packet->GetPayloadView()};
+			rc = WriteToNetworkBuffer(p_network_connection, publish_segments, 2);
 			if(ResponseCode::SUCCESS != rc) {
 				if(is_ack_registered) {
 					p_client_state_->DeletePendingAck(packet_id);
 				}
 				AWS_LOG_ERROR(PUBLISH_ACTION_LOG_TAG, "Publish Write to Network Failed with return code : %d",
 							  static_cast<int>(rc));
+			} else if(QoS::QOS0 == p_publish_packet->GetQoS() && nullptr != p_publish_packet->p_async_ack_handler_) {
+				// QoS0 requests have no Ack, complete them once written to the network
+				p_client_state_->ForwardWrittenAck(packet_id, p_network_connection);
+			}
+
+			return rc;
+		}
+
+		/******************************************************
+		 * PublishBatchActionAsync class function definitions *
+		 *****************************************************/
+		PublishBatchActionAsync::PublishBatchActionAsync(std::shared_ptr<ClientState> p_client_state)
+				: Action(ActionType::PUBLISH_BATCH, PUBLISH_BATCH_ACTION_DESCRIPTION) {
+			p_client_state_ = p_client_state;
+		}
+
+		std::unique_ptr<Action> PublishBatchActionAsync::Create(std::shared_ptr<ActionState> p_action_state) {
+			std::shared_ptr<mqtt::ClientState> p_client_state = std::dynamic_pointer_cast<mqtt::ClientState>(p_action_state);
+			if(nullptr == p_client_state) {
+				return nullptr;
+			}
+
+			return std::unique_ptr<PublishBatchActionAsync>(new PublishBatchActionAsync(p_client_state));
+		}
+
+		ResponseCode PublishBatchActionAsync::PerformAction(std::shared_ptr<NetworkConnection> p_network_connection, std::shared_ptr<ActionData> p_action_data) {
+			std::shared_ptr<PublishBatchPacket> p_batch_packet = std::dynamic_pointer_cast<PublishBatchPacket>(p_action_data);
+			if(nullptr == p_batch_packet) {
+				return ResponseCode::NULL_VALUE_ERROR;
+			}
+
+			// Register all Acks before writing, responses can arrive before the write returns
+			ResponseCode rc = ResponseCode::SUCCESS;
+			const util::Vector<std::shared_ptr<PublishPacket>> &publish_packets = p_batch_packet->GetPublishPackets();
+			size_t registered_count = 0;
+			for(; registered_count < publish_packets.size(); registered_count++) {
+				const std::shared_ptr<PublishPacket> &p_publish_packet = publish_packets[registered_count];
+				if(nullptr == p_publish_packet->p_async_ack_handler_) {
+					continue;
+				}
+				rc = p_client_state_->RegisterPendingAck(p_publish_packet->GetPacketId(), p_publish_packet->p_async_ack_handler_);
+				if(ResponseCode::SUCCESS != rc) {
+					AWS_LOG_ERROR(PUBLISH_BATCH_ACTION_LOG_TAG,
+								  "Registering Ack Handler for Publish Batch Action failed with return code : %d",
+								  static_cast<int>(rc));
+					break;
+				}
+			}
+
+			if(ResponseCode::SUCCESS == rc) {
+				output_buffer_.Clear();
+				p_batch_packet->SerializeTo(output_buffer_);
+				rc = WriteToNetworkBuffer(p_network_connection, output_buffer_.GetBuffer());
+				if(ResponseCode::SUCCESS != rc) {
+					AWS_LOG_ERROR(PUBLISH_BATCH_ACTION_LOG_TAG,
+								  "Publish Batch Write to Network Failed with return code : %d",
+								  static_cast<int>(rc));
+				}
+			}
+
+			if(ResponseCode::SUCCESS != rc) {
+				// Failure is reported to the packets through the Ack handler of the batch
+				for(size_t itr = 0; itr < registered_count; itr++) {
+					if(nullptr != publish_packets[itr]->p_async_ack_handler_) {
+						p_client_state_->DeletePendingAck(publish_packets[itr]->GetPacketId());
+					}
+				}
+				return rc;
+			}
+
+			// QoS0 requests have no Ack, complete them once written to the network
+			for(const std::shared_ptr<PublishPacket> &p_publish_packet : publish_packets) {
+				if(QoS::QOS0 == p_publish_packet->GetQoS() && nullptr != p_publish_packet->p_async_ack_handler_) {
+					p_client_state_->ForwardReceivedAck(p_publish_packet->GetPacketId(), ResponseCode::SUCCESS);
+				}
+			}
+			if(nullptr != p_batch_packet->p_async_ack_handler_) {
+				p_client_state_->ForwardReceivedAck(p_batch_packet->GetActionId(), ResponseCode::SUCCESS);
 			}
 
 			return rc;
@@ -220,8 +368,9 @@ namespace awsiotsdk {
 				return ResponseCode::NULL_VALUE_ERROR;
 			}
 
-			const util::String packet_data = p_puback_packet->ToString();
-			ResponseCode rc = WriteToNetworkBuffer(p_network_connection, packet_data);
+			output_buffer_.Clear();
+			p_puback_packet->SerializeTo(output_buffer_);
+			ResponseCode rc = WriteToNetworkBuffer(p_network_connection, output_buffer_.GetBuffer());
 			if(ResponseCode::SUCCESS != rc) {
 				AWS_LOG_ERROR(PUBACK_ACTION_LOG_TAG, "Puback Write to Network Failed with return code : %d",
 							  static_cast<int>(rc));
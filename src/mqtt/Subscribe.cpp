@@ -22,6 +22,7 @@
  */
 
 #include "util/logging/LogMacros.hpp"
+#include "util/memory/PoolAllocator.hpp"
 #include "util/memory/stl/Vector.hpp"
 
 #include "mqtt/ClientState.hpp"
@@ -62,10 +63,9 @@ namespace awsiotsdk {
 			return std::make_shared<SubscribePacket>(subscription_list);
 		}
 
-		util::String SubscribePacket::ToString() {
-			util::String buf;
-			buf.reserve(serialized_packet_length_);
-			char temp_qos_byte;
+		void SubscribePacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_packet_length_);
+			unsigned char temp_qos_byte = 0x00;
 
 			fixed_header_.AppendToBuffer(buf);
 			AppendUInt16ToBuffer(buf, static_cast<uint16_t>(packet_id_));
@@ -73,8 +73,7 @@ namespace awsiotsdk {
 			uint8_t itr_index;
 			util::Vector<std::shared_ptr<Subscription>>::iterator itr;
 			for(itr = subscription_list_.begin(), itr_index = 1; itr < subscription_list_.end(); ++itr, ++itr_index) {
-				std::shared_ptr<Utf8String> utf8_str = (*itr)->GetTopicName();
-				AppendUtf8StringToBuffer(buf, utf8_str);
+				AppendUtf8StringToBuffer(buf, *(*itr)->GetTopicName());
 				switch((*itr)->GetMaxQos()) {
 					case QoS::QOS0:
 						temp_qos_byte = 0x00;
@@ -83,11 +82,9 @@ namespace awsiotsdk {
 						temp_qos_byte = 0x01;
 						break;
 				}
-				buf.append(&temp_qos_byte, 1);
+				buf.AppendByte(temp_qos_byte);
 				(*itr)->SetAckIndex(static_cast<uint16_t>(packet_id_), itr_index);
 			}
-
-			return buf;
 		}
 
 		/*******************************************
@@ -111,23 +108,18 @@ namespace awsiotsdk {
 				return nullptr;
 			}
 
-			return std::make_shared<SubackPacket>(buf);
+			return std::allocate_shared<SubackPacket>(util::memory::PoolAllocator<SubackPacket>(), buf);
 		}
 
-		util::String SubackPacket::ToString() {
-			util::String buf;
-			buf.reserve(serialized_packet_length_);
+		void SubackPacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_packet_length_);
 
 			fixed_header_.AppendToBuffer(buf);
 			AppendUInt16ToBuffer(buf, static_cast<uint16_t>(packet_id_));
 
-			char temp;
 			for(uint8_t suback_info : suback_list_) {
-				temp = static_cast<char>(suback_info);
-				buf.append(&temp, 1);
+				buf.AppendByte(suback_info);
 			}
-
-			return buf;
 		}
 
 		/************************************************
@@ -155,19 +147,16 @@ namespace awsiotsdk {
 			return std::make_shared<UnsubscribePacket>(std::move(topic_list));
 		}
 
-		util::String UnsubscribePacket::ToString() {
-			util::String buf;
-			buf.reserve(serialized_packet_length_);
+		void UnsubscribePacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_packet_length_);
 
 			fixed_header_.AppendToBuffer(buf);
 			AppendUInt16ToBuffer(buf, static_cast<uint16_t>(packet_id_));
 
 			util::Vector<std::unique_ptr<Utf8String>>::iterator itr;
 			for(itr = topic_list_.begin(); itr < topic_list_.end(); ++itr) {
-				AppendUtf8StringToBuffer(buf, (*itr));
+				AppendUtf8StringToBuffer(buf, *(*itr));
 			}
-
-			return buf;
 		}
 
 		/*********************************************
@@ -190,14 +179,11 @@ namespace awsiotsdk {
 			return std::make_shared<UnsubackPacket>(buf);
 		}
 
-		util::String UnsubackPacket::ToString() {
-			util::String buf;
-			buf.reserve(serialized_packet_length_);
+		void UnsubackPacket::SerializeTo(util::OutputBuffer &buf) {
+			buf.Reserve(buf.Size() + serialized_packet_length_);
 
 			fixed_header_.AppendToBuffer(buf);
 			AppendUInt16ToBuffer(buf, static_cast<uint16_t>(packet_id_));
-
-			return buf;
 		}
 
 		/***************************************************
@@ -229,6 +215,16 @@ namespace awsiotsdk {
 				return ResponseCode::NULL_VALUE_ERROR;
 			}
 
+			// Reject the whole request before any state is changed, the server would close the connection
+			for(const std::shared_ptr<Subscription> &p_subscription : p_subscribe_packet->subscription_list_) {
+				util::String topic_filter = p_subscription->GetTopicName()->ToStdString();
+				if(!TopicFilterTrie::IsValidFilter(topic_filter)) {
+					AWS_LOG_ERROR(SUBSCRIBE_ACTION_LOG_TAG, "Invalid topic filter in Subscribe request : %s",
+								  topic_filter.c_str());
+					return ResponseCode::MQTT_INVALID_DATA_ERROR;
+				}
+			}
+
 			uint16_t packet_id = p_subscribe_packet->GetPacketId();
 			if(nullptr != p_subscribe_packet->p_async_ack_handler_) {
 				rc = p_client_state_->RegisterPendingAck(packet_id, p_subscribe_packet->p_async_ack_handler_);
@@ -245,27 +241,37 @@ namespace awsiotsdk {
 			util::Vector<std::shared_ptr<Subscription>>::iterator itr = p_subscribe_packet->subscription_list_.begin();
 			while(itr != p_subscribe_packet->subscription_list_.end()) {
 				util::String topic_name = (*itr)->GetTopicName()->ToStdString();
-				auto existing_itr = p_client_state_->subscription_map_.find(topic_name);
-				if(p_client_state_->subscription_map_.end() != existing_itr) {
-					if(existing_itr->second->IsActive()) {
+				std::shared_ptr<Subscription> p_existing_sub = p_client_state_->GetSubscription(topic_name);
+				if(nullptr != p_existing_sub) {
+					if(p_existing_sub->IsActive()) {
 						itr = p_subscribe_packet->subscription_list_.erase(itr);
+						continue;
 					}
-				} else {
-					p_client_state_->subscription_map_.insert(std::make_pair(topic_name, (*itr)));
+				} else if(ResponseCode::SUCCESS != p_client_state_->AddSubscription(topic_name, (*itr))) {
+					AWS_LOG_ERROR(SUBSCRIBE_ACTION_LOG_TAG, "Adding subscription failed for topic filter : %s",
+								  topic_name.c_str());
 				}
 
 				itr++;
 			}
 
-			const util::String packet_data = p_subscribe_packet->ToString();
-			rc = WriteToNetworkBuffer(p_network_connection, packet_data);
+			output_buffer_.Clear();
+			p_subscribe_packet->SerializeTo(output_buffer_);
+
+			// Index the subscriptions by position so the SUBACK can be processed without scanning all subscriptions
+			uint8_t itr_index = 1;
+			for(itr = p_subscribe_packet->subscription_list_.begin(); itr < p_subscribe_packet->subscription_list_.end(); ++itr, ++itr_index) {
+				p_client_state_->SetSubscriptionPacketInfo((*itr)->GetTopicName()->ToStdString(), packet_id, itr_index);
+			}
+
+			rc = WriteToNetworkBuffer(p_network_connection, output_buffer_.GetBuffer());
 			if(ResponseCode::SUCCESS != rc) {
 				AWS_LOG_ERROR(SUBSCRIBE_ACTION_LOG_TAG, "Subscribe Write to Network Failed with return code : %d",
 							  static_cast<int>(rc));
 				// Remove acks
 				for(itr = p_subscribe_packet->subscription_list_.begin(); itr < p_subscribe_packet->subscription_list_.end(); ++itr) {
 					util::String topic_name = (*itr)->GetTopicName()->ToStdString();
-					p_client_state_->subscription_map_.erase(topic_name);
+					p_client_state_->RemoveSubscription(topic_name);
 				}
 				if(is_ack_registered) {
 					p_client_state_->DeletePendingAck(packet_id);
@@ -314,12 +320,14 @@ namespace awsiotsdk {
 			}
 
 			uint16_t packet_id = p_unsubscribe_packet->GetPacketId();
+			uint8_t itr_index = 1;
 			for(auto &&itr : p_unsubscribe_packet->topic_list_) {
-				p_client_state_->SetSubscriptionPacketInfo(itr->ToStdString(), packet_id, 0);
+				p_client_state_->SetSubscriptionPacketInfo(itr->ToStdString(), packet_id, itr_index++);
 			}
 
-			const util::String packet_data = p_unsubscribe_packet->ToString();
-			rc = WriteToNetworkBuffer(p_network_connection, packet_data);
+			output_buffer_.Clear();
+			p_unsubscribe_packet->SerializeTo(output_buffer_);
+			rc = WriteToNetworkBuffer(p_network_connection, output_buffer_.GetBuffer());
 			if(ResponseCode::SUCCESS != rc) {
 				AWS_LOG_ERROR(UNSUBSCRIBE_ACTION_LOG_TAG, "Publish Write to Network Failed with return code : %d",
 							  static_cast<int>(rc));
@@ -0,0 +1,406 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicFilterTrie.cpp
+ * @brief
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+#include "mqtt/TopicFilterTrie.hpp"
+#include "mqtt/TopicInternPool.hpp"
+
+#define TOPIC_LEVEL_SEPARATOR '/'
+#define SINGLE_LEVEL_WILDCARD '+'
+#define MULTI_LEVEL_WILDCARD '#'
+#define SYSTEM_TOPIC_PREFIX '$'
+
+#ifndef TOPIC_FILTER_TRIE_MIN_BUCKET_SIZE
+#define TOPIC_FILTER_TRIE_MIN_BUCKET_SIZE 16
+#endif
+
+namespace awsiotsdk {
+	namespace mqtt {
+		static const char *FindLevelEnd(const char *p_level_start, const char *p_end) {
+			return std::find(p_level_start, p_end, TOPIC_LEVEL_SEPARATOR);
+		}
+
+		static bool IsWildcardLevel(const char *p_level_start, const char *p_level_end, char wildcard) {
+			return 1 == (p_level_end - p_level_start) && wildcard == *p_level_start;
+		}
+
+		// Hashes with FNV-1a, std::hash is only provided for strings using std::allocator
+		static size_t GetChildBucketIndex(const util::String &topic_level, size_t bucket_count) {
+			return static_cast<size_t>(TopicInternPool::Hash(topic_level)) & (bucket_count - 1);
+		}
+
+		bool TopicFilterTrie::IsValidFilter(const util::String &topic_filter) {
+			if(topic_filter.empty()) {
+				return false;
+			}
+
+			const char *p_end = topic_filter.data() + topic_filter.length();
+			const char *p_level_start = topic_filter.data();
+			while(true) {
+				const char *p_level_end = FindLevelEnd(p_level_start, p_end);
+				bool is_wildcard = IsWildcardLevel(p_level_start, p_level_end, SINGLE_LEVEL_WILDCARD)
+								   || IsWildcardLevel(p_level_start, p_level_end, MULTI_LEVEL_WILDCARD);
+				if(!is_wildcard && (p_level_end != std::find(p_level_start, p_level_end, SINGLE_LEVEL_WILDCARD)
+									|| p_level_end != std::find(p_level_start, p_level_end, MULTI_LEVEL_WILDCARD))) {
+					// Wildcards must occupy a whole level
+					return false;
+				}
+				if(p_level_end == p_end) {
+					return true;
+				}
+				if(IsWildcardLevel(p_level_start, p_level_end, MULTI_LEVEL_WILDCARD)) {
+					// # must be the last level
+					return false;
+				}
+				p_level_start = p_level_end + 1;
+			}
+		}
+
+		bool TopicFilterTrie::IsMatch(util::StringView topic_filter, util::StringView topic_name) {
+			const char *p_filter = topic_filter.begin();
+			const char *p_filter_end = topic_filter.end();
+			const char *p_topic = topic_name.begin();
+			const char *p_topic_end = topic_name.end();
+
+			if(!topic_name.empty() && SYSTEM_TOPIC_PREFIX == *p_topic && !topic_filter.empty()
+			   && (SINGLE_LEVEL_WILDCARD == *p_filter || MULTI_LEVEL_WILDCARD == *p_filter)) {
+				return false;
+			}
+
+			while(true) {
+				const char *p_filter_level_end = FindLevelEnd(p_filter, p_filter_end);
+				if(IsWildcardLevel(p_filter, p_filter_level_end, MULTI_LEVEL_WILDCARD)) {
+					return true;
+				}
+
+				const char *p_topic_level_end = FindLevelEnd(p_topic, p_topic_end);
+				if(!IsWildcardLevel(p_filter, p_filter_level_end, SINGLE_LEVEL_WILDCARD)
+				   && ((p_filter_level_end - p_filter) != (p_topic_level_end - p_topic)
+					   || !std::equal(p_filter, p_filter_level_end, p_topic))) {
+					return false;
+				}
+
+				bool is_last_filter_level = (p_filter_level_end == p_filter_end);
+				bool is_last_topic_level = (p_topic_level_end == p_topic_end);
+				if(is_last_filter_level || is_last_topic_level) {
+					// "a/#" also matches "a"
+					return (is_last_filter_level && is_last_topic_level)
+						   || (is_last_topic_level && util::StringView(p_filter_level_end, p_filter_end - p_filter_level_end)
+													  == util::StringView("/#", 2));
+				}
+				p_filter = p_filter_level_end + 1;
+				p_topic = p_topic_level_end + 1;
+			}
+		}
+
+		const TopicFilterTrie::Node *TopicFilterTrie::Node::FindChild(const util::String &topic_level) const {
+			if(0 == child_count_) {
+				return nullptr;
+			}
+
+			const ChildBucket &bucket = *child_buckets_[GetChildBucketIndex(topic_level, child_buckets_.size())];
+			ChildBucket::const_iterator child_itr = bucket.find(topic_level);
+			return (bucket.end() != child_itr) ? child_itr->second.get() : nullptr;
+		}
+
+		// Shared nodes and buckets are copied, exclusively owned ones can be modified in place since no other trie
+		// can reach them. The acquire fence orders the modification after the release of any previous owner.
+		template<typename T>
+		static T *MakeWritableShared(std::shared_ptr<const T> &p_shared) {
+			if(nullptr == p_shared) {
+				std::shared_ptr<T> p_new = std::make_shared<T>();
+				p_shared = p_new;
+				return p_new.get();
+			}
+			if(1 == p_shared.use_count()) {
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return const_cast<T *>(p_shared.get());
+			}
+			std::shared_ptr<T> p_copy = std::make_shared<T>(*p_shared);
+			p_shared = p_copy;
+			return p_copy.get();
+		}
+
+		TopicFilterTrie::Node *TopicFilterTrie::MakeWritable(std::shared_ptr<const Node> &p_node) {
+			return MakeWritableShared(p_node);
+		}
+
+		std::shared_ptr<const TopicFilterTrie::Node> &TopicFilterTrie::GetWritableChildSlot(Node &node,
+																							const util::String &topic_level) {
+			if(node.child_buckets_.empty()) {
+				node.child_buckets_.resize(1);
+			}
+
+			std::shared_ptr<const ChildBucket> &p_bucket
+				= node.child_buckets_[GetChildBucketIndex(topic_level, node.child_buckets_.size())];
+			return (*MakeWritableShared(p_bucket))[topic_level];
+		}
+
+		void TopicFilterTrie::EraseChild(Node &node, const util::String &topic_level) {
+			std::shared_ptr<const ChildBucket> &p_bucket
+				= node.child_buckets_[GetChildBucketIndex(topic_level, node.child_buckets_.size())];
+			if(0 != MakeWritableShared(p_bucket)->erase(topic_level)) {
+				node.child_count_--;
+			}
+			if(0 == node.child_count_) {
+				node.child_buckets_.clear();
+			}
+		}
+
+		void TopicFilterTrie::GrowChildBuckets(Node &node) {
+			// Keeps buckets around sqrt(children) in size, bounding the cost of copying a node and one of its buckets
+			size_t bucket_count = node.child_buckets_.size();
+			if(node.child_count_ <= TOPIC_FILTER_TRIE_MIN_BUCKET_SIZE * bucket_count
+			   || node.child_count_ <= bucket_count * bucket_count) {
+				return;
+			}
+
+			util::Vector<std::shared_ptr<const ChildBucket>> new_buckets(bucket_count * 2);
+			util::Vector<ChildBucket *> p_writable_buckets;
+			for(std::shared_ptr<const ChildBucket> &p_new_bucket : new_buckets) {
+				std::shared_ptr<ChildBucket> p_bucket = std::make_shared<ChildBucket>();
+				p_writable_buckets.push_back(p_bucket.get());
+				p_new_bucket = p_bucket;
+			}
+			for(const std::shared_ptr<const ChildBucket> &p_bucket : node.child_buckets_) {
+				for(const auto &child : *p_bucket) {
+					(*p_writable_buckets[GetChildBucketIndex(child.first, new_buckets.size())])[child.first]
+						= child.second;
+				}
+			}
+			node.child_buckets_.swap(new_buckets);
+		}
+
+		bool TopicFilterTrie::InsertIntoNode(std::shared_ptr<const Node> &p_node, const char *p_level_start,
+											 const char *p_filter_end, std::shared_ptr<Subscription> p_subscription) {
+			Node *p_writable_node = MakeWritable(p_node);
+
+			const char *p_level_end = FindLevelEnd(p_level_start, p_filter_end);
+			if(IsWildcardLevel(p_level_start, p_level_end, MULTI_LEVEL_WILDCARD)) {
+				bool is_added = (nullptr == p_writable_node->p_multi_level_subscription_);
+				p_writable_node->p_multi_level_subscription_ = p_subscription;
+				return is_added;
+			}
+
+			bool is_new_child = false;
+			std::shared_ptr<const Node> *p_child = nullptr;
+			if(IsWildcardLevel(p_level_start, p_level_end, SINGLE_LEVEL_WILDCARD)) {
+				p_child = &p_writable_node->p_single_level_child_;
+			} else {
+				p_child = &GetWritableChildSlot(*p_writable_node, util::String(p_level_start, p_level_end));
+				is_new_child = (nullptr == *p_child);
+			}
+
+			bool is_added = false;
+			if(p_level_end == p_filter_end) {
+				Node *p_writable_child = MakeWritable(*p_child);
+				is_added = (nullptr == p_writable_child->p_subscription_);
+				p_writable_child->p_subscription_ = p_subscription;
+			} else {
+				is_added = InsertIntoNode(*p_child, p_level_end + 1, p_filter_end, p_subscription);
+			}
+
+			if(is_new_child) {
+				p_writable_node->child_count_++;
+				GrowChildBuckets(*p_writable_node);
+			}
+			return is_added;
+		}
+
+		ResponseCode TopicFilterTrie::Insert(const util::String &topic_filter,
+											 std::shared_ptr<Subscription> p_subscription) {
+			if(nullptr == p_subscription) {
+				return ResponseCode::NULL_VALUE_ERROR;
+			}
+			if(!IsValidFilter(topic_filter)) {
+				return ResponseCode::MQTT_INVALID_DATA_ERROR;
+			}
+
+			if(InsertIntoNode(p_root_, topic_filter.data(), topic_filter.data() + topic_filter.length(),
+							  p_subscription)) {
+				size_++;
+			}
+			return ResponseCode::SUCCESS;
+		}
+
+		void TopicFilterTrie::RemoveFromNode(Node &node, const char *p_level_start, const char *p_filter_end) {
+			const char *p_level_end = FindLevelEnd(p_level_start, p_filter_end);
+			if(IsWildcardLevel(p_level_start, p_level_end, MULTI_LEVEL_WILDCARD) && p_level_end == p_filter_end) {
+				node.p_multi_level_subscription_ = nullptr;
+				return;
+			}
+
+			bool is_single_level = IsWildcardLevel(p_level_start, p_level_end, SINGLE_LEVEL_WILDCARD);
+			util::String topic_level;
+			std::shared_ptr<const Node> *p_child = nullptr;
+			if(is_single_level) {
+				p_child = &node.p_single_level_child_;
+			} else {
+				topic_level.assign(p_level_start, p_level_end);
+				p_child = &GetWritableChildSlot(node, topic_level);
+			}
+
+			Node *p_writable_child = MakeWritable(*p_child);
+			if(p_level_end == p_filter_end) {
+				p_writable_child->p_subscription_ = nullptr;
+			} else {
+				RemoveFromNode(*p_writable_child, p_level_end + 1, p_filter_end);
+			}
+
+			// Prune nodes that no longer lead to any filter
+			if(p_writable_child->IsEmpty()) {
+				if(is_single_level) {
+					p_child->reset();
+				} else {
+					EraseChild(node, topic_level);
+				}
+			}
+		}
+
+		bool TopicFilterTrie::Remove(const util::String &topic_filter) {
+			// Only modify the path once the filter is known to be stored, nodes are copied on the way down
+			if(nullptr == Find(topic_filter)) {
+				return false;
+			}
+
+			RemoveFromNode(*MakeWritable(p_root_), topic_filter.data(), topic_filter.data() + topic_filter.length());
+			if(p_root_->IsEmpty()) {
+				p_root_ = nullptr;
+			}
+			size_--;
+			return true;
+		}
+
+		std::shared_ptr<Subscription> TopicFilterTrie::Find(const util::String &topic_filter) const {
+			if(topic_filter.empty()) {
+				return nullptr;
+			}
+
+			const Node *p_node = p_root_.get();
+			if(nullptr == p_node) {
+				return nullptr;
+			}
+
+			const char *p_end = topic_filter.data() + topic_filter.length();
+			const char *p_level_start = topic_filter.data();
+			while(true) {
+				const char *p_level_end = FindLevelEnd(p_level_start, p_end);
+				if(IsWildcardLevel(p_level_start, p_level_end, MULTI_LEVEL_WILDCARD) && p_level_end == p_end) {
+					return p_node->p_multi_level_subscription_;
+				}
+
+				if(IsWildcardLevel(p_level_start, p_level_end, SINGLE_LEVEL_WILDCARD)) {
+					p_node = p_node->p_single_level_child_.get();
+				} else {
+					p_node = p_node->FindChild(util::String(p_level_start, p_level_end));
+				}
+				if(nullptr == p_node) {
+					return nullptr;
+				}
+
+				if(p_level_end == p_end) {
+					return p_node->p_subscription_;
+				}
+				p_level_start = p_level_end + 1;
+			}
+		}
+
+		void TopicFilterTrie::MatchLevel(const Node &node, const char *p_level_start, const char *p_topic_end,
+										 bool is_first_level, util::String &lookup_key,
+										 util::Vector<std::shared_ptr<Subscription>> &matches_out) {
+			const char *p_level_end = FindLevelEnd(p_level_start, p_topic_end);
+			bool is_last_level = (p_level_end == p_topic_end);
+			// Wildcards at the first level do not match system topics
+			bool is_wildcard_allowed = !(is_first_level && p_level_start != p_level_end
+										 && SYSTEM_TOPIC_PREFIX == *p_level_start);
+
+			if(is_wildcard_allowed && nullptr != node.p_multi_level_subscription_) {
+				matches_out.push_back(node.p_multi_level_subscription_);
+			}
+
+			// Reuses the key buffer, avoids an allocation for every level
+			lookup_key.assign(p_level_start, p_level_end);
+			const Node *p_children[2] = {
+				node.FindChild(lookup_key),
+				is_wildcard_allowed ? node.p_single_level_child_.get() : nullptr
+			};
+
+			for(const Node *p_child : p_children) {
+				if(nullptr == p_child) {
+					continue;
+				}
+				if(is_last_level) {
+					if(nullptr != p_child->p_subscription_) {
+						matches_out.push_back(p_child->p_subscription_);
+					}
+					// "a/#" also matches "a"
+					if(nullptr != p_child->p_multi_level_subscription_) {
+						matches_out.push_back(p_child->p_multi_level_subscription_);
+					}
+				} else {
+					MatchLevel(*p_child, p_level_end + 1, p_topic_end, false, lookup_key, matches_out);
+				}
+			}
+		}
+
+		void TopicFilterTrie::Match(util::StringView topic_name,
+									util::Vector<std::shared_ptr<Subscription>> &matches_out) const {
+			if(topic_name.empty() || nullptr == p_root_) {
+				return;
+			}
+
+			util::String lookup_key;
+			MatchLevel(*p_root_, topic_name.begin(), topic_name.end(), true, lookup_key, matches_out);
+		}
+
+		void TopicFilterTrie::CollectSubscriptions(const Node &node,
+												   util::Vector<std::shared_ptr<Subscription>> &subscriptions_out) {
+			if(nullptr != node.p_subscription_) {
+				subscriptions_out.push_back(node.p_subscription_);
+			}
+			if(nullptr != node.p_multi_level_subscription_) {
+				subscriptions_out.push_back(node.p_multi_level_subscription_);
+			}
+			for(const std::shared_ptr<const ChildBucket> &p_bucket : node.child_buckets_) {
+				for(const auto &child : *p_bucket) {
+					CollectSubscriptions(*child.second, subscriptions_out);
+				}
+			}
+			if(nullptr != node.p_single_level_child_) {
+				CollectSubscriptions(*node.p_single_level_child_, subscriptions_out);
+			}
+		}
+
+		void TopicFilterTrie::GetAll(util::Vector<std::shared_ptr<Subscription>> &subscriptions_out) const {
+			if(nullptr != p_root_) {
+				CollectSubscriptions(*p_root_, subscriptions_out);
+			}
+		}
+
+		void TopicFilterTrie::Clear() {
+			p_root_ = nullptr;
+			size_ = 0;
+		}
+	}
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicInternPool.cpp
+ * @brief
+ *
+ */
+
+#include "mqtt/TopicInternPool.hpp"
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+namespace awsiotsdk {
+	namespace mqtt {
+		InternedTopic::InternedTopic(util::StringView topic_name, uint64_t hash)
+			: topic_name_(topic_name.ToString()), hash_(hash), has_cached_matches_(false), cached_matches_version_(0) {
+		}
+
+		util::Vector<std::shared_ptr<Subscription>> &InternedTopic::ResetCachedMatches(uint32_t subscription_table_version) {
+			cached_matches_.clear();
+			cached_matches_version_ = subscription_table_version;
+			has_cached_matches_ = true;
+			return cached_matches_;
+		}
+
+		TopicInternPool::TopicInternPool(size_t max_topics) : topic_count_(0), max_topics_(max_topics), clock_hand_(0) {
+			if(0 == max_topics_) {
+				max_topics_ = 1;
+			}
+
+			// Keep the table at most half full so probe sequences stay short
+			size_t slot_count = 2;
+			while(slot_count < 2 * max_topics_) {
+				slot_count *= 2;
+			}
+			slots_.resize(slot_count);
+			referenced_slots_.resize(slot_count, false);
+		}
+
+		uint64_t TopicInternPool::Hash(util::StringView topic_name) {
+			uint64_t hash = FNV_OFFSET_BASIS;
+			for(char c : topic_name) {
+				hash ^= static_cast<unsigned char>(c);
+				hash *= FNV_PRIME;
+			}
+			return hash;
+		}
+
+		std::shared_ptr<InternedTopic> TopicInternPool::Intern(util::StringView topic_name) {
+			uint64_t hash = Hash(topic_name);
+			size_t mask = slots_.size() - 1;
+			size_t slot_index = static_cast<size_t>(hash) & mask;
+			while(nullptr != slots_[slot_index]) {
+				const std::shared_ptr<InternedTopic> &p_topic = slots_[slot_index];
+				if(hash == p_topic->GetHash() && topic_name == util::StringView(p_topic->GetTopicName())) {
+					referenced_slots_[slot_index] = true;
+					return p_topic;
+				}
+				slot_index = (slot_index + 1) & mask;
+			}
+
+			if(max_topics_ == topic_count_) {
+				// Removing an entry can shift the end of the probe sequence, search for a free slot again
+				RemoveSlot(FindEvictionSlot());
+				slot_index = static_cast<size_t>(hash) & mask;
+				while(nullptr != slots_[slot_index]) {
+					slot_index = (slot_index + 1) & mask;
+				}
+			}
+
+			std::shared_ptr<InternedTopic> p_topic = std::make_shared<InternedTopic>(topic_name, hash);
+			slots_[slot_index] = p_topic;
+			referenced_slots_[slot_index] = false;
+			topic_count_++;
+			return p_topic;
+		}
+
+		size_t TopicInternPool::FindEvictionSlot() {
+			size_t mask = slots_.size() - 1;
+			while(true) {
+				size_t slot_index = clock_hand_;
+				clock_hand_ = (clock_hand_ + 1) & mask;
+				if(nullptr != slots_[slot_index]) {
+					if(!referenced_slots_[slot_index]) {
+						return slot_index;
+					}
+					// Second chance, evicted on the next pass unless it is looked up again
+					referenced_slots_[slot_index] = false;
+				}
+			}
+		}
+
+		void TopicInternPool::RemoveSlot(size_t slot_index) {
+			size_t mask = slots_.size() - 1;
+			size_t next_index = (slot_index + 1) & mask;
+			// Shift following entries of the probe sequence back so lookups never stop at the freed slot
+			while(nullptr != slots_[next_index]) {
+				size_t home_index = static_cast<size_t>(slots_[next_index]->GetHash()) & mask;
+				if(((next_index - home_index) & mask) >= ((next_index - slot_index) & mask)) {
+					slots_[slot_index] = std::move(slots_[next_index]);
+					referenced_slots_[slot_index] = referenced_slots_[next_index];
+					slot_index = next_index;
+				}
+				next_index = (next_index + 1) & mask;
+			}
+			slots_[slot_index] = nullptr;
+			referenced_slots_[slot_index] = false;
+			topic_count_--;
+		}
+
+		void TopicInternPool::Clear() {
+			for(std::shared_ptr<InternedTopic> &p_slot : slots_) {
+				p_slot = nullptr;
+			}
+			referenced_slots_.assign(referenced_slots_.size(), false);
+			topic_count_ = 0;
+			clock_hand_ = 0;
+		}
+	}
+}
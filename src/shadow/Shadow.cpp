@@ -95,7 +95,7 @@ namespace awsiotsdk {
 
 		util::JsonParser::InitializeFromJsonString(cur_device_state_document_, SHADOW_DOCUMENT_EMPTY_STRING);
 		cur_server_state_document_.SetObject();
-		client_token_ = client_token_prefix_ + "_" + std::to_string(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+		client_token_ = client_token_prefix_ + "_" + util::ToString(std::chrono::high_resolution_clock::now().time_since_epoch().count());
 		cur_device_state_document_[SHADOW_DOCUMENT_CLIENT_TOKEN_KEY].SetString(client_token_.c_str(), cur_server_state_document_.GetAllocator());
 		cur_device_state_document_[SHADOW_DOCUMENT_STATE_KEY][SHADOW_DOCUMENT_DESIRED_KEY].SetObject();
 		cur_device_state_document_[SHADOW_DOCUMENT_STATE_KEY][SHADOW_DOCUMENT_REPORTED_KEY].SetObject();
@@ -571,7 +571,7 @@ namespace awsiotsdk {
 	}
 
 	void Shadow::ResetClientTokenSuffix(){
-		client_token_ = client_token_prefix_ + "_" + std::to_string(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+		client_token_ = client_token_prefix_ + "_" + util::ToString(std::chrono::high_resolution_clock::now().time_since_epoch().count());
 		cur_device_state_document_[SHADOW_DOCUMENT_CLIENT_TOKEN_KEY].SetString(client_token_.c_str(), cur_server_state_document_.GetAllocator());
 	}
 
@@ -41,7 +41,7 @@ namespace awsiotsdk {
 			}
 
 			std::streampos fsize = 0;
-			std::ifstream config_file_stream(config_file_path, std::ios::binary);
+			std::ifstream config_file_stream(config_file_path.c_str(), std::ios::binary);
 			fsize = config_file_stream.tellg();
 			config_file_stream.seekg(0, std::ios::end);
 			fsize = config_file_stream.tellg() - fsize;
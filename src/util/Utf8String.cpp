@@ -329,5 +329,9 @@ namespace awsiotsdk {
 	util::String Utf8String::ToStdString() {
 		return data;
 	}
+
+	const util::String &Utf8String::GetData() const {
+		return data;
+	}
 }
 
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file MemoryResource.cpp
+ * @brief
+ *
+ */
+
+#include <new>
+
+#include "util/memory/MemoryResource.hpp"
+
+namespace awsiotsdk {
+	namespace util {
+		namespace memory {
+			/**
+			 * @brief Resource backed by the global operator new and operator delete
+			 */
+			class NewDeleteResource : public MemoryResource {
+			protected:
+				void *DoAllocate(std::size_t bytes, std::size_t alignment) { return ::operator new(bytes); }
+				void DoDeallocate(void *p, std::size_t bytes, std::size_t alignment) { ::operator delete(p); }
+				bool DoIsEqual(const MemoryResource &other) const { return this == &other; }
+			};
+
+			MemoryResource *MemoryResource::GetNewDeleteResource() {
+				// Never destroyed, containers may still free memory while static objects are being destroyed
+				static MemoryResource *p_new_delete_resource = new NewDeleteResource();
+				return p_new_delete_resource;
+			}
+
+			// Constant initialized, containers may be created by static initializers in other translation units
+			std::atomic<MemoryResource *> MemoryResource::p_default_resource_(nullptr);
+
+			// Set on client threads and by ThreadResourceScope, takes precedence over p_default_resource_
+			static thread_local MemoryResource *p_thread_default_resource = nullptr;
+
+			MemoryResource *MemoryResource::GetDefaultResource() {
+				if(nullptr != p_thread_default_resource) {
+					return p_thread_default_resource;
+				}
+				MemoryResource *p_resource = p_default_resource_.load(std::memory_order_acquire);
+				return (nullptr == p_resource) ? GetNewDeleteResource() : p_resource;
+			}
+
+			MemoryResource *MemoryResource::GetThreadDefaultResource() {
+				return p_thread_default_resource;
+			}
+
+			MemoryResource *MemoryResource::SetThreadDefaultResource(MemoryResource *p_resource) {
+				MemoryResource *p_previous_resource = p_thread_default_resource;
+				p_thread_default_resource = p_resource;
+				return p_previous_resource;
+			}
+
+			MemoryResource *MemoryResource::SetDefaultResource(MemoryResource *p_resource) {
+				MemoryResource *p_previous_resource = p_default_resource_.exchange(p_resource, std::memory_order_acq_rel);
+				return (nullptr == p_previous_resource) ? GetNewDeleteResource() : p_previous_resource;
+			}
+		}
+	}
+}
@@ -26,8 +26,13 @@ namespace awsiotsdk {
 		namespace Threading {
 			ThreadTask::ThreadTask(DestructorAction destructor_action, std::shared_ptr<std::atomic_bool> sync_point,
 								   util::String thread_descriptor)
-					: destructor_action_(destructor_action), m_continue_(sync_point),
-					  thread_descriptor_(thread_descriptor) {
+					: ThreadTask(destructor_action, sync_point, thread_descriptor, nullptr) {
+			}
+
+			ThreadTask::ThreadTask(DestructorAction destructor_action, std::shared_ptr<std::atomic_bool> sync_point,
+								   util::String thread_descriptor, util::memory::MemoryResource *p_memory_resource)
+					: destructor_action_(destructor_action), p_memory_resource_(p_memory_resource),
+					  m_continue_(sync_point), thread_descriptor_(thread_descriptor) {
 			}
 
 			ThreadTask::~ThreadTask() {
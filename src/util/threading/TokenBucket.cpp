@@ -0,0 +1,77 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TokenBucket.cpp
+ * @brief
+ *
+ */
+
+#include "util/threading/TokenBucket.hpp"
+
+namespace awsiotsdk {
+	namespace util {
+		namespace Threading {
+			TokenBucket::TokenBucket(uint32_t rate_per_sec, uint32_t burst_size) {
+				available_tokens_ = 0;
+				Configure(rate_per_sec, burst_size);
+				available_tokens_ = burst_size_;
+				last_refill_time_ = std::chrono::steady_clock::now();
+			}
+
+			void TokenBucket::Configure(uint32_t rate_per_sec, uint32_t burst_size) {
+				rate_per_sec_ = (0 == rate_per_sec) ? 1 : rate_per_sec;
+				burst_size_ = (0 == burst_size) ? 1 : burst_size;
+				if(available_tokens_ > burst_size_) {
+					available_tokens_ = burst_size_;
+				}
+			}
+
+			void TokenBucket::Refill(std::chrono::steady_clock::time_point now) {
+				if(now <= last_refill_time_) {
+					return;
+				}
+				std::chrono::duration<double> elapsed = now - last_refill_time_;
+				available_tokens_ += elapsed.count() * rate_per_sec_;
+				if(available_tokens_ > burst_size_) {
+					available_tokens_ = burst_size_;
+				}
+				last_refill_time_ = now;
+			}
+
+			bool TokenBucket::TryConsume(std::chrono::steady_clock::time_point now, uint32_t token_count) {
+				Refill(now);
+				double required_tokens = (token_count < burst_size_) ? token_count : burst_size_;
+				if(required_tokens > available_tokens_) {
+					return false;
+				}
+				available_tokens_ -= token_count;
+				return true;
+			}
+
+			std::chrono::steady_clock::time_point TokenBucket::GetNextAvailableTime(
+					std::chrono::steady_clock::time_point now, uint32_t token_count) {
+				Refill(now);
+				double required_tokens = (token_count < burst_size_) ? token_count : burst_size_;
+				if(required_tokens <= available_tokens_) {
+					return now;
+				}
+				std::chrono::duration<double> wait_time((required_tokens - available_tokens_) / rate_per_sec_);
+				return now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(wait_time) +
+					   std::chrono::steady_clock::duration(1);
+			}
+		}
+	}
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ActionQueueBenchmark.hpp
+ * @brief Multi-threaded enqueue benchmark for the outbound action queue
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Outbound action queue benchmark
+			 *
+			 * Measures enqueue throughput with an increasing number of producer threads and a single consumer.
+			 * The lock-free queue is compared against a mutex guarded queue of the same capacity, followed by the
+			 * end to end ClientCore enqueue path which also includes action dispatch in the outbound thread.
+			 */
+			class ActionQueueBenchmark {
+			protected:
+				std::chrono::nanoseconds RunLockFreeQueue(size_t producer_count, size_t items_per_producer);
+				std::chrono::nanoseconds RunMutexQueue(size_t producer_count, size_t items_per_producer);
+				std::chrono::nanoseconds RunClientCoreEnqueue(size_t producer_count, size_t items_per_producer);
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
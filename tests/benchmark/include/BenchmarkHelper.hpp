@@ -0,0 +1,98 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file BenchmarkHelper.hpp
+ * @brief Common helpers for SDK benchmarks
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "util/memory/stl/String.hpp"
+
+#include "Action.hpp"
+#include "NetworkConnection.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Network connection that accepts all writes and never has data to read
+			 *
+			 * Used to measure SDK overhead without any transport cost
+			 */
+			class NullNetworkConnection : public NetworkConnection {
+			protected:
+				std::atomic_bool is_connected_;
+
+			public:
+				std::atomic_size_t total_write_calls_;
+				std::atomic_size_t total_written_bytes_;
+
+				NullNetworkConnection();
+
+				ResponseCode ConnectInternal();
+				ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out);
+				ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+										  size_t size_bytes_to_read, size_t &size_read_bytes_out);
+				ResponseCode DisconnectInternal();
+				bool IsConnected() { return is_connected_; }
+				bool IsPhysicalLayerConnected() { return is_connected_; }
+			};
+
+			/**
+			 * @brief Action Data with no payload, used to measure queueing overhead
+			 */
+			class NullActionData : public ActionData {
+			protected:
+				uint16_t action_id_;
+
+			public:
+				NullActionData() : action_id_(0) { }
+				uint16_t GetActionId() { return action_id_; }
+				void SetActionId(uint16_t action_id) { action_id_ = action_id; }
+			};
+
+			/**
+			 * @brief Action that does nothing except count how many times it was performed
+			 */
+			class NullAction : public Action {
+			public:
+				static std::atomic_size_t total_perform_action_call_count_;
+
+				NullAction() : Action(ActionType::RESERVED_ACTION, "Null Action") { }
+
+				static std::unique_ptr<Action> Create(std::shared_ptr<ActionState> p_action_state);
+				ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
+										   std::shared_ptr<ActionData> p_action_data);
+			};
+
+			/**
+			 * @brief Print one result line in a common format
+			 *
+			 * @param benchmark_name - Name of the benchmark
+			 * @param case_description - Description of the measured case
+			 * @param operation_count - Number of operations performed
+			 * @param elapsed - Time taken to perform all operations
+			 */
+			void PrintResult(const util::String &benchmark_name, const util::String &case_description,
+							 size_t operation_count, std::chrono::nanoseconds elapsed);
+		}
+	}
+}
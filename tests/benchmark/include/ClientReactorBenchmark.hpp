@@ -0,0 +1,48 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ClientReactorBenchmark.hpp
+ * @brief Many client benchmark with dedicated client threads and with a Client Reactor
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Client Reactor benchmark
+			 *
+			 * Connects many MQTT clients over loopback TCP to a minimal in process broker and publishes QoS1 messages
+			 * from each of them. Compares clients running their own threads against clients driven by a Client
+			 * Reactor, reporting time taken and the number of threads in the process. Only runs on Linux.
+			 */
+			class ClientReactorBenchmark {
+			protected:
+				std::chrono::nanoseconds RunClients(size_t client_count, size_t reactor_thread_count,
+													size_t &process_thread_count_out, size_t &acked_count_out);
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
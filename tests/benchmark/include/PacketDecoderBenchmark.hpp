@@ -0,0 +1,47 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PacketDecoderBenchmark.hpp
+ * @brief Decode throughput benchmark for the incremental MQTT packet decoder
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Packet decoder benchmark
+			 *
+			 * Feeds a stream of serialized Publish packets to a PacketDecoder in chunks of different sizes and reports
+			 * decoded packets per second. Small chunks exercise resuming in the middle of headers and bodies.
+			 */
+			class PacketDecoderBenchmark {
+			protected:
+				std::chrono::nanoseconds RunDecode(const util::String &stream, size_t chunk_size, size_t iterations,
+												   size_t &decoded_count_out);
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PacketSerializationBenchmark.hpp
+ * @brief Outbound packet serialization benchmark, ToString compared to SerializeTo a reused buffer
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include "util/OutputBuffer.hpp"
+#include "util/memory/stl/String.hpp"
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Packet serialization benchmark
+			 *
+			 * Serializes each outbound packet type repeatedly, once through ToString which builds a new string per
+			 * packet and once through SerializeTo into a single OutputBuffer that is cleared between packets, the way
+			 * Actions serialize packets before writing them to the network.
+			 */
+			class PacketSerializationBenchmark {
+			protected:
+				void RunCase(const util::String &packet_description, std::function<util::String()> to_string,
+							 std::function<void(util::OutputBuffer &)> serialize_to);
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
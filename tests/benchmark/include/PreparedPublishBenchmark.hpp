@@ -0,0 +1,50 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PreparedPublishBenchmark.hpp
+ * @brief Per message cost of Publish packets built from a topic name compared to a PreparedPublish
+ *
+ */
+
+#pragma once
+
+#include <functional>
+
+#include "util/OutputBuffer.hpp"
+#include "util/memory/stl/String.hpp"
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief PreparedPublish benchmark
+			 *
+			 * Measures the work done per message before it is written to the network: creating the Publish packet and
+			 * serializing its header the way PublishActionAsync does. Packets are created either from a new Utf8String
+			 * topic name, as the MqttClient::Publish overloads taking a topic name do, or from a shared PreparedPublish.
+			 */
+			class PreparedPublishBenchmark {
+			protected:
+				void RunCase(const util::String &case_description, std::function<void(util::OutputBuffer &)> publish);
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ResubscribeBenchmark.hpp
+ * @brief SUBACK processing benchmark for large numbers of subscriptions
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Resubscribe benchmark
+			 *
+			 * Replays the client state updates done when all subscriptions are resubscribed after a reconnect,
+			 * registering each Subscribe request and then processing its SUBACK, for different subscription counts.
+			 */
+			class ResubscribeBenchmark {
+			protected:
+				std::chrono::nanoseconds RunResubscribe(size_t subscription_count);
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file SubscriptionChurnBenchmark.hpp
+ * @brief Incoming publish dispatch benchmark under concurrent subscription changes
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "mqtt/ClientState.hpp"
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Subscription churn benchmark
+			 *
+			 * One thread matches incoming topic names against the client state subscription table the same way the
+			 * network read thread does, while other threads keep subscribing and unsubscribing. Reports lookups per
+			 * second for different numbers of churning threads along with the rate of subscription changes.
+			 */
+			class SubscriptionChurnBenchmark {
+			protected:
+				std::chrono::nanoseconds RunDispatch(std::shared_ptr<mqtt::ClientState> p_client_state,
+													 size_t churn_thread_count, size_t lookup_count,
+													 size_t &update_count_out);
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
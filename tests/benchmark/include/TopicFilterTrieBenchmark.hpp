@@ -0,0 +1,55 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicFilterTrieBenchmark.hpp
+ * @brief Incoming publish subscription lookup benchmark
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Topic filter trie benchmark
+			 *
+			 * Registers a large number of literal and wildcard topic filters and reports how many incoming topic
+			 * names per second can be matched against them, using the TopicFilterTrie and using a linear scan over
+			 * all filters.
+			 */
+			class TopicFilterTrieBenchmark {
+			protected:
+				std::chrono::nanoseconds RunTrieMatch(const util::Vector<util::String> &topic_filters,
+													  const util::Vector<util::String> &topic_names,
+													  size_t &match_count_out);
+				std::chrono::nanoseconds RunLinearMatch(const util::Vector<util::String> &topic_filters,
+														const util::Vector<util::String> &topic_names,
+														size_t &match_count_out);
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicInternBenchmark.hpp
+ * @brief Incoming publish topic resolution benchmark with and without topic interning
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Topic intern benchmark
+			 *
+			 * Resolves the subscriptions for a stream of incoming topic names drawn from a few hundred distinct topics,
+			 * either by matching every topic name against the subscription trie or by interning the topic name and
+			 * reusing the matches cached on the interned handle.
+			 */
+			class TopicInternBenchmark {
+			protected:
+				std::chrono::nanoseconds RunResolve(const util::Vector<util::String> &topic_names, bool use_intern_pool,
+													size_t &match_count_out);
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TransportBenchmark.hpp
+ * @brief TLS round trip benchmark comparing the OpenSSL socket and io_uring transports
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "ResponseCode.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Transport benchmark
+			 *
+			 * Connects an OpenSSLConnection over loopback to an in process TLS echo server and measures request/reply
+			 * round trips with each available transport. Only runs on Linux with the OpenSSL network library.
+			 */
+			class TransportBenchmark {
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
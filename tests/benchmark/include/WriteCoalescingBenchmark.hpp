@@ -0,0 +1,53 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file WriteCoalescingBenchmark.hpp
+ * @brief Publish throughput benchmark with and without write coalescing
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "ResponseCode.hpp"
+
+#include "TlsTestServer.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			/**
+			 * @brief Write coalescing benchmark
+			 *
+			 * Measures QoS0 publish throughput through the outbound thread from multiple producers over an
+			 * OpenSSLConnection to an in process TLS server on loopback. Compares one write per publish against
+			 * coalesced writes. Only runs on Linux with the OpenSSL network library.
+			 */
+			class WriteCoalescingBenchmark {
+#if defined(__linux__) && !defined(USE_MBEDTLS)
+			protected:
+				ResponseCode RunPublish(support::SelfSignedIdentity &identity, size_t producer_count,
+										size_t publish_per_producer, size_t coalescing_max_bytes,
+										std::chrono::nanoseconds &elapsed_out, size_t &write_call_count_out);
+#endif
+
+			public:
+				ResponseCode RunBenchmark();
+			};
+		}
+	}
+}
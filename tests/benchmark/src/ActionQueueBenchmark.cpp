@@ -0,0 +1,192 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ActionQueueBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include <mutex>
+#include <thread>
+
+#include "util/memory/stl/Queue.hpp"
+#include "util/memory/stl/Vector.hpp"
+#include "util/threading/LockFreeQueue.hpp"
+
+#include "ClientCore.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "ActionQueueBenchmark.hpp"
+
+#define ACTION_QUEUE_BENCHMARK_NAME "ActionQueue"
+#define ACTION_QUEUE_BENCHMARK_ITEMS_PER_PRODUCER 200000
+#define ACTION_QUEUE_BENCHMARK_CORE_ITEMS_PER_PRODUCER 20000
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			typedef std::pair<ActionType, std::shared_ptr<ActionData>> QueuedAction;
+
+			/**
+			 * @brief Start all producers at the same time and wait for them to finish
+			 */
+			template<typename Fn>
+			static void RunProducers(size_t producer_count, Fn producer_fn) {
+				std::atomic_bool start(false);
+				util::Vector<std::thread> producers;
+				for(size_t producer_id = 0; producer_id < producer_count; producer_id++) {
+					producers.push_back(std::thread([&start, &producer_fn]() {
+						while(!start) {
+							std::this_thread::yield();
+						}
+						producer_fn();
+					}));
+				}
+				start = true;
+				for(std::thread &producer : producers) {
+					producer.join();
+				}
+			}
+
+			std::chrono::nanoseconds ActionQueueBenchmark::RunLockFreeQueue(size_t producer_count,
+																			size_t items_per_producer) {
+				util::Threading::LockFreeQueue<QueuedAction> queue(MAX_ACTION_QUEUE_CAPACITY);
+				std::shared_ptr<ActionData> p_action_data = std::make_shared<NullActionData>();
+				size_t total_items = producer_count * items_per_producer;
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				std::thread consumer([&queue, total_items]() {
+					QueuedAction item;
+					size_t received = 0;
+					while(received < total_items) {
+						if(queue.TryDequeue(item)) {
+							received++;
+						} else {
+							std::this_thread::yield();
+						}
+					}
+				});
+				RunProducers(producer_count, [&queue, &p_action_data, items_per_producer]() {
+					for(size_t itr = 0; itr < items_per_producer; itr++) {
+						QueuedAction item = std::make_pair(ActionType::RESERVED_ACTION, p_action_data);
+						while(!queue.TryEnqueue(item)) {
+							std::this_thread::yield();
+						}
+					}
+				});
+				consumer.join();
+				return std::chrono::steady_clock::now() - start;
+			}
+
+			std::chrono::nanoseconds ActionQueueBenchmark::RunMutexQueue(size_t producer_count,
+																		 size_t items_per_producer) {
+				std::mutex queue_lock;
+				util::Queue<QueuedAction> queue;
+				std::shared_ptr<ActionData> p_action_data = std::make_shared<NullActionData>();
+				size_t total_items = producer_count * items_per_producer;
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				std::thread consumer([&queue, &queue_lock, total_items]() {
+					size_t received = 0;
+					while(received < total_items) {
+						bool is_empty = true;
+						{
+							std::lock_guard<std::mutex> lock(queue_lock);
+							if(!queue.empty()) {
+								queue.pop();
+								received++;
+								is_empty = false;
+							}
+						}
+						if(is_empty) {
+							std::this_thread::yield();
+						}
+					}
+				});
+				RunProducers(producer_count, [&queue, &queue_lock, &p_action_data, items_per_producer]() {
+					for(size_t itr = 0; itr < items_per_producer; itr++) {
+						bool is_enqueued = false;
+						while(!is_enqueued) {
+							{
+								std::lock_guard<std::mutex> lock(queue_lock);
+								if(queue.size() < MAX_ACTION_QUEUE_CAPACITY) {
+									queue.push(std::make_pair(ActionType::RESERVED_ACTION, p_action_data));
+									is_enqueued = true;
+								}
+							}
+							if(!is_enqueued) {
+								std::this_thread::yield();
+							}
+						}
+					}
+				});
+				consumer.join();
+				return std::chrono::steady_clock::now() - start;
+			}
+
+			std::chrono::nanoseconds ActionQueueBenchmark::RunClientCoreEnqueue(size_t producer_count,
+																				size_t items_per_producer) {
+				std::shared_ptr<ClientCoreState> p_core_state = std::make_shared<ClientCoreState>();
+				std::shared_ptr<NetworkConnection> p_network_connection = std::make_shared<NullNetworkConnection>();
+				std::unique_ptr<ClientCore> p_client_core = ClientCore::Create(p_network_connection, p_core_state);
+				p_client_core->RegisterAction(ActionType::RESERVED_ACTION, NullAction::Create);
+				p_core_state->SetMaxActionQueueSize(MAX_ACTION_QUEUE_CAPACITY);
+				p_client_core->SetProcessQueuedActions(true);
+
+				NullAction::total_perform_action_call_count_ = 0;
+				size_t total_items = producer_count * items_per_producer;
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				RunProducers(producer_count, [&p_client_core, items_per_producer]() {
+					std::shared_ptr<ActionData> p_action_data = std::make_shared<NullActionData>();
+					uint16_t action_id = 0;
+					for(size_t itr = 0; itr < items_per_producer; itr++) {
+						while(ResponseCode::SUCCESS != p_client_core->PerformActionAsync(ActionType::RESERVED_ACTION,
+																						  p_action_data, action_id)) {
+							std::this_thread::yield();
+						}
+					}
+				});
+				while(NullAction::total_perform_action_call_count_ < total_items) {
+					std::this_thread::yield();
+				}
+				return std::chrono::steady_clock::now() - start;
+			}
+
+			ResponseCode ActionQueueBenchmark::RunBenchmark() {
+				size_t max_producer_count = std::thread::hardware_concurrency();
+				if(2 > max_producer_count) {
+					max_producer_count = 2;
+				}
+
+				for(size_t producer_count = 1; producer_count <= max_producer_count; producer_count *= 2) {
+					util::String producers = util::ToString(producer_count) + " producer(s)";
+					size_t total_items = producer_count * ACTION_QUEUE_BENCHMARK_ITEMS_PER_PRODUCER;
+					PrintResult(ACTION_QUEUE_BENCHMARK_NAME, "LockFreeQueue, " + producers, total_items,
+								RunLockFreeQueue(producer_count, ACTION_QUEUE_BENCHMARK_ITEMS_PER_PRODUCER));
+					PrintResult(ACTION_QUEUE_BENCHMARK_NAME, "Mutex guarded queue, " + producers, total_items,
+								RunMutexQueue(producer_count, ACTION_QUEUE_BENCHMARK_ITEMS_PER_PRODUCER));
+
+					total_items = producer_count * ACTION_QUEUE_BENCHMARK_CORE_ITEMS_PER_PRODUCER;
+					PrintResult(ACTION_QUEUE_BENCHMARK_NAME, "ClientCore PerformActionAsync, " + producers, total_items,
+								RunClientCoreEnqueue(producer_count, ACTION_QUEUE_BENCHMARK_CORE_ITEMS_PER_PRODUCER));
+				}
+
+				return ResponseCode::SUCCESS;
+			}
+		}
+	}
+}
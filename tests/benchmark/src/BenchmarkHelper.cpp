@@ -0,0 +1,80 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file BenchmarkHelper.cpp
+ * @brief
+ *
+ */
+
+#include <cstdio>
+
+#include "BenchmarkHelper.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			std::atomic_size_t NullAction::total_perform_action_call_count_(0);
+
+			NullNetworkConnection::NullNetworkConnection() {
+				is_connected_ = true;
+				total_write_calls_ = 0;
+				total_written_bytes_ = 0;
+			}
+
+			ResponseCode NullNetworkConnection::ConnectInternal() {
+				is_connected_ = true;
+				return ResponseCode::SUCCESS;
+			}
+
+			ResponseCode NullNetworkConnection::WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+				total_write_calls_++;
+				total_written_bytes_ += buf.length();
+				size_written_bytes_out = buf.length();
+				return ResponseCode::SUCCESS;
+			}
+
+			ResponseCode NullNetworkConnection::ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+															 size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+				size_read_bytes_out = 0;
+				return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+			}
+
+			ResponseCode NullNetworkConnection::DisconnectInternal() {
+				is_connected_ = false;
+				return ResponseCode::SUCCESS;
+			}
+
+			std::unique_ptr<Action> NullAction::Create(std::shared_ptr<ActionState> p_action_state) {
+				return std::unique_ptr<Action>(new NullAction());
+			}
+
+			ResponseCode NullAction::PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
+												   std::shared_ptr<ActionData> p_action_data) {
+				total_perform_action_call_count_++;
+				return ResponseCode::SUCCESS;
+			}
+
+			void PrintResult(const util::String &benchmark_name, const util::String &case_description,
+							 size_t operation_count, std::chrono::nanoseconds elapsed) {
+				double elapsed_sec = static_cast<double>(elapsed.count()) / 1e9;
+				double ops_per_sec = (0 < elapsed_sec) ? static_cast<double>(operation_count) / elapsed_sec : 0;
+				double ns_per_op = (0 < operation_count) ? static_cast<double>(elapsed.count()) / operation_count : 0;
+				printf("%-28s %-44s %12zu ops %14.0f ops/s %10.1f ns/op\n", benchmark_name.c_str(),
+					   case_description.c_str(), operation_count, ops_per_sec, ns_per_op);
+			}
+		}
+	}
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file BenchmarkRunner.cpp
+ * @brief Runs SDK benchmarks. Optionally accepts the name of a single benchmark to run
+ *
+ */
+
+#include <iostream>
+
+#include "util/logging/Logging.hpp"
+#include "util/logging/LogMacros.hpp"
+#include "util/logging/ConsoleLogSystem.hpp"
+
+#include "BenchmarkRunner.hpp"
+#include "ActionQueueBenchmark.hpp"
+#include "ClientReactorBenchmark.hpp"
+#include "PacketDecoderBenchmark.hpp"
+#include "PacketSerializationBenchmark.hpp"
+#include "PreparedPublishBenchmark.hpp"
+#include "ResubscribeBenchmark.hpp"
+#include "SubscriptionChurnBenchmark.hpp"
+#include "TopicFilterTrieBenchmark.hpp"
+#include "TopicInternBenchmark.hpp"
+#include "TransportBenchmark.hpp"
+#include "WriteCoalescingBenchmark.hpp"
+
+#define BENCHMARK_RUNNER_LOG_TAG "[Benchmark Runner]"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			bool BenchmarkRunner::IsSelected(const util::String &benchmark_name) {
+				return benchmark_filter_.empty() || benchmark_filter_ == benchmark_name;
+			}
+
+			ResponseCode BenchmarkRunner::RunAllBenchmarks() {
+				ResponseCode rc = ResponseCode::SUCCESS;
+				// Each benchmark runs in its own scope to ensure complete cleanup
+				/**
+				 * Run Outbound Action Queue benchmark
+				 */
+				if(IsSelected("ActionQueue")) {
+					ActionQueueBenchmark action_queue_benchmark;
+					rc = action_queue_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run Write coalescing benchmark
+				 */
+				if(IsSelected("WriteCoalescing")) {
+					WriteCoalescingBenchmark write_coalescing_benchmark;
+					rc = write_coalescing_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run Client Reactor benchmark
+				 */
+				if(IsSelected("ClientReactor")) {
+					ClientReactorBenchmark client_reactor_benchmark;
+					rc = client_reactor_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run Packet decoder benchmark
+				 */
+				if(IsSelected("PacketDecoder")) {
+					PacketDecoderBenchmark packet_decoder_benchmark;
+					rc = packet_decoder_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run Packet serialization benchmark
+				 */
+				if(IsSelected("PacketSerialization")) {
+					PacketSerializationBenchmark packet_serialization_benchmark;
+					rc = packet_serialization_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run PreparedPublish benchmark
+				 */
+				if(IsSelected("PreparedPublish")) {
+					PreparedPublishBenchmark prepared_publish_benchmark;
+					rc = prepared_publish_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run Topic filter trie benchmark
+				 */
+				if(IsSelected("TopicTrie")) {
+					TopicFilterTrieBenchmark topic_filter_trie_benchmark;
+					rc = topic_filter_trie_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run Topic intern benchmark
+				 */
+				if(IsSelected("TopicIntern")) {
+					TopicInternBenchmark topic_intern_benchmark;
+					rc = topic_intern_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run Resubscribe benchmark
+				 */
+				if(IsSelected("Resubscribe")) {
+					ResubscribeBenchmark resubscribe_benchmark;
+					rc = resubscribe_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run Subscription churn benchmark
+				 */
+				if(IsSelected("SubscriptionChurn")) {
+					SubscriptionChurnBenchmark subscription_churn_benchmark;
+					rc = subscription_churn_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				/**
+				 * Run TLS transport benchmark
+				 */
+				if(IsSelected("Transport")) {
+					TransportBenchmark transport_benchmark;
+					rc = transport_benchmark.RunBenchmark();
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+				}
+
+				return rc;
+			}
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	std::shared_ptr<awsiotsdk::util::Logging::ConsoleLogSystem> p_log_system = std::make_shared<awsiotsdk::util::Logging::ConsoleLogSystem>(awsiotsdk::util::Logging::LogLevel::Warn);
+	awsiotsdk::util::Logging::InitializeAWSLogging(p_log_system);
+
+	awsiotsdk::util::String benchmark_filter = (1 < argc) ? argv[1] : "";
+	std::unique_ptr<awsiotsdk::tests::benchmark::BenchmarkRunner> benchmark_runner = std::unique_ptr<awsiotsdk::tests::benchmark::BenchmarkRunner>(new awsiotsdk::tests::benchmark::BenchmarkRunner(benchmark_filter));
+
+	awsiotsdk::ResponseCode rc = benchmark_runner->RunAllBenchmarks();
+	if(awsiotsdk::ResponseCode::SUCCESS != rc) {
+		AWS_LOG_ERROR(BENCHMARK_RUNNER_LOG_TAG, "Benchmark run failed with rc : %d", static_cast<int>(rc));
+	}
+
+	awsiotsdk::util::Logging::ShutdownAWSLogging();
+	return static_cast<int>(rc);
+}
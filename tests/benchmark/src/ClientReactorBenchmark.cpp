@@ -0,0 +1,435 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ClientReactorBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "util/memory/stl/Map.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "ClientReactor.hpp"
+#include "mqtt/Client.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "ClientReactorBenchmark.hpp"
+
+#define CLIENT_REACTOR_BENCHMARK_NAME "ClientReactor"
+
+#ifndef CLIENT_REACTOR_BENCHMARK_CLIENT_COUNT
+#define CLIENT_REACTOR_BENCHMARK_CLIENT_COUNT 200
+#endif
+
+#define CLIENT_REACTOR_BENCHMARK_PUBLISH_PER_CLIENT 50
+#define CLIENT_REACTOR_BENCHMARK_PAYLOAD_SIZE 100
+#define CLIENT_REACTOR_BENCHMARK_THREAD_COUNT 2
+#define CLIENT_REACTOR_BENCHMARK_TIMEOUT_MS 20000
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+#ifdef __linux__
+			namespace {
+				/**
+				 * @brief Plain TCP connection with readiness waits, stands in for a TLS connection
+				 */
+				class TcpNetworkConnection : public NetworkConnection {
+				protected:
+					uint16_t port_;
+					int socket_fd_;
+					std::atomic_bool is_connected_;
+
+					int PollSocket(short events, std::chrono::milliseconds timeout) {
+						pollfd poll_fd;
+						poll_fd.fd = socket_fd_;
+						poll_fd.events = events;
+						poll_fd.revents = 0;
+						return poll(&poll_fd, 1, static_cast<int>(timeout.count()));
+					}
+
+					ResponseCode ConnectInternal() {
+						sockaddr_in address;
+						memset(&address, 0, sizeof(address));
+						address.sin_family = AF_INET;
+						address.sin_port = htons(port_);
+						address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+						socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+						if(0 > socket_fd_) {
+							return ResponseCode::NETWORK_TCP_SETUP_ERROR;
+						}
+						if(0 != connect(socket_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address))) {
+							close(socket_fd_);
+							socket_fd_ = -1;
+							return ResponseCode::NETWORK_TCP_CONNECT_ERROR;
+						}
+						int flag = 1;
+						setsockopt(socket_fd_, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+						fcntl(socket_fd_, F_SETFL, fcntl(socket_fd_, F_GETFL, 0) | O_NONBLOCK);
+						is_connected_ = true;
+						return ResponseCode::SUCCESS;
+					}
+
+					ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+						ssize_t sent_bytes = send(socket_fd_, buf.c_str(), buf.length(), MSG_NOSIGNAL);
+						if(0 > sent_bytes) {
+							size_written_bytes_out = 0;
+							return (EAGAIN == errno) ? ResponseCode::SUCCESS : ResponseCode::NETWORK_SSL_WRITE_ERROR;
+						}
+						size_written_bytes_out = static_cast<size_t>(sent_bytes);
+						return ResponseCode::SUCCESS;
+					}
+
+					ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+											  size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+						size_read_bytes_out = 0;
+						ssize_t read_bytes = recv(socket_fd_, &buf[buf_read_offset], size_bytes_to_read, 0);
+						if(0 < read_bytes) {
+							size_read_bytes_out = static_cast<size_t>(read_bytes);
+							return ResponseCode::SUCCESS;
+						} else if(0 > read_bytes && EAGAIN == errno) {
+							return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+						}
+						return ResponseCode::NETWORK_SSL_READ_ERROR;
+					}
+
+					ResponseCode DisconnectInternal() {
+						is_connected_ = false;
+						if(0 <= socket_fd_) {
+							close(socket_fd_);
+							socket_fd_ = -1;
+						}
+						return ResponseCode::SUCCESS;
+					}
+
+					ResponseCode WaitForReadableInternal(std::chrono::milliseconds timeout) {
+						int poll_retcode = PollSocket(POLLIN, timeout);
+						if(0 < poll_retcode) {
+							return ResponseCode::SUCCESS;
+						}
+						return (0 == poll_retcode) ? ResponseCode::NETWORK_SSL_NOTHING_TO_READ
+												   : ResponseCode::NETWORK_SSL_READ_ERROR;
+					}
+
+					ResponseCode WaitForWritableInternal(std::chrono::milliseconds timeout) {
+						int poll_retcode = PollSocket(POLLOUT, timeout);
+						if(0 < poll_retcode) {
+							return ResponseCode::SUCCESS;
+						}
+						return (0 == poll_retcode) ? ResponseCode::NETWORK_SSL_WRITE_TIMEOUT_ERROR
+												   : ResponseCode::NETWORK_SSL_WRITE_ERROR;
+					}
+
+				public:
+					TcpNetworkConnection(uint16_t port) : port_(port), socket_fd_(-1) {
+						is_connected_ = false;
+					}
+
+					virtual ~TcpNetworkConnection() {
+						DisconnectInternal();
+					}
+
+					bool IsConnected() { return is_connected_; }
+					bool IsPhysicalLayerConnected() { return is_connected_; }
+					int GetSocketDescriptor() { return socket_fd_; }
+				};
+
+				/**
+				 * @brief Minimal loopback broker, acknowledges CONNECT, QoS1 PUBLISH and PINGREQ packets
+				 */
+				class LoopbackBroker {
+				protected:
+					int listen_fd_;
+					int epoll_fd_;
+					uint16_t port_;
+					std::shared_ptr<std::atomic_bool> p_thread_continue_;
+					std::thread broker_thread_;
+					util::Map<int, util::Vector<unsigned char>> receive_buf_map_;
+
+					void SendResponse(int socket_fd, const unsigned char *response, size_t length) {
+						size_t total_sent_bytes = 0;
+						while(total_sent_bytes < length) {
+							ssize_t sent_bytes = send(socket_fd, response + total_sent_bytes, length - total_sent_bytes,
+													  MSG_NOSIGNAL);
+							if(0 < sent_bytes) {
+								total_sent_bytes += static_cast<size_t>(sent_bytes);
+							} else if(0 > sent_bytes && EAGAIN == errno) {
+								std::this_thread::yield();
+							} else {
+								return;
+							}
+						}
+					}
+
+					void HandlePackets(int socket_fd, util::Vector<unsigned char> &receive_buf) {
+						size_t start = 0;
+						while(start + 2 <= receive_buf.size()) {
+							size_t rem_len = 0;
+							size_t multiplier = 1;
+							size_t index = start + 1;
+							bool is_complete = false;
+							while(index < receive_buf.size()) {
+								unsigned char encoded_byte = receive_buf[index++];
+								rem_len += (encoded_byte & 127) * multiplier;
+								multiplier *= 128;
+								if(0 == (encoded_byte & 128)) {
+									is_complete = true;
+									break;
+								}
+							}
+							if(!is_complete || index + rem_len > receive_buf.size()) {
+								break;
+							}
+
+							unsigned char packet_type = receive_buf[start] & 0xF0;
+							if(0x10 == packet_type) {
+								const unsigned char connack[] = {0x20, 0x02, 0x00, 0x00};
+								SendResponse(socket_fd, connack, sizeof(connack));
+							} else if(0x30 == packet_type && 0x02 == (receive_buf[start] & 0x06)) {
+								size_t topic_length = (static_cast<size_t>(receive_buf[index]) << 8) | receive_buf[index + 1];
+								size_t packet_id_index = index + 2 + topic_length;
+								const unsigned char puback[] = {0x40, 0x02, receive_buf[packet_id_index],
+																receive_buf[packet_id_index + 1]};
+								SendResponse(socket_fd, puback, sizeof(puback));
+							} else if(0xC0 == packet_type) {
+								const unsigned char pingresp[] = {0xD0, 0x00};
+								SendResponse(socket_fd, pingresp, sizeof(pingresp));
+							}
+							start = index + rem_len;
+						}
+						receive_buf.erase(receive_buf.begin(), receive_buf.begin() + start);
+					}
+
+					void Run() {
+						epoll_event events[64];
+						unsigned char read_buf[16384];
+						while(*p_thread_continue_) {
+							int event_count = epoll_wait(epoll_fd_, events, 64, 100);
+							for(int itr = 0; itr < event_count; itr++) {
+								int socket_fd = events[itr].data.fd;
+								if(listen_fd_ == socket_fd) {
+									int client_fd = accept(listen_fd_, nullptr, nullptr);
+									if(0 > client_fd) {
+										continue;
+									}
+									int flag = 1;
+									setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+									fcntl(client_fd, F_SETFL, fcntl(client_fd, F_GETFL, 0) | O_NONBLOCK);
+									epoll_event client_event;
+									client_event.events = EPOLLIN;
+									client_event.data.fd = client_fd;
+									epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client_fd, &client_event);
+									receive_buf_map_[client_fd].clear();
+									continue;
+								}
+
+								ssize_t read_bytes = recv(socket_fd, read_buf, sizeof(read_buf), 0);
+								if(0 < read_bytes) {
+									util::Vector<unsigned char> &receive_buf = receive_buf_map_[socket_fd];
+									receive_buf.insert(receive_buf.end(), read_buf, read_buf + read_bytes);
+									HandlePackets(socket_fd, receive_buf);
+								} else if(0 == read_bytes || EAGAIN != errno) {
+									receive_buf_map_.erase(socket_fd);
+									close(socket_fd);
+								}
+							}
+						}
+						for(auto &receive_buf : receive_buf_map_) {
+							close(receive_buf.first);
+						}
+					}
+
+				public:
+					LoopbackBroker() : listen_fd_(-1), epoll_fd_(-1), port_(0) {
+						p_thread_continue_ = std::make_shared<std::atomic_bool>(true);
+					}
+
+					~LoopbackBroker() {
+						*p_thread_continue_ = false;
+						if(broker_thread_.joinable()) {
+							broker_thread_.join();
+						}
+						if(0 <= listen_fd_) {
+							close(listen_fd_);
+						}
+						if(0 <= epoll_fd_) {
+							close(epoll_fd_);
+						}
+					}
+
+					ResponseCode Start() {
+						sockaddr_in address;
+						memset(&address, 0, sizeof(address));
+						address.sin_family = AF_INET;
+						address.sin_port = 0;
+						address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+						socklen_t address_length = sizeof(address);
+
+						listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+						epoll_fd_ = epoll_create1(0);
+						if(0 > listen_fd_ || 0 > epoll_fd_
+						   || 0 != bind(listen_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address))
+						   || 0 != listen(listen_fd_, SOMAXCONN)
+						   || 0 != getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&address), &address_length)) {
+							return ResponseCode::NETWORK_TCP_SETUP_ERROR;
+						}
+						port_ = ntohs(address.sin_port);
+
+						epoll_event listen_event;
+						listen_event.events = EPOLLIN;
+						listen_event.data.fd = listen_fd_;
+						epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &listen_event);
+						broker_thread_ = std::thread(&LoopbackBroker::Run, this);
+						return ResponseCode::SUCCESS;
+					}
+
+					uint16_t GetPort() { return port_; }
+				};
+
+				size_t GetProcessThreadCount() {
+					std::ifstream status_file("/proc/self/status");
+					util::String line;
+					while(std::getline(status_file, line)) {
+						if(0 == line.compare(0, 8, "Threads:")) {
+							return static_cast<size_t>(std::strtoul(line.c_str() + 8, nullptr, 10));
+						}
+					}
+					return 0;
+				}
+			}
+
+			std::chrono::nanoseconds ClientReactorBenchmark::RunClients(size_t client_count,
+																		size_t reactor_thread_count,
+																		size_t &process_thread_count_out,
+																		size_t &acked_count_out) {
+				LoopbackBroker broker;
+				std::shared_ptr<ClientReactor> p_client_reactor = nullptr;
+				std::atomic_size_t acked_count(0);
+				util::String payload(CLIENT_REACTOR_BENCHMARK_PAYLOAD_SIZE, 'x');
+				util::Vector<std::unique_ptr<MqttClient>> clients;
+				std::chrono::milliseconds timeout(CLIENT_REACTOR_BENCHMARK_TIMEOUT_MS);
+
+				acked_count_out = 0;
+				process_thread_count_out = 0;
+				if(ResponseCode::SUCCESS != broker.Start()) {
+					return std::chrono::nanoseconds(0);
+				}
+				if(0 < reactor_thread_count) {
+					p_client_reactor = ClientReactor::Create(reactor_thread_count);
+				}
+
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				for(size_t client_itr = 0; client_itr < client_count; client_itr++) {
+					std::shared_ptr<NetworkConnection> p_network_connection
+							= std::make_shared<TcpNetworkConnection>(broker.GetPort());
+					std::unique_ptr<MqttClient> p_client = (nullptr == p_client_reactor)
+							? MqttClient::Create(p_network_connection, timeout)
+							: MqttClient::Create(p_network_connection, timeout, p_client_reactor);
+					if(nullptr == p_client
+					   || ResponseCode::MQTT_CONNACK_CONNECTION_ACCEPTED
+						  != p_client->Connect(timeout, true, mqtt::Version::MQTT_3_1_1, std::chrono::seconds(60),
+											   Utf8String::Create("benchmark_" + util::ToString(client_itr)),
+											   nullptr, nullptr, nullptr)) {
+						break;
+					}
+					clients.push_back(std::move(p_client));
+				}
+
+				ActionData::AsyncAckNotificationHandlerPtr p_ack_handler = [&acked_count](uint16_t action_id,
+																						  ResponseCode rc) {
+					IOT_UNUSED(action_id);
+					if(ResponseCode::SUCCESS == rc) {
+						acked_count++;
+					}
+				};
+				for(size_t publish_itr = 0; publish_itr < CLIENT_REACTOR_BENCHMARK_PUBLISH_PER_CLIENT; publish_itr++) {
+					for(std::unique_ptr<MqttClient> &p_client : clients) {
+						uint16_t packet_id = 0;
+						// Queue holds few actions by default, wait for the client to catch up
+						while(ResponseCode::ACTION_QUEUE_FULL
+							  == p_client->PublishAsync(Utf8String::Create("benchmark/topic"), false, false,
+														mqtt::QoS::QOS1, payload, p_ack_handler, packet_id)) {
+							std::this_thread::yield();
+						}
+					}
+				}
+
+				size_t total_publish = clients.size() * CLIENT_REACTOR_BENCHMARK_PUBLISH_PER_CLIENT;
+				while(acked_count < total_publish && std::chrono::steady_clock::now() - start_time < timeout) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start_time;
+				process_thread_count_out = GetProcessThreadCount();
+				acked_count_out = acked_count;
+
+				// Client threads take up to one sleep interval to stop, destroy clients in parallel
+				util::Vector<std::thread> destroy_threads;
+				for(std::unique_ptr<MqttClient> &p_client : clients) {
+					MqttClient *p_destroyed_client = p_client.release();
+					destroy_threads.push_back(std::thread([p_destroyed_client]() {
+						delete p_destroyed_client;
+					}));
+				}
+				for(std::thread &destroy_thread : destroy_threads) {
+					destroy_thread.join();
+				}
+				return elapsed;
+			}
+#endif
+
+			ResponseCode ClientReactorBenchmark::RunBenchmark() {
+#ifdef __linux__
+				size_t client_count = CLIENT_REACTOR_BENCHMARK_CLIENT_COUNT;
+				util::String clients = util::ToString(client_count) + " clients, ";
+				size_t process_thread_count = 0;
+				size_t acked_count = 0;
+
+				std::chrono::nanoseconds elapsed = RunClients(client_count, 0, process_thread_count, acked_count);
+				PrintResult(CLIENT_REACTOR_BENCHMARK_NAME, "Client threads, " + clients
+														   + util::ToString(process_thread_count) + " threads",
+							acked_count, elapsed);
+
+				elapsed = RunClients(client_count, CLIENT_REACTOR_BENCHMARK_THREAD_COUNT, process_thread_count,
+									 acked_count);
+				PrintResult(CLIENT_REACTOR_BENCHMARK_NAME, "Reactor, " + clients
+														   + util::ToString(process_thread_count) + " threads",
+							acked_count, elapsed);
+#else
+				printf("%-28s %s\n", CLIENT_REACTOR_BENCHMARK_NAME, "Skipped, Client Reactor requires Linux");
+#endif
+				return ResponseCode::SUCCESS;
+			}
+		}
+	}
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PacketDecoderBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include <algorithm>
+
+#include "util/memory/stl/String.hpp"
+
+#include "mqtt/PacketDecoder.hpp"
+#include "mqtt/Publish.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "PacketDecoderBenchmark.hpp"
+
+#define PACKET_DECODER_BENCHMARK_NAME "PacketDecoder"
+#define PACKET_DECODER_BENCHMARK_PACKETS_PER_STREAM 10000
+#define PACKET_DECODER_BENCHMARK_ITERATIONS 50
+#define PACKET_DECODER_BENCHMARK_PAYLOAD_SIZE 100
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			std::chrono::nanoseconds PacketDecoderBenchmark::RunDecode(const util::String &stream, size_t chunk_size,
+																	   size_t iterations, size_t &decoded_count_out) {
+				size_t decoded_count = 0;
+				size_t decoded_bytes = 0;
+				std::unique_ptr<mqtt::PacketDecoder> p_decoder = mqtt::PacketDecoder::Create(
+					[&decoded_count, &decoded_bytes](unsigned char fixed_header_byte, const unsigned char *p_body,
+													 size_t body_length) {
+						decoded_count++;
+						decoded_bytes += body_length;
+						return ResponseCode::SUCCESS;
+					});
+
+				const unsigned char *p_stream = reinterpret_cast<const unsigned char *>(stream.data());
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				for(size_t iteration = 0; iteration < iterations; iteration++) {
+					for(size_t offset = 0; offset < stream.length(); offset += chunk_size) {
+						size_t consumed = 0;
+						p_decoder->Feed(p_stream + offset, std::min(chunk_size, stream.length() - offset), consumed);
+					}
+				}
+				std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+				decoded_count_out = decoded_count;
+				return elapsed;
+			}
+
+			ResponseCode PacketDecoderBenchmark::RunBenchmark() {
+				util::String payload(PACKET_DECODER_BENCHMARK_PAYLOAD_SIZE, 'x');
+				util::String packet = mqtt::PublishPacket::Create(Utf8String::Create("benchmark/decoder/topic"), false,
+																  false, mqtt::QoS::QOS1, payload)->ToString();
+				util::String stream;
+				stream.reserve(packet.length() * PACKET_DECODER_BENCHMARK_PACKETS_PER_STREAM);
+				for(size_t itr = 0; itr < PACKET_DECODER_BENCHMARK_PACKETS_PER_STREAM; itr++) {
+					stream.append(packet);
+				}
+
+				// Whole stream, typical TLS record and TCP segment sizes, and chunks smaller than a packet header
+				const size_t chunk_sizes[] = {stream.length(), 16384, 1460, 7};
+				for(size_t chunk_size : chunk_sizes) {
+					size_t decoded_count = 0;
+					std::chrono::nanoseconds elapsed = RunDecode(stream, chunk_size, PACKET_DECODER_BENCHMARK_ITERATIONS,
+																 decoded_count);
+					size_t expected_count = PACKET_DECODER_BENCHMARK_PACKETS_PER_STREAM * PACKET_DECODER_BENCHMARK_ITERATIONS;
+					if(expected_count != decoded_count) {
+						return ResponseCode::FAILURE;
+					}
+					util::String case_description = (stream.length() == chunk_size)
+													? util::String("single chunk")
+													: util::ToString(chunk_size) + " byte chunks";
+					case_description += ", " + util::ToString(packet.length()) + " byte packets";
+					PrintResult(PACKET_DECODER_BENCHMARK_NAME, case_description, decoded_count, elapsed);
+				}
+
+				return ResponseCode::SUCCESS;
+			}
+		}
+	}
+}
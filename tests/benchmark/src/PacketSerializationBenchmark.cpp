@@ -0,0 +1,151 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PacketSerializationBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include <cstdio>
+
+#include "mqtt/Connect.hpp"
+#include "mqtt/Publish.hpp"
+#include "mqtt/Subscribe.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "PacketSerializationBenchmark.hpp"
+
+#define PACKET_SERIALIZATION_BENCHMARK_NAME "PacketSerialization"
+#define PACKET_SERIALIZATION_BENCHMARK_ITERATIONS 500000
+#define PACKET_SERIALIZATION_BENCHMARK_SMALL_PAYLOAD_SIZE 64
+#define PACKET_SERIALIZATION_BENCHMARK_LARGE_PAYLOAD_SIZE 4096
+#define PACKET_SERIALIZATION_BENCHMARK_TOPIC_COUNT 8
+#define PACKET_SERIALIZATION_BENCHMARK_BATCH_SIZE 16
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			static util::String GetThroughputDescription(const util::String &description, size_t byte_count,
+														 std::chrono::nanoseconds elapsed) {
+				double elapsed_sec = static_cast<double>(elapsed.count()) / 1e9;
+				double mb_per_sec = (0 < elapsed_sec) ? static_cast<double>(byte_count) / elapsed_sec / 1e6 : 0;
+				char throughput[32];
+				snprintf(throughput, sizeof(throughput), ", %.1f MB/s", mb_per_sec);
+				return description + throughput;
+			}
+
+			void PacketSerializationBenchmark::RunCase(const util::String &packet_description,
+													   std::function<util::String()> to_string,
+													   std::function<void(util::OutputBuffer &)> serialize_to) {
+				// Sum of the serialized lengths keeps the compiler from dropping the serialization
+				size_t byte_count = 0;
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				for(size_t itr = 0; itr < PACKET_SERIALIZATION_BENCHMARK_ITERATIONS; itr++) {
+					util::String serialized = to_string();
+					byte_count += serialized.length();
+				}
+				std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start_time;
+				PrintResult(PACKET_SERIALIZATION_BENCHMARK_NAME,
+							GetThroughputDescription(packet_description + " ToString", byte_count, elapsed),
+							PACKET_SERIALIZATION_BENCHMARK_ITERATIONS, elapsed);
+
+				util::OutputBuffer buf;
+				byte_count = 0;
+				start_time = std::chrono::steady_clock::now();
+				for(size_t itr = 0; itr < PACKET_SERIALIZATION_BENCHMARK_ITERATIONS; itr++) {
+					buf.Clear();
+					serialize_to(buf);
+					byte_count += buf.Size();
+				}
+				elapsed = std::chrono::steady_clock::now() - start_time;
+				PrintResult(PACKET_SERIALIZATION_BENCHMARK_NAME,
+							GetThroughputDescription(packet_description + " SerializeTo", byte_count, elapsed),
+							PACKET_SERIALIZATION_BENCHMARK_ITERATIONS, elapsed);
+			}
+
+			ResponseCode PacketSerializationBenchmark::RunBenchmark() {
+				const util::String topic_name = "factory/line1/machine/42/telemetry";
+
+				std::shared_ptr<mqtt::ConnectPacket> p_connect_packet = mqtt::ConnectPacket::Create(
+					true, mqtt::Version::MQTT_3_1_1, std::chrono::seconds(30), Utf8String::Create("benchmark_client"),
+					nullptr, nullptr, nullptr);
+				RunCase("Connect", [&]() { return p_connect_packet->ToString(); },
+						[&](util::OutputBuffer &buf) { p_connect_packet->SerializeTo(buf); });
+
+				std::shared_ptr<mqtt::PublishPacket> p_small_publish_packet = mqtt::PublishPacket::Create(
+					Utf8String::Create(topic_name), false, false, mqtt::QoS::QOS0,
+					util::String(PACKET_SERIALIZATION_BENCHMARK_SMALL_PAYLOAD_SIZE, 'x'));
+				RunCase("Publish QoS0 64B", [&]() { return p_small_publish_packet->ToString(); },
+						[&](util::OutputBuffer &buf) { p_small_publish_packet->SerializeTo(buf); });
+
+				std::shared_ptr<mqtt::PublishPacket> p_large_publish_packet = mqtt::PublishPacket::Create(
+					Utf8String::Create(topic_name), false, false, mqtt::QoS::QOS1,
+					util::String(PACKET_SERIALIZATION_BENCHMARK_LARGE_PAYLOAD_SIZE, 'x'));
+				p_large_publish_packet->SetPacketId(1);
+				RunCase("Publish QoS1 4KB", [&]() { return p_large_publish_packet->ToString(); },
+						[&](util::OutputBuffer &buf) { p_large_publish_packet->SerializeTo(buf); });
+
+				util::Vector<std::shared_ptr<mqtt::PublishPacket>> publish_packets;
+				for(uint16_t itr = 1; itr <= PACKET_SERIALIZATION_BENCHMARK_BATCH_SIZE; itr++) {
+					std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+						Utf8String::Create(topic_name), false, false, mqtt::QoS::QOS1,
+						util::String(PACKET_SERIALIZATION_BENCHMARK_SMALL_PAYLOAD_SIZE, 'x'));
+					p_publish_packet->SetPacketId(itr);
+					publish_packets.push_back(p_publish_packet);
+				}
+				std::shared_ptr<mqtt::PublishBatchPacket> p_batch_packet = mqtt::PublishBatchPacket::Create(publish_packets);
+				RunCase("Publish batch 16x64B", [&]() { return p_batch_packet->ToString(); },
+						[&](util::OutputBuffer &buf) { p_batch_packet->SerializeTo(buf); });
+
+				std::shared_ptr<mqtt::PubackPacket> p_puback_packet = mqtt::PubackPacket::Create(1);
+				RunCase("Puback", [&]() { return p_puback_packet->ToString(); },
+						[&](util::OutputBuffer &buf) { p_puback_packet->SerializeTo(buf); });
+
+				util::Vector<std::shared_ptr<mqtt::Subscription>> subscription_list;
+				util::Vector<std::unique_ptr<Utf8String>> unsubscribe_topics;
+				for(size_t itr = 0; itr < PACKET_SERIALIZATION_BENCHMARK_TOPIC_COUNT; itr++) {
+					util::String topic_filter = "factory/line" + util::ToString(itr) + "/machine/+/telemetry";
+					subscription_list.push_back(mqtt::Subscription::Create(
+						Utf8String::Create(topic_filter), mqtt::QoS::QOS1,
+						[](util::String, util::String, std::shared_ptr<mqtt::SubscriptionHandlerContextData>) {
+							return ResponseCode::SUCCESS;
+						}, nullptr));
+					unsubscribe_topics.push_back(Utf8String::Create(topic_filter));
+				}
+				std::shared_ptr<mqtt::SubscribePacket> p_subscribe_packet = mqtt::SubscribePacket::Create(subscription_list);
+				p_subscribe_packet->SetPacketId(1);
+				RunCase("Subscribe 8 topics", [&]() { return p_subscribe_packet->ToString(); },
+						[&](util::OutputBuffer &buf) { p_subscribe_packet->SerializeTo(buf); });
+
+				std::shared_ptr<mqtt::UnsubscribePacket> p_unsubscribe_packet
+					= mqtt::UnsubscribePacket::Create(std::move(unsubscribe_topics));
+				p_unsubscribe_packet->SetPacketId(1);
+				RunCase("Unsubscribe 8 topics", [&]() { return p_unsubscribe_packet->ToString(); },
+						[&](util::OutputBuffer &buf) { p_unsubscribe_packet->SerializeTo(buf); });
+
+				std::shared_ptr<mqtt::PingreqPacket> p_pingreq_packet = mqtt::PingreqPacket::Create();
+				RunCase("Pingreq", [&]() { return p_pingreq_packet->ToString(); },
+						[&](util::OutputBuffer &buf) { p_pingreq_packet->SerializeTo(buf); });
+
+				std::shared_ptr<mqtt::DisconnectPacket> p_disconnect_packet = mqtt::DisconnectPacket::Create();
+				RunCase("Disconnect", [&]() { return p_disconnect_packet->ToString(); },
+						[&](util::OutputBuffer &buf) { p_disconnect_packet->SerializeTo(buf); });
+
+				return ResponseCode::SUCCESS;
+			}
+		}
+	}
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PreparedPublishBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include "mqtt/Publish.hpp"
+#include "mqtt/PreparedPublish.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "PreparedPublishBenchmark.hpp"
+
+#define PREPARED_PUBLISH_BENCHMARK_NAME "PreparedPublish"
+#define PREPARED_PUBLISH_BENCHMARK_ITERATIONS 1000000
+#define PREPARED_PUBLISH_BENCHMARK_PAYLOAD_SIZE 64
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			void PreparedPublishBenchmark::RunCase(const util::String &case_description,
+												   std::function<void(util::OutputBuffer &)> publish) {
+				// Sum of the serialized lengths keeps the compiler from dropping the serialization
+				size_t byte_count = 0;
+				util::OutputBuffer buf;
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				for(size_t itr = 0; itr < PREPARED_PUBLISH_BENCHMARK_ITERATIONS; itr++) {
+					buf.Clear();
+					publish(buf);
+					byte_count += buf.Size();
+				}
+				std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start_time;
+				if(0 == byte_count) {
+					return;
+				}
+				PrintResult(PREPARED_PUBLISH_BENCHMARK_NAME, case_description, PREPARED_PUBLISH_BENCHMARK_ITERATIONS,
+							elapsed);
+			}
+
+			ResponseCode PreparedPublishBenchmark::RunBenchmark() {
+				const util::String topic_name = "factory/line1/machine/42/telemetry";
+				const util::String payload(PREPARED_PUBLISH_BENCHMARK_PAYLOAD_SIZE, 'x');
+				const mqtt::QoS qos_values[2] = {mqtt::QoS::QOS0, mqtt::QoS::QOS1};
+
+				for(mqtt::QoS qos : qos_values) {
+					util::String qos_description = (mqtt::QoS::QOS0 == qos) ? "QoS0" : "QoS1";
+					uint16_t packet_id = 0;
+
+					RunCase(qos_description + " topic name", [&](util::OutputBuffer &buf) {
+						std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+							Utf8String::Create(topic_name), false, false, qos, payload);
+						p_publish_packet->SetPacketId(++packet_id);
+						p_publish_packet->SerializeHeaderTo(buf);
+					});
+
+					std::shared_ptr<mqtt::PreparedPublish> p_prepared_publish = mqtt::PreparedPublish::Create(
+						Utf8String::Create(topic_name), qos, false);
+					if(nullptr == p_prepared_publish) {
+						return ResponseCode::FAILURE;
+					}
+					RunCase(qos_description + " PreparedPublish", [&](util::OutputBuffer &buf) {
+						std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+							p_prepared_publish, payload);
+						p_publish_packet->SetPacketId(++packet_id);
+						p_publish_packet->SerializeHeaderTo(buf);
+					});
+				}
+
+				return ResponseCode::SUCCESS;
+			}
+		}
+	}
+}
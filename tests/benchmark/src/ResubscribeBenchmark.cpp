@@ -0,0 +1,81 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ResubscribeBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include "mqtt/ClientState.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "ResubscribeBenchmark.hpp"
+
+#define RESUBSCRIBE_BENCHMARK_NAME "Resubscribe"
+#define RESUBSCRIBE_BENCHMARK_MIN_SUBSCRIPTIONS 500
+#define RESUBSCRIBE_BENCHMARK_MAX_SUBSCRIPTIONS 50000
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			std::chrono::nanoseconds ResubscribeBenchmark::RunResubscribe(size_t subscription_count) {
+				std::shared_ptr<mqtt::ClientState> p_client_state = mqtt::ClientState::Create(std::chrono::milliseconds(2000));
+				for(size_t itr = 0; itr < subscription_count; itr++) {
+					util::String topic_name = "benchmark/devices/" + util::ToString(itr) + "/commands";
+					p_client_state->AddSubscription(topic_name, mqtt::Subscription::Create(
+						Utf8String::Create(topic_name), mqtt::QoS::QOS1,
+						[](util::String, util::String, std::shared_ptr<mqtt::SubscriptionHandlerContextData>) {
+							return ResponseCode::SUCCESS;
+						}, nullptr));
+				}
+
+				util::Vector<util::String> packet_topics;
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				util::Vector<std::shared_ptr<mqtt::Subscription>> subscriptions;
+				p_client_state->GetSubscriptionTable()->GetAll(subscriptions);
+				util::Vector<std::shared_ptr<mqtt::Subscription>>::const_iterator itr = subscriptions.begin();
+				while(itr != subscriptions.end()) {
+					packet_topics.clear();
+					while(itr != subscriptions.end() && MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET > packet_topics.size()) {
+						(*itr)->SetActive(false);
+						packet_topics.push_back((*itr)->GetTopicName()->ToStdString());
+						itr++;
+					}
+
+					uint16_t packet_id = p_client_state->GetNextPacketId();
+					for(size_t index = 0; index < packet_topics.size(); index++) {
+						p_client_state->SetSubscriptionPacketInfo(packet_topics[index], packet_id, static_cast<uint8_t>(index + 1));
+					}
+					for(size_t index = 0; index < packet_topics.size(); index++) {
+						p_client_state->SetSubscriptionActive(packet_id, static_cast<uint8_t>(index + 1), mqtt::QoS::QOS1);
+					}
+				}
+				return std::chrono::steady_clock::now() - start_time;
+			}
+
+			ResponseCode ResubscribeBenchmark::RunBenchmark() {
+				for(size_t subscription_count = RESUBSCRIBE_BENCHMARK_MIN_SUBSCRIPTIONS;
+					subscription_count <= RESUBSCRIBE_BENCHMARK_MAX_SUBSCRIPTIONS; subscription_count *= 10) {
+					std::chrono::nanoseconds elapsed = RunResubscribe(subscription_count);
+					PrintResult(RESUBSCRIBE_BENCHMARK_NAME, util::ToString(subscription_count) + " subscriptions",
+								subscription_count, elapsed);
+				}
+
+				return ResponseCode::SUCCESS;
+			}
+		}
+	}
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file SubscriptionChurnBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include <thread>
+
+#include "util/logging/LogMacros.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "SubscriptionChurnBenchmark.hpp"
+
+#define SUBSCRIPTION_CHURN_BENCHMARK_NAME "SubscriptionChurn"
+#define SUBSCRIPTION_CHURN_BENCHMARK_LOG_TAG "[Subscription Churn Benchmark]"
+#define SUBSCRIPTION_CHURN_BENCHMARK_SUBSCRIPTIONS 10000
+#define SUBSCRIPTION_CHURN_BENCHMARK_LOOKUPS 2000000
+#define SUBSCRIPTION_CHURN_BENCHMARK_MAX_CHURN_THREADS 4
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			static std::shared_ptr<mqtt::Subscription> CreateBenchmarkSubscription(const util::String &topic_filter) {
+				return mqtt::Subscription::Create(
+					Utf8String::Create(topic_filter), mqtt::QoS::QOS0,
+					[](util::String, util::String, std::shared_ptr<mqtt::SubscriptionHandlerContextData>) {
+						return ResponseCode::SUCCESS;
+					}, nullptr);
+			}
+
+			std::chrono::nanoseconds SubscriptionChurnBenchmark::RunDispatch(
+				std::shared_ptr<mqtt::ClientState> p_client_state, size_t churn_thread_count, size_t lookup_count,
+				size_t &update_count_out) {
+				util::Vector<util::String> topic_names;
+				for(size_t itr = 0; itr < SUBSCRIPTION_CHURN_BENCHMARK_SUBSCRIPTIONS; itr++) {
+					topic_names.push_back("fleet/devices/" + util::ToString(itr) + "/commands");
+				}
+
+				std::atomic_bool is_running(true);
+				std::atomic<size_t> update_count(0);
+				util::Vector<std::thread> churn_threads;
+				for(size_t thread_id = 0; thread_id < churn_thread_count; thread_id++) {
+					churn_threads.push_back(std::thread([&is_running, &update_count, p_client_state, thread_id]() {
+						util::String topic_filter = "fleet/churn/" + util::ToString(thread_id) + "/+/commands";
+						std::shared_ptr<mqtt::Subscription> p_subscription = CreateBenchmarkSubscription(topic_filter);
+						while(is_running) {
+							p_client_state->AddSubscription(topic_filter, p_subscription);
+							p_client_state->RemoveSubscription(topic_filter);
+							update_count += 2;
+						}
+					}));
+				}
+
+				// Same lookup as NetworkReadActionRunner::HandlePublish
+				std::shared_ptr<const mqtt::TopicFilterTrie> p_subscription_table;
+				uint32_t subscription_table_version = 0;
+				util::Vector<std::shared_ptr<mqtt::Subscription>> matches;
+				size_t match_count = 0;
+
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				for(size_t itr = 0; itr < lookup_count; itr++) {
+					uint32_t current_version = p_client_state->GetSubscriptionTableVersion();
+					if(nullptr == p_subscription_table || current_version != subscription_table_version) {
+						p_subscription_table = p_client_state->GetSubscriptionTable();
+						subscription_table_version = current_version;
+					}
+					matches.clear();
+					p_subscription_table->Match(topic_names[itr % topic_names.size()], matches);
+					match_count += matches.size();
+				}
+				std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start_time;
+
+				is_running = false;
+				for(std::thread &churn_thread : churn_threads) {
+					churn_thread.join();
+				}
+				update_count_out = update_count;
+
+				if(match_count < lookup_count) {
+					AWS_LOG_ERROR(SUBSCRIPTION_CHURN_BENCHMARK_LOG_TAG, "Missing matches : %zu of %zu", match_count, lookup_count);
+				}
+				return elapsed;
+			}
+
+			ResponseCode SubscriptionChurnBenchmark::RunBenchmark() {
+				std::shared_ptr<mqtt::ClientState> p_client_state = mqtt::ClientState::Create(std::chrono::milliseconds(2000));
+				for(size_t itr = 0; itr < SUBSCRIPTION_CHURN_BENCHMARK_SUBSCRIPTIONS; itr++) {
+					util::String topic_filter = "fleet/devices/" + util::ToString(itr) + "/commands";
+					p_client_state->AddSubscription(topic_filter, CreateBenchmarkSubscription(topic_filter));
+				}
+
+				for(size_t churn_thread_count = 0; churn_thread_count <= SUBSCRIPTION_CHURN_BENCHMARK_MAX_CHURN_THREADS;
+					churn_thread_count = (0 == churn_thread_count) ? 1 : churn_thread_count * 2) {
+					size_t update_count = 0;
+					std::chrono::nanoseconds elapsed = RunDispatch(p_client_state, churn_thread_count,
+																   SUBSCRIPTION_CHURN_BENCHMARK_LOOKUPS, update_count);
+					double updates_per_second = static_cast<double>(update_count) * 1e9 / static_cast<double>(elapsed.count());
+					PrintResult(SUBSCRIPTION_CHURN_BENCHMARK_NAME, util::ToString(churn_thread_count) + " churn thread(s), "
+																   + util::ToString(static_cast<size_t>(updates_per_second))
+																   + " updates/s",
+								SUBSCRIPTION_CHURN_BENCHMARK_LOOKUPS, elapsed);
+				}
+
+				return ResponseCode::SUCCESS;
+			}
+		}
+	}
+}
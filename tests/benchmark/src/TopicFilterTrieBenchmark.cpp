@@ -0,0 +1,128 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicFilterTrieBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include "mqtt/TopicFilterTrie.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "TopicFilterTrieBenchmark.hpp"
+
+#define TOPIC_FILTER_TRIE_BENCHMARK_NAME "TopicTrie"
+#define TOPIC_FILTER_TRIE_BENCHMARK_FILTER_COUNT 100000
+#define TOPIC_FILTER_TRIE_BENCHMARK_TRIE_LOOKUPS 200000
+#define TOPIC_FILTER_TRIE_BENCHMARK_LINEAR_LOOKUPS 200
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			std::chrono::nanoseconds TopicFilterTrieBenchmark::RunTrieMatch(
+				const util::Vector<util::String> &topic_filters, const util::Vector<util::String> &topic_names,
+				size_t &match_count_out) {
+				mqtt::TopicFilterTrie trie;
+				for(const util::String &topic_filter : topic_filters) {
+					trie.Insert(topic_filter, mqtt::Subscription::Create(
+						Utf8String::Create(topic_filter), mqtt::QoS::QOS0,
+						[](util::String, util::String, std::shared_ptr<mqtt::SubscriptionHandlerContextData>) {
+							return ResponseCode::SUCCESS;
+						}, nullptr));
+				}
+
+				util::Vector<std::shared_ptr<mqtt::Subscription>> matches;
+				match_count_out = 0;
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				for(const util::String &topic_name : topic_names) {
+					matches.clear();
+					trie.Match(topic_name, matches);
+					match_count_out += matches.size();
+				}
+				return std::chrono::steady_clock::now() - start_time;
+			}
+
+			std::chrono::nanoseconds TopicFilterTrieBenchmark::RunLinearMatch(
+				const util::Vector<util::String> &topic_filters, const util::Vector<util::String> &topic_names,
+				size_t &match_count_out) {
+				match_count_out = 0;
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				for(const util::String &topic_name : topic_names) {
+					for(const util::String &topic_filter : topic_filters) {
+						if(mqtt::TopicFilterTrie::IsMatch(topic_filter, topic_name)) {
+							match_count_out++;
+						}
+					}
+				}
+				return std::chrono::steady_clock::now() - start_time;
+			}
+
+			ResponseCode TopicFilterTrieBenchmark::RunBenchmark() {
+				// Mix of per device literal filters, per device single level wildcards and per group multi level
+				// wildcards, similar to a gateway subscribing on behalf of many devices
+				util::Vector<util::String> topic_filters;
+				topic_filters.reserve(TOPIC_FILTER_TRIE_BENCHMARK_FILTER_COUNT);
+				for(size_t itr = 0; topic_filters.size() < TOPIC_FILTER_TRIE_BENCHMARK_FILTER_COUNT; itr++) {
+					util::String device = util::ToString(itr);
+					switch(itr % 4) {
+						case 0:
+						case 1:
+							topic_filters.push_back("fleet/devices/" + device + "/telemetry");
+							break;
+						case 2:
+							topic_filters.push_back("fleet/devices/" + device + "/+/set");
+							break;
+						default:
+							topic_filters.push_back("fleet/groups/" + util::ToString(itr % 1000) + "/" + device + "/#");
+							break;
+					}
+				}
+
+				util::Vector<util::String> topic_names;
+				topic_names.reserve(TOPIC_FILTER_TRIE_BENCHMARK_TRIE_LOOKUPS);
+				for(size_t itr = 0; itr < TOPIC_FILTER_TRIE_BENCHMARK_TRIE_LOOKUPS; itr++) {
+					size_t device = (itr * 7919) % TOPIC_FILTER_TRIE_BENCHMARK_FILTER_COUNT;
+					switch(itr % 3) {
+						case 0:
+							topic_names.push_back("fleet/devices/" + util::ToString(device) + "/telemetry");
+							break;
+						case 1:
+							topic_names.push_back("fleet/devices/" + util::ToString(device) + "/config/set");
+							break;
+						default:
+							topic_names.push_back("fleet/groups/" + util::ToString(device % 1000) + "/"
+												  + util::ToString(device) + "/status/battery");
+							break;
+					}
+				}
+
+				size_t match_count = 0;
+				std::chrono::nanoseconds elapsed = RunTrieMatch(topic_filters, topic_names, match_count);
+				PrintResult(TOPIC_FILTER_TRIE_BENCHMARK_NAME, "Trie, " + util::ToString(topic_filters.size())
+															  + " filters, " + util::ToString(match_count) + " matches",
+							topic_names.size(), elapsed);
+
+				topic_names.resize(TOPIC_FILTER_TRIE_BENCHMARK_LINEAR_LOOKUPS);
+				elapsed = RunLinearMatch(topic_filters, topic_names, match_count);
+				PrintResult(TOPIC_FILTER_TRIE_BENCHMARK_NAME, "Linear scan, " + util::ToString(topic_filters.size())
+															  + " filters, " + util::ToString(match_count) + " matches",
+							topic_names.size(), elapsed);
+
+				return ResponseCode::SUCCESS;
+			}
+		}
+	}
+}
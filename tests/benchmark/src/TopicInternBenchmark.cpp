@@ -0,0 +1,107 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicInternBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include "mqtt/TopicFilterTrie.hpp"
+#include "mqtt/TopicInternPool.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "TopicInternBenchmark.hpp"
+
+#define TOPIC_INTERN_BENCHMARK_NAME "TopicIntern"
+#define TOPIC_INTERN_BENCHMARK_DISTINCT_TOPICS 300
+#define TOPIC_INTERN_BENCHMARK_SUBSCRIPTIONS 1000
+#define TOPIC_INTERN_BENCHMARK_MESSAGES 2000000
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+			std::chrono::nanoseconds TopicInternBenchmark::RunResolve(const util::Vector<util::String> &topic_names,
+																	  bool use_intern_pool, size_t &match_count_out) {
+				mqtt::TopicFilterTrie trie;
+				for(size_t itr = 0; itr < TOPIC_INTERN_BENCHMARK_SUBSCRIPTIONS; itr++) {
+					util::String topic_filter;
+					switch(itr % 3) {
+						case 0:
+							topic_filter = "factory/line" + util::ToString(itr % 10) + "/machine/" + util::ToString(itr) + "/telemetry";
+							break;
+						case 1:
+							topic_filter = "factory/+/machine/" + util::ToString(itr) + "/telemetry";
+							break;
+						default:
+							topic_filter = "factory/line" + util::ToString(itr % 10) + "/machine/" + util::ToString(itr) + "/#";
+							break;
+					}
+					trie.Insert(topic_filter, mqtt::Subscription::Create(
+						Utf8String::Create(topic_filter), mqtt::QoS::QOS0,
+						[](util::String, util::String, std::shared_ptr<mqtt::SubscriptionHandlerContextData>) {
+							return ResponseCode::SUCCESS;
+						}, nullptr));
+				}
+
+				mqtt::TopicInternPool topic_intern_pool;
+				util::Vector<std::shared_ptr<mqtt::Subscription>> matches;
+				const uint32_t subscription_table_version = 1;
+				match_count_out = 0;
+
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				for(size_t itr = 0; itr < TOPIC_INTERN_BENCHMARK_MESSAGES; itr++) {
+					util::StringView topic_name(topic_names[(itr * 7) % topic_names.size()]);
+					if(use_intern_pool) {
+						std::shared_ptr<mqtt::InternedTopic> p_interned_topic = topic_intern_pool.Intern(topic_name);
+						const util::Vector<std::shared_ptr<mqtt::Subscription>> *p_matches
+							= p_interned_topic->GetCachedMatches(subscription_table_version);
+						if(nullptr == p_matches) {
+							util::Vector<std::shared_ptr<mqtt::Subscription>> &cached_matches
+								= p_interned_topic->ResetCachedMatches(subscription_table_version);
+							trie.Match(topic_name, cached_matches);
+							p_matches = &cached_matches;
+						}
+						match_count_out += p_matches->size();
+					} else {
+						matches.clear();
+						trie.Match(topic_name, matches);
+						match_count_out += matches.size();
+					}
+				}
+				return std::chrono::steady_clock::now() - start_time;
+			}
+
+			ResponseCode TopicInternBenchmark::RunBenchmark() {
+				util::Vector<util::String> topic_names;
+				for(size_t itr = 0; itr < TOPIC_INTERN_BENCHMARK_DISTINCT_TOPICS; itr++) {
+					topic_names.push_back("factory/line" + util::ToString(itr % 10) + "/machine/" + util::ToString(itr)
+										  + "/telemetry");
+				}
+
+				size_t match_count = 0;
+				std::chrono::nanoseconds elapsed = RunResolve(topic_names, false, match_count);
+				PrintResult(TOPIC_INTERN_BENCHMARK_NAME, "Trie match, " + util::ToString(match_count) + " matches",
+							TOPIC_INTERN_BENCHMARK_MESSAGES, elapsed);
+
+				elapsed = RunResolve(topic_names, true, match_count);
+				PrintResult(TOPIC_INTERN_BENCHMARK_NAME, "Interned, " + util::ToString(match_count) + " matches",
+							TOPIC_INTERN_BENCHMARK_MESSAGES, elapsed);
+
+				return ResponseCode::SUCCESS;
+			}
+		}
+	}
+}
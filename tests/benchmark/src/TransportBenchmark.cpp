@@ -0,0 +1,145 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TransportBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include <cstdio>
+
+#if defined(__linux__) && !defined(USE_MBEDTLS)
+#include "OpenSSLConnection.hpp"
+#endif
+
+#include "util/logging/LogMacros.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "BenchmarkHelper.hpp"
+#include "TlsTestServer.hpp"
+#include "TransportBenchmark.hpp"
+
+#define TRANSPORT_BENCHMARK_NAME "Transport"
+#define TRANSPORT_BENCHMARK_LOG_TAG "[Transport Benchmark]"
+
+#define TRANSPORT_BENCHMARK_SMALL_MESSAGE_SIZE 128
+#define TRANSPORT_BENCHMARK_SMALL_MESSAGE_COUNT 20000
+#define TRANSPORT_BENCHMARK_LARGE_MESSAGE_SIZE 8192
+#define TRANSPORT_BENCHMARK_LARGE_MESSAGE_COUNT 5000
+#define TRANSPORT_BENCHMARK_TIMEOUT_MS 5000
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+#if defined(__linux__) && !defined(USE_MBEDTLS)
+			namespace {
+				ResponseCode RunRoundTrips(network::OpenSSLConnection::Transport transport, support::SelfSignedIdentity &identity,
+										   size_t message_size, size_t message_count,
+										   std::chrono::nanoseconds &elapsed_out) {
+					support::TlsTestServer server(true);
+					if(!server.Start(identity)) {
+						AWS_LOG_ERROR(TRANSPORT_BENCHMARK_LOG_TAG, "Unable to start TLS echo server");
+						return ResponseCode::FAILURE;
+					}
+
+					std::chrono::milliseconds timeout(TRANSPORT_BENCHMARK_TIMEOUT_MS);
+					std::shared_ptr<network::OpenSSLConnection> p_connection = std::make_shared<network::OpenSSLConnection>(
+						"127.0.0.1", server.port_, identity.cert_path_, timeout, timeout, timeout, false);
+					ResponseCode rc = p_connection->Initialize();
+					if(ResponseCode::SUCCESS == rc) {
+						rc = p_connection->SetTransport(transport);
+					}
+					if(ResponseCode::SUCCESS == rc) {
+						rc = p_connection->Connect();
+					}
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+
+					util::String message(message_size, 'x');
+					util::Vector<unsigned char> reply(message_size);
+
+					std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+					for(size_t count = 0; ResponseCode::SUCCESS == rc && count < message_count; count++) {
+						size_t written = 0;
+						rc = p_connection->Write(message, written);
+						size_t total_read = 0;
+						while(ResponseCode::SUCCESS == rc && total_read < message_size) {
+							size_t read_length = 0;
+							rc = p_connection->Read(reply, total_read, message_size - total_read, read_length);
+							total_read += read_length;
+						}
+					}
+					elapsed_out = std::chrono::steady_clock::now() - start;
+
+					p_connection->Disconnect();
+					return rc;
+				}
+			}
+
+			ResponseCode TransportBenchmark::RunBenchmark() {
+				support::SelfSignedIdentity identity;
+				if(!identity.Generate()) {
+					AWS_LOG_ERROR(TRANSPORT_BENCHMARK_LOG_TAG, "Unable to generate benchmark certificate");
+					return ResponseCode::FAILURE;
+				}
+
+				struct {
+					network::OpenSSLConnection::Transport transport;
+					const char *p_name;
+				} transports[] = {
+					{network::OpenSSLConnection::Transport::SOCKET, "socket"},
+					{network::OpenSSLConnection::Transport::IO_URING, "io_uring"}
+				};
+				struct {
+					size_t message_size;
+					size_t message_count;
+				} workloads[] = {
+					{TRANSPORT_BENCHMARK_SMALL_MESSAGE_SIZE, TRANSPORT_BENCHMARK_SMALL_MESSAGE_COUNT},
+					{TRANSPORT_BENCHMARK_LARGE_MESSAGE_SIZE, TRANSPORT_BENCHMARK_LARGE_MESSAGE_COUNT}
+				};
+
+				for(auto &workload : workloads) {
+					for(auto &transport : transports) {
+						util::String case_description = util::String(transport.p_name) + ", "
+							+ util::ToString(workload.message_size) + " byte round trips";
+						std::chrono::nanoseconds elapsed(0);
+						ResponseCode rc = RunRoundTrips(transport.transport, identity, workload.message_size,
+														workload.message_count, elapsed);
+						if(ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR == rc) {
+							printf("%-28s %-44s skipped, not supported on this system\n", TRANSPORT_BENCHMARK_NAME,
+								   case_description.c_str());
+							continue;
+						} else if(ResponseCode::SUCCESS != rc) {
+							AWS_LOG_ERROR(TRANSPORT_BENCHMARK_LOG_TAG, "%s failed with rc : %d",
+										  case_description.c_str(), static_cast<int>(rc));
+							return rc;
+						}
+						PrintResult(TRANSPORT_BENCHMARK_NAME, case_description, workload.message_count, elapsed);
+					}
+				}
+
+				return ResponseCode::SUCCESS;
+			}
+#else
+			ResponseCode TransportBenchmark::RunBenchmark() {
+				printf("%-28s skipped, requires Linux and the OpenSSL network library\n", TRANSPORT_BENCHMARK_NAME);
+				return ResponseCode::SUCCESS;
+			}
+#endif
+		}
+	}
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file WriteCoalescingBenchmark.cpp
+ * @brief
+ *
+ */
+
+#include <cstdio>
+#include <thread>
+
+#include "util/logging/LogMacros.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "ClientCore.hpp"
+#include "mqtt/ClientState.hpp"
+#include "mqtt/Publish.hpp"
+
+#if defined(__linux__) && !defined(USE_MBEDTLS)
+#include "OpenSSLConnection.hpp"
+#endif
+
+#include "BenchmarkHelper.hpp"
+#include "TlsTestServer.hpp"
+#include "WriteCoalescingBenchmark.hpp"
+
+#define WRITE_COALESCING_BENCHMARK_NAME "WriteCoalescing"
+#define WRITE_COALESCING_BENCHMARK_LOG_TAG "[Write Coalescing Benchmark]"
+#define WRITE_COALESCING_BENCHMARK_PUBLISH_PER_PRODUCER 20000
+#define WRITE_COALESCING_BENCHMARK_PAYLOAD_SIZE 200
+#define WRITE_COALESCING_BENCHMARK_MAX_BYTES 16384
+#define WRITE_COALESCING_BENCHMARK_MAX_DELAY_US 200
+#define WRITE_COALESCING_BENCHMARK_TIMEOUT_MS 5000
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace benchmark {
+#if defined(__linux__) && !defined(USE_MBEDTLS)
+			namespace {
+				/**
+				 * @brief OpenSSL connection that counts the write calls reaching the TLS layer
+				 */
+				class CountingOpenSSLConnection : public network::OpenSSLConnection {
+				protected:
+					ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+						total_write_calls_++;
+						return network::OpenSSLConnection::WriteInternal(buf, size_written_bytes_out);
+					}
+
+					ResponseCode WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+												size_t &size_written_bytes_out) {
+						total_write_calls_++;
+						return network::OpenSSLConnection::WriteVInternal(p_segments, segment_count,
+																		  size_written_bytes_out);
+					}
+
+				public:
+					std::atomic_size_t total_write_calls_;
+
+					CountingOpenSSLConnection(util::String endpoint, uint16_t endpoint_port, util::String root_ca_location,
+											  std::chrono::milliseconds timeout)
+						: network::OpenSSLConnection(endpoint, endpoint_port, root_ca_location, timeout, timeout, timeout,
+													 false) {
+						total_write_calls_ = 0;
+					}
+				};
+			}
+
+			ResponseCode WriteCoalescingBenchmark::RunPublish(support::SelfSignedIdentity &identity, size_t producer_count,
+															  size_t publish_per_producer, size_t coalescing_max_bytes,
+															  std::chrono::nanoseconds &elapsed_out,
+															  size_t &write_call_count_out) {
+				support::TlsTestServer server(false);
+				if(!server.Start(identity)) {
+					AWS_LOG_ERROR(WRITE_COALESCING_BENCHMARK_LOG_TAG, "Unable to start TLS server");
+					return ResponseCode::FAILURE;
+				}
+
+				std::shared_ptr<CountingOpenSSLConnection> p_network_connection = std::make_shared<CountingOpenSSLConnection>(
+					"127.0.0.1", server.port_, identity.cert_path_,
+					std::chrono::milliseconds(WRITE_COALESCING_BENCHMARK_TIMEOUT_MS));
+				ResponseCode rc = p_network_connection->Initialize();
+				if(ResponseCode::SUCCESS == rc) {
+					rc = p_network_connection->Connect();
+				}
+				if(ResponseCode::SUCCESS != rc) {
+					return rc;
+				}
+
+				std::shared_ptr<mqtt::ClientState> p_client_state = mqtt::ClientState::Create(std::chrono::milliseconds(2000));
+				std::unique_ptr<ClientCore> p_client_core = ClientCore::Create(p_network_connection, p_client_state);
+				p_client_core->RegisterAction(ActionType::PUBLISH, mqtt::PublishActionAsync::Create);
+				p_client_state->SetMaxActionQueueSize(MAX_ACTION_QUEUE_CAPACITY);
+				p_client_state->SetWriteCoalescing(coalescing_max_bytes,
+												   std::chrono::microseconds(WRITE_COALESCING_BENCHMARK_MAX_DELAY_US));
+				p_client_core->SetProcessQueuedActions(true);
+
+				util::String payload(WRITE_COALESCING_BENCHMARK_PAYLOAD_SIZE, 'x');
+				size_t packet_size = mqtt::PublishPacket::Create(Utf8String::Create("benchmark/topic"), false, false,
+																 mqtt::QoS::QOS0, payload)->Size();
+				size_t total_bytes = producer_count * publish_per_producer * packet_size;
+
+				std::atomic_bool start(false);
+				util::Vector<std::thread> producers;
+				for(size_t producer_id = 0; producer_id < producer_count; producer_id++) {
+					producers.push_back(std::thread([&start, &p_client_core, &payload, publish_per_producer]() {
+						while(!start) {
+							std::this_thread::yield();
+						}
+						uint16_t packet_id = 0;
+						for(size_t itr = 0; itr < publish_per_producer; itr++) {
+							std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+									Utf8String::Create("benchmark/topic"), false, false, mqtt::QoS::QOS0, payload);
+							while(ResponseCode::SUCCESS != p_client_core->PerformActionAsync(ActionType::PUBLISH,
+																							  p_publish_packet,
+																							  packet_id)) {
+								std::this_thread::yield();
+							}
+						}
+					}));
+				}
+
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				start = true;
+				for(std::thread &producer : producers) {
+					producer.join();
+				}
+				// Complete once the server has received every publish, not when the last write call returns
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now()
+					+ std::chrono::milliseconds(WRITE_COALESCING_BENCHMARK_TIMEOUT_MS);
+				while(server.total_read_bytes_ < total_bytes && std::chrono::steady_clock::now() < deadline) {
+					std::this_thread::yield();
+				}
+				elapsed_out = std::chrono::steady_clock::now() - start_time;
+				write_call_count_out = p_network_connection->total_write_calls_;
+
+				p_client_core.reset();
+				p_network_connection->Disconnect();
+				if(server.total_read_bytes_ < total_bytes) {
+					AWS_LOG_ERROR(WRITE_COALESCING_BENCHMARK_LOG_TAG, "Server received %zu of %zu bytes",
+								  static_cast<size_t>(server.total_read_bytes_), total_bytes);
+					return ResponseCode::NETWORK_SSL_WRITE_TIMEOUT_ERROR;
+				}
+				return ResponseCode::SUCCESS;
+			}
+
+			ResponseCode WriteCoalescingBenchmark::RunBenchmark() {
+				support::SelfSignedIdentity identity;
+				if(!identity.Generate()) {
+					AWS_LOG_ERROR(WRITE_COALESCING_BENCHMARK_LOG_TAG, "Unable to generate benchmark certificate");
+					return ResponseCode::FAILURE;
+				}
+
+				size_t max_producer_count = std::thread::hardware_concurrency();
+				if(2 > max_producer_count) {
+					max_producer_count = 2;
+				}
+
+				struct {
+					size_t coalescing_max_bytes;
+					const char *p_name;
+				} configurations[] = {
+					{0, "Disabled"},
+					{WRITE_COALESCING_BENCHMARK_MAX_BYTES, "16KB budget"}
+				};
+
+				for(size_t producer_count = 1; producer_count <= max_producer_count; producer_count *= 2) {
+					util::String producers = util::ToString(producer_count) + " producer(s)";
+					size_t total_publish = producer_count * WRITE_COALESCING_BENCHMARK_PUBLISH_PER_PRODUCER;
+
+					for(auto &configuration : configurations) {
+						std::chrono::nanoseconds elapsed(0);
+						size_t write_call_count = 0;
+						ResponseCode rc = RunPublish(identity, producer_count,
+													 WRITE_COALESCING_BENCHMARK_PUBLISH_PER_PRODUCER,
+													 configuration.coalescing_max_bytes, elapsed, write_call_count);
+						if(ResponseCode::SUCCESS != rc) {
+							AWS_LOG_ERROR(WRITE_COALESCING_BENCHMARK_LOG_TAG, "%s, %s failed with rc : %d",
+										  configuration.p_name, producers.c_str(), static_cast<int>(rc));
+							return rc;
+						}
+						PrintResult(WRITE_COALESCING_BENCHMARK_NAME, util::String(configuration.p_name) + ", " + producers
+																	 + ", " + util::ToString(write_call_count) + " writes",
+									total_publish, elapsed);
+					}
+				}
+
+				return ResponseCode::SUCCESS;
+			}
+#else
+			ResponseCode WriteCoalescingBenchmark::RunBenchmark() {
+				printf("%-28s skipped, requires Linux and the OpenSSL network library\n", WRITE_COALESCING_BENCHMARK_NAME);
+				return ResponseCode::SUCCESS;
+			}
+#endif
+		}
+	}
+}
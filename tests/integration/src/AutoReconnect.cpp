@@ -64,7 +64,7 @@ namespace awsiotsdk {
 
 				do {
 					util::String payload = "Hello from SDK : ";
-					payload.append(std::to_string(itr));
+					payload.append(util::ToString(itr));
 					std::cout << "Publish Payload : " << payload << std::endl;
 
 					std::unique_ptr<Utf8String> p_topic_name = Utf8String::Create(p_topic_name_str);
@@ -225,7 +225,7 @@ namespace awsiotsdk {
 					p_iot_client_->SetAutoReconnectEnabled(true);
 					client_id_tagged_ = ConfigCommon::base_client_id_;
 					client_id_tagged_.append("_autoreconnect_tester_");
-					client_id_tagged_.append(std::to_string(rand()));
+					client_id_tagged_.append(util::ToString(rand()));
 					std::unique_ptr<Utf8String> client_id = Utf8String::Create(client_id_tagged_);
 
 					rc = p_iot_client_->Connect(ConfigCommon::mqtt_command_timeout_, ConfigCommon::is_clean_session_,
@@ -53,7 +53,7 @@ namespace awsiotsdk {
 
 				do {
 					util::String payload2 = "[Client 2] Hello from SDK : ";
-					payload2.append(std::to_string(itr));
+					payload2.append(util::ToString(itr));
 					std::cout << "Publish Payload : " << payload2 << std::endl;
 
 					p_topic_name = Utf8String::Create(p_topic_name_str);
@@ -71,7 +71,7 @@ namespace awsiotsdk {
 					}
 
 					util::String payload3 = "[Client 3] Hello from SDK : ";
-					payload3.append(std::to_string(itr));
+					payload3.append(util::ToString(itr));
 					std::cout << "Publish Payload : " << payload3 << std::endl;
 
 					p_topic_name = Utf8String::Create(p_topic_name_str);
@@ -192,7 +192,7 @@ namespace awsiotsdk {
 				p_iot_client_1_ = MqttClient::Create(p_network_connection_1_, ConfigCommon::mqtt_command_timeout_);
 				util::String client_id_1_tagged = ConfigCommon::base_client_id_;
 				client_id_1_tagged.append("_multiple_clients_tester_");
-				client_id_1_tagged.append(std::to_string(rand()));
+				client_id_1_tagged.append(util::ToString(rand()));
 				std::unique_ptr<Utf8String> client_id = Utf8String::Create(client_id_1_tagged);
 				rc = p_iot_client_1_->Connect(ConfigCommon::mqtt_command_timeout_, ConfigCommon::is_clean_session_,
 											  mqtt::Version::MQTT_3_1_1, ConfigCommon::keep_alive_timeout_secs_,
@@ -210,7 +210,7 @@ namespace awsiotsdk {
 				p_iot_client_2_ = MqttClient::Create(p_network_connection_2_, ConfigCommon::mqtt_command_timeout_);
 				util::String client_id_2_tagged = ConfigCommon::base_client_id_;
 				client_id_2_tagged.append("_multiple_clients_tester_");
-				client_id_2_tagged.append(std::to_string(rand()));
+				client_id_2_tagged.append(util::ToString(rand()));
 				std::unique_ptr<Utf8String> client_id_2 = Utf8String::Create(client_id_2_tagged);
 				rc = p_iot_client_2_->Connect(ConfigCommon::mqtt_command_timeout_, ConfigCommon::is_clean_session_,
 											mqtt::Version::MQTT_3_1_1, ConfigCommon::keep_alive_timeout_secs_,
@@ -228,7 +228,7 @@ namespace awsiotsdk {
 				p_iot_client_3_ = MqttClient::Create(p_network_connection_3_, ConfigCommon::mqtt_command_timeout_);
 				util::String client_id_3_tagged = ConfigCommon::base_client_id_;
 				client_id_3_tagged.append("_multiple_clients_tester_");
-				client_id_3_tagged.append(std::to_string(rand()));
+				client_id_3_tagged.append(util::ToString(rand()));
 				std::unique_ptr<Utf8String> client_id_3 = Utf8String::Create(client_id_3_tagged);
 				rc = p_iot_client_3_->Connect(ConfigCommon::mqtt_command_timeout_, ConfigCommon::is_clean_session_,
 											mqtt::Version::MQTT_3_1_1, ConfigCommon::keep_alive_timeout_secs_,
@@ -0,0 +1,356 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file IoUringTransportTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#if defined(__linux__) && !defined(USE_MBEDTLS)
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "OpenSSLConnection.hpp"
+#include "TlsTestServer.hpp"
+
+#define IO_URING_TEST_TIMEOUT_MS 2000
+#define IO_URING_TEST_SHORT_TIMEOUT_MS 50
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			class IoUringTransportTester : public ::testing::Test {
+			protected:
+				std::unique_ptr<network::IoUringTransport> p_transport_;
+				int socket_fds_[2];
+				std::chrono::milliseconds timeout_;
+
+				IoUringTransportTester() : timeout_(IO_URING_TEST_TIMEOUT_MS) {
+					socket_fds_[0] = -1;
+					socket_fds_[1] = -1;
+				}
+
+				void SetUp() override {
+					p_transport_ = network::IoUringTransport::Create(IO_URING_TRANSPORT_RECEIVE_BUFFER_SIZE);
+					if(nullptr == p_transport_) {
+						GTEST_SKIP() << "io_uring is not supported on this system";
+					}
+					ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds_));
+				}
+
+				void TearDown() override {
+					if(0 <= socket_fds_[0]) {
+						shutdown(socket_fds_[0], SHUT_RDWR);
+						if(nullptr != p_transport_) {
+							p_transport_->Drain(timeout_);
+						}
+						close(socket_fds_[0]);
+					}
+					if(0 <= socket_fds_[1]) {
+						close(socket_fds_[1]);
+					}
+				}
+
+				void WritePeer(const util::String &data) {
+					ASSERT_EQ(static_cast<ssize_t>(data.length()), write(socket_fds_[1], data.c_str(), data.length()));
+				}
+
+				util::String ReadPeer(size_t length) {
+					util::Vector<char> buf(length);
+					size_t total_read = 0;
+					while(total_read < length) {
+						ssize_t read_length = read(socket_fds_[1], &buf[total_read], length - total_read);
+						if(0 >= read_length) {
+							break;
+						}
+						total_read += static_cast<size_t>(read_length);
+					}
+					return util::String(buf.data(), total_read);
+				}
+			};
+
+			// Test that a zero sized receive buffer is rejected
+			TEST_F(IoUringTransportTester, CreateWithoutReceiveBuffer) {
+				EXPECT_EQ(nullptr, network::IoUringTransport::Create(0));
+			}
+
+			// Test that sent data reaches the peer and data from the peer is received
+			TEST_F(IoUringTransportTester, SendAndReceiveRoundTrip) {
+				util::String request = "ping from the client";
+				EXPECT_EQ(ResponseCode::SUCCESS,
+						  p_transport_->Send(socket_fds_[0], reinterpret_cast<const unsigned char *>(request.c_str()),
+											 request.length(), timeout_));
+				EXPECT_EQ(request, ReadPeer(request.length()));
+
+				WritePeer("pong from the peer");
+				const unsigned char *p_data = nullptr;
+				size_t data_length = 0;
+				ASSERT_EQ(ResponseCode::SUCCESS, p_transport_->Receive(socket_fds_[0], timeout_, p_data, data_length));
+				EXPECT_EQ("pong from the peer", util::String(reinterpret_cast<const char *>(p_data), data_length));
+				p_transport_->ConsumeReceived(data_length);
+			}
+
+			// Test that the receive times out without data and that the descriptor signals a completed receive
+			TEST_F(IoUringTransportTester, ReceiveTimeout) {
+				const unsigned char *p_data = nullptr;
+				size_t data_length = 0;
+				EXPECT_EQ(ResponseCode::NETWORK_SSL_NOTHING_TO_READ,
+						  p_transport_->Receive(socket_fds_[0], std::chrono::milliseconds(IO_URING_TEST_SHORT_TIMEOUT_MS),
+												p_data, data_length));
+				EXPECT_LE(0, p_transport_->GetReceiveDescriptor());
+
+				WritePeer("late");
+				EXPECT_EQ(ResponseCode::SUCCESS, p_transport_->WaitForReceive(socket_fds_[0], timeout_));
+				ASSERT_EQ(ResponseCode::SUCCESS, p_transport_->Receive(socket_fds_[0], timeout_, p_data, data_length));
+				EXPECT_EQ("late", util::String(reinterpret_cast<const char *>(p_data), data_length));
+			}
+
+			// Test that partially consumed data is returned again and that data arriving in chunks is received in order
+			TEST_F(IoUringTransportTester, PartialReads) {
+				WritePeer("0123456789");
+				const unsigned char *p_data = nullptr;
+				size_t data_length = 0;
+				ASSERT_EQ(ResponseCode::SUCCESS, p_transport_->Receive(socket_fds_[0], timeout_, p_data, data_length));
+				ASSERT_EQ(static_cast<size_t>(10), data_length);
+
+				p_transport_->ConsumeReceived(4);
+				ASSERT_EQ(ResponseCode::SUCCESS, p_transport_->Receive(socket_fds_[0], timeout_, p_data, data_length));
+				EXPECT_EQ("456789", util::String(reinterpret_cast<const char *>(p_data), data_length));
+				p_transport_->ConsumeReceived(data_length);
+
+				util::String received;
+				WritePeer("abc");
+				ASSERT_EQ(ResponseCode::SUCCESS, p_transport_->Receive(socket_fds_[0], timeout_, p_data, data_length));
+				received.append(reinterpret_cast<const char *>(p_data), data_length);
+				p_transport_->ConsumeReceived(data_length);
+				WritePeer("def");
+				ASSERT_EQ(ResponseCode::SUCCESS, p_transport_->Receive(socket_fds_[0], timeout_, p_data, data_length));
+				received.append(reinterpret_cast<const char *>(p_data), data_length);
+				p_transport_->ConsumeReceived(data_length);
+				EXPECT_EQ("abcdef", received);
+			}
+
+			// Test that data larger than the receive buffer is returned over several receives
+			TEST_F(IoUringTransportTester, ReceiveLargerThanBuffer) {
+				std::unique_ptr<network::IoUringTransport> p_small_transport = network::IoUringTransport::Create(8);
+				ASSERT_NE(nullptr, p_small_transport);
+
+				util::String sent = "the quick brown fox jumps over the lazy dog";
+				WritePeer(sent);
+				util::String received;
+				while(received.length() < sent.length()) {
+					const unsigned char *p_data = nullptr;
+					size_t data_length = 0;
+					ASSERT_EQ(ResponseCode::SUCCESS,
+							  p_small_transport->Receive(socket_fds_[0], timeout_, p_data, data_length));
+					EXPECT_GE(static_cast<size_t>(8), data_length);
+					received.append(reinterpret_cast<const char *>(p_data), data_length);
+					p_small_transport->ConsumeReceived(data_length);
+				}
+				EXPECT_EQ(sent, received);
+			}
+
+			// Test that a peer disconnect is reported on receive and send
+			TEST_F(IoUringTransportTester, PeerDisconnect) {
+				WritePeer("last words");
+				close(socket_fds_[1]);
+				socket_fds_[1] = -1;
+
+				const unsigned char *p_data = nullptr;
+				size_t data_length = 0;
+				ASSERT_EQ(ResponseCode::SUCCESS, p_transport_->Receive(socket_fds_[0], timeout_, p_data, data_length));
+				EXPECT_EQ("last words", util::String(reinterpret_cast<const char *>(p_data), data_length));
+				p_transport_->ConsumeReceived(data_length);
+				EXPECT_EQ(ResponseCode::NETWORK_SSL_CONNECTION_CLOSED_ERROR,
+						  p_transport_->Receive(socket_fds_[0], timeout_, p_data, data_length));
+
+				util::String request = "nobody is listening";
+				EXPECT_EQ(ResponseCode::NETWORK_SSL_WRITE_ERROR,
+						  p_transport_->Send(socket_fds_[0], reinterpret_cast<const unsigned char *>(request.c_str()),
+											 request.length(), timeout_));
+			}
+
+			// Test that draining completes an armed receive once the socket is shut down and the transport can be reused
+			TEST_F(IoUringTransportTester, DrainAfterShutdown) {
+				EXPECT_EQ(ResponseCode::NETWORK_SSL_NOTHING_TO_READ,
+						  p_transport_->WaitForReceive(socket_fds_[0], std::chrono::milliseconds(0)));
+
+				shutdown(socket_fds_[0], SHUT_RDWR);
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				p_transport_->Drain(timeout_);
+				EXPECT_GT(timeout_, std::chrono::steady_clock::now() - start);
+				close(socket_fds_[0]);
+				close(socket_fds_[1]);
+
+				p_transport_->Reset();
+				ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds_));
+				WritePeer("second connection");
+				const unsigned char *p_data = nullptr;
+				size_t data_length = 0;
+				ASSERT_EQ(ResponseCode::SUCCESS, p_transport_->Receive(socket_fds_[0], timeout_, p_data, data_length));
+				EXPECT_EQ("second connection", util::String(reinterpret_cast<const char *>(p_data), data_length));
+			}
+
+			class IoUringConnectionTester : public ::testing::Test {
+			protected:
+				support::SelfSignedIdentity identity_;
+				support::TlsTestServer server_;
+				std::shared_ptr<network::OpenSSLConnection> p_connection_;
+
+				IoUringConnectionTester() : server_(true) { }
+
+				void SetUp() override {
+					ASSERT_TRUE(identity_.Generate());
+					ASSERT_TRUE(server_.Start(identity_));
+
+					std::chrono::milliseconds timeout(IO_URING_TEST_TIMEOUT_MS);
+					p_connection_ = std::make_shared<network::OpenSSLConnection>(
+						"127.0.0.1", server_.port_, identity_.cert_path_, timeout,
+						std::chrono::milliseconds(IO_URING_TEST_SHORT_TIMEOUT_MS), timeout, false);
+					ASSERT_EQ(ResponseCode::SUCCESS, p_connection_->Initialize());
+				}
+
+				void TearDown() override {
+					if(p_connection_->IsConnected()) {
+						p_connection_->Disconnect();
+					}
+				}
+
+				ResponseCode ReadExactly(util::Vector<unsigned char> &buf, size_t offset, size_t length) {
+					size_t total_read = 0;
+					ResponseCode rc = ResponseCode::SUCCESS;
+					while(ResponseCode::SUCCESS == rc && total_read < length) {
+						size_t read_length = 0;
+						rc = p_connection_->Read(buf, offset + total_read, length - total_read, read_length);
+						total_read += read_length;
+					}
+					return rc;
+				}
+			};
+
+			// Test connecting over io_uring, a TLS round trip read in parts and disconnecting
+			TEST_F(IoUringConnectionTester, ConnectRoundTripAndDisconnect) {
+				ResponseCode rc = p_connection_->SetTransport(network::OpenSSLConnection::Transport::IO_URING);
+				if(ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR == rc) {
+					GTEST_SKIP() << "io_uring is not supported on this system";
+				}
+				ASSERT_EQ(ResponseCode::SUCCESS, rc);
+				ASSERT_EQ(ResponseCode::SUCCESS, p_connection_->Connect());
+				EXPECT_TRUE(p_connection_->IsConnected());
+
+				util::Vector<unsigned char> reply(64);
+				size_t read_length = 0;
+				EXPECT_EQ(ResponseCode::NETWORK_SSL_NOTHING_TO_READ, p_connection_->Read(reply, 0, 1, read_length));
+
+				util::String message(64, 'm');
+				message.replace(0, 5, "first");
+				size_t written = 0;
+				ASSERT_EQ(ResponseCode::SUCCESS, p_connection_->Write(message, written));
+				EXPECT_EQ(message.length(), written);
+
+				// The echoed record is decrypted at once, the remainder must be served from the TLS buffer
+				ASSERT_EQ(ResponseCode::SUCCESS, ReadExactly(reply, 0, 5));
+				ASSERT_EQ(ResponseCode::SUCCESS, ReadExactly(reply, 5, message.length() - 5));
+				EXPECT_EQ(message, util::String(reply.begin(), reply.end()));
+
+				EXPECT_EQ(ResponseCode::SUCCESS, p_connection_->Disconnect());
+				EXPECT_FALSE(p_connection_->IsConnected());
+				EXPECT_EQ(message.length(), server_.total_read_bytes_.load());
+			}
+
+#if defined(AWS_IOT_IO_URING_SUPPORTED) && defined(__NR_io_uring_setup)
+			/**
+			 * @brief Make io_uring_setup fail with ENOSYS for the rest of the process, as on a kernel without io_uring
+			 *
+			 * @return true if the filter was installed
+			 */
+			static bool DisableIoUring() {
+				struct sock_filter filter[] = {
+					BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, nr)),
+					BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_io_uring_setup, 0, 1),
+					BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | (ENOSYS & SECCOMP_RET_DATA)),
+					BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW)
+				};
+				struct sock_fprog program;
+				program.len = static_cast<unsigned short>(sizeof(filter) / sizeof(filter[0]));
+				program.filter = filter;
+				return 0 == prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0)
+					&& 0 == prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &program);
+			}
+
+			/**
+			 * @brief Request io_uring on a system without it and check the connection still works over sockets
+			 *
+			 * @return int - Exit code, 0 if the fallback behaved as expected
+			 */
+			static int RunUnsupportedKernelFallback(std::shared_ptr<network::OpenSSLConnection> p_connection) {
+				if(!DisableIoUring()) {
+					return 1;
+				}
+				if(nullptr != network::IoUringTransport::Create(IO_URING_TRANSPORT_RECEIVE_BUFFER_SIZE)) {
+					return 2;
+				}
+				if(ResponseCode::NETWORK_TRANSPORT_NOT_SUPPORTED_ERROR
+				   != p_connection->SetTransport(network::OpenSSLConnection::Transport::IO_URING)
+				   || network::OpenSSLConnection::Transport::SOCKET != p_connection->GetTransport()) {
+					return 3;
+				}
+				if(ResponseCode::SUCCESS != p_connection->Connect()) {
+					return 4;
+				}
+
+				util::String message = "over sockets";
+				util::Vector<unsigned char> reply(message.length());
+				size_t written = 0;
+				size_t total_read = 0;
+				ResponseCode rc = p_connection->Write(message, written);
+				while(ResponseCode::SUCCESS == rc && total_read < message.length()) {
+					size_t read_length = 0;
+					rc = p_connection->Read(reply, total_read, message.length() - total_read, read_length);
+					total_read += read_length;
+				}
+				p_connection->Disconnect();
+				if(ResponseCode::SUCCESS != rc || message != util::String(reply.begin(), reply.end())) {
+					return 5;
+				}
+				return 0;
+			}
+
+			// Test that selecting io_uring on a kernel without it fails and leaves the connection on sockets
+			TEST_F(IoUringConnectionTester, FallbackOnUnsupportedKernel) {
+				// The filter can not be removed, so it is installed in the death test child process only
+				::testing::FLAGS_gtest_death_test_style = "threadsafe";
+				EXPECT_EXIT(exit(RunUnsupportedKernelFallback(p_connection_)), ::testing::ExitedWithCode(0), "");
+			}
+#endif
+		}
+	}
+}
+
+#endif
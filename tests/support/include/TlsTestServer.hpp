@@ -0,0 +1,92 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TlsTestServer.hpp
+ * @brief In process TLS server used by the benchmarks that need a real OpenSSL transport
+ *
+ */
+
+#pragma once
+
+#if defined(__linux__) && !defined(USE_MBEDTLS)
+
+#include <atomic>
+#include <thread>
+
+#include <openssl/ssl.h>
+
+#include "util/memory/stl/String.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace support {
+			/**
+			 * @brief Self signed certificate and key, the certificate is also written to a file to be used as root CA
+			 */
+			class SelfSignedIdentity {
+			public:
+				EVP_PKEY *p_key_;
+				X509 *p_cert_;
+				util::String cert_path_;
+
+				SelfSignedIdentity() : p_key_(nullptr), p_cert_(nullptr) { }
+
+				/**
+				 * @brief Generate the key and certificate for CN localhost
+				 *
+				 * @return true if the identity and the certificate file were created
+				 */
+				bool Generate();
+
+				~SelfSignedIdentity();
+			};
+
+			/**
+			 * @brief TLS server on loopback accepting a single client
+			 *
+			 * In echo mode everything read is written back to the client, otherwise reads are discarded. Either way
+			 * the number of bytes received is counted so that a test or benchmark can wait for all its data to arrive.
+			 */
+			class TlsTestServer {
+			protected:
+				SSL_CTX *p_ssl_context_;
+				int listen_fd_;
+				bool is_echo_;
+				std::thread server_thread_;
+
+				void Serve();
+
+			public:
+				uint16_t port_;
+				std::atomic_size_t total_read_bytes_;
+
+				TlsTestServer(bool is_echo);
+
+				/**
+				 * @brief Start listening on an ephemeral loopback port and serve one client on a new thread
+				 *
+				 * @param identity - Certificate and key presented to the client
+				 * @return true if the server is listening, port_ is valid only in that case
+				 */
+				bool Start(SelfSignedIdentity &identity);
+
+				~TlsTestServer();
+			};
+		}
+	}
+}
+
+#endif
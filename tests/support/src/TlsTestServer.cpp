@@ -0,0 +1,164 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TlsTestServer.cpp
+ * @brief
+ *
+ */
+
+#if defined(__linux__) && !defined(USE_MBEDTLS)
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include "util/memory/stl/Vector.hpp"
+
+#include "TlsTestServer.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace support {
+			bool SelfSignedIdentity::Generate() {
+				EVP_PKEY_CTX *p_key_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+				if(nullptr == p_key_ctx || 0 >= EVP_PKEY_keygen_init(p_key_ctx)
+				   || 0 >= EVP_PKEY_CTX_set_ec_paramgen_curve_nid(p_key_ctx, NID_X9_62_prime256v1)
+				   || 0 >= EVP_PKEY_keygen(p_key_ctx, &p_key_)) {
+					EVP_PKEY_CTX_free(p_key_ctx);
+					return false;
+				}
+				EVP_PKEY_CTX_free(p_key_ctx);
+
+				p_cert_ = X509_new();
+				X509_set_version(p_cert_, 2);
+				ASN1_INTEGER_set(X509_get_serialNumber(p_cert_), 1);
+				X509_gmtime_adj(X509_getm_notBefore(p_cert_), -60);
+				X509_gmtime_adj(X509_getm_notAfter(p_cert_), 3600);
+				X509_set_pubkey(p_cert_, p_key_);
+				X509_NAME *p_name = X509_get_subject_name(p_cert_);
+				X509_NAME_add_entry_by_txt(p_name, "CN", MBSTRING_ASC,
+										   reinterpret_cast<const unsigned char *>("localhost"), -1, -1, 0);
+				X509_set_issuer_name(p_cert_, p_name);
+				if(0 >= X509_sign(p_cert_, p_key_, EVP_sha256())) {
+					return false;
+				}
+
+				char path_template[] = "/tmp/aws-iot-test-XXXXXX";
+				int fd = mkstemp(path_template);
+				if(0 > fd) {
+					return false;
+				}
+				FILE *p_file = fdopen(fd, "w");
+				if(nullptr == p_file) {
+					close(fd);
+					return false;
+				}
+				bool is_written = (0 < PEM_write_X509(p_file, p_cert_));
+				fclose(p_file);
+				cert_path_ = path_template;
+				return is_written;
+			}
+
+			SelfSignedIdentity::~SelfSignedIdentity() {
+				if(!cert_path_.empty()) {
+					unlink(cert_path_.c_str());
+				}
+				X509_free(p_cert_);
+				EVP_PKEY_free(p_key_);
+			}
+
+			TlsTestServer::TlsTestServer(bool is_echo) : p_ssl_context_(nullptr), listen_fd_(-1), is_echo_(is_echo),
+														 port_(0) {
+				total_read_bytes_ = 0;
+			}
+
+			void TlsTestServer::Serve() {
+				int client_fd = accept(listen_fd_, nullptr, nullptr);
+				if(0 > client_fd) {
+					return;
+				}
+				int flag = 1;
+				setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+				SSL *p_ssl = SSL_new(p_ssl_context_);
+				SSL_set_fd(p_ssl, client_fd);
+				if(1 == SSL_accept(p_ssl)) {
+					util::Vector<unsigned char> buf(16 * 1024);
+					int read_length;
+					while(0 < (read_length = SSL_read(p_ssl, buf.data(), static_cast<int>(buf.size())))) {
+						total_read_bytes_ += static_cast<size_t>(read_length);
+						if(is_echo_ && read_length != SSL_write(p_ssl, buf.data(), read_length)) {
+							break;
+						}
+					}
+				}
+				SSL_free(p_ssl);
+				close(client_fd);
+			}
+
+			bool TlsTestServer::Start(SelfSignedIdentity &identity) {
+				p_ssl_context_ = SSL_CTX_new(TLS_server_method());
+				if(nullptr == p_ssl_context_ || 1 != SSL_CTX_use_certificate(p_ssl_context_, identity.p_cert_)
+				   || 1 != SSL_CTX_use_PrivateKey(p_ssl_context_, identity.p_key_)) {
+					return false;
+				}
+
+				listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+				sockaddr_in addr;
+				memset(&addr, 0, sizeof(addr));
+				addr.sin_family = AF_INET;
+				addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+				addr.sin_port = 0;
+				socklen_t addr_length = sizeof(addr);
+				if(0 != bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr))
+				   || 0 != listen(listen_fd_, 1)
+				   || 0 != getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&addr), &addr_length)) {
+					return false;
+				}
+				port_ = ntohs(addr.sin_port);
+
+				server_thread_ = std::thread(&TlsTestServer::Serve, this);
+				return true;
+			}
+
+			TlsTestServer::~TlsTestServer() {
+				if(0 <= listen_fd_) {
+					// Unblocks accept if the client never connected
+					shutdown(listen_fd_, SHUT_RDWR);
+				}
+				if(server_thread_.joinable()) {
+					server_thread_.join();
+				}
+				if(0 <= listen_fd_) {
+					close(listen_fd_);
+				}
+				SSL_CTX_free(p_ssl_context_);
+			}
+		}
+	}
+}
+
+#endif
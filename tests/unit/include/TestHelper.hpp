@@ -93,6 +93,24 @@ namespace awsiotsdk {
 			static util::String GetSerializedUnsubAckMessage(uint16_t packet_id);
 			static util::String GetSerializedPubAckMessage(uint16_t packet_id);
 			static util::String GetSerializedConnAckMessage(bool is_session_present, ConnackTestReturnCode connack_rc);
+
+			/**
+			 * @brief Get the number of heap allocations made by the calling thread so far
+			 *
+			 * Counted by the global operator new replaced in the unit test binary
+			 *
+			 * @return Allocation count
+			 */
+			static size_t GetAllocationCount();
+
+			/**
+			 * @brief Get the number of heap allocations made by all threads of the process so far
+			 *
+			 * Used for paths that run on SDK threads, the caller has to make sure no other threads are allocating
+			 *
+			 * @return Allocation count
+			 */
+			static size_t GetProcessAllocationCount();
 		};
 	}
 }
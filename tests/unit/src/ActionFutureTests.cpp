@@ -0,0 +1,111 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ActionFutureTests.cpp
+ * @brief
+ *
+ */
+
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "ActionFuture.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			// Test futures that are not associated with a request and futures created ready
+			TEST(ActionFutureTester, ReadyAndInvalidFutures) {
+				ActionFuture invalid_future;
+				EXPECT_FALSE(invalid_future.IsValid());
+				EXPECT_FALSE(invalid_future.IsReady());
+				EXPECT_FALSE(invalid_future.WaitFor(std::chrono::milliseconds(1)));
+				EXPECT_EQ(ResponseCode::NULL_VALUE_ERROR, invalid_future.GetResponseCode());
+
+				ActionFuture ready_future = ActionFuture::CreateReady(ResponseCode::ACTION_QUEUE_FULL);
+				EXPECT_TRUE(ready_future.IsValid());
+				EXPECT_TRUE(ready_future.IsReady());
+				EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, ready_future.GetResponseCode());
+
+				util::Vector<ActionFuture> futures;
+				futures.push_back(invalid_future);
+				size_t ready_index = 0;
+				EXPECT_EQ(ResponseCode::NULL_VALUE_ERROR,
+						  ActionFuture::WaitAny(futures, std::chrono::milliseconds(1), ready_index));
+				EXPECT_EQ(ResponseCode::SUCCESS, ActionFuture::WaitAll(futures, std::chrono::milliseconds(1)));
+			}
+
+			// Test waiting for a batch of futures completed by another thread through their Ack handlers
+			TEST(ActionFutureTester, WaitAll) {
+				util::Vector<std::shared_ptr<ActionCompletion>> completions;
+				util::Vector<ActionFuture> futures;
+				for(uint16_t itr = 1; itr <= 100; itr++) {
+					std::shared_ptr<ActionCompletion> p_action_completion = ActionCompletion::Create();
+					completions.push_back(p_action_completion);
+					futures.push_back(ActionFuture(p_action_completion, itr));
+				}
+
+				EXPECT_EQ(ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR,
+						  ActionFuture::WaitAll(futures, std::chrono::milliseconds(10)));
+
+				std::thread ack_thread([&completions]() {
+					for(size_t itr = 0; itr < completions.size(); itr++) {
+						ActionCompletion::GetAckHandler(completions[itr])(static_cast<uint16_t>(itr + 1),
+																		  ResponseCode::SUCCESS);
+					}
+				});
+				EXPECT_EQ(ResponseCode::SUCCESS, ActionFuture::WaitAll(futures, std::chrono::milliseconds(5000)));
+				ack_thread.join();
+
+				for(size_t itr = 0; itr < futures.size(); itr++) {
+					EXPECT_TRUE(futures[itr].IsReady());
+					EXPECT_EQ(static_cast<uint16_t>(itr + 1), futures[itr].GetActionId());
+					EXPECT_EQ(ResponseCode::SUCCESS, futures[itr].GetResponseCode());
+				}
+			}
+
+			// Test waiting for any one of multiple futures
+			TEST(ActionFutureTester, WaitAny) {
+				util::Vector<std::shared_ptr<ActionCompletion>> completions;
+				util::Vector<ActionFuture> futures;
+				for(uint16_t itr = 1; itr <= 4; itr++) {
+					std::shared_ptr<ActionCompletion> p_action_completion = ActionCompletion::Create();
+					completions.push_back(p_action_completion);
+					futures.push_back(ActionFuture(p_action_completion, itr));
+				}
+
+				size_t ready_index = 0;
+				EXPECT_EQ(ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR,
+						  ActionFuture::WaitAny(futures, std::chrono::milliseconds(10), ready_index));
+
+				std::thread ack_thread([&completions]() {
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+					completions[2]->Complete(ResponseCode::MQTT_SUBSCRIBE_FAILED);
+				});
+				EXPECT_EQ(ResponseCode::SUCCESS,
+						  ActionFuture::WaitAny(futures, std::chrono::milliseconds(5000), ready_index));
+				ack_thread.join();
+				EXPECT_EQ(static_cast<size_t>(2), ready_index);
+				EXPECT_EQ(ResponseCode::MQTT_SUBSCRIBE_FAILED, futures[ready_index].GetResponseCode());
+
+				// Already complete futures are returned without waiting
+				completions[0]->Complete(ResponseCode::SUCCESS);
+				EXPECT_EQ(ResponseCode::SUCCESS, ActionFuture::WaitAny(futures, std::chrono::milliseconds(0), ready_index));
+				EXPECT_EQ(static_cast<size_t>(0), ready_index);
+			}
+		}
+	}
+}
@@ -20,6 +20,7 @@
  */
 
 #include <atomic>
+#include <thread>
 #include <gtest/gtest.h>
 
 #include "MockNetworkConnection.hpp"
@@ -35,11 +36,21 @@ namespace awsiotsdk {
 				public:
 					uint16_t action_id_;
 					std::atomic_int perform_action_count_;
+					std::atomic_int last_perform_order_;
+					bool is_ack_deferred_;
+					util::String write_buf_;
+					uint32_t packet_count_;
+					std::atomic<util::memory::MemoryResource *> p_perform_resource_;
 
 					uint16_t GetActionId() { return action_id_; }
 					void SetActionId(uint16_t action_id) { action_id_ = action_id; }
+					uint32_t GetPacketCount() { return packet_count_; }
 					TestActionData() {
+						packet_count_ = 1;
+						p_perform_resource_ = nullptr;
 						perform_action_count_ = 0;
+						last_perform_order_ = -1;
+						is_ack_deferred_ = false;
 					}
 				};
 
@@ -109,7 +120,24 @@ namespace awsiotsdk {
 				}
 
 				p_test_action_data->perform_action_count_++;
-				total_perform_action_call_count_++;
+				p_test_action_data->last_perform_order_ = total_perform_action_call_count_++;
+				p_test_action_data->p_perform_resource_ = util::memory::MemoryResource::GetDefaultResource();
+				if(!p_test_action_data->write_buf_.empty()) {
+					ResponseCode rc = WriteToNetworkBuffer(p_network_connection, p_test_action_data->write_buf_);
+					if(ResponseCode::SUCCESS != rc) {
+						return rc;
+					}
+					if(!p_test_action_data->is_ack_deferred_) {
+						// Like QoS0 publishes, requests that are written have no response
+						p_client_state_->ForwardWrittenAck(p_test_action_data->GetActionId(), p_network_connection);
+						return ResponseCode::SUCCESS;
+					}
+				}
+				if(p_test_action_data->is_ack_deferred_) {
+					// Ack is forwarded later by the test
+					return p_client_state_->RegisterPendingAck(p_test_action_data->GetActionId(),
+															   p_test_action_data->p_async_ack_handler_);
+				}
 				p_client_state_->ForwardReceivedAck(p_test_action_data->GetActionId(), ResponseCode::SUCCESS);
 				return ResponseCode::SUCCESS;
 			}
@@ -197,6 +225,56 @@ namespace awsiotsdk {
 				EXPECT_EQ(1, p_test_action_data->perform_action_count_);
 			}
 
+			// Test Sync Action execution from multiple threads, all requests should be in flight at the same time
+			// and each caller should receive the response for its own request
+			TEST_F(ClientCoreTester, ConcurrentSyncActions) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				const int sync_caller_count = 4;
+				TestAction::Reset();
+
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				util::Vector<std::shared_ptr<TestActionData>> action_data_list;
+				util::Vector<ResponseCode> rc_list(sync_caller_count, ResponseCode::FAILURE);
+				util::Vector<std::thread> sync_callers;
+				for(int itr = 0; itr < sync_caller_count; itr++) {
+					std::shared_ptr<TestActionData> p_test_action_data = std::make_shared<TestActionData>();
+					p_test_action_data->is_ack_deferred_ = true;
+					action_data_list.push_back(p_test_action_data);
+					sync_callers.push_back(std::thread([this, p_test_action_data, &rc_list, itr]() {
+						rc_list[itr] = p_client_core_->PerformAction(ActionType::RESERVED_ACTION, p_test_action_data,
+																	 std::chrono::milliseconds(2000));
+					}));
+				}
+
+				for(size_t itr = 0; itr < 100; itr++) {
+					if(sync_caller_count == TestAction::total_perform_action_call_count_) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				EXPECT_EQ(sync_caller_count, TestAction::total_perform_action_call_count_);
+
+				// Respond in reverse order with a distinct response for one of the requests
+				for(int itr = sync_caller_count - 1; itr >= 0; itr--) {
+					uint16_t action_id = action_data_list[itr]->GetActionId();
+					EXPECT_TRUE(p_core_state_->IsAckPending(action_id));
+					p_core_state_->ForwardReceivedAck(action_id, (0 == itr) ? ResponseCode::MQTT_SUBSCRIBE_FAILED
+																			 : ResponseCode::SUCCESS);
+				}
+
+				for(std::thread &sync_caller : sync_callers) {
+					sync_caller.join();
+				}
+				EXPECT_EQ(ResponseCode::MQTT_SUBSCRIBE_FAILED, rc_list[0]);
+				for(int itr = 1; itr < sync_caller_count; itr++) {
+					EXPECT_EQ(ResponseCode::SUCCESS, rc_list[itr]);
+				}
+			}
+
 			// Test Async Action Execution  - Action not registered
 			TEST_F(ClientCoreTester, TestAsyncFailOnUnregistered) {
 				EXPECT_NE(nullptr, p_client_core_);
@@ -339,6 +417,610 @@ namespace awsiotsdk {
 				p_core_state_->SetMaxActionQueueSize(cur_max_queue_size);
 			}
 
+			// Test Action processing rate limit, queued actions should not be processed faster than the configured rate
+			TEST_F(ClientCoreTester, ActionProcessingRateLimit) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				uint16_t action_id = 0;
+
+				TestAction::Reset();
+				EXPECT_EQ(static_cast<uint32_t>(0), p_core_state_->GetActionProcessingRate());
+
+				p_core_state_->SetActionProcessingRate(10);
+				EXPECT_EQ(static_cast<uint32_t>(10), p_core_state_->GetActionProcessingRate());
+				p_client_core_->SetProcessQueuedActions(true);
+
+				std::shared_ptr<TestActionData> p_test_action_data = std::make_shared<TestActionData>();
+
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				for(size_t itr = 0; itr < 3; itr++) {
+					rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_test_action_data, action_id);
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				}
+
+				for(size_t itr = 0; itr < 50; itr++) {
+					if(3 == p_test_action_data->perform_action_count_) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+						std::chrono::steady_clock::now() - start);
+				EXPECT_EQ(3, p_test_action_data->perform_action_count_);
+				// Third action can only be performed after two full rate limit intervals
+				EXPECT_LE(200, elapsed.count());
+
+				p_core_state_->SetActionProcessingRate(0);
+			}
+
+			// Test priority lanes, Control actions should be performed first followed by High priority actions,
+			// with a Normal priority action after every HIGH_PRIORITY_ACTION_DRAIN_WEIGHT High priority actions
+			TEST_F(ClientCoreTester, ActionPriorityLanes) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				uint16_t action_id = 0;
+
+				TestAction::Reset();
+				p_client_core_->SetProcessQueuedActions(false);
+
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::shared_ptr<TestActionData> p_normal_action_data = std::make_shared<TestActionData>();
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_normal_action_data,
+														ActionPriority::NORMAL, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				util::Vector<std::shared_ptr<TestActionData>> high_action_data_list;
+				for(size_t itr = 0; itr <= HIGH_PRIORITY_ACTION_DRAIN_WEIGHT; itr++) {
+					std::shared_ptr<TestActionData> p_high_action_data = std::make_shared<TestActionData>();
+					rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_high_action_data,
+															ActionPriority::HIGH, action_id);
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+					high_action_data_list.push_back(p_high_action_data);
+				}
+
+				std::shared_ptr<TestActionData> p_control_action_data = std::make_shared<TestActionData>();
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_control_action_data,
+														ActionPriority::CONTROL, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				int total_action_count = HIGH_PRIORITY_ACTION_DRAIN_WEIGHT + 3;
+				p_client_core_->SetProcessQueuedActions(true);
+				for(size_t itr = 0; itr < 50; itr++) {
+					if(total_action_count == TestAction::total_perform_action_call_count_) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				EXPECT_EQ(total_action_count, TestAction::total_perform_action_call_count_);
+
+				EXPECT_EQ(0, p_control_action_data->last_perform_order_);
+				for(int itr = 0; itr < HIGH_PRIORITY_ACTION_DRAIN_WEIGHT; itr++) {
+					EXPECT_EQ(itr + 1, high_action_data_list[itr]->last_perform_order_);
+				}
+				EXPECT_EQ(HIGH_PRIORITY_ACTION_DRAIN_WEIGHT + 1, p_normal_action_data->last_perform_order_);
+				EXPECT_EQ(HIGH_PRIORITY_ACTION_DRAIN_WEIGHT + 2,
+						  high_action_data_list[HIGH_PRIORITY_ACTION_DRAIN_WEIGHT]->last_perform_order_);
+			}
+
+			// Test write coalescing, actions queued back to back should share a single network write
+			// and Action Types that are not coalescable should not be coalesced
+			TEST_F(ClientCoreTester, WriteCoalescing) {
+				tests::mocks::MockNetworkConnection *p_network_mock
+						= dynamic_cast<tests::mocks::MockNetworkConnection *>(p_core_state_->p_network_connection_.get());
+				EXPECT_NE(nullptr, p_network_mock);
+				// Registered Actions keep the Client state and with it the connection alive after the test
+				::testing::Mock::AllowLeak(p_network_mock);
+				EXPECT_CALL(*p_network_mock, IsConnected()).WillRepeatedly(::testing::Return(true));
+
+				TestAction::Reset();
+				p_client_core_->SetProcessQueuedActions(false);
+				EXPECT_EQ(static_cast<size_t>(DEFAULT_WRITE_COALESCING_MAX_BYTES), p_core_state_->GetWriteCoalescingMaxBytes());
+				p_core_state_->SetWriteCoalescing(1024, std::chrono::microseconds(1000000));
+
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::PUBLISH, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				uint16_t action_id = 0;
+				util::String expected_buf;
+				for(int itr = 0; itr < 4; itr++) {
+					std::shared_ptr<TestActionData> p_action_data = std::make_shared<TestActionData>();
+					p_action_data->write_buf_ = "publish_" + util::ToString(itr);
+					expected_buf.append(p_action_data->write_buf_);
+					rc = p_client_core_->PerformActionAsync(ActionType::PUBLISH, p_action_data, action_id);
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				}
+
+				EXPECT_CALL(*p_network_mock, WriteInternalProxy(expected_buf, ::testing::_)).WillOnce(
+						::testing::DoAll(::testing::SetArgReferee<1>(expected_buf.length()),
+										 ::testing::Return(ResponseCode::SUCCESS)));
+				p_client_core_->SetProcessQueuedActions(true);
+				for(size_t itr = 0; itr < 50; itr++) {
+					if(expected_buf == p_network_mock->last_write_buf_) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				EXPECT_EQ(4, TestAction::total_perform_action_call_count_);
+				EXPECT_EQ(expected_buf, p_network_mock->last_write_buf_);
+				::testing::Mock::VerifyAndClearExpectations(p_network_mock);
+			}
+
+			// Test coalesced actions without a response are completed with the result of the write, not before it
+			TEST_F(ClientCoreTester, WriteCoalescingCompletesWrittenActionsOnFlush) {
+				tests::mocks::MockNetworkConnection *p_network_mock
+						= dynamic_cast<tests::mocks::MockNetworkConnection *>(p_core_state_->p_network_connection_.get());
+				EXPECT_NE(nullptr, p_network_mock);
+				// Registered Actions keep the Client state and with it the connection alive after the test
+				::testing::Mock::AllowLeak(p_network_mock);
+				EXPECT_CALL(*p_network_mock, IsConnected()).WillRepeatedly(::testing::Return(true));
+
+				TestAction::Reset();
+				p_client_core_->SetProcessQueuedActions(false);
+				p_core_state_->SetWriteCoalescing(1024, std::chrono::microseconds(1000000));
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::PUBLISH, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::mutex ack_rc_lock;
+				util::Vector<ResponseCode> ack_rc_list;
+				ActionData::AsyncAckNotificationHandlerPtr p_ack_handler = [&ack_rc_lock, &ack_rc_list](uint16_t action_id, ResponseCode ack_rc) {
+					IOT_UNUSED(action_id);
+					std::lock_guard<std::mutex> ack_lock(ack_rc_lock);
+					ack_rc_list.push_back(ack_rc);
+				};
+
+				for(ResponseCode write_rc : {ResponseCode::SUCCESS, ResponseCode::NETWORK_SSL_WRITE_ERROR}) {
+					{
+						std::lock_guard<std::mutex> ack_lock(ack_rc_lock);
+						ack_rc_list.clear();
+					}
+					uint16_t action_id = 0;
+					util::String expected_buf;
+					for(int itr = 0; itr < 2; itr++) {
+						std::shared_ptr<TestActionData> p_action_data = std::make_shared<TestActionData>();
+						p_action_data->write_buf_ = "publish_" + util::ToString(itr);
+						p_action_data->p_async_ack_handler_ = p_ack_handler;
+						expected_buf.append(p_action_data->write_buf_);
+						rc = p_client_core_->PerformActionAsync(ActionType::PUBLISH, p_action_data, action_id);
+						EXPECT_EQ(ResponseCode::SUCCESS, rc);
+					}
+
+					size_t ack_count_at_write = 0;
+					EXPECT_CALL(*p_network_mock, WriteInternalProxy(expected_buf, ::testing::_)).WillOnce(
+							::testing::DoAll(::testing::Invoke([&ack_rc_lock, &ack_rc_list, &ack_count_at_write](const util::String &buf, size_t &size_written_bytes_out) {
+												 std::lock_guard<std::mutex> ack_lock(ack_rc_lock);
+												 ack_count_at_write = ack_rc_list.size();
+											 }),
+											 ::testing::SetArgReferee<1>(ResponseCode::SUCCESS == write_rc ? expected_buf.length() : 0),
+											 ::testing::Return(write_rc)));
+					p_client_core_->SetProcessQueuedActions(true);
+					for(size_t itr = 0; itr < 50; itr++) {
+						{
+							std::lock_guard<std::mutex> ack_lock(ack_rc_lock);
+							if(2 == ack_rc_list.size()) {
+								break;
+							}
+						}
+						std::this_thread::sleep_for(std::chrono::milliseconds(10));
+					}
+					p_client_core_->SetProcessQueuedActions(false);
+
+					std::lock_guard<std::mutex> ack_lock(ack_rc_lock);
+					EXPECT_EQ(static_cast<size_t>(0), ack_count_at_write);
+					EXPECT_EQ(static_cast<size_t>(2), ack_rc_list.size());
+					for(ResponseCode ack_rc : ack_rc_list) {
+						EXPECT_EQ(write_rc, ack_rc);
+					}
+					::testing::Mock::VerifyAndClearExpectations(p_network_mock);
+					EXPECT_CALL(*p_network_mock, IsConnected()).WillRepeatedly(::testing::Return(true));
+				}
+			}
+
+			// Test drop oldest overflow policy, Normal priority actions should be dropped first and
+			// Control actions should never be dropped
+			TEST_F(ClientCoreTester, ActionQueueOverflowDropOldest) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				uint16_t action_id = 0;
+				util::Vector<ResponseCode> drop_rc_list;
+				util::Vector<ResponseCode> ack_rc_list;
+
+				p_client_core_->SetProcessQueuedActions(false);
+				p_core_state_->SetMaxActionQueueSize(2);
+				p_core_state_->SetActionQueueOverflowPolicy(ActionQueueOverflowPolicy::DROP_OLDEST_NORMAL_PRIORITY_FIRST,
+															std::chrono::milliseconds(0));
+				p_core_state_->SetActionDropHandler([&drop_rc_list](ActionType action_type,
+																	std::shared_ptr<ActionData> p_action_data,
+																	ResponseCode rc) {
+					drop_rc_list.push_back(rc);
+				});
+
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::shared_ptr<TestActionData> p_normal_action_data = std::make_shared<TestActionData>();
+				p_normal_action_data->p_async_ack_handler_ = [&ack_rc_list](uint16_t action_id, ResponseCode rc) {
+					ack_rc_list.push_back(rc);
+				};
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_normal_action_data,
+														ActionPriority::NORMAL, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, std::make_shared<TestActionData>(),
+														ActionPriority::HIGH, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				// Queue is full, Normal priority action is dropped even though the High priority action is newer
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, std::make_shared<TestActionData>(),
+														ActionPriority::CONTROL, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_EQ(static_cast<size_t>(1), ack_rc_list.size());
+				EXPECT_EQ(ResponseCode::ACTION_DROPPED, ack_rc_list[0]);
+
+				// High priority action is dropped next
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, std::make_shared<TestActionData>(),
+														ActionPriority::CONTROL, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				// Only Control actions are queued, new action is rejected
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, std::make_shared<TestActionData>(),
+														ActionPriority::NORMAL, action_id);
+				EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, rc);
+
+				EXPECT_EQ(static_cast<size_t>(3), p_core_state_->GetDroppedActionCount());
+				EXPECT_EQ(static_cast<size_t>(3), drop_rc_list.size());
+				EXPECT_EQ(ResponseCode::ACTION_DROPPED, drop_rc_list[0]);
+				EXPECT_EQ(ResponseCode::ACTION_DROPPED, drop_rc_list[1]);
+				EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, drop_rc_list[2]);
+
+				p_core_state_->SetActionDropHandler(nullptr);
+			}
+
+			// Test block with timeout overflow policy, data action producer should time out if no space is freed up
+			// and should succeed once the outbound thread processes queued actions
+			TEST_F(ClientCoreTester, ActionQueueOverflowBlockWithTimeout) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				uint16_t action_id = 0;
+
+				TestAction::Reset();
+				p_client_core_->SetProcessQueuedActions(false);
+				p_core_state_->SetMaxActionQueueSize(1);
+				p_core_state_->SetActionQueueOverflowPolicy(ActionQueueOverflowPolicy::BLOCK_WITH_TIMEOUT,
+															std::chrono::milliseconds(100));
+
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::shared_ptr<TestActionData> p_test_action_data = std::make_shared<TestActionData>();
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_test_action_data,
+														ActionPriority::NORMAL, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_test_action_data,
+														ActionPriority::NORMAL, action_id);
+				std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+						std::chrono::steady_clock::now() - start);
+				EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, rc);
+				EXPECT_LE(100, elapsed.count());
+				EXPECT_EQ(static_cast<size_t>(1), p_core_state_->GetDroppedActionCount());
+
+				// Free up space while the producer is blocked
+				std::thread enable_processing_thread([this]() {
+					std::this_thread::sleep_for(std::chrono::milliseconds(20));
+					p_client_core_->SetProcessQueuedActions(true);
+				});
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_test_action_data,
+														ActionPriority::NORMAL, action_id);
+				enable_processing_thread.join();
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				for(size_t itr = 0; itr < 50; itr++) {
+					if(2 == p_test_action_data->perform_action_count_) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				EXPECT_EQ(2, p_test_action_data->perform_action_count_);
+			}
+
+			// Test Control actions with the block with timeout overflow policy, they should be queued past the max
+			// queue size right away instead of blocking the caller, which can be the thread draining the queue
+			TEST_F(ClientCoreTester, ActionQueueOverflowControlNeverBlocks) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				uint16_t action_id = 0;
+
+				TestAction::Reset();
+				p_client_core_->SetProcessQueuedActions(false);
+				p_core_state_->SetMaxActionQueueSize(1);
+				p_core_state_->SetActionQueueOverflowPolicy(ActionQueueOverflowPolicy::BLOCK_WITH_TIMEOUT,
+															std::chrono::milliseconds(500));
+
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::shared_ptr<TestActionData> p_normal_action_data = std::make_shared<TestActionData>();
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_normal_action_data,
+														ActionPriority::NORMAL, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::shared_ptr<TestActionData> p_control_action_data = std::make_shared<TestActionData>();
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				for(size_t itr = 0; itr < 3; itr++) {
+					rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_control_action_data,
+															ActionPriority::CONTROL, action_id);
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				}
+				std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+						std::chrono::steady_clock::now() - start);
+				EXPECT_GT(100, elapsed.count());
+				EXPECT_EQ(static_cast<size_t>(0), p_core_state_->GetDroppedActionCount());
+
+				// Data actions are still limited while the Control actions are queued
+				p_core_state_->SetActionQueueOverflowPolicy(ActionQueueOverflowPolicy::REJECT,
+															std::chrono::milliseconds(0));
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_normal_action_data,
+														ActionPriority::NORMAL, action_id);
+				EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, rc);
+
+				p_client_core_->SetProcessQueuedActions(true);
+				for(size_t itr = 0; itr < 50; itr++) {
+					if(3 == p_control_action_data->perform_action_count_
+					   && 1 == p_normal_action_data->perform_action_count_) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				EXPECT_EQ(3, p_control_action_data->perform_action_count_);
+				EXPECT_EQ(1, p_normal_action_data->perform_action_count_);
+
+				// All slots, including the ones past the limit, are released
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_normal_action_data,
+														ActionPriority::NORMAL, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+			}
+
+			// Test that Control actions queued past the max queue size are limited to the lane capacity, the action
+			// that does not fit is reported as dropped
+			TEST_F(ClientCoreTester, ActionQueueOverflowControlLimitedToLaneCapacity) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				uint16_t action_id = 0;
+				util::Vector<ResponseCode> drop_rc_list;
+
+				TestAction::Reset();
+				p_client_core_->SetProcessQueuedActions(false);
+				p_core_state_->SetMaxActionQueueSize(1);
+				p_core_state_->SetActionQueueOverflowPolicy(ActionQueueOverflowPolicy::BLOCK_WITH_TIMEOUT,
+															std::chrono::milliseconds(500));
+				p_core_state_->SetActionDropHandler([&drop_rc_list](ActionType action_type,
+																	std::shared_ptr<ActionData> p_action_data,
+																	ResponseCode rc) {
+					drop_rc_list.push_back(rc);
+				});
+
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::shared_ptr<TestActionData> p_control_action_data = std::make_shared<TestActionData>();
+				for(size_t itr = 0; itr < MAX_ACTION_QUEUE_CAPACITY; itr++) {
+					rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_control_action_data,
+															ActionPriority::CONTROL, action_id);
+					ASSERT_EQ(ResponseCode::SUCCESS, rc);
+				}
+				EXPECT_TRUE(drop_rc_list.empty());
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_control_action_data,
+														ActionPriority::CONTROL, action_id);
+				std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+						std::chrono::steady_clock::now() - start);
+				EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, rc);
+				EXPECT_GT(100, elapsed.count());
+				EXPECT_EQ(static_cast<size_t>(1), p_core_state_->GetDroppedActionCount());
+				ASSERT_EQ(static_cast<size_t>(1), drop_rc_list.size());
+				EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL, drop_rc_list[0]);
+
+				p_client_core_->SetProcessQueuedActions(true);
+				for(size_t itr = 0; itr < 100; itr++) {
+					if(MAX_ACTION_QUEUE_CAPACITY == p_control_action_data->perform_action_count_) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				EXPECT_EQ(MAX_ACTION_QUEUE_CAPACITY, p_control_action_data->perform_action_count_);
+				p_core_state_->SetActionDropHandler(nullptr);
+			}
+
+			// Test pending Ack expiry, outbound thread should call the handler with a timeout response
+			TEST_F(ClientCoreTester, PendingAckTimeout) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				std::atomic_int handler_call_count(0);
+				ResponseCode handler_rc = ResponseCode::SUCCESS;
+				ActionData::AsyncAckNotificationHandlerPtr p_async_ack_handler
+						= [&handler_call_count, &handler_rc](uint16_t action_id, ResponseCode rc) {
+							handler_rc = rc;
+							handler_call_count++;
+						};
+
+				p_core_state_->SetAckTimeout(std::chrono::milliseconds(50));
+				ResponseCode rc = p_core_state_->RegisterPendingAck(10, p_async_ack_handler);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				rc = p_core_state_->RegisterPendingAck(11, p_async_ack_handler);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_TRUE(p_core_state_->IsAckPending(10));
+
+				p_core_state_->ForwardReceivedAck(11, ResponseCode::SUCCESS);
+				EXPECT_EQ(1, handler_call_count);
+				EXPECT_EQ(ResponseCode::SUCCESS, handler_rc);
+
+				for(size_t itr = 0; itr < 50; itr++) {
+					if(2 == handler_call_count) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				EXPECT_EQ(2, handler_call_count);
+				EXPECT_EQ(ResponseCode::MQTT_REQUEST_TIMEOUT_ERROR, handler_rc);
+				EXPECT_FALSE(p_core_state_->IsAckPending(10));
+			}
+
+			// Test per Action Type rate limit, actions over the limit should be deferred without
+			// holding up actions of other types
+			TEST_F(ClientCoreTester, ActionRateLimitPerType) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				uint16_t action_id = 0;
+
+				TestAction::Reset();
+				ResponseCode rc = p_core_state_->SetActionRateLimit(ActionType::RESERVED_ACTION, 10, 2);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				p_client_core_->SetProcessQueuedActions(true);
+
+				std::shared_ptr<TestActionData> p_limited_action_data = std::make_shared<TestActionData>();
+				std::shared_ptr<TestActionData> p_unlimited_action_data = std::make_shared<TestActionData>();
+
+				rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				rc = p_client_core_->RegisterAction(ActionType::PUBACK, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				for(size_t itr = 0; itr < 4; itr++) {
+					rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_limited_action_data, action_id);
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				}
+				rc = p_client_core_->PerformActionAsync(ActionType::PUBACK, p_unlimited_action_data, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				// Burst is performed right away, unlimited action should not wait for the rest
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				EXPECT_EQ(1, p_unlimited_action_data->perform_action_count_);
+				EXPECT_EQ(2, p_limited_action_data->perform_action_count_);
+
+				for(size_t itr = 0; itr < 50; itr++) {
+					if(4 == p_limited_action_data->perform_action_count_) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+						std::chrono::steady_clock::now() - start);
+				EXPECT_EQ(4, p_limited_action_data->perform_action_count_);
+				// Last action can only be performed after two tokens have been refilled
+				EXPECT_LE(180, elapsed.count());
+
+				rc = p_core_state_->SetActionRateLimit(ActionType::RESERVED_ACTION, 0, 0);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+			}
+
+			// Test Publish rate limit with batches, each packet in a batch should take a Publish token so that a
+			// Publish queued after a batch that used up the burst has to wait for a refill
+			TEST_F(ClientCoreTester, PublishBatchTakesPublishTokens) {
+				EXPECT_NE(nullptr, p_client_core_);
+				EXPECT_NE(nullptr, p_core_state_);
+
+				uint16_t action_id = 0;
+
+				TestAction::Reset();
+				ResponseCode rc = p_core_state_->SetActionRateLimit(ActionType::PUBLISH, 10, 4);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				p_client_core_->SetProcessQueuedActions(true);
+
+				std::shared_ptr<TestActionData> p_batch_action_data = std::make_shared<TestActionData>();
+				p_batch_action_data->packet_count_ = 4;
+				std::shared_ptr<TestActionData> p_publish_action_data = std::make_shared<TestActionData>();
+
+				rc = p_client_core_->RegisterAction(ActionType::PUBLISH_BATCH, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				rc = p_client_core_->RegisterAction(ActionType::PUBLISH, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				rc = p_client_core_->PerformActionAsync(ActionType::PUBLISH_BATCH, p_batch_action_data, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				rc = p_client_core_->PerformActionAsync(ActionType::PUBLISH, p_publish_action_data, action_id);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				// Batch fits in the burst, it leaves no token for the Publish
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				EXPECT_EQ(1, p_batch_action_data->perform_action_count_);
+				EXPECT_EQ(0, p_publish_action_data->perform_action_count_);
+
+				for(size_t itr = 0; itr < 50; itr++) {
+					if(1 == p_publish_action_data->perform_action_count_) {
+						break;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+				std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+						std::chrono::steady_clock::now() - start);
+				EXPECT_EQ(1, p_publish_action_data->perform_action_count_);
+				EXPECT_LE(90, elapsed.count());
+
+				rc = p_core_state_->SetActionRateLimit(ActionType::PUBLISH, 0, 0);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+			}
+
+			// Test queued actions are performed with the memory resource of the client as the thread default
+			TEST_F(ClientCoreTester, ActionsUseClientMemoryResource) {
+				class TestMemoryResource : public util::memory::MemoryResource {
+				protected:
+					void *DoAllocate(std::size_t bytes, std::size_t alignment) { return ::operator new(bytes); }
+					void DoDeallocate(void *p, std::size_t bytes, std::size_t alignment) { ::operator delete(p); }
+					bool DoIsEqual(const MemoryResource &other) const { return false; }
+				} resource;
+
+				std::shared_ptr<ClientCoreState> p_core_state = std::make_shared<ClientCoreState>();
+				p_core_state->p_memory_resource_ = &resource;
+				std::shared_ptr<NetworkConnection> p_network_connection = std::make_shared<tests::mocks::MockNetworkConnection>();
+				std::unique_ptr<ClientCore> p_client_core = ClientCore::Create(p_network_connection, p_core_state);
+				ASSERT_NE(nullptr, p_client_core);
+
+				TestAction::Reset();
+				std::shared_ptr<TestActionData> p_test_action_data[2] = {std::make_shared<TestActionData>(),
+																		 std::make_shared<TestActionData>()};
+				ClientCore *p_client_cores[2] = {p_client_core.get(), p_client_core_.get()};
+				std::atomic_int ack_count(0);
+				for(size_t itr = 0; itr < 2; itr++) {
+					EXPECT_EQ(ResponseCode::SUCCESS, p_client_cores[itr]->RegisterAction(ActionType::RESERVED_ACTION,
+																						  TestAction::Create));
+					p_client_cores[itr]->SetProcessQueuedActions(true);
+					p_test_action_data[itr]->p_async_ack_handler_ = [&ack_count](uint16_t action_id, ResponseCode rc) {
+						if(ResponseCode::SUCCESS == rc) {
+							ack_count++;
+						}
+					};
+					uint16_t action_id = 0;
+					EXPECT_EQ(ResponseCode::SUCCESS, p_client_cores[itr]->PerformActionAsync(
+						ActionType::RESERVED_ACTION, p_test_action_data[itr], action_id));
+				}
+
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+				while(2 > ack_count && std::chrono::steady_clock::now() < deadline) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				EXPECT_EQ(2, ack_count);
+				EXPECT_EQ(&resource, p_test_action_data[0]->p_perform_resource_.load());
+				// Clients without a resource keep using the process default
+				EXPECT_EQ(util::memory::MemoryResource::GetNewDeleteResource(), p_test_action_data[1]->p_perform_resource_.load());
+				p_client_core.reset();
+			}
+
 			// Test creation of action thread runner, thread should execute successfully,
 			// Action instance count is incremented, Action instance count decremented on thread destroy
 			TEST_F(ClientCoreTester, ActionRunner) {
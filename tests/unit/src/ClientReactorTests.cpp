@@ -0,0 +1,285 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file ClientReactorTests.cpp
+ * @brief
+ *
+ */
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "MockNetworkConnection.hpp"
+
+#include "ClientCore.hpp"
+#include "ClientReactor.hpp"
+
+#ifdef __linux__
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			class ClientReactorTester : public ::testing::Test {
+			protected:
+				class TestActionData : public ActionData {
+				public:
+					uint16_t action_id_;
+
+					uint16_t GetActionId() { return action_id_; }
+					void SetActionId(uint16_t action_id) { action_id_ = action_id; }
+					TestActionData() : action_id_(0) { }
+				};
+
+				class TestAction : public Action {
+				protected:
+					std::shared_ptr<ClientCoreState> p_client_state_;
+
+				public:
+					static std::atomic_int cur_instance_count_;
+					static std::atomic_int perform_action_count_;
+					static std::atomic_int perform_step_count_;
+					static std::atomic_bool is_performed_on_caller_thread_;
+					static std::atomic<util::memory::MemoryResource *> p_step_resource_;
+					static std::thread::id caller_thread_id_;
+					static std::function<void()> step_handler_;
+
+					TestAction(std::shared_ptr<ClientCoreState> p_client_state) : Action(ActionType::RESERVED_ACTION, "Test Action") {
+						p_client_state_ = p_client_state;
+						cur_instance_count_++;
+					}
+
+					~TestAction() {
+						cur_instance_count_--;
+					}
+
+					static std::unique_ptr<Action> Create(std::shared_ptr<ActionState> p_action_state) {
+						std::shared_ptr<ClientCoreState> p_client_state = std::dynamic_pointer_cast<ClientCoreState>(p_action_state);
+						if(nullptr == p_client_state) {
+							return nullptr;
+						}
+						return std::unique_ptr<Action>(new TestAction(p_client_state));
+					}
+
+					ResponseCode PerformAction(std::shared_ptr<NetworkConnection> p_network_connection,
+											   std::shared_ptr<ActionData> p_action_data) {
+						IOT_UNUSED(p_network_connection);
+						perform_action_count_++;
+						if(std::this_thread::get_id() == caller_thread_id_) {
+							is_performed_on_caller_thread_ = true;
+						}
+						p_client_state_->ForwardReceivedAck(p_action_data->GetActionId(), ResponseCode::SUCCESS);
+						return ResponseCode::SUCCESS;
+					}
+
+					ResponseCode PerformStep(std::shared_ptr<NetworkConnection> p_network_connection,
+											 std::chrono::steady_clock::time_point &next_step_time_out) {
+						IOT_UNUSED(p_network_connection);
+						perform_step_count_++;
+						p_step_resource_ = util::memory::MemoryResource::GetDefaultResource();
+						if(step_handler_) {
+							step_handler_();
+						}
+						next_step_time_out = std::chrono::steady_clock::now() + std::chrono::milliseconds(5);
+						return ResponseCode::SUCCESS;
+					}
+
+					static void Reset() {
+						cur_instance_count_ = 0;
+						perform_action_count_ = 0;
+						perform_step_count_ = 0;
+						is_performed_on_caller_thread_ = false;
+						p_step_resource_ = nullptr;
+						caller_thread_id_ = std::this_thread::get_id();
+						step_handler_ = nullptr;
+					}
+				};
+
+				std::shared_ptr<ClientReactor> p_client_reactor_;
+				std::shared_ptr<ClientCoreState> p_core_state_;
+				std::unique_ptr<ClientCore> p_client_core_;
+
+				ClientReactorTester() {
+					p_client_reactor_ = ClientReactor::Create(1);
+					p_core_state_ = std::make_shared<ClientCoreState>();
+					std::shared_ptr<NetworkConnection> p_network_connection = std::make_shared<tests::mocks::MockNetworkConnection>();
+					p_client_core_ = ClientCore::Create(p_network_connection, p_core_state_, p_client_reactor_);
+				}
+			};
+
+			std::atomic_int ClientReactorTester::TestAction::cur_instance_count_(0);
+			std::atomic_int ClientReactorTester::TestAction::perform_action_count_(0);
+			std::atomic_int ClientReactorTester::TestAction::perform_step_count_(0);
+			std::atomic_bool ClientReactorTester::TestAction::is_performed_on_caller_thread_(false);
+			std::atomic<util::memory::MemoryResource *> ClientReactorTester::TestAction::p_step_resource_(nullptr);
+			std::thread::id ClientReactorTester::TestAction::caller_thread_id_;
+			std::function<void()> ClientReactorTester::TestAction::step_handler_;
+
+			// Test Client Reactor create, should fail without event loop threads
+			TEST(ClientReactorCreateTester, CreateFailed) {
+				EXPECT_EQ(nullptr, ClientReactor::Create(0));
+
+				std::shared_ptr<ClientCoreState> p_core_state = std::make_shared<ClientCoreState>();
+				std::shared_ptr<NetworkConnection> p_network_connection = std::make_shared<tests::mocks::MockNetworkConnection>();
+				EXPECT_EQ(nullptr, ClientCore::Create(p_network_connection, p_core_state, nullptr));
+			}
+
+			// Test queued actions are performed by the event loop thread, and the Ack handler is called
+			TEST_F(ClientReactorTester, QueuedActionPerformedByEventLoop) {
+				ASSERT_NE(nullptr, p_client_reactor_);
+				ASSERT_NE(nullptr, p_client_core_);
+				EXPECT_EQ(1u, p_client_reactor_->GetThreadCount());
+
+				TestAction::Reset();
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				p_client_core_->SetProcessQueuedActions(true);
+
+				std::atomic_int ack_count(0);
+				uint16_t action_id = 0;
+				for(int itr = 0; itr < 10; itr++) {
+					std::shared_ptr<TestActionData> p_test_action_data = std::make_shared<TestActionData>();
+					p_test_action_data->p_async_ack_handler_ = [&ack_count](uint16_t ack_action_id, ResponseCode ack_rc) {
+						IOT_UNUSED(ack_action_id);
+						if(ResponseCode::SUCCESS == ack_rc) {
+							ack_count++;
+						}
+					};
+					rc = p_client_core_->PerformActionAsync(ActionType::RESERVED_ACTION, p_test_action_data, action_id);
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				}
+
+				// Enqueue wakes up the event loop, this should not take anywhere near the timer interval
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+				while(10 > ack_count && std::chrono::steady_clock::now() < deadline) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				EXPECT_EQ(10, ack_count);
+				EXPECT_EQ(10, TestAction::perform_action_count_);
+				EXPECT_FALSE(TestAction::is_performed_on_caller_thread_);
+			}
+
+			// Test Action runners are performed in steps and destroyed with the client
+			TEST_F(ClientReactorTester, ActionRunnerPerformedInSteps) {
+				ASSERT_NE(nullptr, p_client_reactor_);
+				ASSERT_NE(nullptr, p_client_core_);
+
+				TestAction::Reset();
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				rc = p_client_core_->CreateActionRunner(ActionType::RESERVED_ACTION, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+				while(3 > TestAction::perform_step_count_ && std::chrono::steady_clock::now() < deadline) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				EXPECT_LE(3, TestAction::perform_step_count_);
+				EXPECT_EQ(0, TestAction::perform_action_count_);
+				// One instance is registered with the client state, the other is the runner
+				EXPECT_EQ(2, TestAction::cur_instance_count_);
+
+				p_client_core_.reset();
+				EXPECT_EQ(1, TestAction::cur_instance_count_);
+				int step_count = TestAction::perform_step_count_;
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				EXPECT_EQ(step_count, TestAction::perform_step_count_);
+			}
+
+			// Test the event loop thread uses the memory resource of the client while performing its steps
+			TEST_F(ClientReactorTester, ActionRunnerUsesClientMemoryResource) {
+				class TestMemoryResource : public util::memory::MemoryResource {
+				protected:
+					void *DoAllocate(std::size_t bytes, std::size_t alignment) { return ::operator new(bytes); }
+					void DoDeallocate(void *p, std::size_t bytes, std::size_t alignment) { ::operator delete(p); }
+					bool DoIsEqual(const MemoryResource &other) const { return false; }
+				} resource;
+
+				// Replaces the client of the fixture on the same event loop thread
+				p_client_core_.reset();
+				p_core_state_ = std::make_shared<ClientCoreState>();
+				p_core_state_->p_memory_resource_ = &resource;
+				std::shared_ptr<NetworkConnection> p_network_connection = std::make_shared<tests::mocks::MockNetworkConnection>();
+				p_client_core_ = ClientCore::Create(p_network_connection, p_core_state_, p_client_reactor_);
+				ASSERT_NE(nullptr, p_client_core_);
+
+				TestAction::Reset();
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				rc = p_client_core_->CreateActionRunner(ActionType::RESERVED_ACTION, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+				while(1 > TestAction::perform_step_count_ && std::chrono::steady_clock::now() < deadline) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				EXPECT_LE(1, TestAction::perform_step_count_);
+				EXPECT_EQ(&resource, TestAction::p_step_resource_.load());
+				p_client_core_.reset();
+			}
+
+			// Test Action runner steps can create and destroy clients on their own Client Reactor without blocking it
+			TEST_F(ClientReactorTester, ActionRunnerCreatesAndDestroysClients) {
+				ASSERT_NE(nullptr, p_client_reactor_);
+				ASSERT_NE(nullptr, p_client_core_);
+
+				TestAction::Reset();
+				std::atomic_int created_count(0);
+				std::weak_ptr<ClientReactor> p_weak_client_reactor = p_client_reactor_;
+				TestAction::step_handler_ = [p_weak_client_reactor, &created_count]() {
+					std::shared_ptr<ClientReactor> p_client_reactor = p_weak_client_reactor.lock();
+					if(nullptr == p_client_reactor || 3 <= created_count) {
+						return;
+					}
+					std::shared_ptr<ClientCoreState> p_core_state = std::make_shared<ClientCoreState>();
+					std::shared_ptr<NetworkConnection> p_network_connection = std::make_shared<tests::mocks::MockNetworkConnection>();
+					std::unique_ptr<ClientCore> p_client_core = ClientCore::Create(p_network_connection, p_core_state, p_client_reactor);
+					if(nullptr != p_client_core
+					   && ResponseCode::SUCCESS == p_client_core->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create)
+					   && ResponseCode::SUCCESS == p_client_core->CreateActionRunner(ActionType::RESERVED_ACTION, nullptr)) {
+						created_count++;
+					}
+					// Client is destroyed on the event loop thread before its runner was picked up
+				};
+
+				ResponseCode rc = p_client_core_->RegisterAction(ActionType::RESERVED_ACTION, TestAction::Create);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				rc = p_client_core_->CreateActionRunner(ActionType::RESERVED_ACTION, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+				while(3 > created_count && std::chrono::steady_clock::now() < deadline) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				EXPECT_EQ(3, created_count);
+
+				// Event loop keeps performing the runner of the remaining client
+				int step_count = TestAction::perform_step_count_;
+				deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+				while(step_count + 3 > TestAction::perform_step_count_ && std::chrono::steady_clock::now() < deadline) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				EXPECT_LE(step_count + 3, TestAction::perform_step_count_);
+
+				p_client_core_.reset();
+				TestAction::step_handler_ = nullptr;
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file CoalescingNetworkConnectionTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "MockNetworkConnection.hpp"
+
+#include "CoalescingNetworkConnection.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			class CoalescingNetworkConnectionTester : public ::testing::Test {
+			protected:
+				std::shared_ptr<tests::mocks::MockNetworkConnection> p_network_connection_;
+				std::unique_ptr<CoalescingNetworkConnection> p_coalescing_connection_;
+				std::atomic_bool thread_continue_;
+
+				CoalescingNetworkConnectionTester() {
+					p_network_connection_ = std::make_shared<tests::mocks::MockNetworkConnection>();
+					p_coalescing_connection_ = std::unique_ptr<CoalescingNetworkConnection>(
+							new CoalescingNetworkConnection(p_network_connection_));
+					thread_continue_ = true;
+					EXPECT_CALL(*p_network_connection_, IsConnected()).WillRepeatedly(::testing::Return(true));
+				}
+			};
+
+			// Test that writes are only passed on when flushed, as a single write
+			TEST_F(CoalescingNetworkConnectionTester, FlushWritesOnce) {
+				size_t written_bytes = 0;
+				EXPECT_EQ(ResponseCode::SUCCESS, p_coalescing_connection_->Flush(thread_continue_));
+
+				EXPECT_EQ(ResponseCode::SUCCESS, p_coalescing_connection_->Write("first", written_bytes));
+				EXPECT_EQ(static_cast<size_t>(5), written_bytes);
+				EXPECT_EQ(ResponseCode::SUCCESS, p_coalescing_connection_->Write("second", written_bytes));
+				EXPECT_EQ(static_cast<size_t>(11), p_coalescing_connection_->GetCoalescedLength());
+				EXPECT_FALSE(p_network_connection_->was_write_called_);
+
+				EXPECT_CALL(*p_network_connection_, WriteInternalProxy(util::String("firstsecond"), ::testing::_))
+						.WillOnce(::testing::DoAll(::testing::SetArgReferee<1>(11), ::testing::Return(ResponseCode::SUCCESS)));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_coalescing_connection_->Flush(thread_continue_));
+				EXPECT_EQ(static_cast<size_t>(0), p_coalescing_connection_->GetCoalescedLength());
+			}
+
+			// Test that partial writes are retried with the remaining data and failures clear the buffer
+			TEST_F(CoalescingNetworkConnectionTester, PartialWriteAndFailure) {
+				size_t written_bytes = 0;
+				EXPECT_EQ(ResponseCode::SUCCESS, p_coalescing_connection_->Write("firstsecond", written_bytes));
+
+				::testing::InSequence write_sequence;
+				EXPECT_CALL(*p_network_connection_, WriteInternalProxy(util::String("firstsecond"), ::testing::_))
+						.WillOnce(::testing::DoAll(::testing::SetArgReferee<1>(5), ::testing::Return(ResponseCode::SUCCESS)));
+				EXPECT_CALL(*p_network_connection_, WriteInternalProxy(util::String("second"), ::testing::_))
+						.WillOnce(::testing::DoAll(::testing::SetArgReferee<1>(6), ::testing::Return(ResponseCode::SUCCESS)));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_coalescing_connection_->Flush(thread_continue_));
+
+				EXPECT_EQ(ResponseCode::SUCCESS, p_coalescing_connection_->Write("third", written_bytes));
+				EXPECT_CALL(*p_network_connection_, WriteInternalProxy(util::String("third"), ::testing::_))
+						.WillOnce(::testing::Return(ResponseCode::NETWORK_SSL_WRITE_ERROR));
+				EXPECT_EQ(ResponseCode::NETWORK_SSL_WRITE_ERROR, p_coalescing_connection_->Flush(thread_continue_));
+				EXPECT_EQ(static_cast<size_t>(0), p_coalescing_connection_->GetCoalescedLength());
+			}
+
+			// Test that vectored writes append every segment and that the default implementation joins them
+			TEST_F(CoalescingNetworkConnectionTester, WriteVSegments) {
+				util::String header = "head";
+				util::String payload = "payload";
+				util::StringView segments[3] = {util::StringView(header), util::StringView(), util::StringView(payload)};
+
+				size_t written_bytes = 0;
+				EXPECT_EQ(ResponseCode::SUCCESS, p_coalescing_connection_->WriteV(segments, 3, written_bytes));
+				EXPECT_EQ(static_cast<size_t>(11), written_bytes);
+				EXPECT_EQ(static_cast<size_t>(11), p_coalescing_connection_->GetCoalescedLength());
+				EXPECT_EQ(static_cast<size_t>(11), NetworkConnection::GetSegmentsLength(segments, 3));
+
+				EXPECT_CALL(*p_network_connection_, WriteInternalProxy(util::String("headpayload"), ::testing::_))
+						.Times(2)
+						.WillRepeatedly(::testing::DoAll(::testing::SetArgReferee<1>(11), ::testing::Return(ResponseCode::SUCCESS)));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_coalescing_connection_->Flush(thread_continue_));
+
+				written_bytes = 0;
+				EXPECT_EQ(ResponseCode::SUCCESS, p_network_connection_->WriteV(segments, 3, written_bytes));
+				EXPECT_EQ(static_cast<size_t>(11), written_bytes);
+			}
+		}
+	}
+}
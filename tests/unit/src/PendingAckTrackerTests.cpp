@@ -0,0 +1,196 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PendingAckTrackerTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "PendingAckTracker.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			class PendingAckTrackerTester : public ::testing::Test {
+			protected:
+				std::unique_ptr<PendingAckTracker> p_tracker_;
+				std::chrono::steady_clock::time_point start_;
+				util::Vector<PendingAckTracker::ExpiredAck> expired_acks_;
+				ActionData::AsyncAckNotificationHandlerPtr p_handler_;
+
+				PendingAckTrackerTester() {
+					p_tracker_ = std::unique_ptr<PendingAckTracker>(new PendingAckTracker(16, std::chrono::milliseconds(10)));
+					start_ = std::chrono::steady_clock::now();
+					p_handler_ = [](uint16_t action_id, ResponseCode rc) { };
+				}
+			};
+
+			// Test register and remove, handler should be handed back once and only for the registered Action ID
+			TEST_F(PendingAckTrackerTester, RegisterAndRemove) {
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(5, p_handler_, start_ + std::chrono::seconds(1)));
+				EXPECT_TRUE(p_tracker_->IsPending(5));
+				EXPECT_FALSE(p_tracker_->IsPending(21));
+				EXPECT_EQ(static_cast<size_t>(1), p_tracker_->GetPendingAckCount());
+
+				ActionData::AsyncAckNotificationHandlerPtr p_removed_handler = nullptr;
+				EXPECT_FALSE(p_tracker_->Remove(21, p_removed_handler));
+				EXPECT_EQ(nullptr, p_removed_handler);
+				EXPECT_TRUE(p_tracker_->Remove(5, p_removed_handler));
+				EXPECT_NE(nullptr, p_removed_handler);
+				EXPECT_FALSE(p_tracker_->Remove(5, p_removed_handler));
+				EXPECT_EQ(static_cast<size_t>(0), p_tracker_->GetPendingAckCount());
+
+				EXPECT_EQ(ResponseCode::NULL_VALUE_ERROR, p_tracker_->Register(5, nullptr, start_));
+			}
+
+			// Test dispatch, Ack should stay pending until dispatch ends and should not be removed or registered again
+			// while it is being dispatched
+			TEST_F(PendingAckTrackerTester, Dispatch) {
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(7, p_handler_, start_ + std::chrono::seconds(1)));
+
+				ActionData::AsyncAckNotificationHandlerPtr p_dispatched_handler = nullptr;
+				EXPECT_TRUE(p_tracker_->BeginDispatch(7, p_dispatched_handler));
+				EXPECT_NE(nullptr, p_dispatched_handler);
+				EXPECT_TRUE(p_tracker_->IsPending(7));
+
+				ActionData::AsyncAckNotificationHandlerPtr p_removed_handler = nullptr;
+				EXPECT_FALSE(p_tracker_->BeginDispatch(7, p_removed_handler));
+				EXPECT_FALSE(p_tracker_->Remove(7, p_removed_handler));
+				EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL,
+						  p_tracker_->Register(7, p_handler_, start_ + std::chrono::seconds(1)));
+
+				// Dispatched Ack should not expire
+				p_tracker_->BeginDispatchExpired(start_ + std::chrono::seconds(2), expired_acks_);
+				EXPECT_TRUE(expired_acks_.empty());
+
+				p_tracker_->EndDispatch(7);
+				EXPECT_FALSE(p_tracker_->IsPending(7));
+				EXPECT_EQ(static_cast<size_t>(0), p_tracker_->GetPendingAckCount());
+			}
+
+			// Test Action IDs sharing a chain, both should be pending at the same time and be removed, dispatched
+			// and expired independently, while registering the same Action ID again should replace the existing
+			// registration
+			TEST_F(PendingAckTrackerTester, SharedChain) {
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(3, p_handler_, start_ + std::chrono::seconds(1)));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(19, p_handler_, start_ + std::chrono::seconds(1)));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(35, p_handler_, start_ + std::chrono::seconds(3)));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(3, p_handler_, start_ + std::chrono::seconds(2)));
+				EXPECT_EQ(static_cast<size_t>(3), p_tracker_->GetPendingAckCount());
+
+				ActionData::AsyncAckNotificationHandlerPtr p_removed_handler = nullptr;
+				EXPECT_TRUE(p_tracker_->Remove(19, p_removed_handler));
+				EXPECT_TRUE(p_tracker_->IsPending(3));
+				EXPECT_FALSE(p_tracker_->IsPending(19));
+				EXPECT_TRUE(p_tracker_->IsPending(35));
+
+				// Replaced registration should expire at the new time only
+				p_tracker_->BeginDispatchExpired(start_ + std::chrono::milliseconds(1500), expired_acks_);
+				EXPECT_TRUE(expired_acks_.empty());
+				p_tracker_->BeginDispatchExpired(start_ + std::chrono::milliseconds(2100), expired_acks_);
+				ASSERT_EQ(static_cast<size_t>(1), expired_acks_.size());
+				EXPECT_EQ(3, expired_acks_[0].first);
+				p_tracker_->EndDispatch(3);
+				EXPECT_FALSE(p_tracker_->IsPending(3));
+				EXPECT_TRUE(p_tracker_->IsPending(35));
+
+				ActionData::AsyncAckNotificationHandlerPtr p_dispatched_handler = nullptr;
+				EXPECT_TRUE(p_tracker_->BeginDispatch(35, p_dispatched_handler));
+				p_tracker_->EndDispatch(35);
+				EXPECT_EQ(static_cast<size_t>(0), p_tracker_->GetPendingAckCount());
+			}
+
+			// Test a full table, registering should fail only once every slot holds a pending Ack and succeed again
+			// once one is released
+			TEST_F(PendingAckTrackerTester, TableFull) {
+				for(uint16_t action_id = 0; action_id < 16; action_id++) {
+					EXPECT_EQ(ResponseCode::SUCCESS,
+							  p_tracker_->Register(static_cast<uint16_t>(action_id * 7), p_handler_,
+												   start_ + std::chrono::seconds(1)));
+				}
+				EXPECT_EQ(ResponseCode::ACTION_QUEUE_FULL,
+						  p_tracker_->Register(200, p_handler_, start_ + std::chrono::seconds(1)));
+
+				ActionData::AsyncAckNotificationHandlerPtr p_removed_handler = nullptr;
+				EXPECT_TRUE(p_tracker_->Remove(14, p_removed_handler));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(200, p_handler_, start_ + std::chrono::seconds(1)));
+				EXPECT_EQ(static_cast<size_t>(16), p_tracker_->GetPendingAckCount());
+			}
+
+			// Test a slow Ack with sequential Action IDs, an Action ID a full table size later should still register
+			// while the first one is pending
+			TEST(PendingAckTrackerSequentialTest, RegisterWhileEarlierIdPending) {
+				PendingAckTracker tracker(PENDING_ACK_TABLE_SIZE, std::chrono::milliseconds(PENDING_ACK_TIMER_TICK_MS));
+				std::chrono::steady_clock::time_point expiry = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+				ActionData::AsyncAckNotificationHandlerPtr p_handler = [](uint16_t action_id, ResponseCode rc) { };
+
+				const uint16_t slow_action_id = 100;
+				EXPECT_EQ(ResponseCode::SUCCESS, tracker.Register(slow_action_id, p_handler, expiry));
+				for(uint16_t action_id = slow_action_id + 1; action_id <= slow_action_id + PENDING_ACK_TABLE_SIZE;
+					action_id++) {
+					EXPECT_EQ(ResponseCode::SUCCESS, tracker.Register(action_id, p_handler, expiry));
+					ActionData::AsyncAckNotificationHandlerPtr p_removed_handler = nullptr;
+					EXPECT_TRUE(tracker.Remove(action_id, p_removed_handler));
+				}
+				EXPECT_TRUE(tracker.IsPending(slow_action_id));
+				EXPECT_EQ(static_cast<size_t>(1), tracker.GetPendingAckCount());
+			}
+
+			// Test expiry from both timing wheel levels and beyond the range of the wheel, each Ack should
+			// expire once, not before its expiry time and within a tick after it
+			TEST_F(PendingAckTrackerTester, ExpiryAcrossWheelLevels) {
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(1, p_handler_, start_ + std::chrono::milliseconds(500)));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(2, p_handler_, start_ + std::chrono::seconds(30)));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(3, p_handler_, start_ + std::chrono::seconds(600)));
+				EXPECT_EQ(ResponseCode::SUCCESS, p_tracker_->Register(4, p_handler_, start_ + std::chrono::seconds(30)));
+
+				ActionData::AsyncAckNotificationHandlerPtr p_removed_handler = nullptr;
+				EXPECT_TRUE(p_tracker_->Remove(4, p_removed_handler));
+
+				p_tracker_->BeginDispatchExpired(start_ + std::chrono::milliseconds(480), expired_acks_);
+				EXPECT_TRUE(expired_acks_.empty());
+				p_tracker_->BeginDispatchExpired(start_ + std::chrono::milliseconds(520), expired_acks_);
+				EXPECT_EQ(static_cast<size_t>(1), expired_acks_.size());
+				EXPECT_EQ(1, expired_acks_[0].first);
+				EXPECT_NE(nullptr, expired_acks_[0].second);
+				p_tracker_->EndDispatch(1);
+				expired_acks_.clear();
+
+				p_tracker_->BeginDispatchExpired(start_ + std::chrono::milliseconds(29980), expired_acks_);
+				EXPECT_TRUE(expired_acks_.empty());
+				p_tracker_->BeginDispatchExpired(start_ + std::chrono::milliseconds(30020), expired_acks_);
+				EXPECT_EQ(static_cast<size_t>(1), expired_acks_.size());
+				EXPECT_EQ(2, expired_acks_[0].first);
+				p_tracker_->EndDispatch(2);
+				expired_acks_.clear();
+
+				p_tracker_->BeginDispatchExpired(start_ + std::chrono::milliseconds(599980), expired_acks_);
+				EXPECT_TRUE(expired_acks_.empty());
+				p_tracker_->BeginDispatchExpired(start_ + std::chrono::milliseconds(600020), expired_acks_);
+				EXPECT_EQ(static_cast<size_t>(1), expired_acks_.size());
+				EXPECT_EQ(3, expired_acks_[0].first);
+
+				// Slot is held until dispatch ends
+				EXPECT_TRUE(p_tracker_->IsPending(3));
+				p_tracker_->EndDispatch(3);
+				EXPECT_FALSE(p_tracker_->IsPending(3));
+				EXPECT_EQ(static_cast<size_t>(0), p_tracker_->GetPendingAckCount());
+			}
+		}
+	}
+}
@@ -19,8 +19,38 @@
  *
  */
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
 #include "TestHelper.hpp"
 
+// Heap allocations are counted per thread and for the whole process so tests can check that hot paths do not allocate
+static thread_local size_t thread_allocation_count = 0;
+static std::atomic_size_t process_allocation_count(0);
+
+void *operator new(size_t size) {
+	thread_allocation_count++;
+	process_allocation_count.fetch_add(1, std::memory_order_relaxed);
+	void *p = malloc(0 == size ? 1 : size);
+	if(nullptr == p) {
+		abort();
+	}
+	return p;
+}
+
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p) noexcept {
+	free(p);
+}
+
 namespace awsiotsdk {
 	namespace tests {
 		void TestHelper::WriteCharToBuffer(unsigned char **p_buf, unsigned char value) {
@@ -93,8 +123,8 @@ namespace awsiotsdk {
 					break;
 				}
 
-				calculated_rem_len += (size_t)((*ptr & 127) * multiplier);
 				multiplier *= 128;
+				calculated_rem_len += (size_t)((*ptr & 127) * multiplier);
 			}
 			*p_buf = ptr + 1;
 			return calculated_rem_len;
@@ -253,5 +283,13 @@ namespace awsiotsdk {
 
 			return buf;
 		}
+
+		size_t TestHelper::GetAllocationCount() {
+			return thread_allocation_count;
+		}
+
+		size_t TestHelper::GetProcessAllocationCount() {
+			return process_allocation_count.load();
+		}
 	}
 }
\ No newline at end of file
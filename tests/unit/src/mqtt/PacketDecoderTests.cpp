@@ -0,0 +1,166 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PacketDecoderTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "mqtt/PacketDecoder.hpp"
+
+#define PUBLISH_QOS0_FIXED_HEADER_VAL 0x30
+#define PINGRESP_FIXED_HEADER_VAL 0xD0
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			class PacketDecoderTester : public ::testing::Test {
+			protected:
+				struct DecodedPacket {
+					unsigned char fixed_header_byte;
+					util::Vector<unsigned char> body;
+				};
+
+				util::Vector<DecodedPacket> decoded_packets_;
+				ResponseCode handler_rc_;
+				std::unique_ptr<mqtt::PacketDecoder> p_decoder_;
+
+				PacketDecoderTester() {
+					handler_rc_ = ResponseCode::SUCCESS;
+					p_decoder_ = mqtt::PacketDecoder::Create(
+						[this](unsigned char fixed_header_byte, const unsigned char *p_body, size_t body_length) {
+							DecodedPacket packet;
+							packet.fixed_header_byte = fixed_header_byte;
+							if(0 < body_length) {
+								packet.body.assign(p_body, p_body + body_length);
+							}
+							decoded_packets_.push_back(packet);
+							return handler_rc_;
+						});
+				}
+
+				static util::Vector<unsigned char> CreatePublishPacket(size_t payload_length) {
+					util::Vector<unsigned char> packet;
+					size_t rem_len = 2 + 1 + payload_length;	// Topic length, one byte topic, payload
+					packet.push_back(PUBLISH_QOS0_FIXED_HEADER_VAL);
+					do {
+						unsigned char encoded_byte = static_cast<unsigned char>(rem_len % 128);
+						rem_len /= 128;
+						if(0 < rem_len) {
+							encoded_byte |= 128;
+						}
+						packet.push_back(encoded_byte);
+					} while(0 < rem_len);
+					packet.push_back(0x00);
+					packet.push_back(0x01);
+					packet.push_back('t');
+					for(size_t itr = 0; itr < payload_length; itr++) {
+						packet.push_back(static_cast<unsigned char>(itr));
+					}
+					return packet;
+				}
+			};
+
+			TEST_F(PacketDecoderTester, CreateWithoutHandlerFails) {
+				EXPECT_EQ(nullptr, mqtt::PacketDecoder::Create(nullptr));
+			}
+
+			TEST_F(PacketDecoderTester, DecodesMultiplePacketsInOneChunk) {
+				util::Vector<unsigned char> stream = CreatePublishPacket(10);
+				stream.push_back(PINGRESP_FIXED_HEADER_VAL);
+				stream.push_back(0x00);
+				util::Vector<unsigned char> second = CreatePublishPacket(200);
+				stream.insert(stream.end(), second.begin(), second.end());
+
+				size_t consumed = 0;
+				EXPECT_EQ(ResponseCode::SUCCESS, p_decoder_->Feed(stream.data(), stream.size(), consumed));
+				EXPECT_EQ(stream.size(), consumed);
+				EXPECT_TRUE(p_decoder_->IsAtPacketBoundary());
+				ASSERT_EQ(3, static_cast<int>(decoded_packets_.size()));
+				EXPECT_EQ(PUBLISH_QOS0_FIXED_HEADER_VAL, decoded_packets_[0].fixed_header_byte);
+				EXPECT_EQ(13, static_cast<int>(decoded_packets_[0].body.size()));
+				EXPECT_EQ(PINGRESP_FIXED_HEADER_VAL, decoded_packets_[1].fixed_header_byte);
+				EXPECT_TRUE(decoded_packets_[1].body.empty());
+				EXPECT_EQ(util::Vector<unsigned char>(second.begin() + 3, second.end()), decoded_packets_[2].body);
+			}
+
+			TEST_F(PacketDecoderTester, ResumesAcrossSingleByteChunks) {
+				// Two byte remaining length, so every part of the packet is split at least once
+				util::Vector<unsigned char> stream = CreatePublishPacket(300);
+				for(size_t itr = 0; itr < stream.size(); itr++) {
+					size_t consumed = 0;
+					EXPECT_EQ(ResponseCode::SUCCESS, p_decoder_->Feed(&stream[itr], 1, consumed));
+					EXPECT_EQ(1, static_cast<int>(consumed));
+					EXPECT_EQ((itr == stream.size() - 1) ? 1 : 0, static_cast<int>(decoded_packets_.size()));
+				}
+				ASSERT_EQ(1, static_cast<int>(decoded_packets_.size()));
+				EXPECT_EQ(util::Vector<unsigned char>(stream.begin() + 3, stream.end()), decoded_packets_[0].body);
+			}
+
+			TEST_F(PacketDecoderTester, HandlerErrorStopsFeedAndResumes) {
+				util::Vector<unsigned char> stream = CreatePublishPacket(5);
+				util::Vector<unsigned char> second = CreatePublishPacket(6);
+				stream.insert(stream.end(), second.begin(), second.end());
+
+				handler_rc_ = ResponseCode::FAILURE;
+				size_t consumed = 0;
+				EXPECT_EQ(ResponseCode::FAILURE, p_decoder_->Feed(stream.data(), stream.size(), consumed));
+				EXPECT_EQ(stream.size() - second.size(), consumed);
+				EXPECT_EQ(1, static_cast<int>(decoded_packets_.size()));
+
+				handler_rc_ = ResponseCode::SUCCESS;
+				size_t resumed = 0;
+				EXPECT_EQ(ResponseCode::SUCCESS, p_decoder_->Feed(stream.data() + consumed, stream.size() - consumed, resumed));
+				EXPECT_EQ(second.size(), resumed);
+				EXPECT_EQ(2, static_cast<int>(decoded_packets_.size()));
+			}
+
+			TEST_F(PacketDecoderTester, InvalidStreamFailsUntilReset) {
+				const unsigned char invalid_rem_len[] = {PUBLISH_QOS0_FIXED_HEADER_VAL, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+				size_t consumed = 0;
+				EXPECT_EQ(ResponseCode::MQTT_DECODE_REMAINING_LENGTH_ERROR,
+						  p_decoder_->Feed(invalid_rem_len, sizeof(invalid_rem_len), consumed));
+				EXPECT_EQ(ResponseCode::MQTT_DECODE_REMAINING_LENGTH_ERROR,
+						  p_decoder_->Feed(invalid_rem_len, sizeof(invalid_rem_len), consumed));
+
+				p_decoder_->Reset();
+				const unsigned char reserved_type[] = {0xF0, 0x00};
+				EXPECT_EQ(ResponseCode::MQTT_RX_MESSAGE_PACKET_TYPE_INVALID_ERROR,
+						  p_decoder_->Feed(reserved_type, sizeof(reserved_type), consumed));
+				EXPECT_EQ(0, static_cast<int>(consumed));
+
+				p_decoder_->Reset();
+				util::Vector<unsigned char> stream = CreatePublishPacket(1);
+				EXPECT_EQ(ResponseCode::SUCCESS, p_decoder_->Feed(stream.data(), stream.size(), consumed));
+				EXPECT_EQ(1, static_cast<int>(decoded_packets_.size()));
+			}
+
+			TEST_F(PacketDecoderTester, RemainingLengthAboveLimitFails) {
+				std::unique_ptr<mqtt::PacketDecoder> p_limited_decoder = mqtt::PacketDecoder::Create(
+					[](unsigned char, const unsigned char *, size_t) { return ResponseCode::SUCCESS; }, 100);
+				util::Vector<unsigned char> stream = CreatePublishPacket(200);
+				size_t consumed = 0;
+				EXPECT_EQ(ResponseCode::MQTT_DECODE_REMAINING_LENGTH_ERROR,
+						  p_limited_decoder->Feed(stream.data(), stream.size(), consumed));
+			}
+		}
+	}
+}
@@ -27,6 +27,7 @@
 #include "mqtt/Publish.hpp"
 #include "mqtt/ClientState.hpp"
 #include "mqtt/NetworkRead.hpp"
+#include "mqtt/Client.hpp"
 
 #define PUBLISH_QOS0_FIXED_HEADER_RETAINED_FALSE_VAL 0x30
 #define PUBLISH_QOS0_FIXED_HEADER_RETAINED_TRUE_VAL 0x31
@@ -36,9 +37,127 @@
 #define PUBLISH_QOS1_FIXED_HEADER_DUP_TRUE_RETAINED_FALSE_VAL 0x3A
 #define PUBLISH_QOS1_FIXED_HEADER_DUP_TRUE_RETAINED_TRUE_VAL 0x3B
 
+#define PUBLISH_STEADY_STATE_TEST_MESSAGE_COUNT 1000
+#define PUBLISH_STEADY_STATE_TEST_PAYLOAD_SIZE 256
+#define PUBLISH_STEADY_STATE_TEST_WAIT_TIMEOUT_MS 5000
+
 namespace awsiotsdk {
 	namespace tests {
 		namespace unit {
+			/**
+			 * @brief Network connection that accepts all writes
+			 *
+			 * Unlike the mock connection, it does not record calls, so it does not allocate memory when written to
+			 */
+			class NullWriteNetworkConnection : public NetworkConnection {
+			protected:
+				ResponseCode ConnectInternal() { return ResponseCode::SUCCESS; }
+				ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+					size_written_bytes_out = buf.length();
+					return ResponseCode::SUCCESS;
+				}
+				ResponseCode WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+											size_t &size_written_bytes_out) {
+					size_written_bytes_out = GetSegmentsLength(p_segments, segment_count);
+					return ResponseCode::SUCCESS;
+				}
+				ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+										  size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+					size_read_bytes_out = 0;
+					return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+				}
+				ResponseCode DisconnectInternal() { return ResponseCode::SUCCESS; }
+
+			public:
+				bool IsConnected() { return true; }
+				bool IsPhysicalLayerConnected() { return true; }
+			};
+
+			/**
+			 * @brief Network connection that accepts all writes and serves bytes provided by the test as incoming data
+			 *
+			 * Only counts written bytes, so neither direction allocates memory. Incoming data is set by the test thread
+			 * once the previous data has been processed by the read thread
+			 */
+			class ScriptedNetworkConnection : public NullWriteNetworkConnection {
+			protected:
+				std::atomic<const char *> p_inbound_data_;
+				std::atomic_size_t inbound_offset_;
+				std::atomic_size_t inbound_length_;
+
+				ResponseCode WriteInternal(const util::String &buf, size_t &size_written_bytes_out) {
+					written_bytes_ += buf.length();
+					return NullWriteNetworkConnection::WriteInternal(buf, size_written_bytes_out);
+				}
+				ResponseCode WriteVInternal(const util::StringView *p_segments, size_t segment_count,
+											size_t &size_written_bytes_out) {
+					ResponseCode rc = NullWriteNetworkConnection::WriteVInternal(p_segments, segment_count,
+																				 size_written_bytes_out);
+					written_bytes_ += size_written_bytes_out;
+					return rc;
+				}
+				ResponseCode ReadInternal(util::Vector<unsigned char> &buf, size_t buf_read_offset,
+										  size_t size_bytes_to_read, size_t &size_read_bytes_out) {
+					size_t inbound_length = inbound_length_;
+					size_t inbound_offset = inbound_offset_;
+					size_read_bytes_out = 0;
+					if(inbound_offset >= inbound_length) {
+						return ResponseCode::NETWORK_SSL_NOTHING_TO_READ;
+					}
+					size_read_bytes_out = std::min(size_bytes_to_read, inbound_length - inbound_offset);
+					memcpy(&buf[buf_read_offset], p_inbound_data_.load() + inbound_offset, size_read_bytes_out);
+					inbound_offset_ = inbound_offset + size_read_bytes_out;
+					return ResponseCode::SUCCESS;
+				}
+				ResponseCode WaitForReadableInternal(std::chrono::milliseconds timeout) {
+					// Polls so the read thread does not sleep for the full timeout between packets
+					std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now() + timeout;
+					while(inbound_offset_ >= inbound_length_ && std::chrono::steady_clock::now() < end_time) {
+						std::this_thread::sleep_for(std::chrono::microseconds(50));
+					}
+					return ResponseCode::SUCCESS;
+				}
+
+			public:
+				std::atomic_size_t written_bytes_;
+
+				ScriptedNetworkConnection() : p_inbound_data_(nullptr), inbound_offset_(0), inbound_length_(0),
+											  written_bytes_(0) {}
+
+				void SetInboundData(const char *p_data, size_t length) {
+					p_inbound_data_ = p_data;
+					inbound_offset_ = 0;
+					inbound_length_ = length;
+				}
+			};
+
+			/**
+			 * @brief MQTT Client with access to its core and state, so it can be used without a server
+			 */
+			class SteadyStateMqttClient : public MqttClient {
+			public:
+				SteadyStateMqttClient(std::shared_ptr<NetworkConnection> p_network_connection)
+					: MqttClient(p_network_connection, std::chrono::milliseconds(200)) {}
+
+				std::shared_ptr<mqtt::ClientState> GetClientState() { return p_client_state_; }
+				void SetProcessQueuedActions(bool process_queued_actions) {
+					p_client_core_->SetProcessQueuedActions(process_queued_actions);
+				}
+			};
+
+			template<typename T>
+			static bool WaitForValue(const std::atomic<T> &value, T expected_value) {
+				std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now()
+					+ std::chrono::milliseconds(PUBLISH_STEADY_STATE_TEST_WAIT_TIMEOUT_MS);
+				while(value != expected_value) {
+					if(std::chrono::steady_clock::now() > end_time) {
+						return false;
+					}
+					std::this_thread::yield();
+				}
+				return true;
+			}
+
 			class PublishActionTester : public ::testing::Test {
 			protected:
 				std::shared_ptr<mqtt::ClientState> p_core_state_;
@@ -356,6 +475,311 @@ namespace awsiotsdk {
 				EXPECT_TRUE(p_network_connection_->was_read_called_);
 				EXPECT_TRUE(callback_received_);
 			}
+
+			TEST_F(PublishActionTester, PublishBatchActionTest) {
+				std::unique_ptr<Action> p_batch_action = mqtt::PublishBatchActionAsync::Create(p_core_state_);
+				EXPECT_NE(nullptr, p_batch_action);
+
+				util::Vector<uint16_t> acked_ids;
+				ActionData::AsyncAckNotificationHandlerPtr p_handler = [&acked_ids](uint16_t action_id, ResponseCode rc) {
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+					acked_ids.push_back(action_id);
+				};
+
+				util::Vector<std::shared_ptr<mqtt::PublishPacket>> publish_packets;
+				publish_packets.push_back(mqtt::PublishPacket::Create(Utf8String::Create(test_topic_), false, false,
+																	  mqtt::QoS::QOS0, test_payload_));
+				publish_packets.push_back(mqtt::PublishPacket::Create(Utf8String::Create(test_topic_), false, false,
+																	  mqtt::QoS::QOS1, test_payload_));
+				publish_packets[0]->SetPacketId(test_packet_id_);
+				publish_packets[1]->SetPacketId(test_packet_id_ + 1);
+				publish_packets[0]->p_async_ack_handler_ = p_handler;
+				publish_packets[1]->p_async_ack_handler_ = p_handler;
+				util::String expected_buf = publish_packets[0]->ToString() + publish_packets[1]->ToString();
+
+				EXPECT_EQ(nullptr, mqtt::PublishBatchPacket::Create(util::Vector<std::shared_ptr<mqtt::PublishPacket>>()));
+				std::shared_ptr<mqtt::PublishBatchPacket> p_batch_packet = mqtt::PublishBatchPacket::Create(publish_packets);
+				EXPECT_EQ(expected_buf.length(), p_batch_packet->Size());
+
+				// Both packets must be written using a single write
+				p_network_connection_->last_write_buf_.clear();
+				EXPECT_CALL(*p_network_mock_, WriteInternalProxy(::testing::_, ::testing::_)).WillOnce(
+						::testing::DoAll(::testing::SetArgReferee<1>(p_batch_packet->Size()),
+										 ::testing::Return(ResponseCode::SUCCESS)));
+				ResponseCode rc = p_batch_action->PerformAction(p_network_connection_, p_batch_packet);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_EQ(expected_buf, p_network_connection_->last_write_buf_);
+
+				// QoS0 packet completes on write, QoS1 packet waits for its own Ack
+				EXPECT_EQ(static_cast<size_t>(1), acked_ids.size());
+				EXPECT_EQ(test_packet_id_, acked_ids[0]);
+				EXPECT_TRUE(p_core_state_->IsAckPending(test_packet_id_ + 1));
+				p_core_state_->ForwardReceivedAck(test_packet_id_ + 1, ResponseCode::SUCCESS);
+				EXPECT_EQ(static_cast<size_t>(2), acked_ids.size());
+				EXPECT_FALSE(p_core_state_->IsAckPending(test_packet_id_ + 1));
+
+				// Failed writes must not leave pending Acks behind
+				acked_ids.clear();
+				EXPECT_CALL(*p_network_mock_, WriteInternalProxy(::testing::_, ::testing::_)).WillOnce(
+						::testing::Return(ResponseCode::NETWORK_SSL_WRITE_ERROR));
+				rc = p_batch_action->PerformAction(p_network_connection_, p_batch_packet);
+				EXPECT_EQ(ResponseCode::NETWORK_SSL_WRITE_ERROR, rc);
+				EXPECT_TRUE(acked_ids.empty());
+				EXPECT_FALSE(p_core_state_->IsAckPending(test_packet_id_ + 1));
+			}
+
+			TEST_F(PublishActionTester, PublishPartialWritesResumeTest) {
+				std::unique_ptr<Action> p_publish_action = mqtt::PublishActionAsync::Create(p_core_state_);
+				// Actions only retry partial writes while their thread is running
+				p_publish_action->SetParentThreadSync(std::make_shared<std::atomic_bool>(true));
+				std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+						Utf8String::Create(test_topic_), false, false, mqtt::QoS::QOS1, test_payload_);
+				p_publish_packet->SetPacketId(test_packet_id_);
+				const util::String expected_buf = p_publish_packet->ToString();
+
+				// Accept at most 16 bytes per write, header and payload are written as separate segments and the
+				// write has to resume inside both of them
+				util::String received_buf;
+				EXPECT_CALL(*p_network_mock_, WriteInternalProxy(::testing::_, ::testing::_)).WillRepeatedly(
+						::testing::Invoke([&received_buf](const util::String &buf, size_t &size_written_bytes_out) {
+							size_written_bytes_out = std::min(buf.length(), static_cast<size_t>(16));
+							received_buf.append(buf, 0, size_written_bytes_out);
+							return ResponseCode::SUCCESS;
+						}));
+				ResponseCode rc = p_publish_action->PerformAction(p_network_connection_, p_publish_packet);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_EQ(expected_buf, received_buf);
+				p_core_state_->DeletePendingAck(test_packet_id_);
+			}
+
+			TEST_F(PublishActionTester, SerializeToAppendsSameBytesAsToStringTest) {
+				std::shared_ptr<mqtt::PublishPacket> p_qos0_packet = mqtt::PublishPacket::Create(
+						Utf8String::Create(test_topic_), true, false, mqtt::QoS::QOS0, test_payload_);
+				std::shared_ptr<mqtt::PublishPacket> p_qos1_packet = mqtt::PublishPacket::Create(
+						Utf8String::Create(test_topic_), false, true, mqtt::QoS::QOS1, test_payload_);
+				p_qos1_packet->SetPacketId(test_packet_id_);
+				std::shared_ptr<mqtt::PubackPacket> p_puback_packet = mqtt::PubackPacket::Create(test_packet_id_);
+
+				util::Vector<std::shared_ptr<mqtt::PublishPacket>> publish_packets;
+				publish_packets.push_back(p_qos0_packet);
+				publish_packets.push_back(p_qos1_packet);
+				std::shared_ptr<mqtt::PublishBatchPacket> p_batch_packet = mqtt::PublishBatchPacket::Create(publish_packets);
+
+				// SerializeTo appends, bytes already in the buffer are kept
+				util::String prefix = "prefix";
+				util::OutputBuffer buf;
+				buf.Append(prefix.data(), prefix.length());
+				p_qos0_packet->SerializeTo(buf);
+				p_qos1_packet->SerializeTo(buf);
+				p_puback_packet->SerializeTo(buf);
+				p_batch_packet->SerializeTo(buf);
+
+				util::String expected_buf = prefix + p_qos0_packet->ToString() + p_qos1_packet->ToString()
+											+ p_puback_packet->ToString() + p_batch_packet->ToString();
+				EXPECT_EQ(expected_buf, buf.GetBuffer());
+				EXPECT_EQ(prefix.length() + p_qos0_packet->Size() + p_qos1_packet->Size() + p_puback_packet->Size()
+						  + p_batch_packet->Size(), buf.Size());
+			}
+
+			TEST_F(PublishActionTester, SerializeToReusesBufferMemoryTest) {
+				std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+						Utf8String::Create(test_topic_), false, false, mqtt::QoS::QOS1, test_payload_);
+				util::OutputBuffer buf;
+				p_publish_packet->SerializeTo(buf);
+				const util::String expected_buf = buf.GetBuffer();
+				const char *p_storage = buf.GetBuffer().data();
+				size_t capacity = buf.Capacity();
+
+				// Once grown to fit the packet, serializing again must not reallocate
+				for(uint16_t packet_id = 1; packet_id < 100; packet_id++) {
+					buf.Clear();
+					EXPECT_EQ(capacity, buf.Capacity());
+					p_publish_packet->SetPacketId(packet_id);
+					p_publish_packet->SerializeTo(buf);
+					EXPECT_EQ(p_publish_packet->Size(), buf.Size());
+					EXPECT_EQ(capacity, buf.Capacity());
+					EXPECT_EQ(p_storage, buf.GetBuffer().data());
+				}
+
+				buf.Clear();
+				p_publish_packet->SetPacketId(0);
+				p_publish_packet->SerializeTo(buf);
+				EXPECT_EQ(expected_buf, buf.GetBuffer());
+
+				util::String released = buf.Release();
+				EXPECT_EQ(expected_buf, released);
+				EXPECT_TRUE(buf.IsEmpty());
+			}
+
+			TEST_F(PublishActionTester, SerializeToMultiByteRemainingLengthTest) {
+				// 3 bytes are needed to encode a remaining length above 16383
+				util::String large_payload(20000, 'x');
+				std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(
+						Utf8String::Create(test_topic_), false, false, mqtt::QoS::QOS0, large_payload);
+				util::OutputBuffer buf;
+				p_publish_packet->SerializeTo(buf);
+				EXPECT_EQ(p_publish_packet->Size(), buf.Size());
+
+				unsigned char *p_last_msg = (unsigned char *)(buf.GetBuffer().c_str());
+				EXPECT_EQ(PUBLISH_QOS0_FIXED_HEADER_RETAINED_FALSE_VAL, (int) p_last_msg[0]);
+				p_last_msg++;
+				size_t expected_rem_len = test_topic_.length() + 2 + large_payload.length();
+				EXPECT_EQ(expected_rem_len, TestHelper::ParseRemLenFromBuffer(&p_last_msg));
+				EXPECT_EQ(static_cast<size_t>(4), p_last_msg - (unsigned char *)(buf.GetBuffer().c_str()));
+			}
+
+			TEST_F(PublishActionTester, PreparedPublishSerializesSameBytesTest) {
+				util::String large_payload(20000, 'x');
+				const mqtt::QoS qos_values[2] = {mqtt::QoS::QOS0, mqtt::QoS::QOS1};
+				for(mqtt::QoS qos : qos_values) {
+					for(bool is_retained : {false, true}) {
+						std::shared_ptr<mqtt::PreparedPublish> p_prepared_publish = mqtt::PreparedPublish::Create(
+								Utf8String::Create(test_topic_), qos, is_retained);
+						ASSERT_NE(nullptr, p_prepared_publish);
+						EXPECT_EQ(test_topic_, p_prepared_publish->GetTopicName());
+
+						// Same template used for several messages with different payload lengths and packet ids
+						for(const util::String &payload : {test_payload_, util::String(), large_payload}) {
+							std::shared_ptr<mqtt::PublishPacket> p_expected_packet = mqtt::PublishPacket::Create(
+									Utf8String::Create(test_topic_), is_retained, false, qos, payload);
+							p_expected_packet->SetPacketId(test_packet_id_);
+							std::shared_ptr<mqtt::PublishPacket> p_prepared_packet = mqtt::PublishPacket::Create(
+									p_prepared_publish, payload);
+							ASSERT_NE(nullptr, p_prepared_packet);
+							p_prepared_packet->SetPacketId(test_packet_id_);
+
+							EXPECT_EQ(p_expected_packet->ToString(), p_prepared_packet->ToString());
+							EXPECT_EQ(p_expected_packet->Size(), p_prepared_packet->Size());
+							EXPECT_EQ(test_topic_, p_prepared_packet->GetTopicName());
+							EXPECT_EQ(qos, p_prepared_packet->GetQoS());
+							EXPECT_EQ(is_retained, p_prepared_packet->IsRetained());
+							EXPECT_FALSE(p_prepared_packet->IsDuplicate());
+						}
+					}
+				}
+			}
+
+			TEST_F(PublishActionTester, PreparedPublishInvalidInputTest) {
+				EXPECT_EQ(nullptr, mqtt::PreparedPublish::Create(nullptr, mqtt::QoS::QOS0, false));
+				EXPECT_EQ(nullptr, mqtt::PreparedPublish::Create(Utf8String::Create(util::String()), mqtt::QoS::QOS0, false));
+				EXPECT_EQ(nullptr, mqtt::PublishPacket::Create(std::shared_ptr<const mqtt::PreparedPublish>(), test_payload_));
+			}
+
+			TEST_F(PublishActionTester, PreparedPublishActionTest) {
+				std::shared_ptr<mqtt::PreparedPublish> p_prepared_publish = mqtt::PreparedPublish::Create(
+						Utf8String::Create(test_topic_), mqtt::QoS::QOS0, false);
+				std::shared_ptr<mqtt::PublishPacket> p_publish_packet = mqtt::PublishPacket::Create(p_prepared_publish,
+																									 test_payload_);
+				std::shared_ptr<mqtt::PublishPacket> p_expected_packet = mqtt::PublishPacket::Create(
+						Utf8String::Create(test_topic_), false, false, mqtt::QoS::QOS0, test_payload_);
+
+				p_network_connection_->last_write_buf_.clear();
+				std::unique_ptr<Action> p_publish_action = mqtt::PublishActionAsync::Create(p_core_state_);
+				EXPECT_CALL(*p_network_mock_, WriteInternalProxy(::testing::_, ::testing::_)).WillOnce(
+						::testing::DoAll(::testing::SetArgReferee<1>(p_publish_packet->Size()),
+										 ::testing::Return(ResponseCode::SUCCESS)));
+				ResponseCode rc = p_publish_action->PerformAction(p_network_connection_, p_publish_packet);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_EQ(p_expected_packet->ToString(), p_network_mock_->last_write_buf_);
+			}
+
+			TEST_F(PublishActionTester, SteadyStatePublishDoesNotAllocateTest) {
+				std::shared_ptr<ScriptedNetworkConnection> p_network_connection = std::make_shared<ScriptedNetworkConnection>();
+				std::unique_ptr<SteadyStateMqttClient> p_client
+					= std::unique_ptr<SteadyStateMqttClient>(new SteadyStateMqttClient(p_network_connection));
+				p_client->SetProcessQueuedActions(true);
+
+				// Messages from the server are delivered as views, copying them to a String would allocate
+				std::atomic_size_t received_count(0);
+				mqtt::Subscription::ApplicationViewCallbackHandlerPtr p_view_handler =
+					[&received_count](const mqtt::PublishView &publish_view,
+									  std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+						received_count++;
+						return ResponseCode::SUCCESS;
+					};
+				std::shared_ptr<mqtt::Subscription> p_subscription = mqtt::Subscription::Create(
+					Utf8String::Create(test_topic_), mqtt::QoS::QOS1, p_view_handler, nullptr);
+				ASSERT_NE(nullptr, p_subscription);
+				ASSERT_EQ(ResponseCode::SUCCESS, p_client->GetClientState()->AddSubscription(test_topic_, p_subscription));
+				p_subscription->SetActive(true);
+
+				std::shared_ptr<mqtt::PreparedPublish> p_prepared_publish[2] = {
+					mqtt::PreparedPublish::Create(Utf8String::Create(test_topic_), mqtt::QoS::QOS0, false),
+					mqtt::PreparedPublish::Create(Utf8String::Create(test_topic_), mqtt::QoS::QOS1, false)
+				};
+				size_t publish_packet_size[2];
+				for(size_t itr = 0; itr < 2; itr++) {
+					publish_packet_size[itr] = mqtt::PublishPacket::Create(
+						p_prepared_publish[itr], util::String(PUBLISH_STEADY_STATE_TEST_PAYLOAD_SIZE, 'x'))->Size();
+				}
+
+				// QoS1 message from the server, the client answers it with a PUBACK
+				std::shared_ptr<mqtt::PublishPacket> p_inbound_packet = mqtt::PublishPacket::Create(
+					Utf8String::Create(test_topic_), false, false, mqtt::QoS::QOS1,
+					util::String(PUBLISH_STEADY_STATE_TEST_PAYLOAD_SIZE, 'y'));
+				p_inbound_packet->SetPacketId(test_packet_id_);
+				const util::String inbound_publish = p_inbound_packet->ToString();
+				char inbound_puback[4] = {(char) PUBACK_PACKET_FIXED_HEADER_VAL, (char) PUBACK_PACKET_REM_LEN_VAL, 0, 0};
+
+				// The lambda fits std::function's small buffer, so the copies made for each packet do not allocate
+				std::atomic_size_t ack_count(0);
+				ActionData::AsyncAckNotificationHandlerPtr p_ack_handler = [&ack_count](uint16_t action_id, ResponseCode rc) {
+					if(ResponseCode::SUCCESS == rc) {
+						ack_count++;
+					}
+				};
+
+				// Payloads are built by the application and moved into the packets, two rounds worth
+				util::Vector<util::String> payloads(2 * PUBLISH_STEADY_STATE_TEST_MESSAGE_COUNT,
+													util::String(PUBLISH_STEADY_STATE_TEST_PAYLOAD_SIZE, 'x'));
+				size_t failure_count = 0;
+				size_t expected_written_bytes = 0;
+				size_t expected_ack_count = 0;
+				size_t expected_received_count = 0;
+				auto publish_round = [&](size_t first_payload_index) {
+					for(size_t itr = 0; itr < PUBLISH_STEADY_STATE_TEST_MESSAGE_COUNT && 0 == failure_count; itr++) {
+						// Publish through the outbound queue, written by the outbound thread
+						uint16_t packet_id = 0;
+						if(ResponseCode::SUCCESS != p_client->PublishAsync(p_prepared_publish[itr % 2],
+																		   std::move(payloads[first_payload_index + itr]),
+																		   p_ack_handler, packet_id)) {
+							failure_count++;
+						}
+						expected_written_bytes += publish_packet_size[itr % 2];
+						if(!WaitForValue(p_network_connection->written_bytes_, expected_written_bytes)) {
+							failure_count++;
+						}
+
+						// QoS0 requests are acked once written, QoS1 requests once the PUBACK from the server is read
+						if(1 == itr % 2) {
+							inbound_puback[2] = (char) (packet_id >> 8);
+							inbound_puback[3] = (char) (packet_id & 0xFF);
+							p_network_connection->SetInboundData(inbound_puback, sizeof(inbound_puback));
+						}
+						if(!WaitForValue(ack_count, ++expected_ack_count)) {
+							failure_count++;
+						}
+
+						// Read by the read thread, which queues a PUBACK for the outbound thread
+						p_network_connection->SetInboundData(inbound_publish.c_str(), inbound_publish.length());
+						expected_written_bytes += sizeof(inbound_puback);
+						if(!WaitForValue(received_count, ++expected_received_count)
+						   || !WaitForValue(p_network_connection->written_bytes_, expected_written_bytes)) {
+							failure_count++;
+						}
+					}
+				};
+
+				// Warm up, fills the packet pools, grows the buffers and creates the actions of each type
+				publish_round(0);
+				size_t allocation_count = TestHelper::GetProcessAllocationCount();
+				publish_round(PUBLISH_STEADY_STATE_TEST_MESSAGE_COUNT);
+				EXPECT_EQ(allocation_count, TestHelper::GetProcessAllocationCount());
+
+				EXPECT_EQ(static_cast<size_t>(0), failure_count);
+				EXPECT_EQ(static_cast<size_t>(2 * PUBLISH_STEADY_STATE_TEST_MESSAGE_COUNT), ack_count.load());
+				EXPECT_EQ(static_cast<size_t>(2 * PUBLISH_STEADY_STATE_TEST_MESSAGE_COUNT), received_count.load());
+			}
 		}
 	}
-}
\ No newline at end of file
+}
@@ -20,6 +20,7 @@
  */
 
 #include <atomic>
+#include <thread>
 #include <gtest/gtest.h>
 
 #include "MockNetworkConnection.hpp"
@@ -215,7 +216,7 @@ namespace awsiotsdk {
 				for(int itr = 1; itr <= MAX_TOPICS_IN_ONE_SUBSCRIBE_PACKET; itr++) {
 					util::String sub_topic = test_topic_base_;
 					sub_topic.append("_");
-					sub_topic.append(std::to_string(itr));
+					sub_topic.append(util::ToString(itr));
 					std::shared_ptr<mqtt::Subscription> p_subscription = mqtt::Subscription::Create(
 							Utf8String::Create(sub_topic), mqtt::QoS::QOS0, p_app_handler, nullptr);
 					topic_vector.push_back(p_subscription);
@@ -245,6 +246,33 @@ namespace awsiotsdk {
 				EXPECT_EQ(ResponseCode::SUCCESS, rc);
 			}
 
+			TEST_F(SubUnsubActionTester, SubscribeActionTestWithInvalidTopicFilter) {
+				ASSERT_NE(nullptr, p_network_connection_);
+				ASSERT_NE(nullptr, p_core_state_);
+				ASSERT_NE(nullptr, p_subscribe_action_);
+
+				mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler = std::bind(&SubUnsubActionTester::SubscribeCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+				util::String invalid_filters[] = {"a/#/b", "a/b+", "#/a"};
+				for(const util::String &invalid_filter : invalid_filters) {
+					p_network_connection_->last_write_buf_.clear();
+					p_network_connection_->was_write_called_ = false;
+
+					util::Vector<std::shared_ptr<mqtt::Subscription>> topic_vector;
+					topic_vector.push_back(mqtt::Subscription::Create(Utf8String::Create(test_topic_base_), mqtt::QoS::QOS0, p_app_handler, nullptr));
+					topic_vector.push_back(mqtt::Subscription::Create(Utf8String::Create(invalid_filter), mqtt::QoS::QOS0, p_app_handler, nullptr));
+					std::shared_ptr<mqtt::SubscribePacket> p_sub_packet = mqtt::SubscribePacket::Create(topic_vector);
+					ASSERT_NE(nullptr, p_sub_packet);
+					p_sub_packet->SetActionId(test_packet_id_);
+
+					// Whole request is rejected, nothing is sent and the valid filter is not added either
+					ResponseCode rc = p_subscribe_action_->PerformAction(p_network_connection_, p_sub_packet);
+					EXPECT_EQ(ResponseCode::MQTT_INVALID_DATA_ERROR, rc);
+					EXPECT_FALSE(p_network_connection_->was_write_called_);
+					EXPECT_EQ(nullptr, p_core_state_->GetSubscription(test_topic_base_));
+					EXPECT_EQ(nullptr, p_core_state_->GetSubscription(invalid_filter));
+				}
+			}
+
 			TEST_F(SubUnsubActionTester, UnubscribeActionTestWithOneTopic) {
 				ASSERT_NE(nullptr, p_network_connection_);
 				ASSERT_NE(nullptr, p_core_state_);
@@ -313,6 +341,49 @@ namespace awsiotsdk {
 				EXPECT_TRUE(callback_received_);
 			}
 
+			TEST_F(SubUnsubActionTester, IncomingPublishOnWildcardSubscriptionsTest) {
+				ASSERT_NE(nullptr, p_network_connection_);
+				ASSERT_NE(nullptr, p_core_state_);
+				ASSERT_NE(nullptr, p_subscribe_action_);
+
+				p_network_connection_->ClearNextReadBuf();
+				p_network_connection_->last_write_buf_.clear();
+				p_network_connection_->was_write_called_ = false;
+
+				std::unique_ptr<Action> p_network_read_action = mqtt::NetworkReadActionRunner::Create(p_core_state_);
+
+				size_t callback_count = 0;
+				mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler =
+					[&callback_count](util::String topic_name, util::String payload,
+									  std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) {
+						EXPECT_EQ(test_topic_base_ + "/sensor1/temp", topic_name);
+						EXPECT_EQ(test_payload_, payload);
+						callback_count++;
+						return ResponseCode::SUCCESS;
+					};
+
+				util::Vector<std::shared_ptr<mqtt::Subscription>> topic_vector;
+				topic_vector.push_back(mqtt::Subscription::Create(Utf8String::Create(test_topic_base_ + "/+/temp"),
+																  mqtt::QoS::QOS0, p_app_handler, nullptr));
+				topic_vector.push_back(mqtt::Subscription::Create(Utf8String::Create(test_topic_base_ + "/#"),
+																  mqtt::QoS::QOS0, p_app_handler, nullptr));
+				topic_vector.push_back(mqtt::Subscription::Create(Utf8String::Create(test_topic_base_ + "/+/humidity"),
+																  mqtt::QoS::QOS0, p_app_handler, nullptr));
+				ResponseCode rc = Subscribe(test_packet_id_, topic_vector);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::vector<uint8_t> suback_list = {0, 0, 0};
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedSubAckMessage(test_packet_id_, suback_list));
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedPublishMessage(
+					test_topic_base_ + "/sensor1/temp", test_packet_id_, mqtt::QoS::QOS0, false, false, test_payload_));
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_EQ(2, static_cast<int>(callback_count));
+			}
+
 			TEST_F(SubUnsubActionTester, IncomingLargePublishOnSubscribedTopicTest) {
 				ASSERT_NE(nullptr, p_network_connection_);
 				ASSERT_NE(nullptr, p_core_state_);
@@ -381,6 +452,256 @@ namespace awsiotsdk {
 				} while(msg_count < 50);
 			}
 
+			TEST_F(SubUnsubActionTester, IncomingMultiplePublishesInOneReadTest) {
+				ASSERT_NE(nullptr, p_network_connection_);
+				ASSERT_NE(nullptr, p_core_state_);
+				ASSERT_NE(nullptr, p_subscribe_action_);
+
+				p_network_connection_->ClearNextReadBuf();
+				p_network_connection_->last_write_buf_.clear();
+				p_network_connection_->was_write_called_ = false;
+
+				callback_received_ = false;
+
+				std::unique_ptr<Action> p_network_read_action = mqtt::NetworkReadActionRunner::Create(p_core_state_);
+
+				mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler = std::bind(&SubUnsubActionTester::SubscribeCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+
+				std::shared_ptr<mqtt::Subscription> p_subscription = mqtt::Subscription::Create(Utf8String::Create(test_topic_base_), mqtt::QoS::QOS1, p_app_handler, nullptr);
+				util::Vector<std::shared_ptr<mqtt::Subscription>> topic_vector;
+
+				topic_vector.push_back(p_subscription);
+				ResponseCode rc = Subscribe(test_packet_id_, topic_vector);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::vector<uint8_t> suback_list;
+				suback_list.push_back(0);
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedSubAckMessage(test_packet_id_, suback_list));
+
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_TRUE(p_subscription->IsActive());
+
+				// All three packets are returned by a single network read
+				cur_expected_topic_name_ = test_topic_base_;
+				util::String publish_packet_str = TestHelper::GetSerializedPublishMessage(test_topic_base_, test_packet_id_, mqtt::QoS::QOS0, false, false, test_payload_);
+				p_network_connection_->SetNextReadBuf(publish_packet_str + publish_packet_str + publish_packet_str);
+
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_EQ(true, p_network_connection_->was_read_called_);
+				EXPECT_TRUE(callback_received_);
+				EXPECT_FALSE(p_network_connection_->HasReadBufSet());
+
+				// Remaining packets must be processed from the receive buffer without reading from the network again
+				for(int itr = 0; itr < 2; itr++) {
+					callback_received_ = false;
+					p_network_connection_->was_read_called_ = false;
+					rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+					EXPECT_EQ(false, p_network_connection_->was_read_called_);
+					EXPECT_TRUE(callback_received_);
+				}
+			}
+
+			TEST_F(SubUnsubActionTester, IncomingPublishWithViewHandlerTest) {
+				ASSERT_NE(nullptr, p_network_connection_);
+				ASSERT_NE(nullptr, p_core_state_);
+				ASSERT_NE(nullptr, p_subscribe_action_);
+
+				p_network_connection_->ClearNextReadBuf();
+				p_network_connection_->last_write_buf_.clear();
+				p_network_connection_->was_write_called_ = false;
+
+				std::unique_ptr<Action> p_network_read_action = mqtt::NetworkReadActionRunner::Create(p_core_state_);
+
+				util::Vector<util::BufferLease> payload_leases;
+				mqtt::Subscription::ApplicationViewCallbackHandlerPtr p_app_view_handler =
+					[&payload_leases](const mqtt::PublishView &publish_view,
+									  std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) -> ResponseCode {
+						EXPECT_EQ(util::StringView(test_topic_base_), publish_view.GetTopicName());
+						EXPECT_EQ(mqtt::QoS::QOS0, publish_view.GetQos());
+						payload_leases.push_back(publish_view.LeasePayload());
+						return ResponseCode::SUCCESS;
+					};
+
+				std::shared_ptr<mqtt::Subscription> p_subscription = mqtt::Subscription::Create(Utf8String::Create(test_topic_base_), mqtt::QoS::QOS1, p_app_view_handler, nullptr);
+				ASSERT_NE(nullptr, p_subscription);
+				util::Vector<std::shared_ptr<mqtt::Subscription>> topic_vector;
+
+				topic_vector.push_back(p_subscription);
+				ResponseCode rc = Subscribe(test_packet_id_, topic_vector);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				std::vector<uint8_t> suback_list;
+				suback_list.push_back(0);
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedSubAckMessage(test_packet_id_, suback_list));
+
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_TRUE(p_subscription->IsActive());
+
+				util::String first_payload = "First payload";
+				util::String second_payload = "Second payload, overwrites the first one if the leased buffer is reused";
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedPublishMessage(test_topic_base_, test_packet_id_, mqtt::QoS::QOS0, false, false, first_payload));
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedPublishMessage(test_topic_base_, test_packet_id_, mqtt::QoS::QOS0, false, false, second_payload));
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				// Leased payloads must remain valid after later reads
+				ASSERT_EQ(static_cast<size_t>(2), payload_leases.size());
+				EXPECT_EQ(first_payload, payload_leases[0].GetView().ToString());
+				EXPECT_EQ(second_payload, payload_leases[1].GetView().ToString());
+			}
+
+			TEST_F(SubUnsubActionTester, IncomingPublishInternedTopicTest) {
+				ASSERT_NE(nullptr, p_network_connection_);
+				ASSERT_NE(nullptr, p_core_state_);
+				ASSERT_NE(nullptr, p_subscribe_action_);
+
+				p_network_connection_->ClearNextReadBuf();
+				p_network_connection_->last_write_buf_.clear();
+				p_network_connection_->was_write_called_ = false;
+
+				std::unique_ptr<Action> p_network_read_action = mqtt::NetworkReadActionRunner::Create(p_core_state_);
+				util::String publish_topic = test_topic_base_ + "/sensor1";
+
+				util::Vector<std::shared_ptr<const mqtt::InternedTopic>> interned_topics;
+				mqtt::Subscription::ApplicationViewCallbackHandlerPtr p_app_view_handler =
+					[&interned_topics](const mqtt::PublishView &publish_view,
+									   std::shared_ptr<mqtt::SubscriptionHandlerContextData> p_app_handler_data) -> ResponseCode {
+						interned_topics.push_back(publish_view.GetInternedTopic());
+						return ResponseCode::SUCCESS;
+					};
+
+				util::Vector<std::shared_ptr<mqtt::Subscription>> topic_vector;
+				topic_vector.push_back(mqtt::Subscription::Create(Utf8String::Create(test_topic_base_ + "/+"), mqtt::QoS::QOS0, p_app_view_handler, nullptr));
+				ResponseCode rc = Subscribe(test_packet_id_, topic_vector);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedSubAckMessage(test_packet_id_, {0}));
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				for(size_t itr = 0; itr < 2; itr++) {
+					p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedPublishMessage(publish_topic, test_packet_id_, mqtt::QoS::QOS0, false, false, test_payload_));
+					rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				}
+				ASSERT_EQ(static_cast<size_t>(2), interned_topics.size());
+				ASSERT_NE(nullptr, interned_topics[0]);
+				EXPECT_EQ(interned_topics[0], interned_topics[1]);
+				EXPECT_EQ(publish_topic, interned_topics[0]->GetTopicName());
+
+				// A new subscription invalidates the matches cached for the topic
+				topic_vector.clear();
+				topic_vector.push_back(mqtt::Subscription::Create(Utf8String::Create(test_topic_base_ + "/#"), mqtt::QoS::QOS0, p_app_view_handler, nullptr));
+				rc = Subscribe(test_packet_id_ + 1, topic_vector);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedSubAckMessage(test_packet_id_ + 1, {0}));
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedPublishMessage(publish_topic, test_packet_id_, mqtt::QoS::QOS0, false, false, test_payload_));
+				rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				EXPECT_EQ(static_cast<size_t>(4), interned_topics.size());
+			}
+
+			TEST_F(SubUnsubActionTester, IncomingSubacksOutOfOrderTest) {
+				ASSERT_NE(nullptr, p_network_connection_);
+				ASSERT_NE(nullptr, p_core_state_);
+				ASSERT_NE(nullptr, p_subscribe_action_);
+
+				p_network_connection_->ClearNextReadBuf();
+				p_network_connection_->last_write_buf_.clear();
+				p_network_connection_->was_write_called_ = false;
+
+				std::unique_ptr<Action> p_network_read_action = mqtt::NetworkReadActionRunner::Create(p_core_state_);
+				mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler = std::bind(&SubUnsubActionTester::SubscribeCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+
+				uint16_t packet_ids[] = {test_packet_id_, test_packet_id_ + 1};
+				util::Vector<std::shared_ptr<mqtt::Subscription>> topic_vectors[2];
+				for(size_t packet_itr = 0; packet_itr < 2; packet_itr++) {
+					for(size_t topic_itr = 0; topic_itr < 3; topic_itr++) {
+						util::String topic_name = test_topic_base_ + "/" + util::ToString(packet_itr) + "/" + util::ToString(topic_itr);
+						topic_vectors[packet_itr].push_back(mqtt::Subscription::Create(Utf8String::Create(topic_name), mqtt::QoS::QOS1, p_app_handler, nullptr));
+					}
+					ResponseCode rc = Subscribe(packet_ids[packet_itr], topic_vectors[packet_itr]);
+					EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				}
+
+				// Second request is acknowledged first, only its subscriptions may change
+				std::vector<uint8_t> suback_list = {1, 128, 0};
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedSubAckMessage(packet_ids[1], suback_list));
+				p_network_read_action->PerformAction(p_network_connection_, nullptr);
+
+				EXPECT_TRUE(topic_vectors[1][0]->IsActive());
+				EXPECT_EQ(mqtt::QoS::QOS1, topic_vectors[1][0]->GetMaxQos());
+				EXPECT_EQ(nullptr, p_core_state_->GetSubscription(test_topic_base_ + "/1/1"));
+				EXPECT_TRUE(topic_vectors[1][2]->IsActive());
+				EXPECT_EQ(mqtt::QoS::QOS0, topic_vectors[1][2]->GetMaxQos());
+				for(std::shared_ptr<mqtt::Subscription> &p_sub : topic_vectors[0]) {
+					EXPECT_FALSE(p_sub->IsActive());
+				}
+
+				suback_list = {0, 0, 0};
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedSubAckMessage(packet_ids[0], suback_list));
+				ResponseCode rc = p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				EXPECT_EQ(ResponseCode::SUCCESS, rc);
+				for(std::shared_ptr<mqtt::Subscription> &p_sub : topic_vectors[0]) {
+					EXPECT_TRUE(p_sub->IsActive());
+					EXPECT_EQ(0, p_sub->GetIndexInPacket());
+				}
+
+				// A repeated SUBACK no longer refers to any subscription
+				p_network_connection_->SetNextReadBuf(TestHelper::GetSerializedSubAckMessage(packet_ids[0], {128, 128, 128}));
+				p_network_read_action->PerformAction(p_network_connection_, nullptr);
+				for(std::shared_ptr<mqtt::Subscription> &p_sub : topic_vectors[0]) {
+					EXPECT_EQ(p_sub, p_core_state_->GetSubscription(p_sub->GetTopicName()->ToStdString()));
+				}
+			}
+
+			// Status is updated by the keep alive and read threads while others read it, Ack index updates are never torn
+			TEST_F(SubUnsubActionTester, SubscriptionStatusConcurrentUpdateTest) {
+				mqtt::Subscription::ApplicationCallbackHandlerPtr p_app_handler = std::bind(&SubUnsubActionTester::SubscribeCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+				std::shared_ptr<mqtt::Subscription> p_subscription = mqtt::Subscription::Create(Utf8String::Create(test_topic_base_), mqtt::QoS::QOS1, p_app_handler, nullptr);
+				ASSERT_NE(nullptr, p_subscription);
+
+				std::atomic_bool is_writer_done(false);
+				std::thread writer_thread([&p_subscription, &is_writer_done]() {
+					for(size_t itr = 0; itr < 100000; itr++) {
+						bool is_even = (0 == itr % 2);
+						p_subscription->SetAckIndex(is_even ? 1 : 2, is_even ? 1 : 2);
+						p_subscription->SetActive(is_even);
+						p_subscription->SetMaxQos(is_even ? mqtt::QoS::QOS0 : mqtt::QoS::QOS1);
+					}
+					is_writer_done = true;
+				});
+
+				size_t torn_read_count = 0;
+				while(!is_writer_done) {
+					if(p_subscription->IsInSuback(1, 2) || p_subscription->IsInSuback(2, 1)) {
+						torn_read_count++;
+					}
+					p_subscription->IsActive();
+					p_subscription->GetMaxQos();
+				}
+				writer_thread.join();
+				EXPECT_EQ(static_cast<size_t>(0), torn_read_count);
+				EXPECT_TRUE(p_subscription->IsInSuback(2, 2));
+				EXPECT_EQ(2, p_subscription->GetPacketId());
+				EXPECT_EQ(2, p_subscription->GetIndexInPacket());
+				EXPECT_FALSE(p_subscription->IsActive());
+
+				// Copies take over the status
+				mqtt::Subscription subscription_copy(*p_subscription);
+				EXPECT_TRUE(subscription_copy.IsInSuback(2, 2));
+				EXPECT_EQ(mqtt::QoS::QOS1, subscription_copy.GetMaxQos());
+			}
+
 			TEST_F(SubUnsubActionTester, IncomingUnsubackOnSubscribedTopicTest) {
 				ASSERT_NE(nullptr, p_network_connection_);
 				ASSERT_NE(nullptr, p_core_state_);
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicFilterTrieTests.cpp
+ * @brief
+ *
+ */
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "mqtt/TopicFilterTrie.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			class TopicFilterTrieTester : public ::testing::Test {
+			protected:
+				mqtt::TopicFilterTrie trie_;
+				util::Map<util::String, std::shared_ptr<mqtt::Subscription>> subscriptions_;
+
+				void Insert(const util::String &topic_filter) {
+					std::shared_ptr<mqtt::Subscription> p_sub = mqtt::Subscription::Create(
+						Utf8String::Create(topic_filter), mqtt::QoS::QOS0,
+						[](util::String, util::String, std::shared_ptr<mqtt::SubscriptionHandlerContextData>) {
+							return ResponseCode::SUCCESS;
+						}, nullptr);
+					subscriptions_[topic_filter] = p_sub;
+					EXPECT_EQ(ResponseCode::SUCCESS, trie_.Insert(topic_filter, p_sub));
+				}
+
+				util::Vector<util::String> Match(const util::String &topic_name) {
+					util::Vector<std::shared_ptr<mqtt::Subscription>> matches;
+					trie_.Match(topic_name, matches);
+					util::Vector<util::String> matched_filters;
+					for(const std::shared_ptr<mqtt::Subscription> &p_sub : matches) {
+						matched_filters.push_back(p_sub->GetTopicName()->ToStdString());
+					}
+					std::sort(matched_filters.begin(), matched_filters.end());
+					return matched_filters;
+				}
+
+				util::Vector<util::String> LinearMatch(const util::String &topic_name) {
+					util::Vector<util::String> matched_filters;
+					for(auto &itr : subscriptions_) {
+						if(mqtt::TopicFilterTrie::IsMatch(itr.first, topic_name)) {
+							matched_filters.push_back(itr.first);
+						}
+					}
+					return matched_filters;
+				}
+			};
+
+			TEST_F(TopicFilterTrieTester, RejectsInvalidFilters) {
+				EXPECT_TRUE(mqtt::TopicFilterTrie::IsValidFilter("sport/+/player1"));
+				EXPECT_TRUE(mqtt::TopicFilterTrie::IsValidFilter("#"));
+				EXPECT_TRUE(mqtt::TopicFilterTrie::IsValidFilter("sport//#"));
+				EXPECT_FALSE(mqtt::TopicFilterTrie::IsValidFilter(""));
+				EXPECT_FALSE(mqtt::TopicFilterTrie::IsValidFilter("sport/#/player1"));
+				EXPECT_FALSE(mqtt::TopicFilterTrie::IsValidFilter("sport+"));
+				EXPECT_FALSE(mqtt::TopicFilterTrie::IsValidFilter("sport/tennis#"));
+
+				std::shared_ptr<mqtt::Subscription> p_sub = mqtt::Subscription::Create(
+					Utf8String::Create("a"), mqtt::QoS::QOS0,
+					[](util::String, util::String, std::shared_ptr<mqtt::SubscriptionHandlerContextData>) {
+						return ResponseCode::SUCCESS;
+					}, nullptr);
+				EXPECT_EQ(ResponseCode::MQTT_INVALID_DATA_ERROR, trie_.Insert("a/#/b", p_sub));
+				EXPECT_EQ(ResponseCode::NULL_VALUE_ERROR, trie_.Insert("a", nullptr));
+				EXPECT_EQ(0, static_cast<int>(trie_.Size()));
+			}
+
+			TEST_F(TopicFilterTrieTester, MatchesWildcardsBySpecification) {
+				Insert("sport/tennis/player1");
+				Insert("sport/tennis/player1/#");
+				Insert("sport/+/player1");
+				Insert("sport/#");
+				Insert("+/+");
+				Insert("+");
+				Insert("#");
+				Insert("/finance");
+				Insert("$SYS/#");
+
+				util::Vector<util::String> expected = {"#", "sport/#", "sport/+/player1", "sport/tennis/player1",
+													   "sport/tennis/player1/#"};
+				EXPECT_EQ(expected, Match("sport/tennis/player1"));
+
+				// Multi level wildcard also matches the parent level
+				expected = {"#", "+", "sport/#"};
+				EXPECT_EQ(expected, Match("sport"));
+
+				expected = {"#", "+/+", "/finance"};
+				EXPECT_EQ(expected, Match("/finance"));
+
+				// Filters starting with a wildcard do not match topics starting with $
+				expected = {"$SYS/#"};
+				EXPECT_EQ(expected, Match("$SYS/broker/uptime"));
+
+				expected = {"#", "sport/#"};
+				EXPECT_EQ(expected, Match("sport/tennis/player2/ranking"));
+			}
+
+			TEST_F(TopicFilterTrieTester, MatchesSameAsLinearScan) {
+				const util::String filters[] = {"a/b/c", "a/+/c", "a/#", "+/b/#", "a//c", "a/+/+/d", "+/+/+", "a/b",
+												"#", "b/+", "a/b/c/d"};
+				for(const util::String &filter : filters) {
+					Insert(filter);
+				}
+
+				const util::String topics[] = {"a/b/c", "a/b", "a", "a//c", "a/x/y/d", "b/b", "b/b/x/y", "a/b/c/d",
+											   "c", "a/", "/"};
+				for(const util::String &topic : topics) {
+					EXPECT_EQ(LinearMatch(topic), Match(topic)) << "Topic : " << topic;
+				}
+			}
+
+			TEST_F(TopicFilterTrieTester, FindReplaceAndRemove) {
+				Insert("a/+/c");
+				Insert("a/#");
+				EXPECT_EQ(2, static_cast<int>(trie_.Size()));
+				EXPECT_EQ(subscriptions_["a/+/c"], trie_.Find("a/+/c"));
+				EXPECT_EQ(nullptr, trie_.Find("a/b/c"));
+
+				// Replacing keeps the number of filters
+				Insert("a/+/c");
+				EXPECT_EQ(2, static_cast<int>(trie_.Size()));
+				EXPECT_EQ(subscriptions_["a/+/c"], trie_.Find("a/+/c"));
+
+				EXPECT_FALSE(trie_.Remove("a/b/c"));
+				EXPECT_TRUE(trie_.Remove("a/+/c"));
+				EXPECT_EQ(nullptr, trie_.Find("a/+/c"));
+				util::Vector<util::String> expected = {"a/#"};
+				EXPECT_EQ(expected, Match("a/b/c"));
+
+				EXPECT_TRUE(trie_.Remove("a/#"));
+				EXPECT_EQ(0, static_cast<int>(trie_.Size()));
+				EXPECT_TRUE(Match("a/b/c").empty());
+			}
+
+			TEST_F(TopicFilterTrieTester, CopiesAreIndependentSnapshots) {
+				Insert("a/b/c");
+				Insert("a/+/c");
+				Insert("x/#");
+
+				mqtt::TopicFilterTrie snapshot(trie_);
+				Insert("a/b/#");
+				EXPECT_TRUE(trie_.Remove("a/+/c"));
+				EXPECT_TRUE(trie_.Remove("x/#"));
+
+				util::Vector<std::shared_ptr<mqtt::Subscription>> matches;
+				snapshot.Match(util::String("a/b/c"), matches);
+				EXPECT_EQ(2, static_cast<int>(matches.size()));
+				EXPECT_EQ(3, static_cast<int>(snapshot.Size()));
+				EXPECT_EQ(subscriptions_["x/#"], snapshot.Find("x/#"));
+				EXPECT_EQ(nullptr, snapshot.Find("a/b/#"));
+
+				util::Vector<util::String> expected = {"a/b/#", "a/b/c"};
+				EXPECT_EQ(expected, Match("a/b/c"));
+
+				util::Vector<std::shared_ptr<mqtt::Subscription>> all_subscriptions;
+				trie_.GetAll(all_subscriptions);
+				EXPECT_EQ(trie_.Size(), all_subscriptions.size());
+			}
+
+			TEST_F(TopicFilterTrieTester, ManyChildrenWithSnapshots) {
+				const size_t device_count = 2000;
+				mqtt::TopicFilterTrie snapshot;
+				for(size_t itr = 0; itr < device_count; itr++) {
+					if(device_count / 2 == itr) {
+						snapshot = trie_;
+					}
+					Insert("devices/" + util::ToString(itr) + "/status");
+				}
+				for(size_t itr = 0; itr < device_count; itr += 2) {
+					EXPECT_TRUE(trie_.Remove("devices/" + util::ToString(itr) + "/status"));
+				}
+				EXPECT_EQ(device_count / 2, trie_.Size());
+				EXPECT_EQ(device_count / 2, snapshot.Size());
+
+				for(size_t itr = 0; itr < device_count; itr++) {
+					util::String topic_name = "devices/" + util::ToString(itr) + "/status";
+					EXPECT_EQ((1 == itr % 2) ? 1 : 0, static_cast<int>(Match(topic_name).size())) << topic_name;
+
+					util::Vector<std::shared_ptr<mqtt::Subscription>> matches;
+					snapshot.Match(topic_name, matches);
+					EXPECT_EQ((device_count / 2 > itr) ? 1 : 0, static_cast<int>(matches.size())) << topic_name;
+				}
+
+				util::Vector<std::shared_ptr<mqtt::Subscription>> all_subscriptions;
+				trie_.GetAll(all_subscriptions);
+				EXPECT_EQ(device_count / 2, all_subscriptions.size());
+			}
+		}
+	}
+}
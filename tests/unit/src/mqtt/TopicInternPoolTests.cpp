@@ -0,0 +1,136 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file TopicInternPoolTests.cpp
+ * @brief
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "mqtt/TopicInternPool.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			TEST(TopicInternPoolTester, SameTopicReturnsSameHandle) {
+				mqtt::TopicInternPool pool(16);
+				util::String buffer = "xx/sensors/1/temperaturexx";
+				std::shared_ptr<mqtt::InternedTopic> p_first = pool.Intern(util::StringView(buffer.data() + 3, 21));
+				std::shared_ptr<mqtt::InternedTopic> p_second = pool.Intern(util::String("sensors/1/temperature"));
+				std::shared_ptr<mqtt::InternedTopic> p_other = pool.Intern(util::String("sensors/2/temperature"));
+
+				ASSERT_NE(nullptr, p_first);
+				EXPECT_EQ(p_first, p_second);
+				EXPECT_NE(p_first, p_other);
+				EXPECT_EQ("sensors/1/temperature", p_first->GetTopicName());
+				EXPECT_EQ(mqtt::TopicInternPool::Hash(util::String("sensors/1/temperature")), p_first->GetHash());
+				EXPECT_EQ(2, static_cast<int>(pool.Size()));
+			}
+
+			TEST(TopicInternPoolTester, FullPoolEvictsOneTopic) {
+				mqtt::TopicInternPool pool(4);
+				util::Vector<std::shared_ptr<mqtt::InternedTopic>> topics;
+				for(size_t itr = 0; itr < 4; itr++) {
+					topics.push_back(pool.Intern(util::String("topic/" + util::ToString(itr))));
+				}
+				EXPECT_EQ(4, static_cast<int>(pool.Size()));
+				for(size_t itr = 1; itr < 4; itr++) {
+					EXPECT_EQ(topics[itr], pool.Intern(util::String("topic/" + util::ToString(itr))));
+				}
+
+				// Only the topic that was not looked up again is evicted, handles held outside the pool stay valid
+				std::shared_ptr<mqtt::InternedTopic> p_new = pool.Intern(util::String("topic/4"));
+				EXPECT_EQ(4, static_cast<int>(pool.Size()));
+				for(size_t itr = 1; itr < 4; itr++) {
+					EXPECT_EQ(topics[itr], pool.Intern(util::String("topic/" + util::ToString(itr))));
+				}
+				EXPECT_EQ(p_new, pool.Intern(util::String("topic/4")));
+				EXPECT_EQ("topic/0", topics[0]->GetTopicName());
+				EXPECT_NE(topics[0], pool.Intern(util::String("topic/0")));
+				EXPECT_EQ(4, static_cast<int>(pool.Size()));
+			}
+
+			TEST(TopicInternPoolTester, HotTopicsSurviveColdTopics) {
+				mqtt::TopicInternPool pool(16);
+				util::Vector<std::shared_ptr<mqtt::InternedTopic>> hot_topics;
+				for(size_t itr = 0; itr < 8; itr++) {
+					hot_topics.push_back(pool.Intern(util::String("hot/" + util::ToString(itr))));
+				}
+
+				for(size_t cold_itr = 0; cold_itr < 1000; cold_itr++) {
+					pool.Intern(util::String("cold/" + util::ToString(cold_itr)));
+					for(size_t itr = 0; itr < hot_topics.size(); itr++) {
+						ASSERT_EQ(hot_topics[itr], pool.Intern(util::String("hot/" + util::ToString(itr))));
+					}
+				}
+				EXPECT_EQ(16, static_cast<int>(pool.Size()));
+			}
+
+			// Evicted entries are removed from the middle of probe sequences, every topic left must still be found
+			TEST(TopicInternPoolTester, EvictionKeepsRemainingTopicsReachable) {
+				mqtt::TopicInternPool pool(32);
+				util::Vector<std::weak_ptr<mqtt::InternedTopic>> handles(200);
+				uint32_t random_state = 12345;
+				for(size_t itr = 0; itr < 20000; itr++) {
+					random_state = random_state * 1103515245 + 12345;
+					size_t topic_index = (random_state >> 16) % handles.size();
+					util::String topic_name = "topic/" + util::ToString(topic_index);
+
+					// The pool holds the only reference, a live handle means the topic is still interned
+					std::shared_ptr<mqtt::InternedTopic> p_expected = handles[topic_index].lock();
+					std::shared_ptr<mqtt::InternedTopic> p_topic = pool.Intern(topic_name);
+					if(nullptr != p_expected) {
+						ASSERT_EQ(p_expected, p_topic);
+					}
+					ASSERT_EQ(topic_name, p_topic->GetTopicName());
+					handles[topic_index] = p_topic;
+				}
+
+				size_t live_count = 0;
+				for(std::weak_ptr<mqtt::InternedTopic> &handle : handles) {
+					if(!handle.expired()) {
+						live_count++;
+					}
+				}
+				EXPECT_EQ(32, static_cast<int>(pool.Size()));
+				EXPECT_EQ(pool.Size(), live_count);
+			}
+
+			TEST(TopicInternPoolTester, CachedMatchesFollowTableVersion) {
+				mqtt::TopicInternPool pool;
+				std::shared_ptr<mqtt::InternedTopic> p_topic = pool.Intern(util::String("a/b"));
+				EXPECT_EQ(nullptr, p_topic->GetCachedMatches(0));
+
+				std::shared_ptr<mqtt::Subscription> p_sub = mqtt::Subscription::Create(
+					Utf8String::Create("a/+"), mqtt::QoS::QOS0,
+					[](util::String, util::String, std::shared_ptr<mqtt::SubscriptionHandlerContextData>) {
+						return ResponseCode::SUCCESS;
+					}, nullptr);
+				p_topic->ResetCachedMatches(3).push_back(p_sub);
+
+				const util::Vector<std::shared_ptr<mqtt::Subscription>> *p_matches = p_topic->GetCachedMatches(3);
+				ASSERT_NE(nullptr, p_matches);
+				EXPECT_EQ(1, static_cast<int>(p_matches->size()));
+				EXPECT_EQ(nullptr, p_topic->GetCachedMatches(4));
+
+				EXPECT_TRUE(p_topic->ResetCachedMatches(4).empty());
+				ASSERT_NE(nullptr, p_topic->GetCachedMatches(4));
+				EXPECT_EQ(nullptr, p_topic->GetCachedMatches(3));
+			}
+		}
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file LockFreeQueueTests.cpp
+ * @brief
+ *
+ */
+
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "util/memory/stl/Vector.hpp"
+#include "util/threading/LockFreeQueue.hpp"
+
+#define LOCK_FREE_QUEUE_TEST_PRODUCER_COUNT 4
+#define LOCK_FREE_QUEUE_TEST_ITEMS_PER_PRODUCER 10000
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			// Test capacity rounding and FIFO order for a single thread
+			TEST(LockFreeQueueTester, SingleThreadFifo) {
+				util::Threading::LockFreeQueue<int> queue(5);
+				EXPECT_EQ(static_cast<size_t>(8), queue.Capacity());
+				EXPECT_TRUE(queue.IsEmpty());
+
+				int value = 0;
+				EXPECT_FALSE(queue.TryDequeue(value));
+
+				for(int itr = 0; itr < 8; itr++) {
+					value = itr;
+					EXPECT_TRUE(queue.TryEnqueue(value));
+				}
+				EXPECT_FALSE(queue.IsEmpty());
+
+				// Queue is full, value should be left untouched
+				value = 100;
+				EXPECT_FALSE(queue.TryEnqueue(value));
+				EXPECT_EQ(100, value);
+
+				for(int itr = 0; itr < 8; itr++) {
+					EXPECT_TRUE(queue.TryDequeue(value));
+					EXPECT_EQ(itr, value);
+				}
+				EXPECT_TRUE(queue.IsEmpty());
+				EXPECT_FALSE(queue.TryDequeue(value));
+			}
+
+			// Test that dequeued cells do not keep references to elements
+			TEST(LockFreeQueueTester, ReleasesDequeuedElements) {
+				util::Threading::LockFreeQueue<std::shared_ptr<int>> queue(2);
+				std::shared_ptr<int> p_value = std::make_shared<int>(1);
+				std::shared_ptr<int> p_enqueued = p_value;
+
+				EXPECT_TRUE(queue.TryEnqueue(p_enqueued));
+				EXPECT_EQ(2, p_value.use_count());
+
+				std::shared_ptr<int> p_dequeued;
+				EXPECT_TRUE(queue.TryDequeue(p_dequeued));
+				p_dequeued = nullptr;
+				EXPECT_EQ(1, p_value.use_count());
+			}
+
+			// Test multiple producers with a single consumer, every element must be received exactly once
+			// and elements from the same producer must be received in order
+			TEST(LockFreeQueueTester, MultipleProducers) {
+				util::Threading::LockFreeQueue<std::pair<int, int>> queue(64);
+				util::Vector<std::thread> producers;
+
+				for(int producer_id = 0; producer_id < LOCK_FREE_QUEUE_TEST_PRODUCER_COUNT; producer_id++) {
+					producers.push_back(std::thread([&queue, producer_id]() {
+						for(int itr = 0; itr < LOCK_FREE_QUEUE_TEST_ITEMS_PER_PRODUCER; itr++) {
+							std::pair<int, int> item = std::make_pair(producer_id, itr);
+							while(!queue.TryEnqueue(item)) {
+								std::this_thread::yield();
+							}
+						}
+					}));
+				}
+
+				util::Vector<int> next_expected(LOCK_FREE_QUEUE_TEST_PRODUCER_COUNT, 0);
+				int total_received = 0;
+				bool is_order_valid = true;
+				while(total_received < LOCK_FREE_QUEUE_TEST_PRODUCER_COUNT * LOCK_FREE_QUEUE_TEST_ITEMS_PER_PRODUCER) {
+					std::pair<int, int> item;
+					if(!queue.TryDequeue(item)) {
+						std::this_thread::yield();
+						continue;
+					}
+					if(next_expected[item.first] != item.second) {
+						is_order_valid = false;
+					}
+					next_expected[item.first] = item.second + 1;
+					total_received++;
+				}
+
+				for(std::thread &producer : producers) {
+					producer.join();
+				}
+
+				EXPECT_TRUE(is_order_valid);
+				EXPECT_TRUE(queue.IsEmpty());
+				for(int producer_id = 0; producer_id < LOCK_FREE_QUEUE_TEST_PRODUCER_COUNT; producer_id++) {
+					EXPECT_EQ(LOCK_FREE_QUEUE_TEST_ITEMS_PER_PRODUCER, next_expected[producer_id]);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file MemoryResourceTests.cpp
+ * @brief
+ *
+ */
+
+#include <map>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "util/memory/MemoryResource.hpp"
+#include "util/memory/stl/Map.hpp"
+#include "util/memory/stl/String.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			/**
+			 * @brief Memory resource that counts the memory it hands out
+			 */
+			class CountingMemoryResource : public util::memory::MemoryResource {
+			protected:
+				void *DoAllocate(std::size_t bytes, std::size_t alignment) {
+					allocation_count_++;
+					allocated_bytes_ += bytes;
+					return ::operator new(bytes);
+				}
+				void DoDeallocate(void *p, std::size_t bytes, std::size_t alignment) {
+					allocated_bytes_ -= bytes;
+					::operator delete(p);
+				}
+				bool DoIsEqual(const MemoryResource &other) const { return false; }
+
+			public:
+				size_t allocation_count_ = 0;
+				size_t allocated_bytes_ = 0;
+			};
+
+			// Containers allocate from the resource passed to their allocator and free back to it
+			TEST(MemoryResourceTester, AllocatorUsesResource) {
+				CountingMemoryResource resource;
+				{
+					util::memory::ResourceAllocator<int> allocator(&resource);
+					std::vector<int, util::memory::ResourceAllocator<int>> values(allocator);
+					for(int itr = 0; itr < 100; itr++) {
+						values.push_back(itr);
+					}
+					EXPECT_LT(static_cast<size_t>(0), resource.allocation_count_);
+					EXPECT_LE(100 * sizeof(int), resource.allocated_bytes_);
+
+					// Copies keep the resource, also when rebound to another value type
+					std::vector<int, util::memory::ResourceAllocator<int>> values_copy(values);
+					EXPECT_EQ(&resource, values_copy.get_allocator().GetResource());
+					std::map<int, int, std::less<int>, util::memory::ResourceAllocator<std::pair<const int, int>>> map(
+						std::less<int>(), allocator);
+					map[1] = 1;
+					EXPECT_EQ(&resource, map.get_allocator().GetResource());
+				}
+				EXPECT_EQ(static_cast<size_t>(0), resource.allocated_bytes_);
+			}
+
+			// Default constructed allocators use the default resource at the time they are created
+			TEST(MemoryResourceTester, DefaultResource) {
+				util::memory::MemoryResource *p_new_delete_resource = util::memory::MemoryResource::GetNewDeleteResource();
+				EXPECT_EQ(p_new_delete_resource, util::memory::MemoryResource::GetDefaultResource());
+
+				CountingMemoryResource resource;
+				EXPECT_EQ(p_new_delete_resource, util::memory::MemoryResource::SetDefaultResource(&resource));
+				util::memory::ResourceAllocator<char> allocator;
+				EXPECT_EQ(&resource, allocator.GetResource());
+				EXPECT_EQ(&resource, util::memory::MemoryResource::SetDefaultResource(nullptr));
+				EXPECT_EQ(p_new_delete_resource, util::memory::MemoryResource::GetDefaultResource());
+
+				// Memory allocated while the resource was the default is still freed through it
+				{
+					std::basic_string<char, std::char_traits<char>, util::memory::ResourceAllocator<char>> str(allocator);
+					str.assign(100, 'x');
+					EXPECT_EQ(static_cast<size_t>(1), resource.allocation_count_);
+				}
+				EXPECT_EQ(static_cast<size_t>(0), resource.allocated_bytes_);
+
+				EXPECT_TRUE(util::memory::ResourceAllocator<int>() == util::memory::ResourceAllocator<char>());
+				EXPECT_FALSE(util::memory::ResourceAllocator<int>(&resource) == util::memory::ResourceAllocator<int>());
+			}
+
+			// Thread default resources take precedence over the process default on their thread only
+			TEST(MemoryResourceTester, ThreadResourceScope) {
+				util::memory::MemoryResource *p_new_delete_resource = util::memory::MemoryResource::GetNewDeleteResource();
+				CountingMemoryResource resource;
+				CountingMemoryResource process_resource;
+				EXPECT_EQ(nullptr, util::memory::MemoryResource::GetThreadDefaultResource());
+				{
+					util::memory::ThreadResourceScope resource_scope(&resource);
+					EXPECT_EQ(&resource, util::memory::MemoryResource::GetThreadDefaultResource());
+					EXPECT_EQ(&resource, util::memory::ResourceAllocator<char>().GetResource());
+
+					util::memory::MemoryResource::SetDefaultResource(&process_resource);
+					EXPECT_EQ(&resource, util::memory::MemoryResource::GetDefaultResource());
+					util::memory::MemoryResource *p_other_thread_resource = nullptr;
+					std::thread other_thread([&p_other_thread_resource]() {
+						p_other_thread_resource = util::memory::MemoryResource::GetDefaultResource();
+					});
+					other_thread.join();
+					EXPECT_EQ(&process_resource, p_other_thread_resource);
+					util::memory::MemoryResource::SetDefaultResource(nullptr);
+
+					// Scopes created with nullptr keep the current resource
+					{
+						util::memory::ThreadResourceScope empty_scope(nullptr);
+						EXPECT_EQ(&resource, util::memory::MemoryResource::GetDefaultResource());
+					}
+					EXPECT_EQ(&resource, util::memory::MemoryResource::GetDefaultResource());
+				}
+				EXPECT_EQ(nullptr, util::memory::MemoryResource::GetThreadDefaultResource());
+				EXPECT_EQ(p_new_delete_resource, util::memory::MemoryResource::GetDefaultResource());
+			}
+
+			// The aliases use the configured allocator
+			TEST(MemoryResourceTester, AliasesUseConfiguredAllocator) {
+				EXPECT_TRUE((std::is_same<util::Allocator<char>, util::String::allocator_type>::value));
+				EXPECT_TRUE((std::is_same<util::Allocator<int>, util::Vector<int>::allocator_type>::value));
+				EXPECT_TRUE((std::is_same<util::Allocator<std::pair<const int, int>>,
+										  util::Map<int, int>::allocator_type>::value));
+				EXPECT_EQ(util::String("42"), util::ToString(42));
+			}
+		}
+	}
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2010-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file PoolAllocatorTests.cpp
+ * @brief
+ *
+ */
+
+#include <memory>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "util/memory/PoolAllocator.hpp"
+#include "util/memory/stl/Vector.hpp"
+
+#include "TestHelper.hpp"
+
+#define POOL_ALLOCATOR_TEST_THREAD_COUNT 4
+#define POOL_ALLOCATOR_TEST_OBJECTS_PER_THREAD 10000
+
+namespace awsiotsdk {
+	namespace tests {
+		namespace unit {
+			// Each test uses its own value type so that it starts with an empty free list
+			struct PoolAllocatorReuseTestObject {
+				uint64_t value_[4];
+			};
+
+			struct PoolAllocatorOverflowTestObject {
+				uint64_t value_[4];
+			};
+
+			struct PoolAllocatorThreadTestObject {
+				uint64_t value_[4];
+			};
+
+			// A freed block is handed out again instead of allocating from the heap
+			TEST(PoolAllocatorTester, ReusesFreedBlocks) {
+				util::memory::PoolAllocator<PoolAllocatorReuseTestObject> allocator;
+				PoolAllocatorReuseTestObject *p_first = allocator.allocate(1);
+				allocator.deallocate(p_first, 1);
+
+				size_t allocation_count = TestHelper::GetAllocationCount();
+				PoolAllocatorReuseTestObject *p_second = allocator.allocate(1);
+				EXPECT_EQ(p_first, p_second);
+				EXPECT_EQ(allocation_count, TestHelper::GetAllocationCount());
+
+				// Arrays are never pooled
+				PoolAllocatorReuseTestObject *p_array = allocator.allocate(2);
+				EXPECT_EQ(allocation_count + 1, TestHelper::GetAllocationCount());
+				allocator.deallocate(p_array, 2);
+				allocator.deallocate(p_second, 1);
+			}
+
+			// Blocks freed while the free list is full go back to the heap, only a bounded number is kept
+			TEST(PoolAllocatorTester, FreeListIsBounded) {
+				const size_t block_count = POOL_ALLOCATOR_MAX_FREE_BLOCKS * 2;
+				util::memory::PoolAllocator<PoolAllocatorOverflowTestObject> allocator;
+				util::Vector<PoolAllocatorOverflowTestObject *> blocks;
+				for(size_t itr = 0; itr < block_count; itr++) {
+					blocks.push_back(allocator.allocate(1));
+				}
+				for(PoolAllocatorOverflowTestObject *p_block : blocks) {
+					allocator.deallocate(p_block, 1);
+				}
+
+				size_t allocation_count = TestHelper::GetAllocationCount();
+				for(size_t itr = 0; itr < block_count; itr++) {
+					blocks[itr] = allocator.allocate(1);
+				}
+				EXPECT_EQ(allocation_count + block_count - POOL_ALLOCATOR_MAX_FREE_BLOCKS, TestHelper::GetAllocationCount());
+				for(PoolAllocatorOverflowTestObject *p_block : blocks) {
+					allocator.deallocate(p_block, 1);
+				}
+			}
+
+			// Blocks are allocated and freed concurrently from several threads through the shared free list
+			TEST(PoolAllocatorTester, SharedAcrossThreads) {
+				util::Vector<std::thread> threads;
+				for(int thread_itr = 0; thread_itr < POOL_ALLOCATOR_TEST_THREAD_COUNT; thread_itr++) {
+					threads.push_back(std::thread([]() {
+						util::Vector<std::shared_ptr<PoolAllocatorThreadTestObject>> objects;
+						for(uint64_t itr = 0; itr < POOL_ALLOCATOR_TEST_OBJECTS_PER_THREAD; itr++) {
+							objects.push_back(std::allocate_shared<PoolAllocatorThreadTestObject>(
+								util::memory::PoolAllocator<PoolAllocatorThreadTestObject>()));
+							objects.back()->value_[0] = itr;
+							if(objects.size() > POOL_ALLOCATOR_MAX_FREE_BLOCKS / 2) {
+								objects.erase(objects.begin());
+							}
+						}
+						for(const std::shared_ptr<PoolAllocatorThreadTestObject> &p_object : objects) {
+							EXPECT_LT(p_object->value_[0], static_cast<uint64_t>(POOL_ALLOCATOR_TEST_OBJECTS_PER_THREAD));
+						}
+					}));
+				}
+				for(std::thread &thread : threads) {
+					thread.join();
+				}
+			}
+		}
+	}
+}